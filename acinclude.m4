@@ -6,6 +6,17 @@ dnl Function to detect if libvhdi dependencies are available
 AC_DEFUN([AX_LIBVHDI_CHECK_LOCAL],
   [dnl Check for internationalization functions in libvhdi/libvhdi_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
+
+  dnl Check for memory mapped file functions in libvhdi/libvhdi_memory_map.c
+  dnl and direct IO functions in libvhdi/libvhdi_direct_io_handle.c
+  AC_CHECK_HEADERS([fcntl.h sys/mman.h sys/stat.h unistd.h])
+
+  AC_CHECK_FUNCS([close fstat mmap munmap open posix_memalign pread])
+
+  dnl Check for io_uring system calls in libvhdi/libvhdi_io_uring.c
+  AC_CHECK_HEADERS([linux/io_uring.h sys/syscall.h])
+
+  AC_CHECK_FUNCS([syscall])
 ])
 
 dnl Function to check if DLL support is needed
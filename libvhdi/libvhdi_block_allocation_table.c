@@ -30,8 +30,7 @@
 #include "libvhdi_libbfio.h"
 #include "libvhdi_libcerror.h"
 #include "libvhdi_libcnotify.h"
-#include "libvhdi_libfdata.h"
-#include "libvhdi_unused.h"
+#include "libvhdi_memory_map.h"
 
 /* Creates a block allocation table
  * Make sure the value block_allocation_table is referencing, is set to NULL
@@ -134,6 +133,7 @@ int libvhdi_block_allocation_table_free(
      libcerror_error_t **error )
 {
 	static char *function = "libvhdi_block_allocation_table_free";
+	int result            = 1;
 
 	if( block_allocation_table == NULL )
 	{
@@ -148,12 +148,46 @@ int libvhdi_block_allocation_table_free(
 	}
 	if( *block_allocation_table != NULL )
 	{
+		if( ( *block_allocation_table )->memory_map != NULL )
+		{
+			if( libvhdi_memory_map_free(
+			     &( ( *block_allocation_table )->memory_map ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free memory map.",
+				 function );
+
+				result = -1;
+			}
+		}
+		else
+		{
+			if( ( *block_allocation_table )->sector_bitmap_file_offsets != NULL )
+			{
+				memory_free(
+				 ( *block_allocation_table )->sector_bitmap_file_offsets );
+			}
+			if( ( *block_allocation_table )->block_states != NULL )
+			{
+				memory_free(
+				 ( *block_allocation_table )->block_states );
+			}
+			if( ( *block_allocation_table )->block_file_offsets != NULL )
+			{
+				memory_free(
+				 ( *block_allocation_table )->block_file_offsets );
+			}
+		}
 		memory_free(
 		 *block_allocation_table );
 
 		*block_allocation_table = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Reads the block allocation table
@@ -281,6 +315,12 @@ int libvhdi_block_allocation_table_read_file_io_handle(
 		}
 		block_allocation_table->entries_per_chunk  = (uint32_t) entries_per_chunk;
 		block_allocation_table->sector_bitmap_size = 1048576 / entries_per_chunk;
+		block_allocation_table->number_of_chunks   = (uint32_t) ( block_allocation_table->number_of_entries / entries_per_chunk );
+
+		if( ( block_allocation_table->number_of_entries % entries_per_chunk ) != 0 )
+		{
+			block_allocation_table->number_of_chunks += 1;
+		}
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -488,34 +528,29 @@ on_error:
 #endif
 }
 
-/* Reads a block allocation table entry
- * Callback function for the data block vector
- * Returns 1 if successful or -1 on error
+/* Reads the block allocation table entries
+ * The entries are read in large chunks and decoded into the block file offsets
+ * and block states, which allows to look up a block without additional reads
+ * Returns 1 if successful, 0 if the table is too large to be read or -1 on error
  */
-int libvhdi_block_allocation_table_read_element_data(
+int libvhdi_block_allocation_table_read_entries_file_io_handle(
      libvhdi_block_allocation_table_t *block_allocation_table,
      libbfio_handle_t *file_io_handle,
-     libfdata_vector_t *vector,
-     libfdata_cache_t *cache,
-     int element_index,
-     int element_data_file_index LIBVHDI_ATTRIBUTE_UNUSED,
-     off64_t element_data_offset LIBVHDI_ATTRIBUTE_UNUSED,
-     size64_t element_data_size LIBVHDI_ATTRIBUTE_UNUSED,
-     uint32_t element_data_flags LIBVHDI_ATTRIBUTE_UNUSED,
-     uint8_t read_flags LIBVHDI_ATTRIBUTE_UNUSED,
      libcerror_error_t **error )
 {
-	libvhdi_block_descriptor_t *block_descriptor               = NULL;
-	libvhdi_block_descriptor_t *sector_bitmap_block_descriptor = NULL;
-	static char *function                                      = "libvhdi_block_allocation_table_read_element_data";
-	off64_t sector_bitmap_offset                               = 0;
-	off64_t table_entry_offset                                 = 0;
-
-	LIBVHDI_UNREFERENCED_PARAMETER( element_data_file_index );
-	LIBVHDI_UNREFERENCED_PARAMETER( element_data_offset );
-	LIBVHDI_UNREFERENCED_PARAMETER( element_data_size );
-	LIBVHDI_UNREFERENCED_PARAMETER( element_data_flags );
-	LIBVHDI_UNREFERENCED_PARAMETER( read_flags );
+	uint8_t *table_data              = NULL;
+	static char *function            = "libvhdi_block_allocation_table_read_entries_file_io_handle";
+	size_t read_size                 = 0;
+	size_t table_data_offset         = 0;
+	ssize_t read_count               = 0;
+	off64_t file_offset              = 0;
+	uint64_t chunk_entry_index       = 0;
+	uint64_t chunk_index             = 0;
+	uint64_t entry_index             = 0;
+	uint64_t number_of_table_entries = 0;
+	uint64_t table_entry             = 0;
+	uint64_t table_entry_index       = 0;
+	uint8_t has_chunks               = 0;
 
 	if( block_allocation_table == NULL )
 	{
@@ -528,145 +563,567 @@ int libvhdi_block_allocation_table_read_element_data(
 
 		return( -1 );
 	}
-	if( libvhdi_block_descriptor_initialize(
-	     &block_descriptor,
-	     error ) != 1 )
+	if( block_allocation_table->block_file_offsets != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create block descriptor.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block allocation table - block file offsets value already set.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	table_entry_offset = element_index;
+	if( ( block_allocation_table->table_entry_size != 4 )
+	 && ( block_allocation_table->table_entry_size != 8 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid block allocation table - unsupported table entry size.",
+		 function );
 
+		return( -1 );
+	}
+	if( ( block_allocation_table->number_of_entries == 0 )
+	 || ( (size_t) block_allocation_table->number_of_entries > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( off64_t ) ) ) )
+	{
+		return( 0 );
+	}
 	if( ( block_allocation_table->file_type == LIBVHDI_FILE_TYPE_VHDX )
 	 && ( block_allocation_table->disk_type != LIBVHDI_DISK_TYPE_FIXED ) )
 	{
-		table_entry_offset /= block_allocation_table->entries_per_chunk;
-		table_entry_offset *= block_allocation_table->entries_per_chunk + 1;
-		table_entry_offset += element_index % block_allocation_table->entries_per_chunk;
+		if( block_allocation_table->entries_per_chunk == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid block allocation table - missing entries per chunk.",
+			 function );
+
+			goto on_error;
+		}
+		has_chunks = 1;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( has_chunks == 0 )
 	{
-		libcnotify_printf(
-		 "%s: table entry index\t: %" PRIi64 "\n",
-		 function,
-		 table_entry_offset );
+		number_of_table_entries = block_allocation_table->number_of_entries;
 	}
-#endif
-	table_entry_offset *= block_allocation_table->table_entry_size;
-	table_entry_offset += block_allocation_table->file_offset;
+	else if( block_allocation_table->disk_type == LIBVHDI_DISK_TYPE_DIFFERENTIAL )
+	{
+		/* The sector bitmap entry follows the entries of every chunk
+		 */
+		number_of_table_entries  = block_allocation_table->number_of_chunks;
+		number_of_table_entries *= (uint64_t) block_allocation_table->entries_per_chunk + 1;
+	}
+	else
+	{
+		/* The sector bitmap entries are not used, hence there is no need to read past the last block entry
+		 */
+		entry_index = block_allocation_table->number_of_entries - 1;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+		number_of_table_entries  = entry_index / block_allocation_table->entries_per_chunk;
+		number_of_table_entries *= (uint64_t) block_allocation_table->entries_per_chunk + 1;
+		number_of_table_entries += ( entry_index % block_allocation_table->entries_per_chunk ) + 1;
+	}
+	block_allocation_table->block_file_offsets = (off64_t *) memory_allocate(
+	                                                          sizeof( off64_t ) * block_allocation_table->number_of_entries );
+
+	if( block_allocation_table->block_file_offsets == NULL )
 	{
-		libcnotify_printf(
-		 "%s: table entry offset\t: %" PRIi64 "\n",
-		 function,
-		 table_entry_offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block file offsets.",
+		 function );
 
-		libcnotify_printf(
-		 "\n" );
+		goto on_error;
 	}
-#endif
-	if( libvhdi_block_descriptor_read_table_entry_file_io_handle(
-	     block_descriptor,
-	     file_io_handle,
-	     block_allocation_table->file_type,
-	     table_entry_offset,
-	     block_allocation_table->sector_bitmap_size,
-	     error ) != 1 )
+	block_allocation_table->block_states = (uint8_t *) memory_allocate(
+	                                                    sizeof( uint8_t ) * block_allocation_table->number_of_entries );
+
+	if( block_allocation_table->block_states == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read block allocation table entry: %d.",
-		 function,
-		 element_index );
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block states.",
+		 function );
 
 		goto on_error;
 	}
-	if( block_allocation_table->file_type == LIBVHDI_FILE_TYPE_VHD )
+	if( memory_set(
+	     block_allocation_table->block_states,
+	     0,
+	     sizeof( uint8_t ) * block_allocation_table->number_of_entries ) == NULL )
 	{
-		sector_bitmap_offset = block_descriptor->file_offset;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block states.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( has_chunks != 0 )
+	 && ( block_allocation_table->disk_type == LIBVHDI_DISK_TYPE_DIFFERENTIAL ) )
+	{
+		block_allocation_table->sector_bitmap_file_offsets = (off64_t *) memory_allocate(
+		                                                                  sizeof( off64_t ) * block_allocation_table->number_of_chunks );
 
-		if( sector_bitmap_offset != -1 )
+		if( block_allocation_table->sector_bitmap_file_offsets == NULL )
 		{
-			sector_bitmap_offset -= block_allocation_table->sector_bitmap_size;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create sector bitmap file offsets.",
+			 function );
+
+			goto on_error;
 		}
 	}
-	else if( block_allocation_table->file_type == LIBVHDI_FILE_TYPE_VHDX )
+	read_size = LIBVHDI_BLOCK_ALLOCATION_TABLE_READ_SIZE;
+
+	if( (uint64_t) read_size > ( number_of_table_entries * block_allocation_table->table_entry_size ) )
+	{
+		read_size = (size_t) ( number_of_table_entries * block_allocation_table->table_entry_size );
+	}
+	table_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * read_size );
+
+	if( table_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create table data.",
+		 function );
+
+		goto on_error;
+	}
+	file_offset = block_allocation_table->file_offset;
+
+	while( table_entry_index < number_of_table_entries )
 	{
-		if( block_allocation_table->disk_type != LIBVHDI_DISK_TYPE_DIFFERENTIAL )
+		read_size = LIBVHDI_BLOCK_ALLOCATION_TABLE_READ_SIZE;
+
+		if( (uint64_t) read_size > ( ( number_of_table_entries - table_entry_index ) * block_allocation_table->table_entry_size ) )
 		{
-			sector_bitmap_offset = -1;
+			read_size = (size_t) ( ( number_of_table_entries - table_entry_index ) * block_allocation_table->table_entry_size );
 		}
-		else
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              table_data,
+		              read_size,
+		              file_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
 		{
-			if( block_allocation_table->entries_per_chunk == 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: invalid block allocation table - missing entries per chunk.",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read table data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 file_offset,
+			 file_offset );
 
-				goto on_error;
+			goto on_error;
+		}
+		file_offset += read_size;
+
+		for( table_data_offset = 0;
+		     table_data_offset < read_size;
+		     table_data_offset += block_allocation_table->table_entry_size )
+		{
+			if( block_allocation_table->table_entry_size == 4 )
+			{
+				byte_stream_copy_to_uint32_big_endian(
+				 &( table_data[ table_data_offset ] ),
+				 table_entry );
 			}
-			if( libvhdi_block_descriptor_initialize(
-			     &sector_bitmap_block_descriptor,
-			     error ) != 1 )
+			else
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create sector bitmap block descriptor.",
-				 function );
-
-				goto on_error;
+				byte_stream_copy_to_uint64_little_endian(
+				 &( table_data[ table_data_offset ] ),
+				 table_entry );
+			}
+			if( has_chunks == 0 )
+			{
+				entry_index = table_entry_index;
 			}
-			table_entry_offset  = 1 + ( element_index / block_allocation_table->entries_per_chunk );
-			table_entry_offset *= block_allocation_table->entries_per_chunk + 1;
-			table_entry_offset -= 1;
+			else
+			{
+				chunk_index       = table_entry_index / ( (uint64_t) block_allocation_table->entries_per_chunk + 1 );
+				chunk_entry_index = table_entry_index % ( (uint64_t) block_allocation_table->entries_per_chunk + 1 );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
+				if( chunk_entry_index == block_allocation_table->entries_per_chunk )
+				{
+					if( block_allocation_table->sector_bitmap_file_offsets != NULL )
+					{
+						block_allocation_table->sector_bitmap_file_offsets[ chunk_index ] = (off64_t) ( ( table_entry >> 20 ) * 1024 * 1024 );
+					}
+					table_entry_index++;
+
+					continue;
+				}
+				entry_index = ( chunk_index * block_allocation_table->entries_per_chunk ) + chunk_entry_index;
+			}
+			if( entry_index < block_allocation_table->number_of_entries )
 			{
-				libcnotify_printf(
-				 "%s: bitmap entry index\t: %" PRIi64 "\n",
-				 function,
-				 table_entry_offset );
+				if( block_allocation_table->file_type == LIBVHDI_FILE_TYPE_VHD )
+				{
+					if( table_entry == 0xffffffffUL )
+					{
+						block_allocation_table->block_file_offsets[ entry_index ] = -1;
+					}
+					else
+					{
+						block_allocation_table->block_file_offsets[ entry_index ] = (off64_t) ( ( table_entry * 512 ) + block_allocation_table->sector_bitmap_size );
+					}
+				}
+				else
+				{
+					block_allocation_table->block_states[ entry_index ]       = (uint8_t) ( table_entry & 0x7 );
+					block_allocation_table->block_file_offsets[ entry_index ] = (off64_t) ( ( table_entry >> 20 ) * 1024 * 1024 );
+				}
 			}
-#endif
-			table_entry_offset *= block_allocation_table->table_entry_size;
-			table_entry_offset += block_allocation_table->file_offset;
+			table_entry_index++;
+		}
+	}
+	memory_free(
+	 table_data );
+
+	return( 1 );
+
+on_error:
+	if( table_data != NULL )
+	{
+		memory_free(
+		 table_data );
+	}
+	if( block_allocation_table->sector_bitmap_file_offsets != NULL )
+	{
+		memory_free(
+		 block_allocation_table->sector_bitmap_file_offsets );
+
+		block_allocation_table->sector_bitmap_file_offsets = NULL;
+	}
+	if( block_allocation_table->block_states != NULL )
+	{
+		memory_free(
+		 block_allocation_table->block_states );
+
+		block_allocation_table->block_states = NULL;
+	}
+	if( block_allocation_table->block_file_offsets != NULL )
+	{
+		memory_free(
+		 block_allocation_table->block_file_offsets );
+
+		block_allocation_table->block_file_offsets = NULL;
+	}
+	return( -1 );
+}
+
+/* Reads a single block allocation table entry
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_block_allocation_table_read_table_entry_file_io_handle(
+     libvhdi_block_allocation_table_t *block_allocation_table,
+     libbfio_handle_t *file_io_handle,
+     uint64_t table_entry_index,
+     uint64_t *table_entry,
+     libcerror_error_t **error )
+{
+	uint8_t table_entry_data[ 8 ];
+
+	static char *function = "libvhdi_block_allocation_table_read_table_entry_file_io_handle";
+	ssize_t read_count    = 0;
+	off64_t file_offset   = 0;
+
+	if( block_allocation_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block allocation table.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_allocation_table->table_entry_size != 4 )
+	 && ( block_allocation_table->table_entry_size != 8 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid block allocation table - unsupported table entry size.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_entry_index > (uint64_t) ( INT64_MAX / 8 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid table entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table entry.",
+		 function );
+
+		return( -1 );
+	}
+	file_offset = block_allocation_table->file_offset + (off64_t) ( table_entry_index * block_allocation_table->table_entry_size );
 
 #if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: bitmap entry offset\t: %" PRIi64 "\n",
-				 function,
-				 table_entry_offset );
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading table entry: %" PRIu64 " at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 table_entry_index,
+		 file_offset,
+		 file_offset );
+	}
+#endif
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              table_entry_data,
+	              block_allocation_table->table_entry_size,
+	              file_offset,
+	              error );
+
+	if( read_count != (ssize_t) block_allocation_table->table_entry_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read table entry data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	if( block_allocation_table->table_entry_size == 4 )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 table_entry_data,
+		 *table_entry );
+	}
+	else
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 table_entry_data,
+		 *table_entry );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific block allocation table entry
+ * The sector bitmap file offset is -1 if the block has no sector bitmap
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_block_allocation_table_get_entry_by_index(
+     libvhdi_block_allocation_table_t *block_allocation_table,
+     libbfio_handle_t *file_io_handle,
+     uint32_t entry_index,
+     off64_t *block_file_offset,
+     uint8_t *block_state,
+     off64_t *sector_bitmap_file_offset,
+     libcerror_error_t **error )
+{
+	static char *function          = "libvhdi_block_allocation_table_get_entry_by_index";
+	off64_t safe_block_file_offset = -1;
+	uint64_t chunk_index           = 0;
+	uint64_t table_entry           = 0;
+	uint64_t table_entry_index     = 0;
+	uint8_t safe_block_state       = 0;
+
+	if( block_allocation_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block allocation table.",
+		 function );
 
-				libcnotify_printf(
-				 "\n" );
+		return( -1 );
+	}
+	if( ( block_allocation_table->file_type != LIBVHDI_FILE_TYPE_VHD )
+	 && ( block_allocation_table->file_type != LIBVHDI_FILE_TYPE_VHDX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid block allocation table - unsupported file type.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_allocation_table->file_type == LIBVHDI_FILE_TYPE_VHDX )
+	 && ( block_allocation_table->disk_type != LIBVHDI_DISK_TYPE_FIXED )
+	 && ( block_allocation_table->entries_per_chunk == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid block allocation table - missing entries per chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index >= block_allocation_table->number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block file offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block state.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_bitmap_file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector bitmap file offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_allocation_table->block_file_offsets != NULL )
+	{
+		safe_block_file_offset = block_allocation_table->block_file_offsets[ entry_index ];
+		safe_block_state       = block_allocation_table->block_states[ entry_index ];
+	}
+	else
+	{
+		table_entry_index = entry_index;
+
+		if( ( block_allocation_table->file_type == LIBVHDI_FILE_TYPE_VHDX )
+		 && ( block_allocation_table->disk_type != LIBVHDI_DISK_TYPE_FIXED ) )
+		{
+			table_entry_index /= block_allocation_table->entries_per_chunk;
+			table_entry_index *= (uint64_t) block_allocation_table->entries_per_chunk + 1;
+			table_entry_index += entry_index % block_allocation_table->entries_per_chunk;
+		}
+		if( libvhdi_block_allocation_table_read_table_entry_file_io_handle(
+		     block_allocation_table,
+		     file_io_handle,
+		     table_entry_index,
+		     &table_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read block allocation table entry: %" PRIu32 ".",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( block_allocation_table->file_type == LIBVHDI_FILE_TYPE_VHD )
+		{
+			if( table_entry != 0xffffffffUL )
+			{
+				safe_block_file_offset = (off64_t) ( ( table_entry * 512 ) + block_allocation_table->sector_bitmap_size );
 			}
-#endif
-			if( libvhdi_block_descriptor_read_table_entry_file_io_handle(
-			     sector_bitmap_block_descriptor,
+		}
+		else
+		{
+			safe_block_state       = (uint8_t) ( table_entry & 0x7 );
+			safe_block_file_offset = (off64_t) ( ( table_entry >> 20 ) * 1024 * 1024 );
+		}
+	}
+	*block_file_offset = safe_block_file_offset;
+	*block_state       = safe_block_state;
+
+	if( block_allocation_table->file_type == LIBVHDI_FILE_TYPE_VHD )
+	{
+		*sector_bitmap_file_offset = safe_block_file_offset;
+
+		if( safe_block_file_offset != -1 )
+		{
+			*sector_bitmap_file_offset -= block_allocation_table->sector_bitmap_size;
+		}
+	}
+	else if( block_allocation_table->disk_type != LIBVHDI_DISK_TYPE_DIFFERENTIAL )
+	{
+		*sector_bitmap_file_offset = -1;
+	}
+	else
+	{
+		chunk_index = entry_index / block_allocation_table->entries_per_chunk;
+
+		if( block_allocation_table->sector_bitmap_file_offsets != NULL )
+		{
+			*sector_bitmap_file_offset = block_allocation_table->sector_bitmap_file_offsets[ chunk_index ];
+		}
+		else
+		{
+			table_entry_index  = chunk_index + 1;
+			table_entry_index *= (uint64_t) block_allocation_table->entries_per_chunk + 1;
+			table_entry_index -= 1;
+
+			if( libvhdi_block_allocation_table_read_table_entry_file_io_handle(
+			     block_allocation_table,
 			     file_io_handle,
-			     block_allocation_table->file_type,
-			     table_entry_offset,
-			     block_allocation_table->sector_bitmap_size,
+			     table_entry_index,
+			     &table_entry,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -676,29 +1133,103 @@ int libvhdi_block_allocation_table_read_element_data(
 				 "%s: unable to read sector bitmap block allocation table entry.",
 				 function );
 
-				goto on_error;
+				return( -1 );
 			}
-			sector_bitmap_offset  = sector_bitmap_block_descriptor->file_offset;
-			sector_bitmap_offset += ( element_index % block_allocation_table->entries_per_chunk ) * block_allocation_table->sector_bitmap_size;
+			*sector_bitmap_file_offset = (off64_t) ( ( table_entry >> 20 ) * 1024 * 1024 );
+		}
+		*sector_bitmap_file_offset += ( entry_index % block_allocation_table->entries_per_chunk ) * block_allocation_table->sector_bitmap_size;
+	}
+	return( 1 );
+}
 
-			if( libvhdi_block_descriptor_free(
-			     &sector_bitmap_block_descriptor,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free sector bitmap block descriptor.",
-				 function );
+/* Reads the block descriptor of a specific block allocation table entry
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_block_allocation_table_read_block_descriptor(
+     libvhdi_block_allocation_table_t *block_allocation_table,
+     libbfio_handle_t *file_io_handle,
+     uint32_t entry_index,
+     libvhdi_block_descriptor_t **block_descriptor,
+     libcerror_error_t **error )
+{
+	libvhdi_block_descriptor_t *safe_block_descriptor = NULL;
+	static char *function                             = "libvhdi_block_allocation_table_read_block_descriptor";
+	off64_t sector_bitmap_offset                      = 0;
 
-				goto on_error;
-			}
-		}
+	if( block_allocation_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block allocation table.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_descriptor != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_block_descriptor_initialize(
+	     &safe_block_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create block descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvhdi_block_allocation_table_get_entry_by_index(
+	     block_allocation_table,
+	     file_io_handle,
+	     entry_index,
+	     &( safe_block_descriptor->file_offset ),
+	     &( safe_block_descriptor->block_state ),
+	     &sector_bitmap_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block allocation table entry: %" PRIu32 ".",
+		 function,
+		 entry_index );
+
+		goto on_error;
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
+		libcnotify_printf(
+		 "%s: block: %" PRIu32 " file offset\t: %" PRIi64 "\n",
+		 function,
+		 entry_index,
+		 safe_block_descriptor->file_offset );
+
 		libcnotify_printf(
 		 "%s: sector bitmap offset\t: %" PRIi64 "\n",
 		 function,
@@ -709,7 +1240,7 @@ int libvhdi_block_allocation_table_read_element_data(
 	}
 #endif
 	if( libvhdi_block_descriptor_read_sector_bitmap_file_io_handle(
-	     block_descriptor,
+	     safe_block_descriptor,
 	     file_io_handle,
 	     block_allocation_table->file_type,
 	     sector_bitmap_offset,
@@ -722,46 +1253,23 @@ int libvhdi_block_allocation_table_read_element_data(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read block: %d sector bitmap.",
+		 "%s: unable to read block: %" PRIu32 " sector bitmap.",
 		 function,
-		 element_index );
+		 entry_index );
 
 		goto on_error;
 	}
-	if( libfdata_vector_set_element_value_by_index(
-	     vector,
-	     (intptr_t *) file_io_handle,
-	     cache,
-	     element_index,
-	     (intptr_t *) block_descriptor,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libvhdi_block_descriptor_free,
-	     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set block descriptor as element value.",
-		 function );
+	*block_descriptor = safe_block_descriptor;
 
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
-	if( sector_bitmap_block_descriptor != NULL )
-	{
-		libvhdi_block_descriptor_free(
-		 &sector_bitmap_block_descriptor,
-		 NULL );
-	}
-	if( block_descriptor != NULL )
+	if( safe_block_descriptor != NULL )
 	{
 		libvhdi_block_descriptor_free(
-		 &block_descriptor,
+		 &safe_block_descriptor,
 		 NULL );
 	}
-	return( 1 );
+	return( -1 );
 }
 
@@ -25,9 +25,10 @@
 #include <common.h>
 #include <types.h>
 
+#include "libvhdi_block_descriptor.h"
 #include "libvhdi_libbfio.h"
 #include "libvhdi_libcerror.h"
-#include "libvhdi_libfdata.h"
+#include "libvhdi_memory_map.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -72,6 +73,27 @@ struct libvhdi_block_allocation_table
 	/* The number of entries per chunk
 	 */
 	uint32_t entries_per_chunk;
+
+	/* The number of chunks
+	 */
+	uint32_t number_of_chunks;
+
+	/* The block file offsets
+	 */
+	off64_t *block_file_offsets;
+
+	/* The block states
+	 */
+	uint8_t *block_states;
+
+	/* The sector bitmap file offsets, one per chunk
+	 */
+	off64_t *sector_bitmap_file_offsets;
+
+	/* The memory map of the index file
+	 * When set the entries reference the mapped index data and are not allocated
+	 */
+	libvhdi_memory_map_t *memory_map;
 };
 
 int libvhdi_block_allocation_table_initialize(
@@ -93,17 +115,32 @@ int libvhdi_block_allocation_table_read_file_io_handle(
      uint32_t bytes_per_sector,
      libcerror_error_t **error );
 
-int libvhdi_block_allocation_table_read_element_data(
+int libvhdi_block_allocation_table_read_entries_file_io_handle(
+     libvhdi_block_allocation_table_t *block_allocation_table,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libvhdi_block_allocation_table_read_table_entry_file_io_handle(
+     libvhdi_block_allocation_table_t *block_allocation_table,
+     libbfio_handle_t *file_io_handle,
+     uint64_t table_entry_index,
+     uint64_t *table_entry,
+     libcerror_error_t **error );
+
+int libvhdi_block_allocation_table_get_entry_by_index(
+     libvhdi_block_allocation_table_t *block_allocation_table,
+     libbfio_handle_t *file_io_handle,
+     uint32_t entry_index,
+     off64_t *block_file_offset,
+     uint8_t *block_state,
+     off64_t *sector_bitmap_file_offset,
+     libcerror_error_t **error );
+
+int libvhdi_block_allocation_table_read_block_descriptor(
      libvhdi_block_allocation_table_t *block_allocation_table,
      libbfio_handle_t *file_io_handle,
-     libfdata_vector_t *vector,
-     libfdata_cache_t *cache,
-     int element_index,
-     int element_data_file_index,
-     off64_t element_data_offset,
-     size64_t element_data_size,
-     uint32_t element_data_flags,
-     uint8_t read_flags,
+     uint32_t entry_index,
+     libvhdi_block_descriptor_t **block_descriptor,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
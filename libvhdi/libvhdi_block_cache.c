@@ -0,0 +1,936 @@
+/*
+ * Block cache functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvhdi_block_cache.h"
+#include "libvhdi_block_descriptor.h"
+#include "libvhdi_definitions.h"
+#include "libvhdi_libcerror.h"
+#include "libvhdi_libcthreads.h"
+
+/* Determines the hash table slot of a block number
+ */
+#define libvhdi_block_cache_get_hash_slot( block_cache, shard, block_number ) \
+	(int) ( ( ( ( (uint64_t) ( block_number ) / (uint64_t) ( block_cache )->number_of_shards ) * 0x9e3779b97f4a7c15ULL ) >> 32 ) & (uint64_t) ( ( shard )->hash_table_size - 1 ) )
+
+/* The referenced flags and the hit and miss counters are updated with atomic operations if available
+ * otherwise, with multi-thread support, lookups hold the write lock of the shard
+ */
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define LIBVHDI_BLOCK_CACHE_HAVE_GNUC_ATOMICS	1
+
+#elif defined( _MSC_VER ) && defined( _WIN64 )
+#define LIBVHDI_BLOCK_CACHE_HAVE_WINAPI_ATOMICS	1
+
+#else
+#define LIBVHDI_BLOCK_CACHE_HAVE_WRITE_LOCK	1
+
+#endif
+#endif /* defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT ) */
+
+/* Sets the referenced flag of an entry
+ * Lookups that only hold the read lock of the shard can set the flag concurrently
+ */
+#if defined( LIBVHDI_BLOCK_CACHE_HAVE_GNUC_ATOMICS )
+#define libvhdi_block_cache_shard_set_referenced( shard, entry_index ) \
+	__atomic_store_n( &( ( shard )->referenced_flags[ entry_index ] ), (uint8_t) 1, __ATOMIC_RELAXED )
+
+#elif defined( LIBVHDI_BLOCK_CACHE_HAVE_WINAPI_ATOMICS )
+#define libvhdi_block_cache_shard_set_referenced( shard, entry_index ) \
+	InterlockedExchange8( (char volatile *) &( ( shard )->referenced_flags[ entry_index ] ), (char) 1 )
+
+#else
+#define libvhdi_block_cache_shard_set_referenced( shard, entry_index ) \
+	( shard )->referenced_flags[ entry_index ] = 1
+
+#endif
+
+/* Increments a hit or miss counter of a shard
+ * Lookups that only hold the read lock of the shard can increment the counter concurrently
+ */
+#if defined( LIBVHDI_BLOCK_CACHE_HAVE_GNUC_ATOMICS )
+#define libvhdi_block_cache_shard_increment_counter( counter ) \
+	__atomic_fetch_add( &( counter ), (uint64_t) 1, __ATOMIC_RELAXED )
+
+#elif defined( LIBVHDI_BLOCK_CACHE_HAVE_WINAPI_ATOMICS )
+#define libvhdi_block_cache_shard_increment_counter( counter ) \
+	InterlockedIncrement64( (LONG64 volatile *) &( counter ) )
+
+#else
+#define libvhdi_block_cache_shard_increment_counter( counter ) \
+	( counter ) += 1
+
+#endif
+
+/* Creates a block cache
+ * The entries are distributed over multiple shards, each with its own lock
+ * Make sure the value block_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_block_cache_initialize(
+     libvhdi_block_cache_t **block_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	libvhdi_block_cache_shard_t *shard  = NULL;
+	static char *function               = "libvhdi_block_cache_initialize";
+	int maximum_number_of_shard_entries = 0;
+	int number_of_shards                = 0;
+	int shard_index                     = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_entries <= 0 )
+	 || ( maximum_number_of_entries > LIBVHDI_MAXIMUM_BLOCK_CACHE_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_shards = LIBVHDI_BLOCK_CACHE_NUMBER_OF_SHARDS;
+
+	if( number_of_shards > maximum_number_of_entries )
+	{
+		number_of_shards = maximum_number_of_entries;
+	}
+	maximum_number_of_shard_entries = maximum_number_of_entries / number_of_shards;
+
+	if( ( maximum_number_of_entries % number_of_shards ) != 0 )
+	{
+		maximum_number_of_shard_entries += 1;
+	}
+	*block_cache = memory_allocate_structure(
+	                libvhdi_block_cache_t );
+
+	if( *block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *block_cache,
+	     0,
+	     sizeof( libvhdi_block_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block cache.",
+		 function );
+
+		memory_free(
+		 *block_cache );
+
+		*block_cache = NULL;
+
+		return( -1 );
+	}
+	( *block_cache )->shards = (libvhdi_block_cache_shard_t *) memory_allocate(
+	                                                            sizeof( libvhdi_block_cache_shard_t ) * number_of_shards );
+
+	if( ( *block_cache )->shards == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shards.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *block_cache )->shards,
+	     0,
+	     sizeof( libvhdi_block_cache_shard_t ) * number_of_shards ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shards.",
+		 function );
+
+		memory_free(
+		 ( *block_cache )->shards );
+
+		( *block_cache )->shards = NULL;
+
+		goto on_error;
+	}
+	( *block_cache )->number_of_shards = number_of_shards;
+
+	for( shard_index = 0;
+	     shard_index < number_of_shards;
+	     shard_index++ )
+	{
+		shard = &( ( ( *block_cache )->shards )[ shard_index ] );
+
+		shard->maximum_number_of_entries = maximum_number_of_shard_entries;
+		shard->hash_table_size           = 1;
+
+		/* Keep the hash table at most half full to limit the probe lengths
+		 */
+		while( shard->hash_table_size < ( 2 * maximum_number_of_shard_entries ) )
+		{
+			shard->hash_table_size <<= 1;
+		}
+		shard->block_numbers = (uint64_t *) memory_allocate(
+		                                     sizeof( uint64_t ) * maximum_number_of_shard_entries );
+
+		if( shard->block_numbers == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d block numbers.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		shard->block_descriptors = (libvhdi_block_descriptor_t **) memory_allocate(
+		                                                            sizeof( libvhdi_block_descriptor_t * ) * maximum_number_of_shard_entries );
+
+		if( shard->block_descriptors == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d block descriptors.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		shard->referenced_flags = (uint8_t *) memory_allocate(
+		                                       sizeof( uint8_t ) * maximum_number_of_shard_entries );
+
+		if( shard->referenced_flags == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d referenced flags.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		shard->hash_table = (int *) memory_allocate(
+		                             sizeof( int ) * shard->hash_table_size );
+
+		if( shard->hash_table == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d hash table.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     shard->hash_table,
+		     0,
+		     sizeof( int ) * shard->hash_table_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear shard: %d hash table.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_initialize(
+		     &( shard->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize shard: %d read/write lock.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#endif
+	}
+	return( 1 );
+
+on_error:
+	if( *block_cache != NULL )
+	{
+		libvhdi_block_cache_free(
+		 block_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a block cache
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_block_cache_free(
+     libvhdi_block_cache_t **block_cache,
+     libcerror_error_t **error )
+{
+	libvhdi_block_cache_shard_t *shard = NULL;
+	static char *function              = "libvhdi_block_cache_free";
+	int entry_index                    = 0;
+	int result                         = 1;
+	int shard_index                    = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_cache != NULL )
+	{
+		if( ( *block_cache )->shards != NULL )
+		{
+			for( shard_index = 0;
+			     shard_index < ( *block_cache )->number_of_shards;
+			     shard_index++ )
+			{
+				shard = &( ( ( *block_cache )->shards )[ shard_index ] );
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+				if( shard->read_write_lock != NULL )
+				{
+					if( libcthreads_read_write_lock_free(
+					     &( shard->read_write_lock ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free shard: %d read/write lock.",
+						 function,
+						 shard_index );
+
+						result = -1;
+					}
+				}
+#endif
+				if( shard->block_descriptors != NULL )
+				{
+					for( entry_index = 0;
+					     entry_index < shard->number_of_entries;
+					     entry_index++ )
+					{
+						if( libvhdi_block_descriptor_free(
+						     &( shard->block_descriptors[ entry_index ] ),
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+							 "%s: unable to free shard: %d block descriptor: %d.",
+							 function,
+							 shard_index,
+							 entry_index );
+
+							result = -1;
+						}
+					}
+					memory_free(
+					 shard->block_descriptors );
+				}
+				if( shard->hash_table != NULL )
+				{
+					memory_free(
+					 shard->hash_table );
+				}
+				if( shard->referenced_flags != NULL )
+				{
+					memory_free(
+					 shard->referenced_flags );
+				}
+				if( shard->block_numbers != NULL )
+				{
+					memory_free(
+					 shard->block_numbers );
+				}
+			}
+			memory_free(
+			 ( *block_cache )->shards );
+		}
+		memory_free(
+		 *block_cache );
+
+		*block_cache = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the entry index of a specific block number in a shard
+ * Returns the entry index or -1 if not available
+ */
+int libvhdi_block_cache_shard_get_entry_index(
+     libvhdi_block_cache_t *block_cache,
+     libvhdi_block_cache_shard_t *shard,
+     uint64_t block_number )
+{
+	int entry_index = 0;
+	int hash_slot   = 0;
+
+	hash_slot = libvhdi_block_cache_get_hash_slot(
+	             block_cache,
+	             shard,
+	             block_number );
+
+	while( shard->hash_table[ hash_slot ] != 0 )
+	{
+		entry_index = shard->hash_table[ hash_slot ] - 1;
+
+		if( shard->block_numbers[ entry_index ] == block_number )
+		{
+			return( entry_index );
+		}
+		hash_slot = ( hash_slot + 1 ) & ( shard->hash_table_size - 1 );
+	}
+	return( -1 );
+}
+
+/* Removes the hash table slot of a specific block number from a shard
+ * The slots that follow are shifted back so that no tombstones are needed
+ * Returns 1 if successful or 0 if not available
+ */
+int libvhdi_block_cache_shard_remove_hash_slot(
+     libvhdi_block_cache_t *block_cache,
+     libvhdi_block_cache_shard_t *shard,
+     uint64_t block_number )
+{
+	int hash_slot      = 0;
+	int home_hash_slot = 0;
+	int next_hash_slot = 0;
+
+	hash_slot = libvhdi_block_cache_get_hash_slot(
+	             block_cache,
+	             shard,
+	             block_number );
+
+	while( shard->hash_table[ hash_slot ] != 0 )
+	{
+		if( shard->block_numbers[ shard->hash_table[ hash_slot ] - 1 ] == block_number )
+		{
+			break;
+		}
+		hash_slot = ( hash_slot + 1 ) & ( shard->hash_table_size - 1 );
+	}
+	if( shard->hash_table[ hash_slot ] == 0 )
+	{
+		return( 0 );
+	}
+	shard->hash_table[ hash_slot ] = 0;
+
+	next_hash_slot = hash_slot;
+
+	while( 1 )
+	{
+		next_hash_slot = ( next_hash_slot + 1 ) & ( shard->hash_table_size - 1 );
+
+		if( shard->hash_table[ next_hash_slot ] == 0 )
+		{
+			break;
+		}
+		home_hash_slot = libvhdi_block_cache_get_hash_slot(
+		                  block_cache,
+		                  shard,
+		                  shard->block_numbers[ shard->hash_table[ next_hash_slot ] - 1 ] );
+
+		/* Move the slot back if its home slot is not cyclically between the empty slot and its current slot
+		 */
+		if( ( ( next_hash_slot > hash_slot )
+		  && ( ( home_hash_slot <= hash_slot )
+		   || ( home_hash_slot > next_hash_slot ) ) )
+		 || ( ( next_hash_slot < hash_slot )
+		  && ( home_hash_slot <= hash_slot )
+		  && ( home_hash_slot > next_hash_slot ) ) )
+		{
+			shard->hash_table[ hash_slot ]      = shard->hash_table[ next_hash_slot ];
+			shard->hash_table[ next_hash_slot ] = 0;
+
+			hash_slot = next_hash_slot;
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the range of a specific block data offset from the cached block descriptor
+ * If atomic operations are available the lookup only holds the read lock of the shard,
+ * hence lookups in the same shard do not block each other
+ * Returns 1 if successful, 0 if the block is not cached or -1 on error
+ */
+int libvhdi_block_cache_get_range_at_offset(
+     libvhdi_block_cache_t *block_cache,
+     uint64_t block_number,
+     uint32_t block_data_offset,
+     off64_t *range_file_offset,
+     size_t *range_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	libvhdi_block_cache_shard_t *shard = NULL;
+	static char *function              = "libvhdi_block_cache_get_range_at_offset";
+	int entry_index                    = 0;
+	int result                         = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	shard = &( ( block_cache->shards )[ block_number % block_cache->number_of_shards ] );
+
+#if defined( LIBVHDI_BLOCK_CACHE_HAVE_WRITE_LOCK )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#elif defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	entry_index = libvhdi_block_cache_shard_get_entry_index(
+	               block_cache,
+	               shard,
+	               block_number );
+
+	if( entry_index == -1 )
+	{
+		libvhdi_block_cache_shard_increment_counter(
+		 shard->number_of_misses );
+	}
+	else
+	{
+		libvhdi_block_cache_shard_increment_counter(
+		 shard->number_of_hits );
+
+		libvhdi_block_cache_shard_set_referenced(
+		 shard,
+		 entry_index );
+
+		/* The range is retrieved while the lock is held since another thread
+		 * can evict the block descriptor once the lock is released
+		 */
+		result = libvhdi_block_descriptor_get_range_at_offset(
+		          shard->block_descriptors[ entry_index ],
+		          block_data_offset,
+		          range_file_offset,
+		          range_size,
+		          range_flags,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range of block: %" PRIu64 " at offset: %" PRIu32 ".",
+			 function,
+			 block_number,
+			 block_data_offset );
+
+			result = -1;
+		}
+	}
+#if defined( LIBVHDI_BLOCK_CACHE_HAVE_WRITE_LOCK )
+	if( libcthreads_read_write_lock_release_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#elif defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Inserts a block descriptor into the cache
+ * The cache takes over ownership of the block descriptor and *block_descriptor is set to NULL.
+ * If the block is already cached the block descriptor is freed.
+ * Returns 1 if successful, 0 if the block was already cached or -1 on error
+ */
+int libvhdi_block_cache_insert_block_descriptor(
+     libvhdi_block_cache_t *block_cache,
+     uint64_t block_number,
+     libvhdi_block_descriptor_t **block_descriptor,
+     libcerror_error_t **error )
+{
+	libvhdi_block_cache_shard_t *shard = NULL;
+	static char *function              = "libvhdi_block_cache_insert_block_descriptor";
+	int entry_index                    = 0;
+	int hash_slot                      = 0;
+	int result                         = 1;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor value.",
+		 function );
+
+		return( -1 );
+	}
+	shard = &( ( block_cache->shards )[ block_number % block_cache->number_of_shards ] );
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	entry_index = libvhdi_block_cache_shard_get_entry_index(
+	               block_cache,
+	               shard,
+	               block_number );
+
+	if( entry_index != -1 )
+	{
+		/* Another thread inserted the same block in the meantime
+		 */
+		if( libvhdi_block_descriptor_free(
+		     block_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free block descriptor.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			result = 0;
+		}
+	}
+	else
+	{
+		if( shard->number_of_entries < shard->maximum_number_of_entries )
+		{
+			entry_index = shard->number_of_entries;
+
+			shard->number_of_entries += 1;
+		}
+		else
+		{
+			/* Evict the first entry that was not referenced since the CLOCK hand last passed it
+			 */
+			while( shard->referenced_flags[ shard->clock_hand ] != 0 )
+			{
+				shard->referenced_flags[ shard->clock_hand ] = 0;
+
+				shard->clock_hand = ( shard->clock_hand + 1 ) % shard->maximum_number_of_entries;
+			}
+			entry_index = shard->clock_hand;
+
+			shard->clock_hand = ( shard->clock_hand + 1 ) % shard->maximum_number_of_entries;
+
+			libvhdi_block_cache_shard_remove_hash_slot(
+			 block_cache,
+			 shard,
+			 shard->block_numbers[ entry_index ] );
+
+			if( libvhdi_block_descriptor_free(
+			     &( shard->block_descriptors[ entry_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free evicted block descriptor.",
+				 function );
+
+				result = -1;
+			}
+		}
+		shard->block_numbers[ entry_index ]     = block_number;
+		shard->block_descriptors[ entry_index ] = *block_descriptor;
+		shard->referenced_flags[ entry_index ]  = 0;
+
+		*block_descriptor = NULL;
+
+		hash_slot = libvhdi_block_cache_get_hash_slot(
+		             block_cache,
+		             shard,
+		             block_number );
+
+		while( shard->hash_table[ hash_slot ] != 0 )
+		{
+			hash_slot = ( hash_slot + 1 ) & ( shard->hash_table_size - 1 );
+		}
+		shard->hash_table[ hash_slot ] = entry_index + 1;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of cache hits and misses
+ * The write lock of each shard is held, hence no lookup can update the counters while they are read
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_block_cache_get_statistics(
+     libvhdi_block_cache_t *block_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	libvhdi_block_cache_shard_t *shard = NULL;
+	static char *function              = "libvhdi_block_cache_get_statistics";
+	uint64_t safe_number_of_hits       = 0;
+	uint64_t safe_number_of_misses     = 0;
+	int shard_index                    = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < block_cache->number_of_shards;
+	     shard_index++ )
+	{
+		shard = &( ( block_cache->shards )[ shard_index ] );
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_write(
+		     shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		safe_number_of_hits   += shard->number_of_hits;
+		safe_number_of_misses += shard->number_of_misses;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+	}
+	*number_of_hits   = safe_number_of_hits;
+	*number_of_misses = safe_number_of_misses;
+
+	return( 1 );
+}
+
@@ -0,0 +1,148 @@
+/*
+ * Block cache functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVHDI_BLOCK_CACHE_H )
+#define _LIBVHDI_BLOCK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvhdi_block_descriptor.h"
+#include "libvhdi_libcerror.h"
+#include "libvhdi_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvhdi_block_cache_shard libvhdi_block_cache_shard_t;
+
+struct libvhdi_block_cache_shard
+{
+	/* The block numbers
+	 */
+	uint64_t *block_numbers;
+
+	/* The block descriptors
+	 */
+	libvhdi_block_descriptor_t **block_descriptors;
+
+	/* The referenced flags, used for CLOCK eviction
+	 * The flags are set by lookups that only hold the read lock
+	 */
+	uint8_t *referenced_flags;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The maximum number of entries
+	 */
+	int maximum_number_of_entries;
+
+	/* The hash table, which contains the entry index + 1 or 0 if the slot is empty
+	 */
+	int *hash_table;
+
+	/* The hash table size, which is a power of 2
+	 */
+	int hash_table_size;
+
+	/* The CLOCK hand
+	 */
+	int clock_hand;
+
+	/* The number of hits
+	 * The value is updated by lookups that only hold the read lock
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of misses
+	 * The value is updated by lookups that only hold the read lock
+	 */
+	uint64_t number_of_misses;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+typedef struct libvhdi_block_cache libvhdi_block_cache_t;
+
+struct libvhdi_block_cache
+{
+	/* The number of shards
+	 */
+	int number_of_shards;
+
+	/* The shards
+	 */
+	libvhdi_block_cache_shard_t *shards;
+};
+
+int libvhdi_block_cache_initialize(
+     libvhdi_block_cache_t **block_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libvhdi_block_cache_free(
+     libvhdi_block_cache_t **block_cache,
+     libcerror_error_t **error );
+
+int libvhdi_block_cache_shard_get_entry_index(
+     libvhdi_block_cache_t *block_cache,
+     libvhdi_block_cache_shard_t *shard,
+     uint64_t block_number );
+
+int libvhdi_block_cache_shard_remove_hash_slot(
+     libvhdi_block_cache_t *block_cache,
+     libvhdi_block_cache_shard_t *shard,
+     uint64_t block_number );
+
+int libvhdi_block_cache_get_range_at_offset(
+     libvhdi_block_cache_t *block_cache,
+     uint64_t block_number,
+     uint32_t block_data_offset,
+     off64_t *range_file_offset,
+     size_t *range_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libvhdi_block_cache_insert_block_descriptor(
+     libvhdi_block_cache_t *block_cache,
+     uint64_t block_number,
+     libvhdi_block_descriptor_t **block_descriptor,
+     libcerror_error_t **error );
+
+int libvhdi_block_cache_get_statistics(
+     libvhdi_block_cache_t *block_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVHDI_BLOCK_CACHE_H ) */
+
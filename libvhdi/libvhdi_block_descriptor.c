@@ -28,10 +28,8 @@
 #include "libvhdi_debug.h"
 #include "libvhdi_definitions.h"
 #include "libvhdi_libbfio.h"
-#include "libvhdi_libcdata.h"
 #include "libvhdi_libcerror.h"
 #include "libvhdi_libcnotify.h"
-#include "libvhdi_sector_range_descriptor.h"
 
 /* Creates a block descriptor
  * Make sure the value block_descriptor is referencing, is set to NULL
@@ -98,20 +96,6 @@ int libvhdi_block_descriptor_initialize(
 
 		return( -1 );
 	}
-	if( libcdata_array_initialize(
-	     &( ( *block_descriptor )->sector_ranges_array ),
-	     0,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sector ranges array.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -133,7 +117,6 @@ int libvhdi_block_descriptor_free(
      libcerror_error_t **error )
 {
 	static char *function = "libvhdi_block_descriptor_free";
-	int result            = 1;
 
 	if( block_descriptor == NULL )
 	{
@@ -148,26 +131,17 @@ int libvhdi_block_descriptor_free(
 	}
 	if( *block_descriptor != NULL )
 	{
-		if( libcdata_array_free(
-		     &( ( *block_descriptor )->sector_ranges_array ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libvhdi_sector_range_descriptor_free,
-		     error ) != 1 )
+		if( ( *block_descriptor )->sector_range_end_offsets != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free sector ranges array.",
-			 function );
-
-			result = -1;
+			memory_free(
+			 ( *block_descriptor )->sector_range_end_offsets );
 		}
 		memory_free(
 		 *block_descriptor );
 
 		*block_descriptor = NULL;
 	}
-	return( result );
+	return( 1 );
 }
 
 /* Reads a block allocation table entry
@@ -417,45 +391,147 @@ int libvhdi_block_descriptor_read_table_entry_file_io_handle(
 	return( 1 );
 }
 
-/* Reads the sector bitmap
+/* Determines the number of trailing zero bits of a 64-bit value
+ * Returns the number of trailing zero bits or 64 if the value is 0
+ */
+int libvhdi_block_descriptor_get_number_of_trailing_zero_bits(
+     uint64_t value )
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+	if( value == 0 )
+	{
+		return( 64 );
+	}
+	return( __builtin_ctzll( value ) );
+#else
+	int number_of_bits = 0;
+
+	if( value == 0 )
+	{
+		return( 64 );
+	}
+	if( ( value & 0xffffffffUL ) == 0 )
+	{
+		number_of_bits += 32;
+		value         >>= 32;
+	}
+	if( ( value & 0x0000ffffUL ) == 0 )
+	{
+		number_of_bits += 16;
+		value         >>= 16;
+	}
+	if( ( value & 0x000000ffUL ) == 0 )
+	{
+		number_of_bits += 8;
+		value         >>= 8;
+	}
+	if( ( value & 0x0000000fUL ) == 0 )
+	{
+		number_of_bits += 4;
+		value         >>= 4;
+	}
+	if( ( value & 0x00000003UL ) == 0 )
+	{
+		number_of_bits += 2;
+		value         >>= 2;
+	}
+	if( ( value & 0x00000001UL ) == 0 )
+	{
+		number_of_bits += 1;
+	}
+	return( number_of_bits );
+#endif
+}
+
+/* Determines the number of leading zero bits of a 64-bit value
+ * Returns the number of leading zero bits or 64 if the value is 0
+ */
+int libvhdi_block_descriptor_get_number_of_leading_zero_bits(
+     uint64_t value )
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+	if( value == 0 )
+	{
+		return( 64 );
+	}
+	return( __builtin_clzll( value ) );
+#else
+	int number_of_bits = 0;
+
+	if( value == 0 )
+	{
+		return( 64 );
+	}
+	if( ( value & 0xffffffff00000000ULL ) == 0 )
+	{
+		number_of_bits += 32;
+		value         <<= 32;
+	}
+	if( ( value & 0xffff000000000000ULL ) == 0 )
+	{
+		number_of_bits += 16;
+		value         <<= 16;
+	}
+	if( ( value & 0xff00000000000000ULL ) == 0 )
+	{
+		number_of_bits += 8;
+		value         <<= 8;
+	}
+	if( ( value & 0xf000000000000000ULL ) == 0 )
+	{
+		number_of_bits += 4;
+		value         <<= 4;
+	}
+	if( ( value & 0xc000000000000000ULL ) == 0 )
+	{
+		number_of_bits += 2;
+		value         <<= 2;
+	}
+	if( ( value & 0x8000000000000000ULL ) == 0 )
+	{
+		number_of_bits += 1;
+	}
+	return( number_of_bits );
+#endif
+}
+
+/* Determines the sector ranges from a sector bitmap
+ * A sector range is a run of sectors with the same allocation state
+ * If sector_range_end_offsets is NULL only the number of sector ranges is determined
+ * otherwise sector_range_end_offsets must contain room for *number_of_sector_ranges entries
+ *
+ * The bitmap is processed 64 bits at a time. The bits that differ from the value of
+ * the current range are determined with a single XOR, hence words that continue the
+ * current range, such as all-zero and all-one words, are skipped without per bit work.
+ * VHD stores the first sector in the most significant bit of a byte and VHDX in the
+ * least significant bit, hence VHD words are read big-endian and scanned with count
+ * leading zeros and VHDX words are read little-endian and scanned with count trailing zeros.
+ *
  * Returns 1 if successful or -1 on error
  */
-int libvhdi_block_descriptor_read_sector_bitmap_data(
-     libvhdi_block_descriptor_t *block_descriptor,
+int libvhdi_block_descriptor_get_sector_ranges_from_bitmap(
      const uint8_t *data,
      size_t data_size,
      int file_type,
      uint32_t bytes_per_sector,
+     uint32_t *sector_range_end_offsets,
+     int *number_of_sector_ranges,
      libcerror_error_t **error )
 {
-	libvhdi_sector_range_descriptor_t *sector_range_descriptor = NULL;
-	static char *function                                      = "libvhdi_block_descriptor_read_sector_bitmap_data";
-	size64_t range_size                                        = 0;
-	size_t data_offset                                         = 0;
-	off64_t range_offset                                       = 0;
-	uint8_t bit_index                                          = 0;
-	uint8_t byte_value                                         = 0;
-	uint8_t element_value                                      = 0;
-	uint8_t first_element_value                                = 0;
-	int element_index                                          = 0;
-	int entry_index                                            = 0;
-	int first_element_index                                    = 0;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	char *range_type                                           = NULL;
-#endif
+	static char *function        = "libvhdi_block_descriptor_get_sector_ranges_from_bitmap";
+	size_t data_offset           = 0;
+	size_t read_size             = 0;
+	uint64_t difference_bits     = 0;
+	uint64_t range_bits          = 0;
+	uint64_t valid_bits_mask     = 0;
+	uint64_t value_64bit         = 0;
+	uint32_t element_index       = 0;
+	int bit_index                = 0;
+	int byte_index               = 0;
+	int maximum_number_of_ranges = 0;
+	int number_of_bits           = 0;
+	int sector_range_index       = 0;
 
-	if( block_descriptor == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid block descriptor.",
-		 function );
-
-		return( -1 );
-	}
 	if( data == NULL )
 	{
 		libcerror_error_set(
@@ -468,7 +544,7 @@ int libvhdi_block_descriptor_read_sector_bitmap_data(
 		return( -1 );
 	}
 	if( ( data_size < 1 )
-	 || ( data_size > (size_t) SSIZE_MAX ) )
+	 || ( data_size > (size_t) ( UINT32_MAX / ( 8 * 4096 ) ) ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -491,202 +567,375 @@ int libvhdi_block_descriptor_read_sector_bitmap_data(
 
 		return( -1 );
 	}
-	if( ( bytes_per_sector != 512 )
-	 && ( bytes_per_sector != 4096 ) )
+	if( number_of_sector_ranges == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported bytes per sector.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of sector ranges.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( sector_range_end_offsets != NULL )
 	{
-		libcnotify_printf(
-		 "%s: sector bitmap data:\n",
-		 function );
-		libcnotify_print_data(
-		 data,
-		 data_size,
-		 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
+		maximum_number_of_ranges = *number_of_sector_ranges;
 	}
-#endif
+	/* range_bits contains the value of the current range in every bit
+	 */
 	if( file_type == LIBVHDI_FILE_TYPE_VHD )
 	{
-		first_element_value = data[ data_offset ] >> 7;
+		range_bits = ( ( data[ 0 ] & 0x80 ) == 0 ) ? 0 : ~( (uint64_t) 0 );
 	}
-	else if( file_type == LIBVHDI_FILE_TYPE_VHDX )
+	else
 	{
-		first_element_value = data[ data_offset ] & 0x01;
+		range_bits = ( ( data[ 0 ] & 0x01 ) == 0 ) ? 0 : ~( (uint64_t) 0 );
 	}
 	while( data_offset < data_size )
 	{
-		byte_value = data[ data_offset ];
+		read_size = data_size - data_offset;
 
-		data_offset++;
-
-		for( bit_index = 0;
-		     bit_index < 8;
-		     bit_index++ )
+		if( read_size >= 8 )
 		{
+			read_size = 8;
+
 			if( file_type == LIBVHDI_FILE_TYPE_VHD )
 			{
-				element_value = byte_value >> ( 7 - bit_index );
+				byte_stream_copy_to_uint64_big_endian(
+				 &( data[ data_offset ] ),
+				 value_64bit );
 			}
-			else if( file_type == LIBVHDI_FILE_TYPE_VHDX )
+			else
 			{
-				element_value = byte_value & 0x01;
-				byte_value  >>= 1;
+				byte_stream_copy_to_uint64_little_endian(
+				 &( data[ data_offset ] ),
+				 value_64bit );
 			}
-			if( element_value != first_element_value )
-			{
-				range_offset = (off64_t) first_element_index * bytes_per_sector;
-				range_size   = ( (size64_t) element_index - first_element_index ) * bytes_per_sector;
+			valid_bits_mask = ~( (uint64_t) 0 );
+		}
+		else
+		{
+			value_64bit = 0;
 
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
+			for( byte_index = 0;
+			     byte_index < (int) read_size;
+			     byte_index++ )
+			{
+				if( file_type == LIBVHDI_FILE_TYPE_VHD )
 				{
-					if( first_element_value == 0 )
-					{
-						range_type = "unallocated";
-					}
-					else
-					{
-						range_type = "allocated";
-					}
-					libcnotify_printf(
-					 "%s: %s sector range\t: 0x%08" PRIx64 " - 0x%08" PRIx64 " (%" PRIu64 ")\n",
-					 function,
-					 range_type,
-					 range_offset,
-					 range_offset + range_size,
-					 range_size );
+					value_64bit |= (uint64_t) data[ data_offset + byte_index ] << ( 56 - ( 8 * byte_index ) );
 				}
-#endif /* defined( HAVE_DEBUG_OUTPUT ) */
-
-				if( libvhdi_sector_range_descriptor_initialize(
-				     &sector_range_descriptor,
-				     error ) != 1 )
+				else
 				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to create sector range descriptor.",
-					 function );
-
-					goto on_error;
+					value_64bit |= (uint64_t) data[ data_offset + byte_index ] << ( 8 * byte_index );
 				}
-				sector_range_descriptor->start_offset = range_offset;
-				sector_range_descriptor->end_offset   = range_offset + range_size;
+			}
+			if( file_type == LIBVHDI_FILE_TYPE_VHD )
+			{
+				valid_bits_mask = ~( ~( (uint64_t) 0 ) >> ( 8 * read_size ) );
+			}
+			else
+			{
+				valid_bits_mask = ~( ~( (uint64_t) 0 ) << ( 8 * read_size ) );
+			}
+		}
+		number_of_bits  = (int) ( 8 * read_size );
+		difference_bits = ( value_64bit ^ range_bits ) & valid_bits_mask;
 
-				if( first_element_value == 0 )
-				{
-					sector_range_descriptor->flags = LIBFDATA_SECTOR_RANGE_FLAG_IS_UNALLOCATED;
-				}
-				if( libcdata_array_append_entry(
-				     block_descriptor->sector_ranges_array,
-				     &entry_index,
-				     (intptr_t *) sector_range_descriptor,
-				     error ) != 1 )
+		while( difference_bits != 0 )
+		{
+			if( file_type == LIBVHDI_FILE_TYPE_VHD )
+			{
+				bit_index = libvhdi_block_descriptor_get_number_of_leading_zero_bits(
+				             difference_bits );
+			}
+			else
+			{
+				bit_index = libvhdi_block_descriptor_get_number_of_trailing_zero_bits(
+				             difference_bits );
+			}
+			if( sector_range_end_offsets != NULL )
+			{
+				if( sector_range_index >= maximum_number_of_ranges )
 				{
 					libcerror_error_set(
 					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-					 "%s: unable to append sector range to array.",
+					 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+					 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+					 "%s: invalid sector range end offsets value too small.",
 					 function );
 
-					goto on_error;
+					return( -1 );
 				}
-				sector_range_descriptor = NULL;
+				sector_range_end_offsets[ sector_range_index ] = ( element_index + (uint32_t) bit_index ) * bytes_per_sector;
+			}
+			sector_range_index++;
+
+			/* The bits that differ from the new range value are the complement of
+			 * the previous differences, from the current bit onwards
+			 */
+			range_bits      = ~range_bits;
+			difference_bits = ~difference_bits & valid_bits_mask;
 
-				first_element_value = element_value;
-				first_element_index = element_index;
+			if( file_type == LIBVHDI_FILE_TYPE_VHD )
+			{
+				difference_bits &= ~( (uint64_t) 0 ) >> bit_index;
+			}
+			else
+			{
+				difference_bits &= ~( (uint64_t) 0 ) << bit_index;
 			}
-			element_index++;
 		}
+		data_offset   += read_size;
+		element_index += (uint32_t) number_of_bits;
 	}
-	range_offset = (off64_t) first_element_index * bytes_per_sector;
-	range_size   = ( (size64_t) element_index - first_element_index ) * bytes_per_sector;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( sector_range_end_offsets != NULL )
 	{
-		if( first_element_value == 0 )
-		{
-			range_type = "unallocated";
-		}
-		else
+		if( sector_range_index >= maximum_number_of_ranges )
 		{
-			range_type = "allocated";
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+			 "%s: invalid sector range end offsets value too small.",
+			 function );
+
+			return( -1 );
 		}
-		libcnotify_printf(
-		 "%s: %s sector range\t: 0x%08" PRIx64 " - 0x%08" PRIx64 " (%" PRIu64 ")\n",
-		 function,
-		 range_type,
-		 range_offset,
-		 range_offset + range_size,
-		 range_size );
+		sector_range_end_offsets[ sector_range_index ] = element_index * bytes_per_sector;
 	}
-#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+	*number_of_sector_ranges = sector_range_index + 1;
 
-	if( libvhdi_sector_range_descriptor_initialize(
-	     &sector_range_descriptor,
-	     error ) != 1 )
+	return( 1 );
+}
+
+/* Reads the sector bitmap
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_block_descriptor_read_sector_bitmap_data(
+     libvhdi_block_descriptor_t *block_descriptor,
+     const uint8_t *data,
+     size_t data_size,
+     int file_type,
+     uint32_t bytes_per_sector,
+     libcerror_error_t **error )
+{
+	uint32_t *sector_range_end_offsets = NULL;
+	static char *function              = "libvhdi_block_descriptor_read_sector_bitmap_data";
+	uint8_t first_element_value        = 0;
+	int number_of_sector_ranges        = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	char *range_type                   = NULL;
+	uint32_t range_end_offset          = 0;
+	uint32_t range_start_offset        = 0;
+	int sector_range_index             = 0;
+#endif
+
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor->number_of_sector_ranges != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sector range descriptor.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block descriptor - sector ranges already set.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	sector_range_descriptor->start_offset = range_offset;
-	sector_range_descriptor->end_offset   = range_offset + range_size;
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
 
-	if( first_element_value == 0 )
+		return( -1 );
+	}
+	if( ( data_size < 1 )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
 	{
-		sector_range_descriptor->flags = LIBFDATA_SECTOR_RANGE_FLAG_IS_UNALLOCATED;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
 	}
-	if( libcdata_array_append_entry(
-	     block_descriptor->sector_ranges_array,
-	     &entry_index,
-	     (intptr_t *) sector_range_descriptor,
+	if( ( file_type != LIBVHDI_FILE_TYPE_VHD )
+	 && ( file_type != LIBVHDI_FILE_TYPE_VHDX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported file type.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector != 512 )
+	 && ( bytes_per_sector != 4096 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: sector bitmap data:\n",
+		 function );
+		libcnotify_print_data(
+		 data,
+		 data_size,
+		 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
+	}
+#endif
+	/* The sector bitmap is scanned twice, first to determine the number of sector ranges
+	 * and second to fill the sector range end offsets. A block that consists of a single
+	 * sector range, such as a fully allocated block, does not need the second scan.
+	 */
+	if( libvhdi_block_descriptor_get_sector_ranges_from_bitmap(
+	     data,
+	     data_size,
+	     file_type,
+	     bytes_per_sector,
+	     NULL,
+	     &number_of_sector_ranges,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append sector range to array.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine number of sector ranges.",
 		 function );
 
 		goto on_error;
 	}
-	sector_range_descriptor = NULL;
+	if( number_of_sector_ranges > 1 )
+	{
+		sector_range_end_offsets = (uint32_t *) memory_allocate(
+		                                         sizeof( uint32_t ) * number_of_sector_ranges );
+
+		if( sector_range_end_offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create sector range end offsets.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvhdi_block_descriptor_get_sector_ranges_from_bitmap(
+		     data,
+		     data_size,
+		     file_type,
+		     bytes_per_sector,
+		     sector_range_end_offsets,
+		     &number_of_sector_ranges,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine sector ranges.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( file_type == LIBVHDI_FILE_TYPE_VHD )
+	{
+		first_element_value = data[ 0 ] >> 7;
+	}
+	else
+	{
+		first_element_value = data[ 0 ] & 0x01;
+	}
+	block_descriptor->sector_ranges_size       = (uint32_t) ( data_size * 8 ) * bytes_per_sector;
+	block_descriptor->number_of_sector_ranges  = number_of_sector_ranges;
+	block_descriptor->sector_range_end_offsets = sector_range_end_offsets;
 
+	if( first_element_value == 0 )
+	{
+		block_descriptor->first_sector_range_flags = LIBFDATA_SECTOR_RANGE_FLAG_IS_UNALLOCATED;
+	}
+	else
+	{
+		block_descriptor->first_sector_range_flags = 0;
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
+		for( sector_range_index = 0;
+		     sector_range_index < number_of_sector_ranges;
+		     sector_range_index++ )
+		{
+			if( sector_range_end_offsets != NULL )
+			{
+				range_end_offset = sector_range_end_offsets[ sector_range_index ];
+			}
+			else
+			{
+				range_end_offset = block_descriptor->sector_ranges_size;
+			}
+			if( ( ( sector_range_index % 2 ) == 0 ) == ( first_element_value == 0 ) )
+			{
+				range_type = "unallocated";
+			}
+			else
+			{
+				range_type = "allocated";
+			}
+			libcnotify_printf(
+			 "%s: %s sector range\t: 0x%08" PRIx32 " - 0x%08" PRIx32 " (%" PRIu32 ")\n",
+			 function,
+			 range_type,
+			 range_start_offset,
+			 range_end_offset,
+			 range_end_offset - range_start_offset );
+
+			range_start_offset = range_end_offset;
+		}
 		libcnotify_printf(
 		 "\n" );
 	}
-#endif
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
 	return( 1 );
 
 on_error:
-	if( sector_range_descriptor != NULL )
+	if( sector_range_end_offsets != NULL )
 	{
-		libvhdi_sector_range_descriptor_free(
-		 &sector_range_descriptor,
-		 NULL );
+		memory_free(
+		 sector_range_end_offsets );
 	}
 	return( -1 );
 }
@@ -704,11 +953,9 @@ int libvhdi_block_descriptor_read_sector_bitmap_file_io_handle(
      uint32_t bytes_per_sector,
      libcerror_error_t **error )
 {
-	libvhdi_sector_range_descriptor_t *sector_range_descriptor = NULL;
-	uint8_t *data                                              = NULL;
-	static char *function                                      = "libvhdi_block_descriptor_read_sector_bitmap_file_io_handle";
-	ssize_t read_count                                         = 0;
-	int entry_index                                            = 0;
+	uint8_t *data         = NULL;
+	static char *function = "libvhdi_block_descriptor_read_sector_bitmap_file_io_handle";
+	ssize_t read_count    = 0;
 
 	if( block_descriptor == NULL )
 	{
@@ -736,43 +983,20 @@ int libvhdi_block_descriptor_read_sector_bitmap_file_io_handle(
 	if( ( file_offset == -1 )
 	 || ( block_descriptor->block_state == 6 ) )
 	{
-		if( libvhdi_sector_range_descriptor_initialize(
-		     &sector_range_descriptor,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create sector range descriptor.",
-			 function );
-
-			goto on_error;
-		}
-		sector_range_descriptor->start_offset = 0;
-		sector_range_descriptor->end_offset   = block_size;
+		/* The block consists of a single sector range that does not require the sector range end offsets
+		 */
+		block_descriptor->sector_ranges_size      = block_size;
+		block_descriptor->number_of_sector_ranges = 1;
 
 		if( ( file_type == LIBVHDI_FILE_TYPE_VHD )
 		 || ( block_descriptor->block_state < 6 ) )
 		{
-			sector_range_descriptor->flags = LIBFDATA_SECTOR_RANGE_FLAG_IS_UNALLOCATED;
+			block_descriptor->first_sector_range_flags = LIBFDATA_SECTOR_RANGE_FLAG_IS_UNALLOCATED;
 		}
-		if( libcdata_array_append_entry(
-		     block_descriptor->sector_ranges_array,
-		     &entry_index,
-		     (intptr_t *) sector_range_descriptor,
-		     error ) != 1 )
+		else
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append sector range to array.",
-			 function );
-
-			goto on_error;
+			block_descriptor->first_sector_range_flags = 0;
 		}
-		sector_range_descriptor = NULL;
 	}
 	else
 	{
@@ -848,30 +1072,28 @@ on_error:
 		memory_free(
 		 data );
 	}
-	if( sector_range_descriptor != NULL )
-	{
-		libvhdi_sector_range_descriptor_free(
-		 &sector_range_descriptor,
-		 NULL );
-	}
 	return( -1 );
 }
 
-/* Retrieves the sector range descriptor for a specific offset
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Retrieves the range of a specific block data offset
+ * The range starts at the block data offset and ends at the end of the sector range that contains it
+ * The sector range is looked up using a binary search of the sector range end offsets
+ * Returns 1 if successful or -1 on error
  */
-int libvhdi_block_descriptor_get_sector_range_descriptor_at_offset(
+int libvhdi_block_descriptor_get_range_at_offset(
      libvhdi_block_descriptor_t *block_descriptor,
-     off64_t offset,
-     libvhdi_sector_range_descriptor_t **sector_range_descriptor,
+     uint32_t block_data_offset,
+     off64_t *range_file_offset,
+     size_t *range_size,
+     uint32_t *range_flags,
      libcerror_error_t **error )
 {
-	libvhdi_sector_range_descriptor_t *safe_sector_range_descriptor = NULL;
-	static char *function                                           = "libvhdi_block_descriptor_get_sector_range_descriptor_at_offset";
-	int entry_index                                                 = 0;
-	int number_of_entries                                           = 0;
+	static char *function     = "libvhdi_block_descriptor_get_range_at_offset";
+	uint32_t range_end_offset = 0;
+	int maximum_range_index   = 0;
+	int middle_range_index    = 0;
+	int minimum_range_index   = 0;
 
-/* TODO uses a sector number to sector range descriptor map for quick look up */
 	if( block_descriptor == NULL )
 	{
 		libcerror_error_set(
@@ -883,60 +1105,110 @@ int libvhdi_block_descriptor_get_sector_range_descriptor_at_offset(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_number_of_entries(
-	     block_descriptor->sector_ranges_array,
-	     &number_of_entries,
-	     error ) != 1 )
+	if( block_descriptor->number_of_sector_ranges <= 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries from sector ranges array.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid block descriptor - missing sector ranges.",
 		 function );
 
 		return( -1 );
 	}
-	for( entry_index = 0;
-	     entry_index < number_of_entries;
-	     entry_index++ )
+	if( ( block_descriptor->number_of_sector_ranges > 1 )
+	 && ( block_descriptor->sector_range_end_offsets == NULL ) )
 	{
-		if( libcdata_array_get_entry_by_index(
-		     block_descriptor->sector_ranges_array,
-		     entry_index,
-		     (intptr_t **) &safe_sector_range_descriptor,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve descriptor: %d from sector range array.",
-			 function,
-			 entry_index );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid block descriptor - missing sector range end offsets.",
+		 function );
 
-			return( -1 );
-		}
-		if( safe_sector_range_descriptor == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing sector range descriptor: %d.",
-			 function,
-			 entry_index );
+		return( -1 );
+	}
+	if( block_data_offset >= block_descriptor->sector_ranges_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block data offset value out of bounds.",
+		 function );
 
-			return( -1 );
-		}
-		if( ( offset >= safe_sector_range_descriptor->start_offset )
-		 && ( offset < safe_sector_range_descriptor->end_offset ) )
+		return( -1 );
+	}
+	if( range_file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range file offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor->number_of_sector_ranges == 1 )
+	{
+		range_end_offset = block_descriptor->sector_ranges_size;
+	}
+	else
+	{
+		maximum_range_index = block_descriptor->number_of_sector_ranges - 1;
+
+		while( minimum_range_index < maximum_range_index )
 		{
-			*sector_range_descriptor = safe_sector_range_descriptor;
+			middle_range_index = minimum_range_index + ( ( maximum_range_index - minimum_range_index ) / 2 );
 
-			return( 1 );
+			if( block_descriptor->sector_range_end_offsets[ middle_range_index ] <= block_data_offset )
+			{
+				minimum_range_index = middle_range_index + 1;
+			}
+			else
+			{
+				maximum_range_index = middle_range_index;
+			}
 		}
+		range_end_offset = block_descriptor->sector_range_end_offsets[ minimum_range_index ];
+	}
+	*range_file_offset = block_descriptor->file_offset;
+
+	if( block_descriptor->file_offset > -1 )
+	{
+		*range_file_offset += block_data_offset;
+	}
+	*range_flags = block_descriptor->first_sector_range_flags;
+
+	if( ( minimum_range_index % 2 ) != 0 )
+	{
+		*range_flags ^= LIBFDATA_SECTOR_RANGE_FLAG_IS_UNALLOCATED;
 	}
-	return( 0 );
+	*range_size = (size_t) ( range_end_offset - block_data_offset );
+
+	return( 1 );
 }
 
@@ -26,9 +26,7 @@
 #include <types.h>
 
 #include "libvhdi_libbfio.h"
-#include "libvhdi_libcdata.h"
 #include "libvhdi_libcerror.h"
-#include "libvhdi_sector_range_descriptor.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -46,9 +44,23 @@ struct libvhdi_block_descriptor
 	 */
 	uint8_t block_state;
 
-	/* The sector ranges array
+	/* The size of the data covered by the sector ranges
 	 */
-	libcdata_array_t *sector_ranges_array;
+	uint32_t sector_ranges_size;
+
+	/* The flags of the first sector range
+	 * Consecutive sector ranges alternate between allocated and unallocated
+	 */
+	uint32_t first_sector_range_flags;
+
+	/* The number of sector ranges
+	 */
+	int number_of_sector_ranges;
+
+	/* The sector range end offsets, sorted in ascending order
+	 * This value is NULL if the block consists of a single sector range
+	 */
+	uint32_t *sector_range_end_offsets;
 };
 
 int libvhdi_block_descriptor_initialize(
@@ -75,6 +87,21 @@ int libvhdi_block_descriptor_read_table_entry_file_io_handle(
      uint32_t sector_bitmap_size,
      libcerror_error_t **error );
 
+int libvhdi_block_descriptor_get_number_of_trailing_zero_bits(
+     uint64_t value );
+
+int libvhdi_block_descriptor_get_number_of_leading_zero_bits(
+     uint64_t value );
+
+int libvhdi_block_descriptor_get_sector_ranges_from_bitmap(
+     const uint8_t *data,
+     size_t data_size,
+     int file_type,
+     uint32_t bytes_per_sector,
+     uint32_t *sector_range_end_offsets,
+     int *number_of_sector_ranges,
+     libcerror_error_t **error );
+
 int libvhdi_block_descriptor_read_sector_bitmap_data(
      libvhdi_block_descriptor_t *block_descriptor,
      const uint8_t *data,
@@ -93,10 +120,12 @@ int libvhdi_block_descriptor_read_sector_bitmap_file_io_handle(
      uint32_t byte_per_sector,
      libcerror_error_t **error );
 
-int libvhdi_block_descriptor_get_sector_range_descriptor_at_offset(
+int libvhdi_block_descriptor_get_range_at_offset(
      libvhdi_block_descriptor_t *block_descriptor,
-     off64_t offset,
-     libvhdi_sector_range_descriptor_t **sector_range_descriptor,
+     uint32_t block_data_offset,
+     off64_t *range_file_offset,
+     size_t *range_size,
+     uint32_t *range_flags,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
@@ -0,0 +1,1034 @@
+/*
+ * Data cache functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvhdi_data_cache.h"
+#include "libvhdi_definitions.h"
+#include "libvhdi_libcerror.h"
+#include "libvhdi_libcthreads.h"
+
+/* Determines the hash table slot of a segment index
+ */
+#define libvhdi_data_cache_get_hash_slot( data_cache, shard, segment_index ) \
+	(int) ( ( ( ( (uint64_t) ( segment_index ) / (uint64_t) ( data_cache )->number_of_shards ) * 0x9e3779b97f4a7c15ULL ) >> 32 ) & (uint64_t) ( ( shard )->hash_table_size - 1 ) )
+
+/* Creates a data cache
+ * The data cache stores (media) data in segments of the segment size and uses
+ * a segmented LRU, where segments that are read once only enter the probation list
+ * and segments that are read again are promoted to the protected list, so that
+ * a sequential read of the media data does not evict the segments that are read often
+ * The entries are distributed over multiple shards, each with its own lock
+ * Make sure the value data_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_data_cache_initialize(
+     libvhdi_data_cache_t **data_cache,
+     size_t maximum_size,
+     size_t segment_size,
+     libcerror_error_t **error )
+{
+	libvhdi_data_cache_shard_t *shard   = NULL;
+	static char *function               = "libvhdi_data_cache_initialize";
+	size_t maximum_number_of_entries    = 0;
+	int maximum_number_of_shard_entries = 0;
+	int number_of_shards                = 0;
+	int shard_index                     = 0;
+
+	if( data_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_size > (size_t) LIBVHDI_MAXIMUM_DATA_CACHE_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_size == 0 )
+	 || ( segment_size > maximum_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_entries = maximum_size / segment_size;
+
+	number_of_shards = LIBVHDI_DATA_CACHE_NUMBER_OF_SHARDS;
+
+	if( (size_t) number_of_shards > maximum_number_of_entries )
+	{
+		number_of_shards = (int) maximum_number_of_entries;
+	}
+	/* The shard entries are rounded down so that the maximum size is not exceeded
+	 */
+	maximum_number_of_shard_entries = (int) ( maximum_number_of_entries / number_of_shards );
+
+	*data_cache = memory_allocate_structure(
+	               libvhdi_data_cache_t );
+
+	if( *data_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *data_cache,
+	     0,
+	     sizeof( libvhdi_data_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data cache.",
+		 function );
+
+		memory_free(
+		 *data_cache );
+
+		*data_cache = NULL;
+
+		return( -1 );
+	}
+	( *data_cache )->shards = (libvhdi_data_cache_shard_t *) memory_allocate(
+	                                                          sizeof( libvhdi_data_cache_shard_t ) * number_of_shards );
+
+	if( ( *data_cache )->shards == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shards.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *data_cache )->shards,
+	     0,
+	     sizeof( libvhdi_data_cache_shard_t ) * number_of_shards ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shards.",
+		 function );
+
+		memory_free(
+		 ( *data_cache )->shards );
+
+		( *data_cache )->shards = NULL;
+
+		goto on_error;
+	}
+	( *data_cache )->segment_size     = segment_size;
+	( *data_cache )->number_of_shards = number_of_shards;
+
+	for( shard_index = 0;
+	     shard_index < number_of_shards;
+	     shard_index++ )
+	{
+		shard = &( ( ( *data_cache )->shards )[ shard_index ] );
+
+		shard->maximum_number_of_entries           = maximum_number_of_shard_entries;
+		shard->maximum_number_of_protected_entries = ( maximum_number_of_shard_entries * 4 ) / 5;
+		shard->hash_table_size                     = 1;
+
+		shard->list_heads[ LIBVHDI_DATA_CACHE_LIST_PROBATION ] = -1;
+		shard->list_heads[ LIBVHDI_DATA_CACHE_LIST_PROTECTED ] = -1;
+		shard->list_tails[ LIBVHDI_DATA_CACHE_LIST_PROBATION ] = -1;
+		shard->list_tails[ LIBVHDI_DATA_CACHE_LIST_PROTECTED ] = -1;
+
+		/* Keep the hash table at most half full to limit the probe lengths
+		 */
+		while( shard->hash_table_size < ( 2 * maximum_number_of_shard_entries ) )
+		{
+			shard->hash_table_size <<= 1;
+		}
+		shard->segment_indexes = (uint64_t *) memory_allocate(
+		                                       sizeof( uint64_t ) * maximum_number_of_shard_entries );
+
+		if( shard->segment_indexes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d segment indexes.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		shard->segment_data = (uint8_t *) memory_allocate(
+		                                   segment_size * maximum_number_of_shard_entries );
+
+		if( shard->segment_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d segment data.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		shard->segment_data_sizes = (size_t *) memory_allocate(
+		                                        sizeof( size_t ) * maximum_number_of_shard_entries );
+
+		if( shard->segment_data_sizes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d segment data sizes.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		shard->entry_lists = (uint8_t *) memory_allocate(
+		                                  sizeof( uint8_t ) * maximum_number_of_shard_entries );
+
+		if( shard->entry_lists == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d entry lists.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		shard->previous_entry_indexes = (int *) memory_allocate(
+		                                         sizeof( int ) * maximum_number_of_shard_entries );
+
+		if( shard->previous_entry_indexes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d previous entry indexes.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		shard->next_entry_indexes = (int *) memory_allocate(
+		                                     sizeof( int ) * maximum_number_of_shard_entries );
+
+		if( shard->next_entry_indexes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d next entry indexes.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		shard->hash_table = (int *) memory_allocate(
+		                             sizeof( int ) * shard->hash_table_size );
+
+		if( shard->hash_table == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d hash table.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     shard->hash_table,
+		     0,
+		     sizeof( int ) * shard->hash_table_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear shard: %d hash table.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_initialize(
+		     &( shard->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize shard: %d read/write lock.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#endif
+	}
+	return( 1 );
+
+on_error:
+	if( *data_cache != NULL )
+	{
+		libvhdi_data_cache_free(
+		 data_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a data cache
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_data_cache_free(
+     libvhdi_data_cache_t **data_cache,
+     libcerror_error_t **error )
+{
+	libvhdi_data_cache_shard_t *shard = NULL;
+	static char *function             = "libvhdi_data_cache_free";
+	int result                        = 1;
+	int shard_index                   = 0;
+
+	if( data_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_cache != NULL )
+	{
+		if( ( *data_cache )->shards != NULL )
+		{
+			for( shard_index = 0;
+			     shard_index < ( *data_cache )->number_of_shards;
+			     shard_index++ )
+			{
+				shard = &( ( ( *data_cache )->shards )[ shard_index ] );
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+				if( shard->read_write_lock != NULL )
+				{
+					if( libcthreads_read_write_lock_free(
+					     &( shard->read_write_lock ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free shard: %d read/write lock.",
+						 function,
+						 shard_index );
+
+						result = -1;
+					}
+				}
+#endif
+				if( shard->hash_table != NULL )
+				{
+					memory_free(
+					 shard->hash_table );
+				}
+				if( shard->next_entry_indexes != NULL )
+				{
+					memory_free(
+					 shard->next_entry_indexes );
+				}
+				if( shard->previous_entry_indexes != NULL )
+				{
+					memory_free(
+					 shard->previous_entry_indexes );
+				}
+				if( shard->entry_lists != NULL )
+				{
+					memory_free(
+					 shard->entry_lists );
+				}
+				if( shard->segment_data_sizes != NULL )
+				{
+					memory_free(
+					 shard->segment_data_sizes );
+				}
+				if( shard->segment_data != NULL )
+				{
+					memory_free(
+					 shard->segment_data );
+				}
+				if( shard->segment_indexes != NULL )
+				{
+					memory_free(
+					 shard->segment_indexes );
+				}
+			}
+			memory_free(
+			 ( *data_cache )->shards );
+		}
+		memory_free(
+		 *data_cache );
+
+		*data_cache = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the entry index of a specific segment index in a shard
+ * Returns the entry index or -1 if not available
+ */
+int libvhdi_data_cache_shard_get_entry_index(
+     libvhdi_data_cache_t *data_cache,
+     libvhdi_data_cache_shard_t *shard,
+     uint64_t segment_index )
+{
+	int entry_index = 0;
+	int hash_slot   = 0;
+
+	hash_slot = libvhdi_data_cache_get_hash_slot(
+	             data_cache,
+	             shard,
+	             segment_index );
+
+	while( shard->hash_table[ hash_slot ] != 0 )
+	{
+		entry_index = shard->hash_table[ hash_slot ] - 1;
+
+		if( shard->segment_indexes[ entry_index ] == segment_index )
+		{
+			return( entry_index );
+		}
+		hash_slot = ( hash_slot + 1 ) & ( shard->hash_table_size - 1 );
+	}
+	return( -1 );
+}
+
+/* Removes the hash table slot of a specific segment index from a shard
+ * The slots that follow are shifted back so that no tombstones are needed
+ * Returns 1 if successful or 0 if not available
+ */
+int libvhdi_data_cache_shard_remove_hash_slot(
+     libvhdi_data_cache_t *data_cache,
+     libvhdi_data_cache_shard_t *shard,
+     uint64_t segment_index )
+{
+	int hash_slot      = 0;
+	int home_hash_slot = 0;
+	int next_hash_slot = 0;
+
+	hash_slot = libvhdi_data_cache_get_hash_slot(
+	             data_cache,
+	             shard,
+	             segment_index );
+
+	while( shard->hash_table[ hash_slot ] != 0 )
+	{
+		if( shard->segment_indexes[ shard->hash_table[ hash_slot ] - 1 ] == segment_index )
+		{
+			break;
+		}
+		hash_slot = ( hash_slot + 1 ) & ( shard->hash_table_size - 1 );
+	}
+	if( shard->hash_table[ hash_slot ] == 0 )
+	{
+		return( 0 );
+	}
+	shard->hash_table[ hash_slot ] = 0;
+
+	next_hash_slot = hash_slot;
+
+	while( 1 )
+	{
+		next_hash_slot = ( next_hash_slot + 1 ) & ( shard->hash_table_size - 1 );
+
+		if( shard->hash_table[ next_hash_slot ] == 0 )
+		{
+			break;
+		}
+		home_hash_slot = libvhdi_data_cache_get_hash_slot(
+		                  data_cache,
+		                  shard,
+		                  shard->segment_indexes[ shard->hash_table[ next_hash_slot ] - 1 ] );
+
+		/* Move the slot back if its home slot is not cyclically between the empty slot and its current slot
+		 */
+		if( ( ( next_hash_slot > hash_slot )
+		  && ( ( home_hash_slot <= hash_slot )
+		   || ( home_hash_slot > next_hash_slot ) ) )
+		 || ( ( next_hash_slot < hash_slot )
+		  && ( home_hash_slot <= hash_slot )
+		  && ( home_hash_slot > next_hash_slot ) ) )
+		{
+			shard->hash_table[ hash_slot ]      = shard->hash_table[ next_hash_slot ];
+			shard->hash_table[ next_hash_slot ] = 0;
+
+			hash_slot = next_hash_slot;
+		}
+	}
+	return( 1 );
+}
+
+/* Unlinks an entry from the list it is part of
+ */
+void libvhdi_data_cache_shard_unlink_entry(
+      libvhdi_data_cache_shard_t *shard,
+      int entry_index )
+{
+	uint8_t entry_list       = shard->entry_lists[ entry_index ];
+	int next_entry_index     = shard->next_entry_indexes[ entry_index ];
+	int previous_entry_index = shard->previous_entry_indexes[ entry_index ];
+
+	if( previous_entry_index == -1 )
+	{
+		shard->list_heads[ entry_list ] = next_entry_index;
+	}
+	else
+	{
+		shard->next_entry_indexes[ previous_entry_index ] = next_entry_index;
+	}
+	if( next_entry_index == -1 )
+	{
+		shard->list_tails[ entry_list ] = previous_entry_index;
+	}
+	else
+	{
+		shard->previous_entry_indexes[ next_entry_index ] = previous_entry_index;
+	}
+	shard->list_sizes[ entry_list ] -= 1;
+}
+
+/* Prepends an entry to a list, which makes it the most recently used entry of the list
+ */
+void libvhdi_data_cache_shard_prepend_entry(
+      libvhdi_data_cache_shard_t *shard,
+      uint8_t entry_list,
+      int entry_index )
+{
+	int head_entry_index = shard->list_heads[ entry_list ];
+
+	shard->entry_lists[ entry_index ]            = entry_list;
+	shard->previous_entry_indexes[ entry_index ] = -1;
+	shard->next_entry_indexes[ entry_index ]     = head_entry_index;
+
+	if( head_entry_index == -1 )
+	{
+		shard->list_tails[ entry_list ] = entry_index;
+	}
+	else
+	{
+		shard->previous_entry_indexes[ head_entry_index ] = entry_index;
+	}
+	shard->list_heads[ entry_list ]  = entry_index;
+	shard->list_sizes[ entry_list ] += 1;
+}
+
+/* Reads data from a cached segment
+ * A segment that is read while on the probation list is promoted to the protected list,
+ * where the least recently used entry of a full protected list is demoted to the probation list
+ * Returns 1 if successful, 0 if the segment is not cached or -1 on error
+ */
+int libvhdi_data_cache_read_segment_data(
+     libvhdi_data_cache_t *data_cache,
+     uint64_t segment_index,
+     size_t segment_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *read_size,
+     libcerror_error_t **error )
+{
+	libvhdi_data_cache_shard_t *shard = NULL;
+	static char *function             = "libvhdi_data_cache_read_segment_data";
+	size_t safe_read_size             = 0;
+	int demoted_entry_index           = 0;
+	int entry_index                   = 0;
+	int result                        = 0;
+
+	if( data_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_data_offset >= data_cache->segment_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read size.",
+		 function );
+
+		return( -1 );
+	}
+	shard = &( ( data_cache->shards )[ segment_index % data_cache->number_of_shards ] );
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	entry_index = libvhdi_data_cache_shard_get_entry_index(
+	               data_cache,
+	               shard,
+	               segment_index );
+
+	if( entry_index == -1 )
+	{
+		shard->number_of_misses += 1;
+	}
+	else
+	{
+		shard->number_of_hits += 1;
+
+		libvhdi_data_cache_shard_unlink_entry(
+		 shard,
+		 entry_index );
+
+		if( shard->maximum_number_of_protected_entries == 0 )
+		{
+			libvhdi_data_cache_shard_prepend_entry(
+			 shard,
+			 LIBVHDI_DATA_CACHE_LIST_PROBATION,
+			 entry_index );
+		}
+		else
+		{
+			if( shard->list_sizes[ LIBVHDI_DATA_CACHE_LIST_PROTECTED ] >= shard->maximum_number_of_protected_entries )
+			{
+				demoted_entry_index = shard->list_tails[ LIBVHDI_DATA_CACHE_LIST_PROTECTED ];
+
+				libvhdi_data_cache_shard_unlink_entry(
+				 shard,
+				 demoted_entry_index );
+
+				libvhdi_data_cache_shard_prepend_entry(
+				 shard,
+				 LIBVHDI_DATA_CACHE_LIST_PROBATION,
+				 demoted_entry_index );
+			}
+			libvhdi_data_cache_shard_prepend_entry(
+			 shard,
+			 LIBVHDI_DATA_CACHE_LIST_PROTECTED,
+			 entry_index );
+		}
+		if( segment_data_offset < shard->segment_data_sizes[ entry_index ] )
+		{
+			safe_read_size = shard->segment_data_sizes[ entry_index ] - segment_data_offset;
+
+			if( safe_read_size > buffer_size )
+			{
+				safe_read_size = buffer_size;
+			}
+			/* The data is copied while the lock is held since another thread
+			 * can evict the segment once the lock is released
+			 */
+			if( memory_copy(
+			     buffer,
+			     &( shard->segment_data[ ( entry_index * data_cache->segment_size ) + segment_data_offset ] ),
+			     safe_read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy segment: %" PRIu64 " data.",
+				 function,
+				 segment_index );
+
+				safe_read_size = 0;
+				result         = -1;
+			}
+		}
+		if( result == 0 )
+		{
+			*read_size = safe_read_size;
+
+			result = 1;
+		}
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Inserts the data of a segment into the cache
+ * The segment is inserted on the probation list, where the least recently used entry
+ * of the probation list is evicted when the cache is full
+ * Returns 1 if successful, 0 if the segment was already cached or -1 on error
+ */
+int libvhdi_data_cache_insert_segment_data(
+     libvhdi_data_cache_t *data_cache,
+     uint64_t segment_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libvhdi_data_cache_shard_t *shard = NULL;
+	static char *function             = "libvhdi_data_cache_insert_segment_data";
+	int entry_index                   = 0;
+	int hash_slot                     = 0;
+	int result                        = 1;
+
+	if( data_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > data_cache->segment_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	shard = &( ( data_cache->shards )[ segment_index % data_cache->number_of_shards ] );
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	entry_index = libvhdi_data_cache_shard_get_entry_index(
+	               data_cache,
+	               shard,
+	               segment_index );
+
+	if( entry_index != -1 )
+	{
+		/* Another thread inserted the same segment in the meantime
+		 */
+		result = 0;
+	}
+	else
+	{
+		if( shard->number_of_entries < shard->maximum_number_of_entries )
+		{
+			entry_index = shard->number_of_entries;
+
+			shard->number_of_entries += 1;
+		}
+		else
+		{
+			/* Evict the least recently used entry of the probation list, where the protected list
+			 * is only used when all entries were promoted
+			 */
+			entry_index = shard->list_tails[ LIBVHDI_DATA_CACHE_LIST_PROBATION ];
+
+			if( entry_index == -1 )
+			{
+				entry_index = shard->list_tails[ LIBVHDI_DATA_CACHE_LIST_PROTECTED ];
+			}
+			libvhdi_data_cache_shard_unlink_entry(
+			 shard,
+			 entry_index );
+
+			libvhdi_data_cache_shard_remove_hash_slot(
+			 data_cache,
+			 shard,
+			 shard->segment_indexes[ entry_index ] );
+		}
+		if( memory_copy(
+		     &( shard->segment_data[ entry_index * data_cache->segment_size ] ),
+		     data,
+		     data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy segment: %" PRIu64 " data.",
+			 function,
+			 segment_index );
+
+			data_size = 0;
+			result    = -1;
+		}
+		shard->segment_indexes[ entry_index ]    = segment_index;
+		shard->segment_data_sizes[ entry_index ] = data_size;
+
+		libvhdi_data_cache_shard_prepend_entry(
+		 shard,
+		 LIBVHDI_DATA_CACHE_LIST_PROBATION,
+		 entry_index );
+
+		hash_slot = libvhdi_data_cache_get_hash_slot(
+		             data_cache,
+		             shard,
+		             segment_index );
+
+		while( shard->hash_table[ hash_slot ] != 0 )
+		{
+			hash_slot = ( hash_slot + 1 ) & ( shard->hash_table_size - 1 );
+		}
+		shard->hash_table[ hash_slot ] = entry_index + 1;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of cache hits and misses
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_data_cache_get_statistics(
+     libvhdi_data_cache_t *data_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	libvhdi_data_cache_shard_t *shard = NULL;
+	static char *function             = "libvhdi_data_cache_get_statistics";
+	uint64_t safe_number_of_hits      = 0;
+	uint64_t safe_number_of_misses    = 0;
+	int shard_index                   = 0;
+
+	if( data_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < data_cache->number_of_shards;
+	     shard_index++ )
+	{
+		shard = &( ( data_cache->shards )[ shard_index ] );
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_read(
+		     shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		safe_number_of_hits   += shard->number_of_hits;
+		safe_number_of_misses += shard->number_of_misses;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_read(
+		     shard->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+	}
+	*number_of_hits   = safe_number_of_hits;
+	*number_of_misses = safe_number_of_misses;
+
+	return( 1 );
+}
+
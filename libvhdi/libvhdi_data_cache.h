@@ -0,0 +1,183 @@
+/*
+ * Data cache functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVHDI_DATA_CACHE_H )
+#define _LIBVHDI_DATA_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvhdi_libcerror.h"
+#include "libvhdi_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvhdi_data_cache_shard libvhdi_data_cache_shard_t;
+
+struct libvhdi_data_cache_shard
+{
+	/* The segment indexes
+	 */
+	uint64_t *segment_indexes;
+
+	/* The segment data, which contains maximum number of entries segments
+	 */
+	uint8_t *segment_data;
+
+	/* The segment data sizes
+	 */
+	size_t *segment_data_sizes;
+
+	/* The list each entry is part of
+	 */
+	uint8_t *entry_lists;
+
+	/* The previous (more recently used) entry indexes, where -1 represents none
+	 */
+	int *previous_entry_indexes;
+
+	/* The next (less recently used) entry indexes, where -1 represents none
+	 */
+	int *next_entry_indexes;
+
+	/* The most recently used entry index of the probation and protected list
+	 */
+	int list_heads[ 2 ];
+
+	/* The least recently used entry index of the probation and protected list
+	 */
+	int list_tails[ 2 ];
+
+	/* The number of entries of the probation and protected list
+	 */
+	int list_sizes[ 2 ];
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The maximum number of entries
+	 */
+	int maximum_number_of_entries;
+
+	/* The maximum number of entries of the protected list
+	 */
+	int maximum_number_of_protected_entries;
+
+	/* The hash table, which contains the entry index + 1 or 0 if the slot is empty
+	 */
+	int *hash_table;
+
+	/* The hash table size, which is a power of 2
+	 */
+	int hash_table_size;
+
+	/* The number of hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of misses
+	 */
+	uint64_t number_of_misses;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+typedef struct libvhdi_data_cache libvhdi_data_cache_t;
+
+struct libvhdi_data_cache
+{
+	/* The segment size
+	 */
+	size_t segment_size;
+
+	/* The number of shards
+	 */
+	int number_of_shards;
+
+	/* The shards
+	 */
+	libvhdi_data_cache_shard_t *shards;
+};
+
+int libvhdi_data_cache_initialize(
+     libvhdi_data_cache_t **data_cache,
+     size_t maximum_size,
+     size_t segment_size,
+     libcerror_error_t **error );
+
+int libvhdi_data_cache_free(
+     libvhdi_data_cache_t **data_cache,
+     libcerror_error_t **error );
+
+int libvhdi_data_cache_shard_get_entry_index(
+     libvhdi_data_cache_t *data_cache,
+     libvhdi_data_cache_shard_t *shard,
+     uint64_t segment_index );
+
+int libvhdi_data_cache_shard_remove_hash_slot(
+     libvhdi_data_cache_t *data_cache,
+     libvhdi_data_cache_shard_t *shard,
+     uint64_t segment_index );
+
+void libvhdi_data_cache_shard_unlink_entry(
+      libvhdi_data_cache_shard_t *shard,
+      int entry_index );
+
+void libvhdi_data_cache_shard_prepend_entry(
+      libvhdi_data_cache_shard_t *shard,
+      uint8_t entry_list,
+      int entry_index );
+
+int libvhdi_data_cache_read_segment_data(
+     libvhdi_data_cache_t *data_cache,
+     uint64_t segment_index,
+     size_t segment_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *read_size,
+     libcerror_error_t **error );
+
+int libvhdi_data_cache_insert_segment_data(
+     libvhdi_data_cache_t *data_cache,
+     uint64_t segment_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvhdi_data_cache_get_statistics(
+     libvhdi_data_cache_t *data_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVHDI_DATA_CACHE_H ) */
+
@@ -0,0 +1,1103 @@
+/*
+ * Direct IO handle functions, which read a file bypassing the page cache
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* O_DIRECT is defined by glibc as a GNU extension
+ */
+#if !defined( _GNU_SOURCE )
+#define _GNU_SOURCE 1
+#endif
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#include <errno.h>
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libvhdi_definitions.h"
+#include "libvhdi_direct_io_handle.h"
+#include "libvhdi_libbfio.h"
+#include "libvhdi_libcerror.h"
+#include "libvhdi_unused.h"
+
+#if defined( O_DIRECT ) && defined( HAVE_OPEN ) && defined( HAVE_CLOSE ) && defined( HAVE_FSTAT ) && defined( HAVE_PREAD ) && defined( HAVE_POSIX_MEMALIGN )
+#define LIBVHDI_HAVE_DIRECT_IO	1
+#endif
+
+/* Creates a direct IO handle
+ * Make sure the value direct_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_direct_io_handle_initialize(
+     libvhdi_direct_io_handle_t **direct_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_direct_io_handle_initialize";
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *direct_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid direct IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*direct_io_handle = memory_allocate_structure(
+	                     libvhdi_direct_io_handle_t );
+
+	if( *direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create direct IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *direct_io_handle,
+	     0,
+	     sizeof( libvhdi_direct_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear direct IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *direct_io_handle )->file_descriptor = -1;
+	( *direct_io_handle )->alignment       = LIBVHDI_DIRECT_IO_ALIGNMENT;
+	( *direct_io_handle )->buffer_size     = LIBVHDI_DIRECT_IO_BUFFER_SIZE;
+
+	return( 1 );
+
+on_error:
+	if( *direct_io_handle != NULL )
+	{
+		memory_free(
+		 *direct_io_handle );
+
+		*direct_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Creates a file IO handle that reads a file using direct IO
+ * Make sure the value file_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_direct_io_handle_initialize_file_io_handle(
+     libbfio_handle_t **file_io_handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	libvhdi_direct_io_handle_t *direct_io_handle = NULL;
+	static char *function                        = "libvhdi_direct_io_handle_initialize_file_io_handle";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_direct_io_handle_initialize(
+	     &direct_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create direct IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvhdi_direct_io_handle_set_name(
+	     direct_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in direct IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     file_io_handle,
+	     (intptr_t *) direct_io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libvhdi_direct_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libvhdi_direct_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libvhdi_direct_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libvhdi_direct_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libvhdi_direct_io_handle_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libvhdi_direct_io_handle_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libvhdi_direct_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libvhdi_direct_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libvhdi_direct_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libvhdi_direct_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( direct_io_handle != NULL )
+	{
+		libvhdi_direct_io_handle_free(
+		 &direct_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a direct IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_direct_io_handle_free(
+     libvhdi_direct_io_handle_t **direct_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_direct_io_handle_free";
+	int result            = 1;
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *direct_io_handle != NULL )
+	{
+		if( ( *direct_io_handle )->file_descriptor != -1 )
+		{
+			if( libvhdi_direct_io_handle_close(
+			     *direct_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close direct IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *direct_io_handle )->filename != NULL )
+		{
+			memory_free(
+			 ( *direct_io_handle )->filename );
+		}
+		memory_free(
+		 *direct_io_handle );
+
+		*direct_io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the direct IO handle
+ * The destination direct IO handle is not opened
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_direct_io_handle_clone(
+     libvhdi_direct_io_handle_t **destination_direct_io_handle,
+     libvhdi_direct_io_handle_t *source_direct_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_direct_io_handle_clone";
+
+	if( destination_direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_direct_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination direct IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_direct_io_handle == NULL )
+	{
+		*destination_direct_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libvhdi_direct_io_handle_initialize(
+	     destination_direct_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination direct IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( source_direct_io_handle->filename != NULL )
+	{
+		if( libvhdi_direct_io_handle_set_name(
+		     *destination_direct_io_handle,
+		     source_direct_io_handle->filename,
+		     source_direct_io_handle->filename_size - 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set filename in destination direct IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	( *destination_direct_io_handle )->alignment   = source_direct_io_handle->alignment;
+	( *destination_direct_io_handle )->buffer_size = source_direct_io_handle->buffer_size;
+
+	return( 1 );
+
+on_error:
+	if( *destination_direct_io_handle != NULL )
+	{
+		libvhdi_direct_io_handle_free(
+		 destination_direct_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the filename
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_direct_io_handle_set_name(
+     libvhdi_direct_io_handle_t *direct_io_handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_direct_io_handle_set_name";
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid direct IO handle - file descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->filename != NULL )
+	{
+		memory_free(
+		 direct_io_handle->filename );
+
+		direct_io_handle->filename      = NULL;
+		direct_io_handle->filename_size = 0;
+	}
+	direct_io_handle->filename = narrow_string_allocate(
+	                              filename_length + 1 );
+
+	if( direct_io_handle->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( narrow_string_copy(
+	     direct_io_handle->filename,
+	     filename,
+	     filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy filename.",
+		 function );
+
+		goto on_error;
+	}
+	direct_io_handle->filename[ filename_length ] = 0;
+
+	direct_io_handle->filename_size = filename_length + 1;
+
+	return( 1 );
+
+on_error:
+	if( direct_io_handle->filename != NULL )
+	{
+		memory_free(
+		 direct_io_handle->filename );
+
+		direct_io_handle->filename = NULL;
+	}
+	direct_io_handle->filename_size = 0;
+
+	return( -1 );
+}
+
+/* Opens the direct IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_direct_io_handle_open(
+     libvhdi_direct_io_handle_t *direct_io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_direct_io_handle_open";
+
+#if defined( LIBVHDI_HAVE_DIRECT_IO )
+	struct stat file_statistics;
+
+	void *buffer          = NULL;
+	int file_descriptor   = -1;
+	int flags             = O_RDONLY | O_DIRECT;
+#endif
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct IO handle - missing filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid direct IO handle - file descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( access_flags & LIBBFIO_ACCESS_FLAG_READ ) == 0 )
+	 || ( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags, direct IO only supports read access.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBVHDI_HAVE_DIRECT_IO )
+#if defined( O_CLOEXEC )
+	flags |= O_CLOEXEC;
+#endif
+	if( posix_memalign(
+	     &buffer,
+	     direct_io_handle->alignment,
+	     direct_io_handle->buffer_size ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create aligned buffer.",
+		 function );
+
+		goto on_error;
+	}
+	file_descriptor = open(
+	                   direct_io_handle->filename,
+	                   flags );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 direct_io_handle->filename );
+
+		goto on_error;
+	}
+	if( fstat(
+	     file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_statistics.st_size < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	direct_io_handle->file_descriptor = file_descriptor;
+	direct_io_handle->file_size       = (size64_t) file_statistics.st_size;
+	direct_io_handle->current_offset  = 0;
+	direct_io_handle->buffer          = (uint8_t *) buffer;
+
+	return( 1 );
+
+on_error:
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	if( buffer != NULL )
+	{
+		free(
+		 buffer );
+	}
+	return( -1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: direct IO is not supported on this platform.",
+	 function );
+
+	return( -1 );
+#endif
+}
+
+/* Closes the direct IO handle
+ * Returns 0 if successful or -1 on error
+ */
+int libvhdi_direct_io_handle_close(
+     libvhdi_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_direct_io_handle_close";
+	int result            = 0;
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct IO handle - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBVHDI_HAVE_DIRECT_IO )
+	if( close(
+	     direct_io_handle->file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file: %s.",
+		 function,
+		 direct_io_handle->filename );
+
+		result = -1;
+	}
+	/* The buffer was allocated by posix_memalign and is freed by free
+	 */
+	if( direct_io_handle->buffer != NULL )
+	{
+		free(
+		 direct_io_handle->buffer );
+
+		direct_io_handle->buffer = NULL;
+	}
+#endif
+	direct_io_handle->file_descriptor = -1;
+	direct_io_handle->file_size       = 0;
+	direct_io_handle->current_offset  = 0;
+
+	return( result );
+}
+
+/* Reads a buffer from the direct IO handle
+ * Reads of which the offset, size and buffer are aligned are read directly into the buffer,
+ * other reads are read through the aligned bounce buffer
+ * Direct reads are only possible for fixed VHD and VHDX images, the block data of a dynamic
+ * or differential VHD image follows a 512 byte sector bitmap, hence its file offsets are
+ * never aligned and all its data is read through the bounce buffer
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libvhdi_direct_io_handle_read(
+         libvhdi_direct_io_handle_t *direct_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function    = "libvhdi_direct_io_handle_read";
+
+#if defined( LIBVHDI_HAVE_DIRECT_IO )
+	size_t buffer_offset     = 0;
+	size_t copy_size         = 0;
+	size_t data_offset       = 0;
+	size_t read_size         = 0;
+	size_t remaining_size    = 0;
+	ssize_t read_count       = 0;
+	off64_t aligned_offset   = 0;
+#endif
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct IO handle - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBVHDI_HAVE_DIRECT_IO )
+	if( (size64_t) direct_io_handle->current_offset >= direct_io_handle->file_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) size > ( direct_io_handle->file_size - direct_io_handle->current_offset ) )
+	{
+		size = (size_t) ( direct_io_handle->file_size - direct_io_handle->current_offset );
+	}
+	while( buffer_offset < size )
+	{
+		remaining_size = size - buffer_offset;
+		data_offset    = (size_t) ( direct_io_handle->current_offset % direct_io_handle->alignment );
+
+		if( ( data_offset == 0 )
+		 && ( remaining_size >= direct_io_handle->alignment )
+		 && ( ( (intptr_t) &( buffer[ buffer_offset ] ) % direct_io_handle->alignment ) == 0 ) )
+		{
+			/* Large aligned reads bypass the bounce buffer
+			 */
+			read_size = remaining_size - ( remaining_size % direct_io_handle->alignment );
+
+			read_count = pread(
+			              direct_io_handle->file_descriptor,
+			              &( buffer[ buffer_offset ] ),
+			              read_size,
+			              (off_t) direct_io_handle->current_offset );
+
+			if( read_count < 0 )
+			{
+				if( errno == EINTR )
+				{
+					continue;
+				}
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 errno,
+				 "%s: unable to read from file: %s.",
+				 function,
+				 direct_io_handle->filename );
+
+				return( -1 );
+			}
+			copy_size = (size_t) read_count;
+		}
+		else
+		{
+			aligned_offset = direct_io_handle->current_offset - data_offset;
+
+			/* Only read the aligned sectors that contain the requested data
+			 */
+			read_size = data_offset + remaining_size;
+
+			if( ( read_size % direct_io_handle->alignment ) != 0 )
+			{
+				read_size += direct_io_handle->alignment - ( read_size % direct_io_handle->alignment );
+			}
+			if( read_size > direct_io_handle->buffer_size )
+			{
+				read_size = direct_io_handle->buffer_size;
+			}
+			read_count = pread(
+			              direct_io_handle->file_descriptor,
+			              direct_io_handle->buffer,
+			              read_size,
+			              (off_t) aligned_offset );
+
+			if( read_count < 0 )
+			{
+				if( errno == EINTR )
+				{
+					continue;
+				}
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 errno,
+				 "%s: unable to read from file: %s.",
+				 function,
+				 direct_io_handle->filename );
+
+				return( -1 );
+			}
+			if( (size_t) read_count <= data_offset )
+			{
+				break;
+			}
+			copy_size = (size_t) read_count - data_offset;
+
+			if( copy_size > remaining_size )
+			{
+				copy_size = remaining_size;
+			}
+			if( memory_copy(
+			     &( buffer[ buffer_offset ] ),
+			     &( direct_io_handle->buffer[ data_offset ] ),
+			     copy_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy data from aligned buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( copy_size == 0 )
+		{
+			break;
+		}
+		buffer_offset                    += copy_size;
+		direct_io_handle->current_offset += copy_size;
+	}
+	return( (ssize_t) buffer_offset );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: direct IO is not supported on this platform.",
+	 function );
+
+	return( -1 );
+#endif
+}
+
+/* Writes a buffer to the direct IO handle
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libvhdi_direct_io_handle_write(
+         libvhdi_direct_io_handle_t *direct_io_handle LIBVHDI_ATTRIBUTE_UNUSED,
+         const uint8_t *buffer LIBVHDI_ATTRIBUTE_UNUSED,
+         size_t size LIBVHDI_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error )
+{
+	static char *function = "libvhdi_direct_io_handle_write";
+
+	LIBVHDI_UNREFERENCED_PARAMETER( direct_io_handle )
+	LIBVHDI_UNREFERENCED_PARAMETER( buffer )
+	LIBVHDI_UNREFERENCED_PARAMETER( size )
+
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: write access not supported.",
+	 function );
+
+	return( -1 );
+}
+
+/* Seeks a certain offset within the direct IO handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libvhdi_direct_io_handle_seek_offset(
+         libvhdi_direct_io_handle_t *direct_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libvhdi_direct_io_handle_seek_offset";
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += direct_io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) direct_io_handle->file_size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	direct_io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if a file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libvhdi_direct_io_handle_exists(
+     libvhdi_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_direct_io_handle_exists";
+
+#if defined( HAVE_SYS_STAT_H )
+	struct stat file_statistics;
+#endif
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct IO handle - missing filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_SYS_STAT_H )
+	if( stat(
+	     direct_io_handle->filename,
+	     &file_statistics ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: direct IO is not supported on this platform.",
+	 function );
+
+	return( -1 );
+#endif
+}
+
+/* Check if the direct IO handle is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libvhdi_direct_io_handle_is_open(
+     libvhdi_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_direct_io_handle_is_open";
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor == -1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of the direct IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_direct_io_handle_get_size(
+     libvhdi_direct_io_handle_t *direct_io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_direct_io_handle_get_size";
+
+	if( direct_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct IO handle - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	*size = direct_io_handle->file_size;
+
+	return( 1 );
+}
+
@@ -0,0 +1,142 @@
+/*
+ * Direct IO handle functions, which read a file bypassing the page cache
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVHDI_DIRECT_IO_HANDLE_H )
+#define _LIBVHDI_DIRECT_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvhdi_libbfio.h"
+#include "libvhdi_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvhdi_direct_io_handle libvhdi_direct_io_handle_t;
+
+struct libvhdi_direct_io_handle
+{
+	/* The filename
+	 */
+	char *filename;
+
+	/* The filename size
+	 */
+	size_t filename_size;
+
+	/* The file descriptor
+	 */
+	int file_descriptor;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The file size
+	 */
+	size64_t file_size;
+
+	/* The alignment of the file offsets, read sizes and buffers
+	 */
+	size_t alignment;
+
+	/* The aligned bounce buffer used for unaligned reads
+	 */
+	uint8_t *buffer;
+
+	/* The bounce buffer size
+	 */
+	size_t buffer_size;
+};
+
+int libvhdi_direct_io_handle_initialize(
+     libvhdi_direct_io_handle_t **direct_io_handle,
+     libcerror_error_t **error );
+
+int libvhdi_direct_io_handle_initialize_file_io_handle(
+     libbfio_handle_t **file_io_handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+int libvhdi_direct_io_handle_free(
+     libvhdi_direct_io_handle_t **direct_io_handle,
+     libcerror_error_t **error );
+
+int libvhdi_direct_io_handle_clone(
+     libvhdi_direct_io_handle_t **destination_direct_io_handle,
+     libvhdi_direct_io_handle_t *source_direct_io_handle,
+     libcerror_error_t **error );
+
+int libvhdi_direct_io_handle_set_name(
+     libvhdi_direct_io_handle_t *direct_io_handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+int libvhdi_direct_io_handle_open(
+     libvhdi_direct_io_handle_t *direct_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libvhdi_direct_io_handle_close(
+     libvhdi_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error );
+
+ssize_t libvhdi_direct_io_handle_read(
+         libvhdi_direct_io_handle_t *direct_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libvhdi_direct_io_handle_write(
+         libvhdi_direct_io_handle_t *direct_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libvhdi_direct_io_handle_seek_offset(
+         libvhdi_direct_io_handle_t *direct_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libvhdi_direct_io_handle_exists(
+     libvhdi_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error );
+
+int libvhdi_direct_io_handle_is_open(
+     libvhdi_direct_io_handle_t *direct_io_handle,
+     libcerror_error_t **error );
+
+int libvhdi_direct_io_handle_get_size(
+     libvhdi_direct_io_handle_t *direct_io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVHDI_DIRECT_IO_HANDLE_H ) */
+
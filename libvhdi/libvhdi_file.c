@@ -26,25 +26,32 @@
 #include <wide_string.h>
 
 #include "libvhdi_block_allocation_table.h"
+#include "libvhdi_block_cache.h"
 #include "libvhdi_block_descriptor.h"
 #include "libvhdi_debug.h"
 #include "libvhdi_definitions.h"
+#include "libvhdi_direct_io_handle.h"
 #include "libvhdi_file.h"
 #include "libvhdi_file_footer.h"
 #include "libvhdi_file_information.h"
 #include "libvhdi_i18n.h"
 #include "libvhdi_image_header.h"
+#include "libvhdi_index.h"
 #include "libvhdi_io_handle.h"
 #include "libvhdi_libbfio.h"
 #include "libvhdi_libcerror.h"
 #include "libvhdi_libcnotify.h"
 #include "libvhdi_libcthreads.h"
-#include "libvhdi_libfcache.h"
-#include "libvhdi_libfdata.h"
+#include "libvhdi_log.h"
+#include "libvhdi_log_io_handle.h"
+#include "libvhdi_memory_map.h"
 #include "libvhdi_metadata_values.h"
+#include "libvhdi_read_ahead.h"
+#include "libvhdi_read_queue.h"
+#include "libvhdi_read_segment.h"
 #include "libvhdi_region_table.h"
 #include "libvhdi_region_type_identifier.h"
-#include "libvhdi_sector_range_descriptor.h"
+#include "libvhdi_statistics.h"
 
 /* Creates a file
  * Make sure the value file is referencing, is set to NULL
@@ -123,6 +130,19 @@ int libvhdi_file_initialize(
 
 		goto on_error;
 	}
+	if( libvhdi_statistics_initialize(
+	     &( internal_file->statistics ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create statistics.",
+		 function );
+
+		goto on_error;
+	}
 	if( libvhdi_i18n_initialize(
 	     error ) != 1 )
 	{
@@ -150,6 +170,30 @@ int libvhdi_file_initialize(
 		goto on_error;
 	}
 #endif
+	if( libvhdi_read_queue_initialize(
+	     &( internal_file->read_queue ),
+	     (intptr_t *) internal_file,
+	     &libvhdi_internal_file_read_queue_read_buffers,
+	     &libvhdi_internal_file_read_queue_get_file_range,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read queue.",
+		 function );
+
+		goto on_error;
+	}
+	internal_file->block_cache_size = LIBVHDI_MAXIMUM_CACHE_ENTRIES_BLOCK_DESCRIPTORS;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	internal_file->maximum_number_of_file_io_handles = LIBVHDI_DEFAULT_NUMBER_OF_FILE_IO_HANDLES;
+#else
+	internal_file->maximum_number_of_file_io_handles = 1;
+#endif
+
 	*file = (libvhdi_file_t *) internal_file;
 
 	return( 1 );
@@ -157,6 +201,20 @@ int libvhdi_file_initialize(
 on_error:
 	if( internal_file != NULL )
 	{
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+		if( internal_file->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_file->read_write_lock ),
+			 NULL );
+		}
+#endif
+		if( internal_file->statistics != NULL )
+		{
+			libvhdi_statistics_free(
+			 &( internal_file->statistics ),
+			 NULL );
+		}
 		if( internal_file->io_handle != NULL )
 		{
 			libvhdi_io_handle_free(
@@ -213,6 +271,19 @@ int libvhdi_file_free(
 		}
 		*file = NULL;
 
+		if( libvhdi_read_queue_free(
+		     &( internal_file->read_queue ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read queue.",
+			 function );
+
+			result = -1;
+		}
 #if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
 		if( libcthreads_read_write_lock_free(
 		     &( internal_file->read_write_lock ),
@@ -241,6 +312,24 @@ int libvhdi_file_free(
 
 			result = -1;
 		}
+		if( libvhdi_statistics_free(
+		     &( internal_file->statistics ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free statistics.",
+			 function );
+
+			result = -1;
+		}
+		if( internal_file->index_filename != NULL )
+		{
+			memory_free(
+			 internal_file->index_filename );
+		}
 		memory_free(
 		 internal_file );
 	}
@@ -297,8 +386,10 @@ int libvhdi_file_open(
 {
 	libbfio_handle_t *file_io_handle       = NULL;
 	libvhdi_internal_file_t *internal_file = NULL;
+	libvhdi_memory_map_t *memory_map       = NULL;
 	static char *function                  = "libvhdi_file_open";
 	size_t filename_length                 = 0;
+	int result                             = 0;
 
 	if( file == NULL )
 	{
@@ -347,18 +438,72 @@ int libvhdi_file_open(
 
 		return( -1 );
 	}
-	if( libbfio_file_initialize(
-	     &file_io_handle,
-	     error ) != 1 )
+	if( ( ( access_flags & LIBVHDI_ACCESS_FLAG_MEMORY_MAP ) != 0 )
+	 && ( ( access_flags & LIBVHDI_ACCESS_FLAG_DIRECT_IO ) != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: memory map and direct IO access cannot be combined.",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( ( access_flags & LIBVHDI_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		/* The direct IO handle reads the file through aligned buffers
+		 * which includes the reads of the metadata
+		 */
+		if( libvhdi_direct_io_handle_initialize_file_io_handle(
+		     &file_io_handle,
+		     filename,
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create direct IO file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( libbfio_file_initialize(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_file_set_name(
+		     file_io_handle,
+		     filename,
+		     filename_length + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set filename in file IO handle.",
+			 function );
+
+			goto on_error;
+		}
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libbfio_handle_set_track_offsets_read(
@@ -376,23 +521,58 @@ int libvhdi_file_open(
 		goto on_error;
 	}
 #endif
-	filename_length = narrow_string_length(
-	                   filename );
+	if( ( access_flags & LIBVHDI_ACCESS_FLAG_MEMORY_MAP ) != 0 )
+	{
+		if( libvhdi_memory_map_initialize(
+		     &memory_map,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create memory map.",
+			 function );
 
-	if( libbfio_file_set_name(
-	     file_io_handle,
-	     filename,
-	     filename_length + 1,
-	     error ) != 1 )
+			goto on_error;
+		}
+		if( libvhdi_memory_map_open(
+		     memory_map,
+		     filename,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to memory map file: %s.",
+			 function,
+			 filename );
+
+			goto on_error;
+		}
+	}
+	/* Submitted reads of data that is stored contiguously in the file are read using
+	 * an io_uring if available, the io_uring does not read through the direct IO handle
+	 */
+	if( ( access_flags & LIBVHDI_ACCESS_FLAG_DIRECT_IO ) == 0 )
 	{
-                libcerror_error_set(
-                 error,
-                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-                 "%s: unable to set filename in file IO handle.",
-                 function );
+		result = libvhdi_read_queue_open_io_uring(
+		          internal_file->read_queue,
+		          filename,
+		          error );
 
-		goto on_error;
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open read queue io_uring.",
+			 function );
+
+			goto on_error;
+		}
 	}
 	if( libvhdi_file_open_file_io_handle(
 	     file,
@@ -426,6 +606,7 @@ int libvhdi_file_open(
 	}
 #endif
 	internal_file->file_io_handle_created_in_library = 1;
+	internal_file->memory_map                        = memory_map;
 
 #if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -445,6 +626,18 @@ int libvhdi_file_open(
 	return( 1 );
 
 on_error:
+	if( result == 1 )
+	{
+		libvhdi_read_queue_close_io_uring(
+		 internal_file->read_queue,
+		 NULL );
+	}
+	if( memory_map != NULL )
+	{
+		libvhdi_memory_map_free(
+		 &memory_map,
+		 NULL );
+	}
 	if( file_io_handle != NULL )
 	{
 		libbfio_handle_free(
@@ -517,6 +710,28 @@ int libvhdi_file_open_wide(
 
 		return( -1 );
 	}
+	if( ( access_flags & LIBVHDI_ACCESS_FLAG_MEMORY_MAP ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: memory map access currently not supported.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBVHDI_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: direct IO access currently not supported.",
+		 function );
+
+		return( -1 );
+	}
 	if( libbfio_file_initialize(
 	     &file_io_handle,
 	     error ) != 1 )
@@ -627,6 +842,7 @@ on_error:
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
 /* Opens a file using a Basic File IO (bfio) handle
+ * The file IO handle is used as-is, LIBVHDI_ACCESS_FLAG_MEMORY_MAP and LIBVHDI_ACCESS_FLAG_DIRECT_IO are only supported by libvhdi_file_open
  * Returns 1 if successful or -1 on error
  */
 int libvhdi_file_open_file_io_handle(
@@ -635,11 +851,20 @@ int libvhdi_file_open_file_io_handle(
      int access_flags,
      libcerror_error_t **error )
 {
-	libvhdi_internal_file_t *internal_file   = NULL;
-	static char *function                    = "libvhdi_file_open_file_io_handle";
-	uint8_t file_io_handle_opened_in_library = 0;
-	int bfio_access_flags                    = 0;
-	int file_io_handle_is_open               = 0;
+	libbfio_handle_t *read_file_io_handle              = NULL;
+	libvhdi_data_cache_t *data_cache                   = NULL;
+	libvhdi_file_io_handle_pool_t *file_io_handle_pool = NULL;
+	libvhdi_internal_file_t *internal_file             = NULL;
+	libvhdi_reference_count_t *reference_count         = NULL;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	libvhdi_read_ahead_t *read_ahead                   = NULL;
+#endif
+
+	static char *function                              = "libvhdi_file_open_file_io_handle";
+	uint8_t file_io_handle_opened_in_library           = 0;
+	int bfio_access_flags                              = 0;
+	int file_io_handle_is_open                         = 0;
 
 	if( file == NULL )
 	{
@@ -725,6 +950,28 @@ int libvhdi_file_open_file_io_handle(
 		}
 		file_io_handle_opened_in_library = 1;
 	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( internal_file->read_ahead_size > 0 )
+	{
+		if( libvhdi_read_ahead_initialize(
+		     &read_ahead,
+		     internal_file->read_ahead_size,
+		     0,
+		     (intptr_t *) internal_file,
+		     &libvhdi_internal_file_read_ahead_read_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read-ahead.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( libvhdi_internal_file_open_read(
 	     internal_file,
 	     file_io_handle,
@@ -739,6 +986,62 @@ int libvhdi_file_open_file_io_handle(
 
 		goto on_error;
 	}
+	/* If the log is applied the file IO handle was replaced by the log file IO handle
+	 */
+	if( internal_file->image_file_io_handle != NULL )
+	{
+		read_file_io_handle = internal_file->file_io_handle;
+	}
+	else
+	{
+		read_file_io_handle = file_io_handle;
+	}
+	if( libvhdi_file_io_handle_pool_initialize(
+	     &file_io_handle_pool,
+	     read_file_io_handle,
+	     internal_file->maximum_number_of_file_io_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvhdi_reference_count_initialize(
+	     &reference_count,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reference count.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_file->data_cache_size > 0 )
+	{
+		if( libvhdi_data_cache_initialize(
+		     &data_cache,
+		     internal_file->data_cache_size,
+		     LIBVHDI_DATA_CACHE_SEGMENT_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create data cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_file->read_write_lock,
@@ -754,8 +1057,20 @@ int libvhdi_file_open_file_io_handle(
 		return( -1 );
 	}
 #endif
-	internal_file->file_io_handle                   = file_io_handle;
+	internal_file->file_io_handle                   = read_file_io_handle;
 	internal_file->file_io_handle_opened_in_library = file_io_handle_opened_in_library;
+	internal_file->file_io_handle_pool              = file_io_handle_pool;
+	internal_file->reference_count                  = reference_count;
+	internal_file->data_cache                       = data_cache;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( read_ahead != NULL )
+	{
+		read_ahead->data_size = internal_file->io_handle->media_size;
+
+		internal_file->read_ahead = read_ahead;
+	}
+#endif
 
 #if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -775,6 +1090,47 @@ int libvhdi_file_open_file_io_handle(
 	return( 1 );
 
 on_error:
+	if( data_cache != NULL )
+	{
+		libvhdi_data_cache_free(
+		 &data_cache,
+		 NULL );
+	}
+	if( reference_count != NULL )
+	{
+		libvhdi_reference_count_free(
+		 &reference_count,
+		 NULL );
+	}
+	if( file_io_handle_pool != NULL )
+	{
+		libvhdi_file_io_handle_pool_free(
+		 &file_io_handle_pool,
+		 NULL );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( read_ahead != NULL )
+	{
+		libvhdi_read_ahead_free(
+		 &read_ahead,
+		 NULL );
+	}
+#endif
+	if( internal_file->image_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &( internal_file->file_io_handle ),
+		 NULL );
+
+		internal_file->file_io_handle       = NULL;
+		internal_file->image_file_io_handle = NULL;
+	}
+	if( internal_file->log != NULL )
+	{
+		libvhdi_log_free(
+		 &( internal_file->log ),
+		 NULL );
+	}
 	if( file_io_handle_opened_in_library != 0 )
 	{
 		libbfio_handle_close(
@@ -784,8 +1140,212 @@ on_error:
 	return( -1 );
 }
 
-/* Closes a file
- * Returns 0 if successful or -1 on error
+/* Clones an open file
+ * The clone has its own current offset, read-ahead and lock, but shares the file IO handles,
+ * the file header values, block allocation table, block cache and parent file with the source file
+ * The shared values are freed when the last of the files that share them is closed
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_file_clone(
+     libvhdi_file_t **destination_file,
+     libvhdi_file_t *source_file,
+     libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_destination_file = NULL;
+	libvhdi_internal_file_t *internal_source_file      = NULL;
+	static char *function                              = "libvhdi_file_clone";
+	int result                                         = 1;
+
+	if( destination_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_source_file = (libvhdi_internal_file_t *) source_file;
+
+	if( internal_source_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid source file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_file_initialize(
+	     destination_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination file.",
+		 function );
+
+		goto on_error;
+	}
+	internal_destination_file = (libvhdi_internal_file_t *) *destination_file;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_source_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( memory_copy(
+	     internal_destination_file->io_handle,
+	     internal_source_file->io_handle,
+	     sizeof( libvhdi_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy IO handle.",
+		 function );
+
+		result = -1;
+	}
+	else if( libvhdi_reference_count_increment(
+	          internal_source_file->reference_count,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to increment reference count.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_destination_file->io_handle->abort = 0;
+
+		internal_destination_file->file_io_handle                    = internal_source_file->file_io_handle;
+		internal_destination_file->file_io_handle_created_in_library = internal_source_file->file_io_handle_created_in_library;
+		internal_destination_file->file_io_handle_opened_in_library  = internal_source_file->file_io_handle_opened_in_library;
+		internal_destination_file->file_io_handle_pool               = internal_source_file->file_io_handle_pool;
+		internal_destination_file->maximum_number_of_file_io_handles = internal_source_file->maximum_number_of_file_io_handles;
+		internal_destination_file->file_footer                       = internal_source_file->file_footer;
+		internal_destination_file->file_information                  = internal_source_file->file_information;
+		internal_destination_file->dynamic_disk_header               = internal_source_file->dynamic_disk_header;
+		internal_destination_file->image_header                      = internal_source_file->image_header;
+		internal_destination_file->region_table                      = internal_source_file->region_table;
+		internal_destination_file->metadata_values                   = internal_source_file->metadata_values;
+		internal_destination_file->block_allocation_table            = internal_source_file->block_allocation_table;
+		internal_destination_file->block_cache                       = internal_source_file->block_cache;
+		internal_destination_file->block_cache_size                  = internal_source_file->block_cache_size;
+		internal_destination_file->data_cache                        = internal_source_file->data_cache;
+		internal_destination_file->data_cache_size                   = internal_source_file->data_cache_size;
+		internal_destination_file->parent_file                       = internal_source_file->parent_file;
+		internal_destination_file->memory_map                        = internal_source_file->memory_map;
+		internal_destination_file->log                               = internal_source_file->log;
+		internal_destination_file->image_file_io_handle              = internal_source_file->image_file_io_handle;
+		internal_destination_file->reference_count                   = internal_source_file->reference_count;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_source_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		result = -1;
+	}
+	if( ( result == 1 )
+	 && ( internal_source_file->read_ahead_size > 0 ) )
+	{
+		/* The clone reads ahead with its own read-ahead, since the read-ahead
+		 * tracks the sequential reads of a single file
+		 */
+		if( libvhdi_read_ahead_initialize(
+		     &( internal_destination_file->read_ahead ),
+		     internal_source_file->read_ahead_size,
+		     internal_destination_file->io_handle->media_size,
+		     (intptr_t *) internal_destination_file,
+		     &libvhdi_internal_file_read_ahead_read_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read-ahead.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			internal_destination_file->read_ahead_size = internal_source_file->read_ahead_size;
+		}
+	}
+#endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *destination_file != NULL )
+	{
+		libvhdi_file_free(
+		 destination_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes a file
+ * Returns 0 if successful or -1 on error
  */
 int libvhdi_file_close(
      libvhdi_file_t *file,
@@ -793,6 +1353,7 @@ int libvhdi_file_close(
 {
 	libvhdi_internal_file_t *internal_file = NULL;
 	static char *function                  = "libvhdi_file_close";
+	int number_of_references               = 0;
 	int result                             = 0;
 
 	if( file == NULL )
@@ -819,6 +1380,35 @@ int libvhdi_file_close(
 
 		return( -1 );
 	}
+	/* The read queue is flushed before the read/write lock is grabbed
+	 * since its threads grab the lock for reading
+	 */
+	if( libvhdi_read_queue_flush(
+	     internal_file->read_queue,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to flush read queue.",
+		 function );
+
+		result = -1;
+	}
+	if( libvhdi_read_queue_close_io_uring(
+	     internal_file->read_queue,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close read queue io_uring.",
+		 function );
+
+		result = -1;
+	}
 #if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_file->read_write_lock,
@@ -833,7 +1423,116 @@ int libvhdi_file_close(
 
 		return( -1 );
 	}
+	/* The read-ahead is freed first since its thread reads from the file
+	 */
+	if( internal_file->read_ahead != NULL )
+	{
+		if( libvhdi_read_ahead_free(
+		     &( internal_file->read_ahead ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead.",
+			 function );
+
+			result = -1;
+		}
+	}
 #endif
+	/* The file values are shared with clones of the file and are only freed
+	 * when the last file that references them is closed
+	 */
+	if( internal_file->reference_count != NULL )
+	{
+		if( libvhdi_reference_count_decrement(
+		     internal_file->reference_count,
+		     &number_of_references,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to decrement reference count.",
+			 function );
+
+			/* The file values are not freed since they could still be referenced
+			 */
+			number_of_references = 1;
+
+			result = -1;
+		}
+		if( number_of_references > 0 )
+		{
+			internal_file->reference_count                   = NULL;
+			internal_file->file_io_handle_pool               = NULL;
+			internal_file->file_io_handle_created_in_library = 0;
+			internal_file->file_io_handle_opened_in_library  = 0;
+			internal_file->memory_map                        = NULL;
+			internal_file->log                               = NULL;
+			internal_file->image_file_io_handle              = NULL;
+			internal_file->file_footer                       = NULL;
+			internal_file->file_information                  = NULL;
+			internal_file->dynamic_disk_header               = NULL;
+			internal_file->image_header                      = NULL;
+			internal_file->region_table                      = NULL;
+			internal_file->metadata_values                   = NULL;
+			internal_file->block_allocation_table            = NULL;
+			internal_file->block_cache                       = NULL;
+			internal_file->data_cache                        = NULL;
+		}
+		else if( libvhdi_reference_count_free(
+		          &( internal_file->reference_count ),
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reference count.",
+			 function );
+
+			result = -1;
+		}
+	}
+	/* The file IO handle pool is freed before the file IO handle it was created with is closed
+	 */
+	if( libvhdi_file_io_handle_pool_free(
+	     &( internal_file->file_io_handle_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle pool.",
+		 function );
+
+		result = -1;
+	}
+	/* The log file IO handle does not manage the file IO handle it reads from
+	 */
+	if( internal_file->image_file_io_handle != NULL )
+	{
+		if( libbfio_handle_free(
+		     &( internal_file->file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free log file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		internal_file->file_io_handle       = internal_file->image_file_io_handle;
+		internal_file->image_file_io_handle = NULL;
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -892,6 +1591,39 @@ int libvhdi_file_close(
 	internal_file->file_io_handle = NULL;
 	internal_file->current_offset = 0;
 
+	if( internal_file->memory_map != NULL )
+	{
+		if( libvhdi_memory_map_free(
+		     &( internal_file->memory_map ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free memory map.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_file->log != NULL )
+	{
+		if( libvhdi_log_free(
+		     &( internal_file->log ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free log.",
+			 function );
+
+			result = -1;
+		}
+	}
+
 	if( libvhdi_io_handle_clear(
 	     internal_file->io_handle,
 	     error ) != 1 )
@@ -1017,33 +1749,33 @@ int libvhdi_file_close(
 			result = -1;
 		}
 	}
-	if( internal_file->block_descriptors_vector != NULL )
+	if( internal_file->block_cache != NULL )
 	{
-		if( libfdata_vector_free(
-		     &( internal_file->block_descriptors_vector ),
+		if( libvhdi_block_cache_free(
+		     &( internal_file->block_cache ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free block descriptors vector.",
+			 "%s: unable to free block cache.",
 			 function );
 
 			result = -1;
 		}
 	}
-	if( internal_file->block_descriptors_cache != NULL )
+	if( internal_file->data_cache != NULL )
 	{
-		if( libfcache_cache_free(
-		     &( internal_file->block_descriptors_cache ),
+		if( libvhdi_data_cache_free(
+		     &( internal_file->data_cache ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free block descriptors cache.",
+			 "%s: unable to free data cache.",
 			 function );
 
 			result = -1;
@@ -1272,6 +2004,28 @@ int libvhdi_internal_file_open_read(
 
 			goto on_error;
 		}
+		result = libvhdi_internal_file_open_read_log(
+		          internal_file,
+		          file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read log.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			/* The remaining values are read with the log applied
+			 */
+			file_io_handle = internal_file->file_io_handle;
+		}
 		if( libvhdi_internal_file_open_read_region_table(
 		     internal_file,
 		     file_io_handle,
@@ -1330,6 +2084,21 @@ on_error:
 		 &( internal_file->region_table ),
 		 NULL );
 	}
+	if( internal_file->image_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &( internal_file->file_io_handle ),
+		 NULL );
+
+		internal_file->file_io_handle       = NULL;
+		internal_file->image_file_io_handle = NULL;
+	}
+	if( internal_file->log != NULL )
+	{
+		libvhdi_log_free(
+		 &( internal_file->log ),
+		 NULL );
+	}
 	if( internal_file->image_header != NULL )
 	{
 		libvhdi_image_header_free(
@@ -1604,10 +2373,182 @@ on_error:
 	return( -1 );
 }
 
-/* Reads the VHDX region table on open
- * Returns 1 if successful or -1 on error
+/* Reads the VHDX log on open
+ * If the log contains log entries that were not applied to the file, the log entries are replayed
+ * in memory and the file IO handle is replaced by a file IO handle that reads the file with the log applied
+ * The file itself is not modified
+ * Returns 1 if successful, 0 if there are no log entries to replay or -1 on error
  */
-int libvhdi_internal_file_open_read_region_table(
+int libvhdi_internal_file_open_read_log(
+     libvhdi_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *log_file_io_handle = NULL;
+	libvhdi_log_t *log                   = NULL;
+	static char *function                = "libvhdi_internal_file_open_read_log";
+	size_t identifier_index              = 0;
+	int result                           = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->image_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing image header.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->log != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - log already set.",
+		 function );
+
+		return( -1 );
+	}
+	/* An empty log identifier indicates that the log is empty
+	 */
+	for( identifier_index = 0;
+	     identifier_index < 16;
+	     identifier_index++ )
+	{
+		if( internal_file->image_header->log_identifier[ identifier_index ] != 0 )
+		{
+			break;
+		}
+	}
+	if( identifier_index >= 16 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Reading log:\n" );
+	}
+#endif
+	if( libvhdi_log_initialize(
+	     &log,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create log.",
+		 function );
+
+		goto on_error;
+	}
+	result = libvhdi_log_read_file_io_handle(
+	          log,
+	          file_io_handle,
+	          (off64_t) internal_file->image_header->log_offset,
+	          (size64_t) internal_file->image_header->log_size,
+	          internal_file->image_header->log_identifier,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read log.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libvhdi_log_free(
+		     &log,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free log.",
+			 function );
+
+			goto on_error;
+		}
+		return( 0 );
+	}
+	if( libvhdi_log_io_handle_initialize_file_io_handle(
+	     &log_file_io_handle,
+	     file_io_handle,
+	     log,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create log file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     log_file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open log file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	internal_file->log                  = log;
+	internal_file->image_file_io_handle = file_io_handle;
+	internal_file->file_io_handle       = log_file_io_handle;
+
+	return( 1 );
+
+on_error:
+	if( log_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &log_file_io_handle,
+		 NULL );
+	}
+	if( log != NULL )
+	{
+		libvhdi_log_free(
+		 &log,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the VHDX region table on open
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_internal_file_open_read_region_table(
      libvhdi_internal_file_t *internal_file,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
@@ -1874,7 +2815,7 @@ int libvhdi_internal_file_open_read_block_allocation_table(
 	static char *function                            = "libvhdi_internal_file_open_read_block_allocation_table";
 	off64_t block_allocation_table_offset            = 0;
 	uint32_t number_of_entries                       = 0;
-	int segment_index                                = 0;
+	int result                                       = 0;
 
 	if( internal_file == NULL )
 	{
@@ -1909,24 +2850,13 @@ int libvhdi_internal_file_open_read_block_allocation_table(
 
 		return( -1 );
 	}
-	if( internal_file->block_descriptors_vector != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - block descriptors vector already set.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_file->block_descriptors_cache != NULL )
+	if( internal_file->block_cache != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - block descriptors cache already set.",
+		 "%s: invalid file - block cache already set.",
 		 function );
 
 		return( -1 );
@@ -2033,54 +2963,53 @@ int libvhdi_internal_file_open_read_block_allocation_table(
 
 		goto on_error;
 	}
-	if( libfdata_vector_initialize(
-	     &( internal_file->block_descriptors_vector ),
-	     (size64_t) internal_file->io_handle->block_size,
-	     (intptr_t *) internal_file->block_allocation_table,
-	     NULL,
-	     NULL,
-	     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfdata_cache_t *, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libvhdi_block_allocation_table_read_element_data,
-	     NULL,
-	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
-	     error ) != 1 )
+	if( internal_file->index_filename != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create block descriptors vector.",
-		 function );
+		result = libvhdi_internal_file_open_read_index(
+		          internal_file,
+		          file_io_handle,
+		          error );
 
-		goto on_error;
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read index.",
+			 function );
+
+			goto on_error;
+		}
 	}
-	if( libfdata_vector_append_segment(
-	     internal_file->block_descriptors_vector,
-	     &segment_index,
-	     0,
-	     0,
-	     internal_file->io_handle->media_size,
-	     0,
-	     error ) != 1 )
+	if( result == 0 )
+	{
+		result = libvhdi_block_allocation_table_read_entries_file_io_handle(
+		          internal_file->block_allocation_table,
+		          file_io_handle,
+		          error );
+	}
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append segment to data block descriptors vector.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block allocation table entries.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfcache_cache_initialize(
-	     &( internal_file->block_descriptors_cache ),
-	     LIBVHDI_MAXIMUM_CACHE_ENTRIES_BLOCK_DESCRIPTORS,
+	if( libvhdi_block_cache_initialize(
+	     &( internal_file->block_cache ),
+	     internal_file->block_cache_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create block descriptors cache.",
+		 "%s: unable to create block cache.",
 		 function );
 
 		goto on_error;
@@ -2088,12 +3017,6 @@ int libvhdi_internal_file_open_read_block_allocation_table(
 	return( 1 );
 
 on_error:
-	if( internal_file->block_descriptors_vector != NULL )
-	{
-		libfdata_vector_free(
-		 &( internal_file->block_descriptors_vector ),
-		 NULL );
-	}
 	if( internal_file->block_allocation_table != NULL )
 	{
 		libvhdi_block_allocation_table_free(
@@ -2103,27 +3026,18 @@ on_error:
 	return( -1 );
 }
 
-/* Reads (media) data from the current offset into a buffer using a Basic File IO (bfio) handle
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read or -1 on error
+/* Retrieves the values that are used to validate an index
+ * This function is not multi-thread safe acquire a read or write lock before call
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libvhdi_internal_file_read_buffer_from_file_io_handle(
-         libvhdi_internal_file_t *internal_file,
-         libbfio_handle_t *file_io_handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libvhdi_internal_file_get_index_values(
+     libvhdi_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     libvhdi_index_t *index,
+     libcerror_error_t **error )
 {
-	libvhdi_block_descriptor_t *block_descriptor               = NULL;
-	libvhdi_sector_range_descriptor_t *sector_range_descriptor = NULL;
-	static char *function                                      = "libvhdi_internal_file_read_buffer_from_file_io_handle";
-	size_t buffer_offset                                       = 0;
-	size_t read_size                                           = 0;
-	ssize_t read_count                                         = 0;
-	off64_t sector_file_offset                                 = 0;
-	uint64_t block_number                                      = 0;
-	uint32_t block_data_offset                                 = 0;
-	uint32_t sector_range_flags                                = 0;
+	static char *function = "libvhdi_internal_file_get_index_values";
+	int result            = 0;
 
 	if( internal_file == NULL )
 	{
@@ -2147,289 +3061,5355 @@ ssize_t libvhdi_internal_file_read_buffer_from_file_io_handle(
 
 		return( -1 );
 	}
-	if( internal_file->io_handle->bytes_per_sector == 0 )
+	if( index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &( index->file_size ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - invalid IO handle - missing bytes per sector.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
 		 function );
 
 		return( -1 );
 	}
+	index->file_type        = internal_file->io_handle->file_type;
+	index->disk_type        = internal_file->io_handle->disk_type;
+	index->block_size       = internal_file->io_handle->block_size;
+	index->bytes_per_sector = internal_file->io_handle->bytes_per_sector;
+
 	if( internal_file->block_allocation_table != NULL )
 	{
-		if( internal_file->io_handle->block_size == 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid file - invalid IO handle - missing block size.",
-			 function );
+		index->block_allocation_table_offset = internal_file->block_allocation_table->file_offset;
+	}
+	/* For VHDX the data write identifier is used, which changes when the image is modified
+	 */
+	if( internal_file->io_handle->file_type == LIBVHDI_FILE_TYPE_VHDX )
+	{
+		result = libvhdi_image_header_get_data_write_identifier(
+		          internal_file->image_header,
+		          index->identifier,
+		          16,
+		          error );
+	}
+	else
+	{
+		result = libvhdi_file_footer_get_identifier(
+		          internal_file->file_footer,
+		          index->identifier,
+		          16,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identifier.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
 	if( internal_file->io_handle->disk_type == LIBVHDI_DISK_TYPE_DIFFERENTIAL )
 	{
-		if( internal_file->parent_file == NULL )
+		if( internal_file->io_handle->file_type == LIBVHDI_FILE_TYPE_VHDX )
+		{
+			result = libvhdi_metadata_values_get_parent_identifier(
+			          internal_file->metadata_values,
+			          index->parent_identifier,
+			          16,
+			          error );
+		}
+		else
+		{
+			result = libvhdi_dynamic_disk_header_get_parent_identifier(
+			          internal_file->dynamic_disk_header,
+			          index->parent_identifier,
+			          16,
+			          error );
+		}
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid file - missing parent file.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent identifier.",
 			 function );
 
 			return( -1 );
 		}
 	}
-	if( internal_file->current_offset < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid file - invalid IO handle - current offset value out of bounds.",
-		 function );
+	return( 1 );
+}
 
-		return( -1 );
-	}
-	if( buffer == NULL )
+/* Reads the block allocation table entries from the index file on open
+ * Returns 1 if successful, 0 if the index file does not exist or is stale or -1 on error
+ */
+int libvhdi_internal_file_open_read_index(
+     libvhdi_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libvhdi_index_t *index = NULL;
+	static char *function  = "libvhdi_internal_file_open_read_index";
+	int result             = 0;
+
+	if( internal_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid file.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( internal_file->index_filename == NULL )
+	{
+		return( 0 );
+	}
+	if( libvhdi_index_initialize(
+	     &index,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid element data size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( (size64_t) internal_file->current_offset >= internal_file->io_handle->media_size )
+	if( libvhdi_internal_file_get_index_values(
+	     internal_file,
+	     file_io_handle,
+	     index,
+	     error ) != 1 )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index values.",
+		 function );
+
+		goto on_error;
 	}
-	while( buffer_offset < buffer_size )
+	result = libvhdi_index_read_file(
+	          index,
+	          internal_file->block_allocation_table,
+	          internal_file->index_filename,
+	          error );
+
+	if( result == -1 )
 	{
-		read_size = buffer_size - buffer_offset;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index file: %s.",
+		 function,
+		 internal_file->index_filename );
 
-		if( internal_file->block_allocation_table == NULL )
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( result == 0 )
 		{
-			sector_file_offset = internal_file->current_offset;
-			sector_range_flags = 0;
+			libcnotify_printf(
+			 "%s: index file: %s does not exist or is stale.\n",
+			 function,
+			 internal_file->index_filename );
 		}
-		else
-		{
-			block_number       = internal_file->current_offset / internal_file->io_handle->block_size;
-			block_data_offset  = (uint32_t) ( internal_file->current_offset % internal_file->io_handle->block_size );
+	}
+#endif
+	if( libvhdi_index_free(
+	     &index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free index.",
+		 function );
 
-			if( libfdata_vector_get_element_value_by_index(
-			     internal_file->block_descriptors_vector,
-			     (intptr_t *) file_io_handle,
-			     (libfdata_cache_t *) internal_file->block_descriptors_cache,
-			     block_number,
-			     (intptr_t **) &block_descriptor,
-			     0,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve block descriptor: %" PRIu64 ".",
-				 function,
-				 block_number );
+		goto on_error;
+	}
+	return( result );
 
-				return( -1 );
-			}
-			if( block_descriptor == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing block descriptor: %" PRIu64 ".",
-				 function,
-				 block_number );
+on_error:
+	if( index != NULL )
+	{
+		libvhdi_index_free(
+		 &index,
+		 NULL );
+	}
+	return( -1 );
+}
 
-				return( -1 );
-			}
-			if( libvhdi_block_descriptor_get_sector_range_descriptor_at_offset(
-			     block_descriptor,
-			     block_data_offset,
-			     &sector_range_descriptor,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve sector range for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-				 function,
-				 block_data_offset,
-				 block_data_offset );
+/* Retrieves the sector range of a specific block data offset
+ * The range size is the number of bytes from the block data offset to the end of the sector range
+ * This function can be called concurrently, the block cache is protected by its own locks
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_internal_file_get_block_sector_range(
+     libvhdi_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     uint64_t block_number,
+     uint32_t block_data_offset,
+     off64_t *range_file_offset,
+     size_t *range_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	libvhdi_block_descriptor_t *block_descriptor = NULL;
+	static char *function                        = "libvhdi_internal_file_get_block_sector_range";
+	off64_t block_file_offset                    = 0;
+	off64_t sector_bitmap_file_offset            = 0;
+	int result                                   = 0;
+	uint8_t block_state                          = 0;
 
-				return( -1 );
-			}
-			if( sector_range_descriptor == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing sector range descriptor for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-				 function,
-				 function,
-				 block_data_offset,
-				 block_data_offset );
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
 
-				return( -1 );
-			}
-			sector_file_offset = block_descriptor->file_offset;
+		return( -1 );
+	}
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
 
-			if( sector_file_offset > -1 )
-			{
-				sector_file_offset += block_data_offset;
-			}
-			sector_range_flags = sector_range_descriptor->flags;
+		return( -1 );
+	}
+	if( internal_file->block_allocation_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing block allocation table.",
+		 function );
 
-			if( (off64_t) read_size > ( sector_range_descriptor->end_offset - block_data_offset ) )
-			{
-				read_size = (size_t) ( sector_range_descriptor->end_offset - block_data_offset );
-			}
-		}
-		if( ( (size64_t) read_size > internal_file->io_handle->media_size )
-		 || ( (size64_t) internal_file->current_offset > ( internal_file->io_handle->media_size - read_size ) ) )
-		{
-			read_size = (size_t) ( internal_file->io_handle->media_size - internal_file->current_offset );
-		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: requested offset\t\t: %" PRIi64 " (0x%08" PRIx64 ")\n",
-			 function,
-			 internal_file->current_offset,
-			 internal_file->current_offset );
+		return( -1 );
+	}
+	if( block_data_offset >= internal_file->io_handle->block_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block data offset value out of bounds.",
+		 function );
 
-			libcnotify_printf(
-			 "%s: sector file offset\t: %" PRIi64 " (0x%08" PRIx64 ") %s\n",
-			 function,
-			 sector_file_offset,
-			 sector_file_offset,
-			 ( sector_range_flags & LIBFDATA_SECTOR_RANGE_FLAG_IS_UNALLOCATED ) == 0 ? "allocated" : "unallocated" );
+		return( -1 );
+	}
+	if( range_file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range file offset.",
+		 function );
 
-			libcnotify_printf(
-			 "%s: read size\t\t: %" PRIzd "\n",
-			 function,
-			 read_size );
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
 
-			libcnotify_printf(
-			 "\n" );
-		}
-#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
 
-		if( ( sector_range_flags & LIBFDATA_SECTOR_RANGE_FLAG_IS_UNALLOCATED ) == 0 )
+		return( -1 );
+	}
+	if( internal_file->block_allocation_table->block_file_offsets != NULL )
+	{
+		if( libvhdi_block_allocation_table_get_entry_by_index(
+		     internal_file->block_allocation_table,
+		     file_io_handle,
+		     (uint32_t) block_number,
+		     &block_file_offset,
+		     &block_state,
+		     &sector_bitmap_file_offset,
+		     error ) != 1 )
 		{
-			read_count = libbfio_handle_read_buffer_at_offset(
-			              file_io_handle,
-			              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-			              read_size,
-			              sector_file_offset,
-			              error );
-
-			if( read_count != (ssize_t) read_size )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read sector data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-				 function,
-				 sector_file_offset,
-				 sector_file_offset );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block allocation table entry: %" PRIu64 ".",
+			 function,
+			 block_number );
 
-				return( -1 );
-			}
+			return( -1 );
 		}
-		else if( internal_file->parent_file == NULL )
+		if( ( sector_bitmap_file_offset == -1 )
+		 || ( block_state == 6 ) )
 		{
-			/* Sparse block
+			/* The block has no sector bitmap, hence there is no need for a block descriptor
 			 */
-			if( memory_set(
-			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-			     0,
-			     read_size ) == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-				 "%s: unable to set sparse data in buffer.",
-				 function );
+			*range_file_offset = block_file_offset;
 
-				return( -1 );
+			if( block_file_offset > -1 )
+			{
+				*range_file_offset += block_data_offset;
 			}
-		}
-		else
-		{
-			read_count = libvhdi_file_read_buffer_at_offset(
-			              internal_file->parent_file,
-			              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-			              read_size,
-			              internal_file->current_offset,
-			              error );
-
-			if( read_count != (ssize_t) read_size )
+			if( ( internal_file->io_handle->file_type == LIBVHDI_FILE_TYPE_VHD )
+			 || ( block_state < 6 ) )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read data from parent file.",
-				 function );
-
-				return( -1 );
+				*range_flags = LIBFDATA_SECTOR_RANGE_FLAG_IS_UNALLOCATED;
 			}
-		}
-		internal_file->current_offset += read_size;
-
-		buffer_offset += read_size;
+			else
+			{
+				*range_flags = 0;
+			}
+			*range_size = (size_t) ( internal_file->io_handle->block_size - block_data_offset );
 
-		if( (size64_t) internal_file->current_offset >= internal_file->io_handle->media_size )
-		{
-			break;
+			return( 1 );
 		}
 	}
-	return( (ssize_t) buffer_offset );
-}
+	result = libvhdi_block_cache_get_range_at_offset(
+	          internal_file->block_cache,
+	          block_number,
+	          block_data_offset,
+	          range_file_offset,
+	          range_size,
+	          range_flags,
+	          error );
 
-/* Reads (media) data from the current offset into a buffer
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range of block: %" PRIu64 " from cache.",
+		 function,
+		 block_number );
+
+		return( -1 );
+	}
+	if( libvhdi_statistics_add_value(
+	     internal_file->statistics,
+	     result != 0 ? LIBVHDI_STATISTIC_NUMBER_OF_BLOCK_CACHE_HITS : LIBVHDI_STATISTIC_NUMBER_OF_BLOCK_CACHE_MISSES,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add block cache statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 0 )
+	{
+		return( 1 );
+	}
+	/* The block descriptor is read without holding a lock, hence another thread
+	 * can read the same block concurrently, in which case the cache keeps one of them
+	 */
+	if( libvhdi_block_allocation_table_read_block_descriptor(
+	     internal_file->block_allocation_table,
+	     file_io_handle,
+	     (uint32_t) block_number,
+	     &block_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block descriptor: %" PRIu64 ".",
+		 function,
+		 block_number );
+
+		goto on_error;
+	}
+	if( libvhdi_statistics_add_value(
+	     internal_file->statistics,
+	     LIBVHDI_STATISTIC_NUMBER_OF_SECTOR_BITMAP_READS,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add number of sector bitmap reads.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvhdi_block_descriptor_get_range_at_offset(
+	     block_descriptor,
+	     block_data_offset,
+	     range_file_offset,
+	     range_size,
+	     range_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range of block: %" PRIu64 " at offset: %" PRIu32 ".",
+		 function,
+		 block_number,
+		 block_data_offset );
+
+		goto on_error;
+	}
+	if( libvhdi_block_cache_insert_block_descriptor(
+	     internal_file->block_cache,
+	     block_number,
+	     &block_descriptor,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert block descriptor: %" PRIu64 " into cache.",
+		 function,
+		 block_number );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( block_descriptor != NULL )
+	{
+		libvhdi_block_descriptor_free(
+		 &block_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the range of data at a specific offset, resolved in the chain of parent files
+ * The file IO handle of the range is the file IO handle of the file in the chain that stores
+ * the data or NULL if the data is sparse in every file in the chain
+ * The range size is the number of bytes from the offset that are stored in the same file
+ * The range chain level is the level in the chain of the file that stores the data,
+ * where 0 represents the file itself and 1 its parent file
+ * The file IO handle of a parent file is grabbed from the file IO handle pool of the parent file,
+ * so that concurrent reads of the parent file do not share a single file IO handle. If the range
+ * is stored in a parent file, the range file IO handle pool is set and the caller must release
+ * the range file IO handle to it after use. If range_file_io_handle_pool is NULL the file IO handle
+ * of a parent file is released before returning, and the range file IO handle should only be used
+ * to determine where the data is stored
+ * The parent files are accessed directly without grabbing their read/write lock, hence
+ * the parent files should not be closed while the file is in use
+ * This function can be called concurrently with a read lock
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_internal_file_get_chain_range(
+     libvhdi_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     libbfio_handle_t **range_file_io_handle,
+     libvhdi_file_io_handle_pool_t **range_file_io_handle_pool,
+     off64_t *range_file_offset,
+     size_t *range_size,
+     int *range_chain_level,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *chain_file_io_handle                   = NULL;
+	libvhdi_file_io_handle_pool_t *chain_file_io_handle_pool = NULL;
+	libvhdi_internal_file_t *chain_file                      = NULL;
+	static char *function                                    = "libvhdi_internal_file_get_chain_range";
+	size64_t remaining_media_size                            = 0;
+	size_t chain_range_size                                  = 0;
+	size_t safe_range_size                                   = 0;
+	off64_t sector_file_offset                               = 0;
+	uint64_t block_number                                    = 0;
+	uint32_t block_data_offset                               = 0;
+	uint32_t sector_range_flags                              = 0;
+	int chain_level                                          = 0;
+	int result                                               = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= internal_file->io_handle->media_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range file offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_chain_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range chain level.",
+		 function );
+
+		return( -1 );
+	}
+	chain_file           = internal_file;
+	chain_file_io_handle = file_io_handle;
+
+	while( chain_file != NULL )
+	{
+		if( chain_file->io_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid chain file - missing IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( (size64_t) offset >= chain_file->io_handle->media_size )
+		{
+			/* Data beyond the media size of a parent file is sparse
+			 */
+			break;
+		}
+		if( chain_file->block_allocation_table == NULL )
+		{
+			remaining_media_size = chain_file->io_handle->media_size - offset;
+
+			if( remaining_media_size > (size64_t) SSIZE_MAX )
+			{
+				chain_range_size = (size_t) SSIZE_MAX;
+			}
+			else
+			{
+				chain_range_size = (size_t) remaining_media_size;
+			}
+			sector_file_offset = offset;
+			sector_range_flags = 0;
+		}
+		else
+		{
+			if( chain_file->io_handle->block_size == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: invalid chain file - invalid IO handle - missing block size.",
+				 function );
+
+				goto on_error;
+			}
+			block_number      = offset / chain_file->io_handle->block_size;
+			block_data_offset = (uint32_t) ( offset % chain_file->io_handle->block_size );
+
+			if( libvhdi_internal_file_get_block_sector_range(
+			     chain_file,
+			     chain_file_io_handle,
+			     block_number,
+			     block_data_offset,
+			     &sector_file_offset,
+			     &chain_range_size,
+			     &sector_range_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve sector range of block: %" PRIu64 " at offset: %" PRIu32 ".",
+				 function,
+				 block_number,
+				 block_data_offset );
+
+				goto on_error;
+			}
+		}
+		/* The range is limited by the smallest range of the files in the chain
+		 */
+		if( ( safe_range_size == 0 )
+		 || ( chain_range_size < safe_range_size ) )
+		{
+			safe_range_size = chain_range_size;
+		}
+		if( ( sector_range_flags & LIBFDATA_SECTOR_RANGE_FLAG_IS_UNALLOCATED ) == 0 )
+		{
+			if( ( chain_file_io_handle_pool != NULL )
+			 && ( range_file_io_handle_pool == NULL ) )
+			{
+				if( libvhdi_file_io_handle_pool_release_file_io_handle(
+				     chain_file_io_handle_pool,
+				     chain_file_io_handle,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release file IO handle of parent file.",
+					 function );
+
+					return( -1 );
+				}
+				chain_file_io_handle_pool = NULL;
+			}
+			*range_file_io_handle = chain_file_io_handle;
+			*range_file_offset    = sector_file_offset;
+			*range_size           = safe_range_size;
+			*range_chain_level    = chain_level;
+
+			if( range_file_io_handle_pool != NULL )
+			{
+				*range_file_io_handle_pool = chain_file_io_handle_pool;
+			}
+			return( 1 );
+		}
+		if( chain_file->parent_file == NULL )
+		{
+			if( chain_file->io_handle->disk_type == LIBVHDI_DISK_TYPE_DIFFERENTIAL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: invalid chain file - missing parent file.",
+				 function );
+
+				goto on_error;
+			}
+			break;
+		}
+		/* The file IO handle of a parent file is released before the next parent file is accessed,
+		 * hence at most one file IO handle of a parent file is in use by a read at any time
+		 */
+		if( chain_file_io_handle_pool != NULL )
+		{
+			result = libvhdi_file_io_handle_pool_release_file_io_handle(
+			          chain_file_io_handle_pool,
+			          chain_file_io_handle,
+			          error );
+
+			chain_file_io_handle_pool = NULL;
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release file IO handle of parent file.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		chain_file = (libvhdi_internal_file_t *) chain_file->parent_file;
+
+		chain_level++;
+
+		if( chain_file->file_io_handle_pool != NULL )
+		{
+			if( libvhdi_file_io_handle_pool_grab_file_io_handle(
+			     chain_file->file_io_handle_pool,
+			     &chain_file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to grab file IO handle of parent file.",
+				 function );
+
+				return( -1 );
+			}
+			chain_file_io_handle_pool = chain_file->file_io_handle_pool;
+		}
+		else
+		{
+			chain_file_io_handle = chain_file->file_io_handle;
+		}
+		if( chain_file_io_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid parent file - missing file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( chain_file_io_handle_pool != NULL )
+	{
+		if( libvhdi_file_io_handle_pool_release_file_io_handle(
+		     chain_file_io_handle_pool,
+		     chain_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release file IO handle of parent file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*range_file_io_handle = NULL;
+	*range_file_offset    = -1;
+	*range_size           = safe_range_size;
+	*range_chain_level    = chain_level;
+
+	if( range_file_io_handle_pool != NULL )
+	{
+		*range_file_io_handle_pool = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( chain_file_io_handle_pool != NULL )
+	{
+		libvhdi_file_io_handle_pool_release_file_io_handle(
+		 chain_file_io_handle_pool,
+		 chain_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the data of a range retrieved by libvhdi_internal_file_get_chain_range into a buffer
+ * If the range file IO handle pool is set the range file IO handle is released to it, also on error
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvhdi_internal_file_read_range_data(
+         libvhdi_internal_file_t *internal_file,
+         libbfio_handle_t *range_file_io_handle,
+         libvhdi_file_io_handle_pool_t *range_file_io_handle_pool,
+         off64_t range_file_offset,
+         int range_chain_level,
+         uint8_t *buffer,
+         size_t read_size,
+         libcerror_error_t **error )
+{
+	static char *function    = "libvhdi_internal_file_read_range_data";
+	ssize_t read_count       = 0;
+	uint64_t start_timestamp = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		goto on_error;
+	}
+	if( range_chain_level > 0 )
+	{
+		if( libvhdi_statistics_add_parent_read(
+		     internal_file->statistics,
+		     range_chain_level,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add parent read statistics.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvhdi_statistics_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              range_file_io_handle,
+	              buffer,
+	              read_size,
+	              range_file_offset,
+	              error );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sector data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 range_file_offset,
+		 range_file_offset );
+
+		goto on_error;
+	}
+	if( range_file_io_handle_pool != NULL )
+	{
+		if( libvhdi_file_io_handle_pool_release_file_io_handle(
+		     range_file_io_handle_pool,
+		     range_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release file IO handle of parent file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libvhdi_statistics_add_file_read(
+	     internal_file->statistics,
+	     read_size,
+	     start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add file read statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+
+on_error:
+	if( range_file_io_handle_pool != NULL )
+	{
+		libvhdi_file_io_handle_pool_release_file_io_handle(
+		 range_file_io_handle_pool,
+		 range_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data at a specific offset into a buffer using a Basic File IO (bfio) handle
+ * This function does not change the current offset and can be called concurrently
+ * with a read lock, as long as the file IO handle supports concurrent reads
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvhdi_internal_file_read_buffer_at_offset_from_file_io_handle(
+         libvhdi_internal_file_t *internal_file,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbfio_handle_t *range_file_io_handle                   = NULL;
+	libvhdi_file_io_handle_pool_t *range_file_io_handle_pool = NULL;
+	static char *function                                    = "libvhdi_internal_file_read_buffer_at_offset_from_file_io_handle";
+	size_t buffer_offset                                     = 0;
+	size_t range_size                                        = 0;
+	size_t read_size                                         = 0;
+	ssize_t read_count                                       = 0;
+	off64_t range_file_offset                                = 0;
+	int range_chain_level                                    = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - invalid IO handle - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->block_allocation_table != NULL )
+	{
+		if( internal_file->io_handle->block_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid file - invalid IO handle - missing block size.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_file->io_handle->disk_type == LIBVHDI_DISK_TYPE_DIFFERENTIAL )
+	{
+		if( internal_file->parent_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid file - missing parent file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid element data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_file->io_handle->media_size )
+	{
+		return( 0 );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		read_size = buffer_size - buffer_offset;
+
+		if( libvhdi_internal_file_get_chain_range(
+		     internal_file,
+		     file_io_handle,
+		     offset,
+		     &range_file_io_handle,
+		     &range_file_io_handle_pool,
+		     &range_file_offset,
+		     &range_size,
+		     &range_chain_level,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		if( read_size > range_size )
+		{
+			read_size = range_size;
+		}
+		if( ( (size64_t) read_size > internal_file->io_handle->media_size )
+		 || ( (size64_t) offset > ( internal_file->io_handle->media_size - read_size ) ) )
+		{
+			read_size = (size_t) ( internal_file->io_handle->media_size - offset );
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: requested offset\t\t: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 offset,
+			 offset );
+
+			libcnotify_printf(
+			 "%s: range file offset\t: %" PRIi64 " (0x%08" PRIx64 ") %s\n",
+			 function,
+			 range_file_offset,
+			 range_file_offset,
+			 range_file_io_handle == NULL ? "sparse" : ( range_file_io_handle == file_io_handle ? "allocated" : "allocated in parent" ) );
+
+			libcnotify_printf(
+			 "%s: read size\t\t: %" PRIzd "\n",
+			 function,
+			 read_size );
+
+			libcnotify_printf(
+			 "\n" );
+		}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+		if( range_file_io_handle != NULL )
+		{
+			read_count = libvhdi_internal_file_read_range_data(
+			              internal_file,
+			              range_file_io_handle,
+			              range_file_io_handle_pool,
+			              range_file_offset,
+			              range_chain_level,
+			              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			              read_size,
+			              error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read range data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			/* The data is sparse in every file in the chain
+			 */
+			if( memory_set(
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     0,
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to set sparse data in buffer.",
+				 function );
+
+				return( -1 );
+			}
+			if( libvhdi_statistics_add_value(
+			     internal_file->statistics,
+			     LIBVHDI_STATISTIC_SPARSE_SIZE,
+			     (uint64_t) read_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add sparse size statistics.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		offset        += read_size;
+		buffer_offset += read_size;
+
+		if( (size64_t) offset >= internal_file->io_handle->media_size )
+		{
+			break;
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Reads (media) data at a specific offset via the data cache using a Basic File IO (bfio) handle
+ * Segments that are not cached are read in full and inserted into the data cache
+ * This function can be called concurrently with a read lock, the data cache is protected by its own locks
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvhdi_internal_file_read_buffer_at_offset_from_data_cache(
+         libvhdi_internal_file_t *internal_file,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	uint8_t *segment_data      = NULL;
+	uint8_t *read_buffer       = NULL;
+	static char *function      = "libvhdi_internal_file_read_buffer_at_offset_from_data_cache";
+	size64_t segment_data_size = 0;
+	size_t buffer_offset       = 0;
+	size_t cached_read_size    = 0;
+	size_t read_size           = 0;
+	size_t segment_data_offset = 0;
+	size_t segment_size        = 0;
+	ssize_t read_count         = 0;
+	uint64_t segment_index     = 0;
+	off64_t segment_offset     = 0;
+	int result                 = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->data_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing data cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_file->io_handle->media_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) buffer_size > ( internal_file->io_handle->media_size - offset ) )
+	{
+		buffer_size = (size_t) ( internal_file->io_handle->media_size - offset );
+	}
+	segment_size = internal_file->data_cache->segment_size;
+
+	while( buffer_offset < buffer_size )
+	{
+		segment_index       = (uint64_t) offset / segment_size;
+		segment_data_offset = (size_t) ( (uint64_t) offset % segment_size );
+		read_size           = segment_size - segment_data_offset;
+
+		if( read_size > ( buffer_size - buffer_offset ) )
+		{
+			read_size = buffer_size - buffer_offset;
+		}
+		result = libvhdi_data_cache_read_segment_data(
+		          internal_file->data_cache,
+		          segment_index,
+		          segment_data_offset,
+		          &( buffer[ buffer_offset ] ),
+		          read_size,
+		          &cached_read_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read segment: %" PRIu64 " data from data cache.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		else if( ( result == 0 )
+		      || ( cached_read_size == 0 ) )
+		{
+			segment_offset    = (off64_t) ( segment_index * segment_size );
+			segment_data_size = internal_file->io_handle->media_size - segment_offset;
+
+			if( segment_data_size > (size64_t) segment_size )
+			{
+				segment_data_size = (size64_t) segment_size;
+			}
+			/* A segment that is read in full is read directly into the buffer
+			 */
+			if( ( segment_data_offset == 0 )
+			 && ( (size64_t) read_size == segment_data_size ) )
+			{
+				read_buffer = &( buffer[ buffer_offset ] );
+			}
+			else
+			{
+				if( segment_data == NULL )
+				{
+					segment_data = (uint8_t *) memory_allocate(
+					                            sizeof( uint8_t ) * segment_size );
+
+					if( segment_data == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+						 "%s: unable to create segment data.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				read_buffer = segment_data;
+			}
+			read_count = libvhdi_internal_file_read_buffer_at_offset_from_file_io_handle(
+			              internal_file,
+			              file_io_handle,
+			              read_buffer,
+			              (size_t) segment_data_size,
+			              segment_offset,
+			              error );
+
+			if( read_count != (ssize_t) segment_data_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read segment: %" PRIu64 " data.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+			if( libvhdi_data_cache_insert_segment_data(
+			     internal_file->data_cache,
+			     segment_index,
+			     read_buffer,
+			     (size_t) segment_data_size,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert segment: %" PRIu64 " data into data cache.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+			if( read_buffer == segment_data )
+			{
+				if( memory_copy(
+				     &( buffer[ buffer_offset ] ),
+				     &( segment_data[ segment_data_offset ] ),
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy segment: %" PRIu64 " data.",
+					 function,
+					 segment_index );
+
+					goto on_error;
+				}
+			}
+		}
+		else
+		{
+			read_size = cached_read_size;
+		}
+		offset        += read_size;
+		buffer_offset += read_size;
+	}
+	if( segment_data != NULL )
+	{
+		memory_free(
+		 segment_data );
+	}
+	return( (ssize_t) buffer_offset );
+
+on_error:
+	if( segment_data != NULL )
+	{
+		memory_free(
+		 segment_data );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+
+/* Reads (media) data at a specific offset on behalf of the read-ahead
+ * The file is not locked, the read-ahead is flushed or freed before
+ * the block allocation table, block cache or parent file are changed
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvhdi_internal_file_read_ahead_read_data(
+         intptr_t *data_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle       = NULL;
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_internal_file_read_ahead_read_data";
+	ssize_t read_count                     = 0;
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) data_handle;
+
+	if( libvhdi_file_io_handle_pool_grab_file_io_handle(
+	     internal_file->file_io_handle_pool,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab file IO handle from pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->data_cache != NULL )
+	{
+		read_count = libvhdi_internal_file_read_buffer_at_offset_from_data_cache(
+			      internal_file,
+			      file_io_handle,
+			      buffer,
+			      buffer_size,
+			      offset,
+			      error );
+	}
+	else
+	{
+		read_count = libvhdi_internal_file_read_buffer_at_offset_from_file_io_handle(
+			      internal_file,
+			      file_io_handle,
+			      buffer,
+			      buffer_size,
+			      offset,
+			      error );
+	}
+
+	if( libvhdi_file_io_handle_pool_release_file_io_handle(
+	     internal_file->file_io_handle_pool,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release file IO handle to pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+#endif /* defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT ) */
+
+/* Reads (media) data at a specific offset
+ * The data is read via the read-ahead if enabled
+ * This function is not multi-thread safe acquire a read or write lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvhdi_internal_file_read_buffer_at_offset(
+         libvhdi_internal_file_t *internal_file,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libvhdi_internal_file_read_buffer_at_offset";
+	ssize_t read_count               = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( internal_file->read_ahead != NULL )
+	{
+		read_count = libvhdi_read_ahead_read_buffer(
+		              internal_file->read_ahead,
+		              (uint8_t *) buffer,
+		              buffer_size,
+		              offset,
+		              error );
+	}
+	else
+#endif
+	{
+		if( libvhdi_file_io_handle_pool_grab_file_io_handle(
+		     internal_file->file_io_handle_pool,
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab file IO handle from pool.",
+			 function );
+
+			return( -1 );
+		}
+		if( internal_file->data_cache != NULL )
+		{
+			read_count = libvhdi_internal_file_read_buffer_at_offset_from_data_cache(
+				      internal_file,
+				      file_io_handle,
+				      (uint8_t *) buffer,
+				      buffer_size,
+				      offset,
+				      error );
+		}
+		else
+		{
+			read_count = libvhdi_internal_file_read_buffer_at_offset_from_file_io_handle(
+				      internal_file,
+				      file_io_handle,
+				      buffer,
+				      buffer_size,
+				      offset,
+				      error );
+		}
+		if( libvhdi_file_io_handle_pool_release_file_io_handle(
+		     internal_file->file_io_handle_pool,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release file IO handle to pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	if( libvhdi_statistics_add_value(
+	     internal_file->statistics,
+	     LIBVHDI_STATISTIC_NUMBER_OF_READS,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add number of reads statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_statistics_add_value(
+	     internal_file->statistics,
+	     LIBVHDI_STATISTIC_READ_SIZE,
+	     (uint64_t) read_count,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add read size statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads (media) data from the current offset into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvhdi_file_read_buffer(
+         libvhdi_file_t *file,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_read_buffer";
+	ssize_t read_count                     = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libvhdi_internal_file_read_buffer_at_offset(
+		      internal_file,
+		      buffer,
+		      buffer_size,
+		      internal_file->current_offset,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+	else
+	{
+		internal_file->current_offset += (off64_t) read_count;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (media) data at a specific offset
+ * This function does not change the current offset and can be called by multiple threads concurrently
  * Returns the number of bytes read or -1 on error
  */
-ssize_t libvhdi_file_read_buffer(
-         libvhdi_file_t *file,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+ssize_t libvhdi_file_read_buffer_at_offset(
+         libvhdi_file_t *file,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_read_buffer_at_offset";
+	ssize_t read_count                     = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libvhdi_internal_file_read_buffer_at_offset(
+		      internal_file,
+		      buffer,
+		      buffer_size,
+		      offset,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (media) data at multiple offsets into buffers using a Basic File IO (bfio) handle
+ * All the requests are first resolved against the block allocation table, after which
+ * the sector data is read in order of file offset, where sector data that is stored
+ * adjacent in the file is read with a single read
+ * This function does not change the current offset and can be called concurrently
+ * with a read lock, as long as the file IO handle supports concurrent reads
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_internal_file_read_buffers_at_offsets_from_file_io_handle(
+     libvhdi_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     void **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *range_file_io_handle                   = NULL;
+	libvhdi_file_io_handle_pool_t *range_file_io_handle_pool = NULL;
+	libvhdi_read_segment_t *last_read_segment                = NULL;
+	libvhdi_read_segment_t *read_segment                     = NULL;
+	libvhdi_read_segment_t *read_segments                    = NULL;
+	uint8_t *buffer                                          = NULL;
+	uint8_t *coalesced_data                                  = NULL;
+	void *reallocation                                       = NULL;
+	static char *function                                    = "libvhdi_internal_file_read_buffers_at_offsets_from_file_io_handle";
+	size_t buffer_offset                                     = 0;
+	size_t buffer_size                                       = 0;
+	size_t coalesced_size                                    = 0;
+	size_t range_size                                        = 0;
+	size_t read_segment_end_offset                           = 0;
+	size_t read_size                                         = 0;
+	ssize_t read_count                                       = 0;
+	off64_t coalesced_file_offset                            = 0;
+	off64_t offset                                           = 0;
+	off64_t range_file_offset                                = 0;
+	uint64_t start_timestamp                                 = 0;
+	int buffer_index                                         = 0;
+	int first_read_segment_index                             = 0;
+	int is_contiguous                                        = 0;
+	int maximum_number_of_read_segments                      = 0;
+	int number_of_read_segments                              = 0;
+	int range_chain_level                                    = 0;
+	int read_segment_index                                   = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->block_allocation_table != NULL )
+	{
+		if( internal_file->io_handle->block_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid file - invalid IO handle - missing block size.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_file->io_handle->disk_type == LIBVHDI_DISK_TYPE_DIFFERENTIAL )
+	{
+		if( internal_file->parent_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid file - missing parent file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_counts == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read counts.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buffers < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of buffers value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	/* Resolve the requests into read segments of allocated sector data
+	 * sparse data and data stored in the parent file is handled directly
+	 */
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		buffer      = (uint8_t *) buffers[ buffer_index ];
+		buffer_size = buffer_sizes[ buffer_index ];
+		offset      = offsets[ buffer_index ];
+
+		if( buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid buffer: %d.",
+			 function,
+			 buffer_index );
+
+			goto on_error;
+		}
+		if( buffer_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid buffer: %d size value exceeds maximum.",
+			 function,
+			 buffer_index );
+
+			goto on_error;
+		}
+		if( offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid offset: %d value out of bounds.",
+			 function,
+			 buffer_index );
+
+			goto on_error;
+		}
+		if( (size64_t) offset >= internal_file->io_handle->media_size )
+		{
+			read_counts[ buffer_index ] = 0;
+
+			continue;
+		}
+		if( (size64_t) buffer_size > ( internal_file->io_handle->media_size - offset ) )
+		{
+			buffer_size = (size_t) ( internal_file->io_handle->media_size - offset );
+		}
+		buffer_offset = 0;
+
+		while( buffer_offset < buffer_size )
+		{
+			read_size = buffer_size - buffer_offset;
+
+			if( libvhdi_internal_file_get_chain_range(
+			     internal_file,
+			     file_io_handle,
+			     offset,
+			     &range_file_io_handle,
+			     &range_file_io_handle_pool,
+			     &range_file_offset,
+			     &range_size,
+			     &range_chain_level,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
+
+				goto on_error;
+			}
+			if( read_size > range_size )
+			{
+				read_size = range_size;
+			}
+			if( range_file_io_handle == file_io_handle )
+			{
+				if( number_of_read_segments >= maximum_number_of_read_segments )
+				{
+					if( maximum_number_of_read_segments == 0 )
+					{
+						maximum_number_of_read_segments = number_of_buffers;
+					}
+					else
+					{
+						maximum_number_of_read_segments *= 2;
+					}
+					if( (size_t) maximum_number_of_read_segments > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libvhdi_read_segment_t ) ) )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+						 "%s: invalid maximum number of read segments value exceeds maximum.",
+						 function );
+
+						goto on_error;
+					}
+					reallocation = memory_reallocate(
+					                read_segments,
+					                sizeof( libvhdi_read_segment_t ) * maximum_number_of_read_segments );
+
+					if( reallocation == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+						 "%s: unable to resize read segments.",
+						 function );
+
+						goto on_error;
+					}
+					read_segments = (libvhdi_read_segment_t *) reallocation;
+				}
+				read_segment = &( read_segments[ number_of_read_segments++ ] );
+
+				read_segment->file_offset = range_file_offset;
+				read_segment->size        = read_size;
+				read_segment->buffer      = &( buffer[ buffer_offset ] );
+			}
+			else if( range_file_io_handle != NULL )
+			{
+				/* The data is stored in a parent file
+				 */
+				read_count = libvhdi_internal_file_read_range_data(
+				              internal_file,
+				              range_file_io_handle,
+				              range_file_io_handle_pool,
+				              range_file_offset,
+				              range_chain_level,
+				              &( buffer[ buffer_offset ] ),
+				              read_size,
+				              error );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read sector data from parent file at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 range_file_offset,
+					 range_file_offset );
+
+					goto on_error;
+				}
+			}
+			else
+			{
+				/* The data is sparse in every file in the chain
+				 */
+				if( memory_set(
+				     &( buffer[ buffer_offset ] ),
+				     0,
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to set sparse data in buffer: %d.",
+					 function,
+					 buffer_index );
+
+					goto on_error;
+				}
+				if( libvhdi_statistics_add_value(
+				     internal_file->statistics,
+				     LIBVHDI_STATISTIC_SPARSE_SIZE,
+				     (uint64_t) read_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to add sparse size statistics.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			offset        += read_size;
+			buffer_offset += read_size;
+		}
+		read_counts[ buffer_index ] = (ssize_t) buffer_size;
+	}
+	if( number_of_read_segments > 1 )
+	{
+		qsort(
+		 read_segments,
+		 (size_t) number_of_read_segments,
+		 sizeof( libvhdi_read_segment_t ),
+		 &libvhdi_read_segment_compare_by_file_offset );
+	}
+	/* Coalesce read segments that are adjacent or overlapping in the file
+	 */
+	read_segment_index = 0;
+
+	while( read_segment_index < number_of_read_segments )
+	{
+		first_read_segment_index = read_segment_index;
+		last_read_segment        = &( read_segments[ read_segment_index ] );
+		coalesced_file_offset    = last_read_segment->file_offset;
+		coalesced_size           = last_read_segment->size;
+		is_contiguous            = 1;
+
+		read_segment_index++;
+
+		while( ( read_segment_index < number_of_read_segments )
+		    && ( coalesced_size <= LIBVHDI_MAXIMUM_COALESCED_READ_SIZE ) )
+		{
+			read_segment = &( read_segments[ read_segment_index ] );
+
+			if( read_segment->file_offset > ( coalesced_file_offset + (off64_t) coalesced_size ) )
+			{
+				break;
+			}
+			read_segment_end_offset = (size_t) ( read_segment->file_offset - coalesced_file_offset ) + read_segment->size;
+
+			if( read_segment_end_offset > LIBVHDI_MAXIMUM_COALESCED_READ_SIZE )
+			{
+				break;
+			}
+			/* Segments that are also adjacent in memory can be read directly into the buffer
+			 */
+			if( ( read_segment->file_offset != ( last_read_segment->file_offset + (off64_t) last_read_segment->size ) )
+			 || ( read_segment->buffer != &( last_read_segment->buffer[ last_read_segment->size ] ) ) )
+			{
+				is_contiguous = 0;
+			}
+			if( read_segment_end_offset > coalesced_size )
+			{
+				coalesced_size = read_segment_end_offset;
+			}
+			last_read_segment = read_segment;
+
+			read_segment_index++;
+		}
+		if( libvhdi_statistics_get_timestamp(
+		     &start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			goto on_error;
+		}
+		if( is_contiguous != 0 )
+		{
+			read_count = libbfio_handle_read_buffer_at_offset(
+			              file_io_handle,
+			              read_segments[ first_read_segment_index ].buffer,
+			              coalesced_size,
+			              coalesced_file_offset,
+			              error );
+		}
+		else
+		{
+			if( coalesced_data == NULL )
+			{
+				coalesced_data = (uint8_t *) memory_allocate(
+				                              sizeof( uint8_t ) * LIBVHDI_MAXIMUM_COALESCED_READ_SIZE );
+
+				if( coalesced_data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create coalesced data.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			read_count = libbfio_handle_read_buffer_at_offset(
+			              file_io_handle,
+			              coalesced_data,
+			              coalesced_size,
+			              coalesced_file_offset,
+			              error );
+		}
+		if( read_count != (ssize_t) coalesced_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sector data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 coalesced_file_offset,
+			 coalesced_file_offset );
+
+			goto on_error;
+		}
+		if( libvhdi_statistics_add_file_read(
+		     internal_file->statistics,
+		     coalesced_size,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add file read statistics.",
+			 function );
+
+			goto on_error;
+		}
+		if( is_contiguous == 0 )
+		{
+			while( first_read_segment_index < read_segment_index )
+			{
+				read_segment = &( read_segments[ first_read_segment_index++ ] );
+
+				if( memory_copy(
+				     read_segment->buffer,
+				     &( coalesced_data[ read_segment->file_offset - coalesced_file_offset ] ),
+				     read_segment->size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy sector data.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+	}
+	if( coalesced_data != NULL )
+	{
+		memory_free(
+		 coalesced_data );
+	}
+	if( read_segments != NULL )
+	{
+		memory_free(
+		 read_segments );
+	}
+	return( 1 );
+
+on_error:
+	if( coalesced_data != NULL )
+	{
+		memory_free(
+		 coalesced_data );
+	}
+	if( read_segments != NULL )
+	{
+		memory_free(
+		 read_segments );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data at multiple offsets into buffers using a file IO handle from the pool
+ * If the data cache is enabled the buffers are read via the data cache
+ * This function is not multi-thread safe acquire a read or write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_internal_file_read_buffers_at_offsets(
+     libvhdi_internal_file_t *internal_file,
+     void **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libvhdi_internal_file_read_buffers_at_offsets";
+	ssize_t read_count               = 0;
+	int buffer_index                 = 0;
+	int result                       = 1;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_file_io_handle_pool_grab_file_io_handle(
+	     internal_file->file_io_handle_pool,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab file IO handle from pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->data_cache != NULL )
+	{
+		if( ( buffers == NULL )
+		 || ( buffer_sizes == NULL )
+		 || ( offsets == NULL )
+		 || ( read_counts == NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid buffers, buffer sizes, offsets or read counts.",
+			 function );
+
+			result = -1;
+		}
+		for( buffer_index = 0;
+		     ( result == 1 ) && ( buffer_index < number_of_buffers );
+		     buffer_index++ )
+		{
+			read_count = libvhdi_internal_file_read_buffer_at_offset_from_data_cache(
+			              internal_file,
+			              file_io_handle,
+			              (uint8_t *) buffers[ buffer_index ],
+			              buffer_sizes[ buffer_index ],
+			              offsets[ buffer_index ],
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer: %d.",
+				 function,
+				 buffer_index );
+
+				result = -1;
+			}
+			else
+			{
+				read_counts[ buffer_index ] = read_count;
+			}
+		}
+	}
+	else if( libvhdi_internal_file_read_buffers_at_offsets_from_file_io_handle(
+	          internal_file,
+	          file_io_handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          number_of_buffers,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffers.",
+		 function );
+
+		result = -1;
+	}
+	if( libvhdi_file_io_handle_pool_release_file_io_handle(
+	     internal_file->file_io_handle_pool,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release file IO handle to pool.",
+		 function );
+
+		return( -1 );
+	}
+	for( buffer_index = 0;
+	     ( result == 1 ) && ( buffer_index < number_of_buffers );
+	     buffer_index++ )
+	{
+		if( libvhdi_statistics_add_value(
+		     internal_file->statistics,
+		     LIBVHDI_STATISTIC_NUMBER_OF_READS,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add number of reads statistics.",
+			 function );
+
+			result = -1;
+		}
+		else if( libvhdi_statistics_add_value(
+		          internal_file->statistics,
+		          LIBVHDI_STATISTIC_READ_SIZE,
+		          (uint64_t) read_counts[ buffer_index ],
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add read size statistics.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Reads (media) data at multiple offsets into buffers
+ * The read count of every buffer is stored in read_counts, which is 0 for an offset beyond the media size
+ * This function does not change the current offset and can be called by multiple threads concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_file_read_buffers_at_offsets(
+     libvhdi_file_t *file,
+     void **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_read_buffers_at_offsets";
+	int result                             = 1;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvhdi_internal_file_read_buffers_at_offsets(
+	     internal_file,
+	     buffers,
+	     buffer_sizes,
+	     offsets,
+	     read_counts,
+	     number_of_buffers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffers.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads (media) data at multiple offsets on behalf of the read queue
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_internal_file_read_queue_read_buffers(
+     intptr_t *data_handle,
+     void **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_internal_file_read_queue_read_buffers";
+	int result                             = 1;
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) data_handle;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		result = -1;
+	}
+	else if( libvhdi_internal_file_read_buffers_at_offsets(
+	          internal_file,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          number_of_buffers,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffers.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the file offset of (media) data on behalf of the read queue
+ * The data is only read by the read queue using the file offset if it is stored contiguously
+ * in the file itself, hence not if it is sparse, stored in a parent file or updated by the VHDX log
+ * Returns 1 if successful, 0 if the data is not stored contiguously in the file or -1 on error
+ */
+int libvhdi_internal_file_read_queue_get_file_range(
+     intptr_t *data_handle,
+     off64_t offset,
+     size_t size,
+     off64_t *file_offset,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *range_file_io_handle = NULL;
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_internal_file_read_queue_get_file_range";
+	size_t range_size                      = 0;
+	off64_t range_file_offset              = 0;
+	int range_chain_level                  = 0;
+	int result                             = 0;
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) data_handle;
+
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_file->io_handle != NULL )
+	 && ( internal_file->file_io_handle != NULL )
+	 && ( internal_file->log == NULL )
+	 && ( (size64_t) offset < internal_file->io_handle->media_size )
+	 && ( size <= ( internal_file->io_handle->media_size - (size64_t) offset ) ) )
+	{
+		result = libvhdi_internal_file_get_chain_range(
+		          internal_file,
+		          internal_file->file_io_handle,
+		          offset,
+		          &range_file_io_handle,
+		          NULL,
+		          &range_file_offset,
+		          &range_size,
+		          &range_chain_level,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			result = -1;
+		}
+		else if( ( range_file_io_handle != internal_file->file_io_handle )
+		      || ( size > range_size ) )
+		{
+			result = 0;
+		}
+		else
+		{
+			*file_offset = range_file_offset;
+		}
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Submits a read of (media) data at a specific offset
+ * If the file was opened using libvhdi_file_open and the data is stored contiguously in the file,
+ * the read is queued on an io_uring, if supported, which submits the queued reads to the kernel in batches.
+ * Otherwise the read is performed asynchronously by a pool of threads, where read requests that are
+ * pending at the same time are read in batches. Without multi-thread support the read is performed
+ * before this function returns
+ * The completion of the read is retrieved with libvhdi_file_poll_read_completions
+ * The buffer must remain available until the completion of the read was retrieved
+ * This function does not change the current offset and can be called by multiple threads concurrently
+ * Returns 1 if successful, 0 if the maximum number of outstanding reads was reached or -1 on error
+ */
+int libvhdi_file_submit_read_buffer_at_offset(
+     libvhdi_file_t *file,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     uint64_t request_identifier,
+     libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_submit_read_buffer_at_offset";
+	int result                             = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvhdi_read_queue_push_request(
+	          internal_file->read_queue,
+	          buffer,
+	          buffer_size,
+	          offset,
+	          request_identifier,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to submit read at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the completions of submitted reads
+ * The request identifier and read count of every completed read are stored in request_identifiers
+ * and read_counts, where the read count is -1 if the read failed and 0 for an offset beyond the media size
+ * If wait for completion is set and no reads have completed this function waits until a submitted
+ * read completes, unless there are no outstanding reads
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_file_poll_read_completions(
+     libvhdi_file_t *file,
+     uint64_t *request_identifiers,
+     ssize_t *read_counts,
+     int maximum_number_of_completions,
+     int *number_of_completions,
+     uint8_t wait_for_completion,
+     libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_poll_read_completions";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( libvhdi_read_queue_pop_completions(
+	     internal_file->read_queue,
+	     request_identifiers,
+	     read_counts,
+	     maximum_number_of_completions,
+	     number_of_completions,
+	     wait_for_completion,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve read completions.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a read-only pointer to the (media) data at a specific offset
+ * This requires the file to be opened with LIBVHDI_ACCESS_FLAG_MEMORY_MAP using libvhdi_file_open
+ * The data size is the number of bytes from the offset, up to size, that are stored contiguously in the file
+ * The data is not available if it is sparse, stored in a parent file or updated by the VHDX log,
+ * in which case it should be read using libvhdi_file_read_buffer_at_offset instead
+ * The data pointer remains valid until the file is closed
+ * Returns 1 if successful, 0 if the data is not available or -1 on error
+ */
+int libvhdi_file_get_data_pointer(
+     libvhdi_file_t *file,
+     off64_t offset,
+     size_t size,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *range_file_io_handle = NULL;
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_get_data_pointer";
+	size_t range_size                      = 0;
+	off64_t range_file_offset              = 0;
+	int range_chain_level                  = 0;
+	int result                             = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	*data      = NULL;
+	*data_size = 0;
+
+	if( size == 0 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* The memory mapped data does not contain the updates of the log
+	 */
+	if( ( internal_file->memory_map != NULL )
+	 && ( internal_file->log == NULL )
+	 && ( (size64_t) offset < internal_file->io_handle->media_size ) )
+	{
+		result = libvhdi_internal_file_get_chain_range(
+		          internal_file,
+		          internal_file->file_io_handle,
+		          offset,
+		          &range_file_io_handle,
+		          NULL,
+		          &range_file_offset,
+		          &range_size,
+		          &range_chain_level,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			result = -1;
+		}
+		else if( range_file_io_handle != internal_file->file_io_handle )
+		{
+			/* The data is sparse or stored in a parent file
+			 */
+			result = 0;
+		}
+		else
+		{
+			if( size > range_size )
+			{
+				size = range_size;
+			}
+			result = libvhdi_memory_map_get_data(
+			          internal_file->memory_map,
+			          range_file_offset,
+			          size,
+			          data,
+			          data_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve mapped data at file offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 range_file_offset,
+				 range_file_offset );
+			}
+		}
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the mapped range of the (media) data at a specific offset
+ * The mapped range is the range in the file, in the chain of parent files, that stores the data
+ * The chain level is the level in the chain of that file, where 0 represents the file itself and 1 its parent file
+ * The mapped size is the number of bytes from the offset, up to size, that are stored contiguously in that file
+ * The data is not mapped if it is sparse or updated by the VHDX log,
+ * in which case it should be read using libvhdi_file_read_buffer_at_offset instead
+ * Returns 1 if successful, 0 if the data is not mapped or -1 on error
+ */
+int libvhdi_file_get_mapped_range(
+     libvhdi_file_t *file,
+     off64_t offset,
+     size_t size,
+     int *chain_level,
+     off64_t *mapped_file_offset,
+     size_t *mapped_size,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *range_file_io_handle = NULL;
+	libvhdi_internal_file_t *chain_file    = NULL;
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_get_mapped_range";
+	size_t range_size                      = 0;
+	off64_t range_file_offset              = 0;
+	int chain_file_level                   = 0;
+	int range_chain_level                  = 0;
+	int result                             = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( chain_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chain level.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapped_file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped file offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapped_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped size.",
+		 function );
+
+		return( -1 );
+	}
+	*chain_level        = 0;
+	*mapped_file_offset = 0;
+	*mapped_size        = 0;
+
+	if( ( size == 0 )
+	 || ( (size64_t) offset >= internal_file->io_handle->media_size ) )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvhdi_internal_file_get_chain_range(
+	          internal_file,
+	          internal_file->file_io_handle,
+	          offset,
+	          &range_file_io_handle,
+	          NULL,
+	          &range_file_offset,
+	          &range_size,
+	          &range_chain_level,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		result = -1;
+	}
+	else if( range_file_io_handle == NULL )
+	{
+		/* The data is sparse in every file in the chain
+		 */
+		result = 0;
+	}
+	else
+	{
+		chain_file = internal_file;
+
+		for( chain_file_level = 0;
+		     chain_file_level < range_chain_level;
+		     chain_file_level++ )
+		{
+			chain_file = (libvhdi_internal_file_t *) chain_file->parent_file;
+		}
+		/* The data in the file does not contain the updates of the log
+		 */
+		if( chain_file->log != NULL )
+		{
+			result = 0;
+		}
+		else
+		{
+			if( size > range_size )
+			{
+				size = range_size;
+			}
+			*chain_level        = range_chain_level;
+			*mapped_file_offset = range_file_offset;
+			*mapped_size        = size;
+		}
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the extent at a specific offset
+ * The extent starts at the offset and contains the following data of the same type,
+ * which is determined from the block allocation table and sector bitmaps without reading the data
+ * This function can be called concurrently with a read lock
+ * Returns 1 if successful, 0 if the offset is beyond the media size or -1 on error
+ */
+int libvhdi_internal_file_get_extent_at_offset(
+     libvhdi_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error )
+{
+	static char *function       = "libvhdi_internal_file_get_extent_at_offset";
+	size64_t safe_extent_size   = 0;
+	size_t range_size           = 0;
+	off64_t sector_file_offset  = 0;
+	uint64_t block_number       = 0;
+	uint32_t block_data_offset  = 0;
+	uint32_t range_extent_flags = 0;
+	uint32_t safe_extent_flags  = 0;
+	uint32_t sector_range_flags = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->block_allocation_table != NULL )
+	{
+		if( internal_file->io_handle->block_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid file - invalid IO handle - missing block size.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent size.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_file->io_handle->media_size )
+	{
+		return( 0 );
+	}
+	if( internal_file->block_allocation_table == NULL )
+	{
+		*extent_size  = internal_file->io_handle->media_size - offset;
+		*extent_flags = 0;
+
+		return( 1 );
+	}
+	while( (size64_t) offset < internal_file->io_handle->media_size )
+	{
+		block_number      = offset / internal_file->io_handle->block_size;
+		block_data_offset = (uint32_t) ( offset % internal_file->io_handle->block_size );
+
+		if( libvhdi_internal_file_get_block_sector_range(
+		     internal_file,
+		     file_io_handle,
+		     block_number,
+		     block_data_offset,
+		     &sector_file_offset,
+		     &range_size,
+		     &sector_range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sector range of block: %" PRIu64 " at offset: %" PRIu32 ".",
+			 function,
+			 block_number,
+			 block_data_offset );
+
+			return( -1 );
+		}
+		if( ( sector_range_flags & LIBFDATA_SECTOR_RANGE_FLAG_IS_UNALLOCATED ) == 0 )
+		{
+			range_extent_flags = 0;
+		}
+		else if( internal_file->parent_file == NULL )
+		{
+			range_extent_flags = LIBVHDI_EXTENT_FLAG_IS_SPARSE;
+		}
+		else
+		{
+			range_extent_flags = LIBVHDI_EXTENT_FLAG_IS_PARENT;
+		}
+		if( safe_extent_size == 0 )
+		{
+			safe_extent_flags = range_extent_flags;
+		}
+		else if( range_extent_flags != safe_extent_flags )
+		{
+			break;
+		}
+		if( (size64_t) range_size > ( internal_file->io_handle->media_size - offset ) )
+		{
+			range_size = (size_t) ( internal_file->io_handle->media_size - offset );
+		}
+		offset           += range_size;
+		safe_extent_size += range_size;
+	}
+	*extent_size  = safe_extent_size;
+	*extent_flags = safe_extent_flags;
+
+	return( 1 );
+}
+
+/* Retrieves the next extent starting at a specific offset
+ * The extent contains the data from the offset onwards that is either allocated,
+ * sparse (LIBVHDI_EXTENT_FLAG_IS_SPARSE) or stored in the parent file (LIBVHDI_EXTENT_FLAG_IS_PARENT)
+ * This function does not read the data and can be called by multiple threads concurrently
+ * Returns 1 if successful, 0 if the offset is beyond the media size or -1 on error
+ */
+int libvhdi_file_get_next_extent(
+     libvhdi_file_t *file,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_get_next_extent";
+	int result                             = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvhdi_internal_file_get_extent_at_offset(
+	          internal_file,
+	          internal_file->file_io_handle,
+	          offset,
+	          extent_size,
+	          extent_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+	}
+	else if( result != 0 )
+	{
+		*extent_offset = offset;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the extent at a specific offset, resolved in the chain of parent files
+ * The extent starts at the offset and contains the following data of the same type,
+ * where data that is stored in a parent file has the LIBVHDI_EXTENT_FLAG_IS_PARENT flag
+ * and data that is sparse in every file in the chain the LIBVHDI_EXTENT_FLAG_IS_SPARSE flag
+ * This function can be called concurrently with a read lock
+ * Returns 1 if successful, 0 if the offset is beyond the media size or -1 on error
+ */
+int libvhdi_internal_file_get_chain_extent_at_offset(
+     libvhdi_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *range_file_io_handle = NULL;
+	static char *function                  = "libvhdi_internal_file_get_chain_extent_at_offset";
+	size64_t safe_extent_size              = 0;
+	size_t range_size                      = 0;
+	off64_t range_file_offset              = 0;
+	uint32_t range_extent_flags            = 0;
+	uint32_t safe_extent_flags             = 0;
+	int range_chain_level                  = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent size.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_file->io_handle->media_size )
+	{
+		return( 0 );
+	}
+	while( (size64_t) offset < internal_file->io_handle->media_size )
+	{
+		if( libvhdi_internal_file_get_chain_range(
+		     internal_file,
+		     file_io_handle,
+		     offset,
+		     &range_file_io_handle,
+		     NULL,
+		     &range_file_offset,
+		     &range_size,
+		     &range_chain_level,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		if( range_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid range size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( range_file_io_handle == NULL )
+		{
+			range_extent_flags = LIBVHDI_EXTENT_FLAG_IS_SPARSE;
+		}
+		else if( range_chain_level != 0 )
+		{
+			range_extent_flags = LIBVHDI_EXTENT_FLAG_IS_PARENT;
+		}
+		else
+		{
+			range_extent_flags = 0;
+		}
+		if( safe_extent_size == 0 )
+		{
+			safe_extent_flags = range_extent_flags;
+		}
+		else if( range_extent_flags != safe_extent_flags )
+		{
+			break;
+		}
+		if( (size64_t) range_size > ( internal_file->io_handle->media_size - offset ) )
+		{
+			range_size = (size_t) ( internal_file->io_handle->media_size - offset );
+		}
+		offset           += range_size;
+		safe_extent_size += range_size;
+	}
+	*extent_size  = safe_extent_size;
+	*extent_flags = safe_extent_flags;
+
+	return( 1 );
+}
+
+/* Retrieves the next extent starting at a specific offset, resolved in the chain of parent files
+ * The extent contains the data from the offset onwards that is either allocated in the file,
+ * allocated in one of its parent files (LIBVHDI_EXTENT_FLAG_IS_PARENT)
+ * or sparse in every file in the chain (LIBVHDI_EXTENT_FLAG_IS_SPARSE)
+ * Returns 1 if successful, 0 if the offset is beyond the media size or -1 on error
+ */
+int libvhdi_file_get_next_chain_extent(
+     libvhdi_file_t *file,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_get_next_chain_extent";
+	int result                             = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvhdi_internal_file_get_chain_extent_at_offset(
+	          internal_file,
+	          internal_file->file_io_handle,
+	          offset,
+	          extent_size,
+	          extent_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+	}
+	else if( result != 0 )
+	{
+		*extent_offset = offset;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the range of a specific block at a specific block data offset
+ * The range contains the data from the block data offset onwards that is either allocated in the file,
+ * sparse (LIBVHDI_EXTENT_FLAG_IS_SPARSE) or stored in the parent file (LIBVHDI_EXTENT_FLAG_IS_PARENT)
+ * The range file offset is the offset of the data in the file or -1 if the data is not allocated in the file
+ * This function does not read the data and can be called by multiple threads concurrently
+ * Returns 1 if successful, 0 if the file has no blocks or the block is beyond the media size or -1 on error
+ */
+int libvhdi_file_get_block_range(
+     libvhdi_file_t *file,
+     uint64_t block_number,
+     uint32_t block_data_offset,
+     off64_t *range_file_offset,
+     size_t *range_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_get_block_range";
+	size_t safe_range_size                 = 0;
+	off64_t safe_range_file_offset         = 0;
+	uint64_t range_offset                  = 0;
+	uint32_t sector_range_flags            = 0;
+	int result                             = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range file offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_file->block_allocation_table != NULL )
+	 && ( internal_file->io_handle->block_size != 0 )
+	 && ( block_number < ( internal_file->io_handle->media_size / internal_file->io_handle->block_size ) + 1 ) )
+	{
+		range_offset = ( block_number * internal_file->io_handle->block_size ) + block_data_offset;
+
+		if( range_offset < internal_file->io_handle->media_size )
+		{
+			result = libvhdi_internal_file_get_block_sector_range(
+			          internal_file,
+			          internal_file->file_io_handle,
+			          block_number,
+			          block_data_offset,
+			          &safe_range_file_offset,
+			          &safe_range_size,
+			          &sector_range_flags,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve sector range of block: %" PRIu64 " at offset: %" PRIu32 ".",
+				 function,
+				 block_number,
+				 block_data_offset );
+
+				result = -1;
+			}
+		}
+	}
+	if( result == 1 )
+	{
+		if( (size64_t) safe_range_size > ( internal_file->io_handle->media_size - range_offset ) )
+		{
+			safe_range_size = (size_t) ( internal_file->io_handle->media_size - range_offset );
+		}
+		if( ( sector_range_flags & LIBFDATA_SECTOR_RANGE_FLAG_IS_UNALLOCATED ) == 0 )
+		{
+			*range_file_offset = safe_range_file_offset;
+			*range_flags       = 0;
+		}
+		else
+		{
+			*range_file_offset = -1;
+
+			if( internal_file->parent_file == NULL )
+			{
+				*range_flags = LIBVHDI_EXTENT_FLAG_IS_SPARSE;
+			}
+			else
+			{
+				*range_flags = LIBVHDI_EXTENT_FLAG_IS_PARENT;
+			}
+		}
+		*range_size = safe_range_size;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Seeks a certain offset of the (media) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libvhdi_internal_file_seek_offset(
+         libvhdi_internal_file_t *internal_file,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libvhdi_internal_file_seek_offset";
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->io_handle->disk_type == LIBVHDI_DISK_TYPE_DIFFERENTIAL )
+	{
+		if( internal_file->parent_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid file - missing parent file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += internal_file->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) internal_file->io_handle->media_size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the (media) data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libvhdi_file_seek_offset(
+         libvhdi_file_t *file,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_seek_offset";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libvhdi_internal_file_seek_offset(
+	          internal_file,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		offset = -1;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (media) data
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_file_get_offset(
+     libvhdi_file_t *file,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_get_offset";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_file->current_offset;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the parent file of a differential image
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_file_set_parent_file(
+     libvhdi_file_t *file,
+     libvhdi_file_t *parent_file,
+     libcerror_error_t **error )
+{
+	uint8_t identifier[ 16 ];
+
+	libvhdi_internal_file_t *internal_file = NULL;
+	uint8_t *parent_identifier             = NULL;
+	static char *function                  = "libvhdi_file_set_parent_file";
+	int result                             = 1;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->io_handle->disk_type != LIBVHDI_DISK_TYPE_DIFFERENTIAL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid file - not a differential disk type.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->parent_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - parent file already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_file_get_identifier(
+	     parent_file,
+	     identifier,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identifier from parent file.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	/* Data read ahead before the parent file is set is discarded
+	 */
+	if( internal_file->read_ahead != NULL )
+	{
+		if( libvhdi_read_ahead_flush(
+		     internal_file->read_ahead,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to flush read-ahead.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	if( internal_file->io_handle->disk_type == LIBVHDI_DISK_TYPE_DIFFERENTIAL )
+	{
+		if( internal_file->io_handle->file_type == LIBVHDI_FILE_TYPE_VHDX )
+		{
+			parent_identifier = internal_file->metadata_values->parent_identifier;
+		}
+		else
+		{
+			parent_identifier = internal_file->dynamic_disk_header->parent_identifier;
+		}
+	}
+	if( parent_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing parent identifier.",
+		 function );
+
+		result = -1;
+	}
+	else if( memory_compare(
+	          parent_identifier,
+	          identifier,
+	          16 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: mismatch in identifier.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_file->parent_file = parent_file;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the maximum number of block descriptors that are cached
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_file_get_block_cache_size(
+     libvhdi_file_t *file,
+     int *number_of_entries,
+     libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_get_block_cache_size";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entries.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_entries = internal_file->block_cache_size;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum number of block descriptors that are cached
+ * If the file is open the cached block descriptors are discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_file_set_block_cache_size(
+     libvhdi_file_t *file,
+     int number_of_entries,
+     libcerror_error_t **error )
+{
+	libvhdi_block_cache_t *block_cache     = NULL;
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_set_block_cache_size";
+	int number_of_references               = 0;
+	int result                             = 1;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( ( number_of_entries <= 0 )
+	 || ( number_of_entries > LIBVHDI_MAXIMUM_BLOCK_CACHE_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	/* The read-ahead is flushed since its thread can use the block cache
+	 */
+	if( internal_file->read_ahead != NULL )
+	{
+		if( libvhdi_read_ahead_flush(
+		     internal_file->read_ahead,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to flush read-ahead.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	if( ( result == 1 )
+	 && ( internal_file->reference_count != NULL ) )
+	{
+		if( libvhdi_reference_count_get_number_of_references(
+		     internal_file->reference_count,
+		     &number_of_references,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of references.",
+			 function );
+
+			result = -1;
+		}
+		else if( number_of_references > 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported block cache shared with a clone of the file.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( internal_file->block_cache != NULL ) )
+	{
+		if( libvhdi_block_cache_initialize(
+		     &block_cache,
+		     number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create block cache.",
+			 function );
+
+			result = -1;
+		}
+		else if( libvhdi_block_cache_free(
+		          &( internal_file->block_cache ),
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free block cache.",
+			 function );
+
+			libvhdi_block_cache_free(
+			 &block_cache,
+			 NULL );
+
+			result = -1;
+		}
+		else
+		{
+			internal_file->block_cache = block_cache;
+		}
+	}
+	if( result == 1 )
+	{
+		internal_file->block_cache_size = number_of_entries;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of block cache hits and misses
+ * The numbers are maintained by the block cache, which is shared with clones of the file,
+ * hence they are not reset by libvhdi_file_reset_statistics
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvhdi_file_get_block_cache_statistics(
+     libvhdi_file_t *file,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_get_block_cache_statistics";
+	int result                             = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_file->block_cache != NULL )
+	{
+		result = libvhdi_block_cache_get_statistics(
+		          internal_file->block_cache,
+		          number_of_hits,
+		          number_of_misses,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block cache statistics.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the maximum size of the (media) data that is cached
+ * A size of 0 represents that the data cache is disabled
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_file_get_data_cache_size(
+     libvhdi_file_t *file,
+     size_t *data_cache_size,
+     libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_get_data_cache_size";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( data_cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data cache size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*data_cache_size = internal_file->data_cache_size;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+/* Sets the maximum size of the (media) data that is cached
+ * The data is cached in segments of 64 KiB, where segments that are read more than once
+ * are protected from being evicted by segments that are read only once, such as by
+ * a sequential read of the media data
+ * A size of 0 disables the data cache, which is the default
+ * If the file is open the cached data is discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_file_set_data_cache_size(
+     libvhdi_file_t *file,
+     size_t data_cache_size,
+     libcerror_error_t **error )
+{
+	libvhdi_data_cache_t *data_cache       = NULL;
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_set_data_cache_size";
+	int number_of_references               = 0;
+	int result                             = 1;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( data_cache_size > (size_t) LIBVHDI_MAXIMUM_DATA_CACHE_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data cache size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_cache_size > 0 )
+	 && ( data_cache_size < (size_t) LIBVHDI_DATA_CACHE_SEGMENT_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid data cache size value too small.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	/* The read-ahead is flushed since its thread can use the data cache
+	 */
+	if( internal_file->read_ahead != NULL )
+	{
+		if( libvhdi_read_ahead_flush(
+		     internal_file->read_ahead,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to flush read-ahead.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	if( ( result == 1 )
+	 && ( internal_file->reference_count != NULL ) )
+	{
+		if( libvhdi_reference_count_get_number_of_references(
+		     internal_file->reference_count,
+		     &number_of_references,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of references.",
+			 function );
+
+			result = -1;
+		}
+		else if( number_of_references > 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported data cache shared with a clone of the file.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( data_cache_size > 0 )
+	 && ( internal_file->file_io_handle != NULL ) )
+	{
+		if( libvhdi_data_cache_initialize(
+		     &data_cache,
+		     data_cache_size,
+		     LIBVHDI_DATA_CACHE_SEGMENT_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create data cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( internal_file->data_cache != NULL ) )
+	{
+		if( libvhdi_data_cache_free(
+		     &( internal_file->data_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free data cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		internal_file->data_cache      = data_cache;
+		internal_file->data_cache_size = data_cache_size;
+	}
+	else if( data_cache != NULL )
+	{
+		libvhdi_data_cache_free(
+		 &data_cache,
+		 NULL );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of data cache hits and misses
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvhdi_file_get_data_cache_statistics(
+     libvhdi_file_t *file,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_get_data_cache_statistics";
+	int result                             = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_file->data_cache != NULL )
+	{
+		result = libvhdi_data_cache_get_statistics(
+		          internal_file->data_cache,
+		          number_of_hits,
+		          number_of_misses,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data cache statistics.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+/* Retrieves the read statistics
+ * The statistics are not protected by the read/write lock, since they are updated concurrently by reads
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_file_get_statistics(
+     libvhdi_file_t *file,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_get_statistics";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( libvhdi_statistics_get_values(
+	     internal_file->statistics,
+	     values,
+	     number_of_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics values.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Resets the read statistics to 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_file_reset_statistics(
+     libvhdi_file_t *file,
+     libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_reset_statistics";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( libvhdi_statistics_reset(
+	     internal_file->statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reset statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the read-ahead size
+ * A size of 0 represents that read-ahead is disabled
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_file_get_read_ahead_size(
+     libvhdi_file_t *file,
+     size_t *read_ahead_size,
+     libcerror_error_t **error )
 {
 	libvhdi_internal_file_t *internal_file = NULL;
-	static char *function                  = "libvhdi_file_read_buffer";
-	ssize_t read_count                     = 0;
+	static char *function                  = "libvhdi_file_get_read_ahead_size";
 
 	if( file == NULL )
 	{
@@ -2444,19 +8424,19 @@ ssize_t libvhdi_file_read_buffer(
 	}
 	internal_file = (libvhdi_internal_file_t *) file;
 
-	if( internal_file->file_io_handle == NULL )
+	if( read_ahead_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing file IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead size.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_file->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2464,32 +8444,16 @@ ssize_t libvhdi_file_read_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	read_count = libvhdi_internal_file_read_buffer_from_file_io_handle(
-		      internal_file,
-		      internal_file->file_io_handle,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
+	*read_ahead_size = internal_file->read_ahead_size;
 
-		read_count = -1;
-	}
 #if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_file->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2497,28 +8461,30 @@ ssize_t libvhdi_file_read_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( 1 );
 }
 
-/* Reads (media) data at a specific offset
- * Returns the number of bytes read or -1 on error
+/* Sets the read-ahead size
+ * When sequential reads are detected the data following the read is read ahead,
+ * in a background thread, in buffers of the read-ahead size
+ * A size of 0 disables read-ahead, which is the default
+ * Read-ahead requires multi-thread support
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libvhdi_file_read_buffer_at_offset(
-         libvhdi_file_t *file,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libvhdi_file_set_read_ahead_size(
+     libvhdi_file_t *file,
+     size_t read_ahead_size,
+     libcerror_error_t **error )
 {
 	libvhdi_internal_file_t *internal_file = NULL;
-	static char *function                  = "libvhdi_file_read_buffer_at_offset";
-	ssize_t read_count                     = 0;
+	static char *function                  = "libvhdi_file_set_read_ahead_size";
+	int result                             = 1;
 
 	if( file == NULL )
 	{
@@ -2533,18 +8499,30 @@ ssize_t libvhdi_file_read_buffer_at_offset(
 	}
 	internal_file = (libvhdi_internal_file_t *) file;
 
-	if( internal_file->file_io_handle == NULL )
+	if( read_ahead_size > (size_t) LIBVHDI_MAXIMUM_READ_AHEAD_SIZE )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing file IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid read-ahead size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+#if !defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( read_ahead_size > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: read-ahead requires multi-thread support.",
+		 function );
+
+		return( -1 );
+	}
+#else
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_file->read_write_lock,
 	     error ) != 1 )
@@ -2558,43 +8536,50 @@ ssize_t libvhdi_file_read_buffer_at_offset(
 
 		return( -1 );
 	}
-#endif
-	if( libvhdi_internal_file_seek_offset(
-	     internal_file,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( internal_file->read_ahead != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+		if( libvhdi_read_ahead_free(
+		     &( internal_file->read_ahead ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead.",
+			 function );
 
-		read_count = -1;
+			result = -1;
+		}
 	}
-	else
+	if( ( result == 1 )
+	 && ( read_ahead_size > 0 )
+	 && ( internal_file->file_io_handle != NULL ) )
 	{
-		read_count = libvhdi_internal_file_read_buffer_from_file_io_handle(
-			      internal_file,
-			      internal_file->file_io_handle,
-			      buffer,
-			      buffer_size,
-			      error );
-
-		if( read_count == -1 )
+		if( libvhdi_read_ahead_initialize(
+		     &( internal_file->read_ahead ),
+		     read_ahead_size,
+		     internal_file->io_handle->media_size,
+		     (intptr_t *) internal_file,
+		     &libvhdi_internal_file_read_ahead_read_data,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read-ahead.",
 			 function );
 
-			read_count = -1;
+			result = -1;
 		}
 	}
+#endif /* !defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT ) */
+
+	if( result == 1 )
+	{
+		internal_file->read_ahead_size = read_ahead_size;
+	}
 #if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_file->read_write_lock,
@@ -2610,22 +8595,21 @@ ssize_t libvhdi_file_read_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( result );
 }
 
-/* Seeks a certain offset of the (media) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+/* Retrieves the maximum number of file IO handles used to read concurrently
+ * Returns 1 if successful or -1 on error
  */
-off64_t libvhdi_internal_file_seek_offset(
-         libvhdi_internal_file_t *internal_file,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libvhdi_file_get_maximum_number_of_file_io_handles(
+     libvhdi_file_t *file,
+     int *maximum_number_of_file_io_handles,
+     libcerror_error_t **error )
 {
-	static char *function = "libvhdi_internal_file_seek_offset";
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_get_maximum_number_of_file_io_handles";
 
-	if( internal_file == NULL )
+	if( file == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2636,79 +8620,69 @@ off64_t libvhdi_internal_file_seek_offset(
 
 		return( -1 );
 	}
-	if( internal_file->io_handle == NULL )
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( maximum_number_of_file_io_handles == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of file IO handles.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_file->io_handle->disk_type == LIBVHDI_DISK_TYPE_DIFFERENTIAL )
-	{
-		if( internal_file->parent_file == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid file - missing parent file.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
-	{
-		offset += internal_file->current_offset;
-	}
-	else if( whence == SEEK_END )
-	{
-		offset += (off64_t) internal_file->io_handle->media_size;
-	}
-	if( offset < 0 )
+#endif
+	*maximum_number_of_file_io_handles = internal_file->maximum_number_of_file_io_handles;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	internal_file->current_offset = offset;
-
-	return( offset );
+#endif
+	return( 1 );
 }
 
-/* Seeks a certain offset of the (media) data
- * Returns the offset if seek is successful or -1 on error
+/* Sets the maximum number of file IO handles used to read concurrently
+ * When concurrent reads are made from multiple threads, additional file IO handles
+ * are cloned on demand, up to the maximum, so that every read has a file IO handle of its own
+ * The maximum can only be set when the file is not open
+ * A maximum larger than 1 requires multi-thread support
+ * Returns 1 if successful or -1 on error
  */
-off64_t libvhdi_file_seek_offset(
-         libvhdi_file_t *file,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libvhdi_file_set_maximum_number_of_file_io_handles(
+     libvhdi_file_t *file,
+     int maximum_number_of_file_io_handles,
+     libcerror_error_t **error )
 {
 	libvhdi_internal_file_t *internal_file = NULL;
-	static char *function                  = "libvhdi_file_seek_offset";
+	static char *function                  = "libvhdi_file_set_maximum_number_of_file_io_handles";
+	int result                             = 1;
 
 	if( file == NULL )
 	{
@@ -2723,18 +8697,31 @@ off64_t libvhdi_file_seek_offset(
 	}
 	internal_file = (libvhdi_internal_file_t *) file;
 
-	if( internal_file->file_io_handle == NULL )
+	if( ( maximum_number_of_file_io_handles <= 0 )
+	 || ( maximum_number_of_file_io_handles > LIBVHDI_MAXIMUM_NUMBER_OF_FILE_IO_HANDLES ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing file IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of file IO handles value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+#if !defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( maximum_number_of_file_io_handles > 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multiple file IO handles requires multi-thread support.",
+		 function );
+
+		return( -1 );
+	}
+#else
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_file->read_write_lock,
 	     error ) != 1 )
@@ -2749,22 +8736,20 @@ off64_t libvhdi_file_seek_offset(
 		return( -1 );
 	}
 #endif
-	offset = libvhdi_internal_file_seek_offset(
-	          internal_file,
-	          offset,
-	          whence,
-	          error );
-
-	if( offset == -1 )
+	if( internal_file->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - file IO handle already set.",
 		 function );
 
-		offset = -1;
+		result = -1;
+	}
+	else
+	{
+		internal_file->maximum_number_of_file_io_handles = maximum_number_of_file_io_handles;
 	}
 #if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -2781,19 +8766,26 @@ off64_t libvhdi_file_seek_offset(
 		return( -1 );
 	}
 #endif
-	return( offset );
+	return( result );
 }
 
-/* Retrieves the current offset of the (media) data
+/* Sets the filename of the sidecar index file
+ * When the file is opened and the index file exists and matches the image,
+ * the block allocation table is read from the index file instead of the image
+ * A stale or missing index file is ignored, use libvhdi_file_write_index to (re)create it
+ * The filename can only be set when the file is not open
  * Returns 1 if successful or -1 on error
  */
-int libvhdi_file_get_offset(
+int libvhdi_file_set_index_filename(
      libvhdi_file_t *file,
-     off64_t *offset,
+     const char *filename,
      libcerror_error_t **error )
 {
 	libvhdi_internal_file_t *internal_file = NULL;
-	static char *function                  = "libvhdi_file_get_offset";
+	char *index_filename                   = NULL;
+	static char *function                  = "libvhdi_file_set_index_filename";
+	size_t filename_length                 = 0;
+	int result                             = 1;
 
 	if( file == NULL )
 	{
@@ -2804,45 +8796,99 @@ int libvhdi_file_get_offset(
 		 "%s: invalid file.",
 		 function );
 
-		return( -1 );
-	}
-	internal_file = (libvhdi_internal_file_t *) file;
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( filename != NULL )
+	{
+		filename_length = narrow_string_length(
+		                   filename );
+
+		if( ( filename_length == 0 )
+		 || ( filename_length > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 1 ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid filename length value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		index_filename = narrow_string_allocate(
+		                  filename_length + 1 );
+
+		if( index_filename == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create index filename.",
+			 function );
+
+			return( -1 );
+		}
+		if( narrow_string_copy(
+		     index_filename,
+		     filename,
+		     filename_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy index filename.",
+			 function );
+
+			memory_free(
+			 index_filename );
 
-	if( internal_file->io_handle == NULL )
+			return( -1 );
+		}
+		index_filename[ filename_length ] = 0;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_file->file_io_handle == NULL )
+#endif
+	if( internal_file->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing file IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - file IO handle already set.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( offset == NULL )
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
-		 function );
+		if( internal_file->index_filename != NULL )
+		{
+			memory_free(
+			 internal_file->index_filename );
+		}
+		internal_file->index_filename = index_filename;
 
-		return( -1 );
+		index_filename = NULL;
 	}
 #if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_file->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2850,46 +8896,48 @@ int libvhdi_file_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	*offset = internal_file->current_offset;
+	if( index_filename != NULL )
+	{
+		memory_free(
+		 index_filename );
+	}
+	return( result );
 
 #if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_file->read_write_lock,
-	     error ) != 1 )
+on_error:
+	if( index_filename != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
-		 function );
-
-		return( -1 );
+		memory_free(
+		 index_filename );
 	}
+	return( -1 );
 #endif
-	return( 1 );
 }
 
-/* Sets the parent file of a differential image
+/* Writes the sidecar index file of an open file
+ * The index file contains the decoded block allocation table and the values
+ * used to determine if the index file matches the image when it is read
+ * An existing index file is overwritten, except for the index file the block
+ * allocation table was read from, which already matches the image
  * Returns 1 if successful or -1 on error
  */
-int libvhdi_file_set_parent_file(
+int libvhdi_file_write_index(
      libvhdi_file_t *file,
-     libvhdi_file_t *parent_file,
+     const char *filename,
      libcerror_error_t **error )
 {
-	uint8_t identifier[ 16 ];
-
+	libvhdi_index_t *index                 = NULL;
 	libvhdi_internal_file_t *internal_file = NULL;
-	uint8_t *parent_identifier             = NULL;
-	static char *function                  = "libvhdi_file_set_parent_file";
+	static char *function                  = "libvhdi_file_write_index";
+	size_t filename_length                 = 0;
 	int result                             = 1;
+	int write_index                        = 1;
 
 	if( file == NULL )
 	{
@@ -2904,124 +8952,146 @@ int libvhdi_file_set_parent_file(
 	}
 	internal_file = (libvhdi_internal_file_t *) file;
 
-	if( internal_file->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_file->io_handle->disk_type != LIBVHDI_DISK_TYPE_DIFFERENTIAL )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: invalid file - not a differential disk type.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_file->parent_file != NULL )
+	if( libvhdi_index_initialize(
+	     &index,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - parent file already set.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index.",
 		 function );
 
 		return( -1 );
 	}
-	if( libvhdi_file_get_identifier(
-	     parent_file,
-	     identifier,
-	     16,
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve identifier from parent file.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
+		libvhdi_index_free(
+		 &index,
+		 NULL );
+
 		return( -1 );
 	}
-#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_file->read_write_lock,
-	     error ) != 1 )
+#endif
+	if( internal_file->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#endif
-	if( internal_file->io_handle->disk_type == LIBVHDI_DISK_TYPE_DIFFERENTIAL )
+	if( result == 1 )
 	{
-		if( internal_file->io_handle->file_type == LIBVHDI_FILE_TYPE_VHDX )
+		if( libvhdi_internal_file_get_index_values(
+		     internal_file,
+		     internal_file->file_io_handle,
+		     index,
+		     error ) != 1 )
 		{
-			parent_identifier = internal_file->metadata_values->parent_identifier;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve index values.",
+			 function );
+
+			result = -1;
 		}
-		else
+	}
+	/* The block allocation table entries can reference the memory mapped index file,
+	 * which cannot be truncated while it is mapped, in that case the index file is
+	 * known to match the image and is not rewritten
+	 */
+	if( ( result == 1 )
+	 && ( internal_file->block_allocation_table != NULL )
+	 && ( internal_file->block_allocation_table->memory_map != NULL )
+	 && ( internal_file->index_filename != NULL ) )
+	{
+		filename_length = narrow_string_length(
+		                   filename );
+
+		if( narrow_string_compare(
+		     filename,
+		     internal_file->index_filename,
+		     filename_length + 1 ) == 0 )
 		{
-			parent_identifier = internal_file->dynamic_disk_header->parent_identifier;
+			write_index = 0;
 		}
 	}
-	if( parent_identifier == NULL )
+	if( ( result == 1 )
+	 && ( write_index != 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing parent identifier.",
-		 function );
+		if( libvhdi_index_write_file(
+		     index,
+		     internal_file->block_allocation_table,
+		     filename,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write index file: %s.",
+			 function,
+			 filename );
 
-		result = -1;
+			result = -1;
+		}
 	}
-	else if( memory_compare(
-	          parent_identifier,
-	          identifier,
-	          16 ) != 0 )
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: mismatch in identifier.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		result = -1;
 	}
-	else
-	{
-		internal_file->parent_file = parent_file;
-	}
-#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_file->read_write_lock,
+#endif
+	if( libvhdi_index_free(
+	     &index,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free index.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#endif
 	return( result );
 }
 
@@ -3449,6 +9519,93 @@ int libvhdi_file_get_bytes_per_sector(
 	return( 1 );
 }
 
+/* Retrieves the block size
+ * Returns 1 if successful, 0 if the file has no blocks or -1 on error
+ */
+int libvhdi_file_get_block_size(
+     libvhdi_file_t *file,
+     uint32_t *block_size,
+     libcerror_error_t **error )
+{
+	libvhdi_internal_file_t *internal_file = NULL;
+	static char *function                  = "libvhdi_file_get_block_size";
+	int result                             = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libvhdi_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_file->block_allocation_table != NULL )
+	 && ( internal_file->io_handle->block_size != 0 ) )
+	{
+		*block_size = internal_file->io_handle->block_size;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
 /* Retrieves the identifier
  * The identifier is a big-endian GUID and is 16 bytes of size
  * For VHDX this value is obtained from the data write identifier
@@ -26,19 +26,27 @@
 #include <types.h>
 
 #include "libvhdi_block_allocation_table.h"
+#include "libvhdi_block_cache.h"
+#include "libvhdi_data_cache.h"
 #include "libvhdi_dynamic_disk_header.h"
 #include "libvhdi_extern.h"
 #include "libvhdi_file_footer.h"
 #include "libvhdi_file_information.h"
+#include "libvhdi_file_io_handle_pool.h"
 #include "libvhdi_image_header.h"
+#include "libvhdi_index.h"
 #include "libvhdi_io_handle.h"
 #include "libvhdi_libbfio.h"
 #include "libvhdi_libcerror.h"
 #include "libvhdi_libcthreads.h"
-#include "libvhdi_libfcache.h"
-#include "libvhdi_libfdata.h"
+#include "libvhdi_log.h"
+#include "libvhdi_memory_map.h"
 #include "libvhdi_metadata_values.h"
+#include "libvhdi_read_ahead.h"
+#include "libvhdi_read_queue.h"
+#include "libvhdi_reference_count.h"
 #include "libvhdi_region_table.h"
+#include "libvhdi_statistics.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -68,6 +76,14 @@ struct libvhdi_internal_file
 	 */
 	uint8_t file_io_handle_opened_in_library;
 
+	/* The pool of file IO handles used to read concurrently
+	 */
+	libvhdi_file_io_handle_pool_t *file_io_handle_pool;
+
+	/* The maximum number of file IO handles in the pool
+	 */
+	int maximum_number_of_file_io_handles;
+
 	/* The file footer
 	 */
 	libvhdi_file_footer_t *file_footer;
@@ -96,19 +112,64 @@ struct libvhdi_internal_file
 	 */
 	libvhdi_block_allocation_table_t *block_allocation_table;
 
-	/* The block descriptors vector
+	/* The block cache
+	 */
+	libvhdi_block_cache_t *block_cache;
+
+	/* The maximum number of entries of the block cache
 	 */
-	libfdata_vector_t *block_descriptors_vector;
+	int block_cache_size;
 
-	/* The block descriptors cache
+	/* The data cache
 	 */
-	libfcache_cache_t *block_descriptors_cache;
+	libvhdi_data_cache_t *data_cache;
+
+	/* The maximum size of the data cache, where 0 represents the data cache is disabled
+	 */
+	size_t data_cache_size;
 
 	/* The parent file
 	 */
 	libvhdi_file_t *parent_file;
 
+	/* The size of the read-ahead window, where 0 represents read-ahead is disabled
+	 */
+	size_t read_ahead_size;
+
+	/* The read queue of the submitted read requests
+	 */
+	libvhdi_read_queue_t *read_queue;
+
+	/* The memory map of the file, which is set if the file was opened with LIBVHDI_ACCESS_FLAG_MEMORY_MAP
+	 */
+	libvhdi_memory_map_t *memory_map;
+
+	/* The log, which is set if the VHDX log contains log entries that were not applied to the file
+	 */
+	libvhdi_log_t *log;
+
+	/* The file IO handle of the file without the log applied, which is set if the log is set
+	 * in which case the file IO handle reads the file with the log applied
+	 */
+	libbfio_handle_t *image_file_io_handle;
+
+	/* The statistics of the reads of the file
+	 */
+	libvhdi_statistics_t *statistics;
+
+	/* The reference count of the file values that are shared with clones of the file
+	 */
+	libvhdi_reference_count_t *reference_count;
+
+	/* The filename of the sidecar index file
+	 */
+	char *index_filename;
+
 #if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	/* The read-ahead
+	 */
+	libvhdi_read_ahead_t *read_ahead;
+
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
@@ -155,6 +216,12 @@ int libvhdi_file_open_file_io_handle(
      int access_flags,
      libcerror_error_t **error );
 
+LIBVHDI_EXTERN \
+int libvhdi_file_clone(
+     libvhdi_file_t **destination_file,
+     libvhdi_file_t *source_file,
+     libcerror_error_t **error );
+
 LIBVHDI_EXTERN \
 int libvhdi_file_close(
      libvhdi_file_t *file,
@@ -175,6 +242,11 @@ int libvhdi_internal_file_open_read_image_header(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libvhdi_internal_file_open_read_log(
+     libvhdi_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
 int libvhdi_internal_file_open_read_region_table(
      libvhdi_internal_file_t *internal_file,
      libbfio_handle_t *file_io_handle,
@@ -190,11 +262,80 @@ int libvhdi_internal_file_open_read_block_allocation_table(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
-ssize_t libvhdi_internal_file_read_buffer_from_file_io_handle(
+int libvhdi_internal_file_get_index_values(
+     libvhdi_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     libvhdi_index_t *index,
+     libcerror_error_t **error );
+
+int libvhdi_internal_file_open_read_index(
+     libvhdi_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libvhdi_internal_file_get_block_sector_range(
+     libvhdi_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     uint64_t block_number,
+     uint32_t block_data_offset,
+     off64_t *range_file_offset,
+     size_t *range_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libvhdi_internal_file_get_chain_range(
+     libvhdi_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     libbfio_handle_t **range_file_io_handle,
+     libvhdi_file_io_handle_pool_t **range_file_io_handle_pool,
+     off64_t *range_file_offset,
+     size_t *range_size,
+     int *range_chain_level,
+     libcerror_error_t **error );
+
+ssize_t libvhdi_internal_file_read_range_data(
+         libvhdi_internal_file_t *internal_file,
+         libbfio_handle_t *range_file_io_handle,
+         libvhdi_file_io_handle_pool_t *range_file_io_handle_pool,
+         off64_t range_file_offset,
+         int range_chain_level,
+         uint8_t *buffer,
+         size_t read_size,
+         libcerror_error_t **error );
+
+ssize_t libvhdi_internal_file_read_buffer_at_offset_from_file_io_handle(
+         libvhdi_internal_file_t *internal_file,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t libvhdi_internal_file_read_buffer_at_offset_from_data_cache(
          libvhdi_internal_file_t *internal_file,
          libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+
+ssize_t libvhdi_internal_file_read_ahead_read_data(
+         intptr_t *data_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT ) */
+
+ssize_t libvhdi_internal_file_read_buffer_at_offset(
+         libvhdi_internal_file_t *internal_file,
          void *buffer,
          size_t buffer_size,
+         off64_t offset,
          libcerror_error_t **error );
 
 LIBVHDI_EXTERN \
@@ -212,12 +353,139 @@ ssize_t libvhdi_file_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+int libvhdi_internal_file_read_buffers_at_offsets_from_file_io_handle(
+     libvhdi_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     void **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     libcerror_error_t **error );
+
+int libvhdi_internal_file_read_buffers_at_offsets(
+     libvhdi_internal_file_t *internal_file,
+     void **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_read_buffers_at_offsets(
+     libvhdi_file_t *file,
+     void **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     libcerror_error_t **error );
+
+int libvhdi_internal_file_read_queue_read_buffers(
+     intptr_t *data_handle,
+     void **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     libcerror_error_t **error );
+
+int libvhdi_internal_file_read_queue_get_file_range(
+     intptr_t *data_handle,
+     off64_t offset,
+     size_t size,
+     off64_t *file_offset,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_submit_read_buffer_at_offset(
+     libvhdi_file_t *file,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     uint64_t request_identifier,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_poll_read_completions(
+     libvhdi_file_t *file,
+     uint64_t *request_identifiers,
+     ssize_t *read_counts,
+     int maximum_number_of_completions,
+     int *number_of_completions,
+     uint8_t wait_for_completion,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_get_data_pointer(
+     libvhdi_file_t *file,
+     off64_t offset,
+     size_t size,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+int libvhdi_internal_file_get_extent_at_offset(
+     libvhdi_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_get_mapped_range(
+     libvhdi_file_t *file,
+     off64_t offset,
+     size_t size,
+     int *chain_level,
+     off64_t *mapped_file_offset,
+     size_t *mapped_size,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_get_next_extent(
+     libvhdi_file_t *file,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error );
+
+int libvhdi_internal_file_get_chain_extent_at_offset(
+     libvhdi_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_get_next_chain_extent(
+     libvhdi_file_t *file,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error );
+
 off64_t libvhdi_internal_file_seek_offset(
          libvhdi_internal_file_t *internal_file,
          off64_t offset,
          int whence,
          libcerror_error_t **error );
 
+LIBVHDI_EXTERN \
+int libvhdi_file_get_block_range(
+     libvhdi_file_t *file,
+     uint64_t block_number,
+     uint32_t block_data_offset,
+     off64_t *range_file_offset,
+     size_t *range_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
 LIBVHDI_EXTERN \
 off64_t libvhdi_file_seek_offset(
          libvhdi_file_t *file,
@@ -237,6 +505,92 @@ int libvhdi_file_set_parent_file(
      libvhdi_file_t *parent_file,
      libcerror_error_t **error );
 
+LIBVHDI_EXTERN \
+int libvhdi_file_get_block_cache_size(
+     libvhdi_file_t *file,
+     int *number_of_entries,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_set_block_cache_size(
+     libvhdi_file_t *file,
+     int number_of_entries,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_get_block_cache_statistics(
+     libvhdi_file_t *file,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_get_data_cache_size(
+     libvhdi_file_t *file,
+     size_t *data_cache_size,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_set_data_cache_size(
+     libvhdi_file_t *file,
+     size_t data_cache_size,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_get_data_cache_statistics(
+     libvhdi_file_t *file,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_get_statistics(
+     libvhdi_file_t *file,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_reset_statistics(
+     libvhdi_file_t *file,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_get_read_ahead_size(
+     libvhdi_file_t *file,
+     size_t *read_ahead_size,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_set_read_ahead_size(
+     libvhdi_file_t *file,
+     size_t read_ahead_size,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_get_maximum_number_of_file_io_handles(
+     libvhdi_file_t *file,
+     int *maximum_number_of_file_io_handles,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_set_maximum_number_of_file_io_handles(
+     libvhdi_file_t *file,
+     int maximum_number_of_file_io_handles,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_set_index_filename(
+     libvhdi_file_t *file,
+     const char *filename,
+     libcerror_error_t **error );
+
+LIBVHDI_EXTERN \
+int libvhdi_file_write_index(
+     libvhdi_file_t *file,
+     const char *filename,
+     libcerror_error_t **error );
+
 LIBVHDI_EXTERN \
 int libvhdi_file_get_file_type(
      libvhdi_file_t *file,
@@ -268,6 +622,12 @@ int libvhdi_file_get_bytes_per_sector(
      uint32_t *bytes_per_sector,
      libcerror_error_t **error );
 
+LIBVHDI_EXTERN \
+int libvhdi_file_get_block_size(
+     libvhdi_file_t *file,
+     uint32_t *block_size,
+     libcerror_error_t **error );
+
 LIBVHDI_EXTERN \
 int libvhdi_file_get_identifier(
      libvhdi_file_t *file,
@@ -0,0 +1,609 @@
+/*
+ * File IO handle pool functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvhdi_definitions.h"
+#include "libvhdi_file_io_handle_pool.h"
+#include "libvhdi_libbfio.h"
+#include "libvhdi_libcerror.h"
+#include "libvhdi_libcthreads.h"
+
+/* Creates a file IO handle pool
+ * Make sure the value file_io_handle_pool is referencing, is set to NULL
+ * The file IO handle is not managed by the pool and should remain open while the pool is used
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_file_io_handle_pool_initialize(
+     libvhdi_file_io_handle_pool_t **file_io_handle_pool,
+     libbfio_handle_t *file_io_handle,
+     int maximum_number_of_file_io_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_file_io_handle_pool_initialize";
+
+	if( file_io_handle_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_file_io_handles <= 0 )
+	 || ( maximum_number_of_file_io_handles > LIBVHDI_MAXIMUM_NUMBER_OF_FILE_IO_HANDLES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of file IO handles value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*file_io_handle_pool = memory_allocate_structure(
+	                        libvhdi_file_io_handle_pool_t );
+
+	if( *file_io_handle_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file IO handle pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_io_handle_pool,
+	     0,
+	     sizeof( libvhdi_file_io_handle_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file IO handle pool.",
+		 function );
+
+		memory_free(
+		 *file_io_handle_pool );
+
+		*file_io_handle_pool = NULL;
+
+		return( -1 );
+	}
+	( *file_io_handle_pool )->file_io_handles = (libbfio_handle_t **) memory_allocate(
+	                                             sizeof( libbfio_handle_t * ) * maximum_number_of_file_io_handles );
+
+	if( ( *file_io_handle_pool )->file_io_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file IO handles.",
+		 function );
+
+		goto on_error;
+	}
+	( *file_io_handle_pool )->file_io_handles_in_use = (uint8_t *) memory_allocate(
+	                                                    sizeof( uint8_t ) * maximum_number_of_file_io_handles );
+
+	if( ( *file_io_handle_pool )->file_io_handles_in_use == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file IO handles in use.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *file_io_handle_pool )->file_io_handles_in_use,
+	     0,
+	     sizeof( uint8_t ) * maximum_number_of_file_io_handles ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file IO handles in use.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *file_io_handle_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *file_io_handle_pool )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *file_io_handle_pool )->file_io_handles[ 0 ]              = file_io_handle;
+	( *file_io_handle_pool )->number_of_file_io_handles         = 1;
+	( *file_io_handle_pool )->maximum_number_of_file_io_handles = maximum_number_of_file_io_handles;
+
+	return( 1 );
+
+on_error:
+	if( *file_io_handle_pool != NULL )
+	{
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+		if( ( *file_io_handle_pool )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *file_io_handle_pool )->mutex ),
+			 NULL );
+		}
+#endif
+		if( ( *file_io_handle_pool )->file_io_handles_in_use != NULL )
+		{
+			memory_free(
+			 ( *file_io_handle_pool )->file_io_handles_in_use );
+		}
+		if( ( *file_io_handle_pool )->file_io_handles != NULL )
+		{
+			memory_free(
+			 ( *file_io_handle_pool )->file_io_handles );
+		}
+		memory_free(
+		 *file_io_handle_pool );
+
+		*file_io_handle_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a file IO handle pool
+ * This closes and frees the cloned file IO handles, the file IO handles should not be in use
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_file_io_handle_pool_free(
+     libvhdi_file_io_handle_pool_t **file_io_handle_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_file_io_handle_pool_free";
+	int file_io_handle_index = 0;
+	int result               = 1;
+
+	if( file_io_handle_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle_pool != NULL )
+	{
+		/* The first file IO handle is not managed by the pool
+		 */
+		for( file_io_handle_index = 1;
+		     file_io_handle_index < ( *file_io_handle_pool )->number_of_file_io_handles;
+		     file_io_handle_index++ )
+		{
+			if( libbfio_handle_close(
+			     ( *file_io_handle_pool )->file_io_handles[ file_io_handle_index ],
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle: %d.",
+				 function,
+				 file_io_handle_index );
+
+				result = -1;
+			}
+			if( libbfio_handle_free(
+			     &( ( *file_io_handle_pool )->file_io_handles[ file_io_handle_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle: %d.",
+				 function,
+				 file_io_handle_index );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_condition_free(
+		     &( ( *file_io_handle_pool )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *file_io_handle_pool )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 ( *file_io_handle_pool )->file_io_handles_in_use );
+
+		memory_free(
+		 ( *file_io_handle_pool )->file_io_handles );
+
+		memory_free(
+		 *file_io_handle_pool );
+
+		*file_io_handle_pool = NULL;
+	}
+	return( result );
+}
+
+/* Grabs a file IO handle that is not in use by another thread
+ * Additional file IO handles are cloned from the first file IO handle when all
+ * file IO handles are in use, until the maximum number of file IO handles is reached,
+ * after which this function waits until a file IO handle is released
+ * If the first file IO handle cannot be cloned the pool is limited to the file IO handles it has
+ * Every grabbed file IO handle must be released with libvhdi_file_io_handle_pool_release_file_io_handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_file_io_handle_pool_grab_file_io_handle(
+     libvhdi_file_io_handle_pool_t *file_io_handle_pool,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function                   = "libvhdi_file_io_handle_pool_grab_file_io_handle";
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	libbfio_handle_t *cloned_file_io_handle = NULL;
+	libcerror_error_t *clone_error          = NULL;
+	int file_io_handle_index                = 0;
+	int result                              = 0;
+#endif
+
+	if( file_io_handle_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     file_io_handle_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( result == 0 )
+	{
+		for( file_io_handle_index = 0;
+		     file_io_handle_index < file_io_handle_pool->number_of_file_io_handles;
+		     file_io_handle_index++ )
+		{
+			if( file_io_handle_pool->file_io_handles_in_use[ file_io_handle_index ] == 0 )
+			{
+				result = 1;
+
+				break;
+			}
+		}
+		if( result != 0 )
+		{
+			break;
+		}
+		if( file_io_handle_pool->number_of_file_io_handles < file_io_handle_pool->maximum_number_of_file_io_handles )
+		{
+			/* The clone is opened while holding the mutex, since this only happens
+			 * until the maximum number of file IO handles is reached
+			 */
+			if( libbfio_handle_clone(
+			     &cloned_file_io_handle,
+			     file_io_handle_pool->file_io_handles[ 0 ],
+			     &clone_error ) == 1 )
+			{
+				result = libbfio_handle_is_open(
+				          cloned_file_io_handle,
+				          &clone_error );
+
+				if( result == 0 )
+				{
+					result = libbfio_handle_open(
+					          cloned_file_io_handle,
+					          LIBBFIO_OPEN_READ,
+					          &clone_error );
+				}
+			}
+			if( result == 1 )
+			{
+				file_io_handle_index = file_io_handle_pool->number_of_file_io_handles;
+
+				file_io_handle_pool->file_io_handles[ file_io_handle_index ] = cloned_file_io_handle;
+
+				file_io_handle_pool->number_of_file_io_handles += 1;
+
+				break;
+			}
+			/* The file IO handle does not support cloning, hence the pool is limited
+			 * to the file IO handles it already has
+			 */
+			if( cloned_file_io_handle != NULL )
+			{
+				libbfio_handle_free(
+				 &cloned_file_io_handle,
+				 NULL );
+			}
+			if( clone_error != NULL )
+			{
+				libcerror_error_free(
+				 &clone_error );
+			}
+			file_io_handle_pool->maximum_number_of_file_io_handles = file_io_handle_pool->number_of_file_io_handles;
+
+			result = 0;
+		}
+		if( libcthreads_condition_wait(
+		     file_io_handle_pool->condition,
+		     file_io_handle_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		file_io_handle_pool->file_io_handles_in_use[ file_io_handle_index ] = 1;
+
+		*file_io_handle = file_io_handle_pool->file_io_handles[ file_io_handle_index ];
+	}
+	if( libcthreads_mutex_release(
+	     file_io_handle_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+#else
+	/* Without multi-thread support there is no concurrent use of the file IO handle
+	 */
+	*file_io_handle = file_io_handle_pool->file_io_handles[ 0 ];
+
+	return( 1 );
+#endif
+}
+
+/* Releases a file IO handle grabbed from the pool
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_file_io_handle_pool_release_file_io_handle(
+     libvhdi_file_io_handle_pool_t *file_io_handle_pool,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function    = "libvhdi_file_io_handle_pool_release_file_io_handle";
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	int file_io_handle_index = 0;
+	int result               = 0;
+#endif
+
+	if( file_io_handle_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     file_io_handle_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	for( file_io_handle_index = 0;
+	     file_io_handle_index < file_io_handle_pool->number_of_file_io_handles;
+	     file_io_handle_index++ )
+	{
+		if( file_io_handle_pool->file_io_handles[ file_io_handle_index ] == file_io_handle )
+		{
+			result = 1;
+
+			break;
+		}
+	}
+	if( ( result == 0 )
+	 || ( file_io_handle_pool->file_io_handles_in_use[ file_io_handle_index ] == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle - not in use.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		file_io_handle_pool->file_io_handles_in_use[ file_io_handle_index ] = 0;
+
+		if( libcthreads_condition_signal(
+		     file_io_handle_pool->condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     file_io_handle_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+#else
+	return( 1 );
+#endif
+}
+
@@ -0,0 +1,93 @@
+/*
+ * File IO handle pool functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVHDI_FILE_IO_HANDLE_POOL_H )
+#define _LIBVHDI_FILE_IO_HANDLE_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvhdi_libbfio.h"
+#include "libvhdi_libcerror.h"
+#include "libvhdi_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvhdi_file_io_handle_pool libvhdi_file_io_handle_pool_t;
+
+struct libvhdi_file_io_handle_pool
+{
+	/* The file IO handles, where the first file IO handle is the file IO handle
+	 * the pool was created with and the others are clones of it
+	 */
+	libbfio_handle_t **file_io_handles;
+
+	/* Values to indicate if the file IO handles are in use
+	 */
+	uint8_t *file_io_handles_in_use;
+
+	/* The number of file IO handles
+	 */
+	int number_of_file_io_handles;
+
+	/* The maximum number of file IO handles
+	 */
+	int maximum_number_of_file_io_handles;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition, which is signalled when a file IO handle is released
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int libvhdi_file_io_handle_pool_initialize(
+     libvhdi_file_io_handle_pool_t **file_io_handle_pool,
+     libbfio_handle_t *file_io_handle,
+     int maximum_number_of_file_io_handles,
+     libcerror_error_t **error );
+
+int libvhdi_file_io_handle_pool_free(
+     libvhdi_file_io_handle_pool_t **file_io_handle_pool,
+     libcerror_error_t **error );
+
+int libvhdi_file_io_handle_pool_grab_file_io_handle(
+     libvhdi_file_io_handle_pool_t *file_io_handle_pool,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int libvhdi_file_io_handle_pool_release_file_io_handle(
+     libvhdi_file_io_handle_pool_t *file_io_handle_pool,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVHDI_FILE_IO_HANDLE_POOL_H ) */
+
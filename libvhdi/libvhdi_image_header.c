@@ -149,8 +149,6 @@ int libvhdi_image_header_read_data(
 	static char *function = "libvhdi_image_header_read_data";
 
 #if defined( HAVE_DEBUG_OUTPUT )
-	uint64_t value_64bit  = 0;
-	uint32_t value_32bit  = 0;
 	uint16_t value_16bit  = 0;
 #endif
 
@@ -265,6 +263,28 @@ int libvhdi_image_header_read_data(
 
 		return( -1 );
 	}
+	if( memory_copy(
+	     image_header->log_identifier,
+	     ( (vhdi_image_header_t *) data )->log_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy log identifier.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vhdi_image_header_t *) data )->log_size,
+	 image_header->log_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vhdi_image_header_t *) data )->log_offset,
+	 image_header->log_offset );
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -354,21 +374,15 @@ int libvhdi_image_header_read_data(
 		 function,
 		 image_header->format_version );
 
-		byte_stream_copy_to_uint32_little_endian(
-		 ( (vhdi_image_header_t *) data )->log_size,
-		 value_32bit );
 		libcnotify_printf(
 		 "%s: log size\t\t\t\t: %" PRIu32 "\n",
 		 function,
-		 value_32bit );
+		 image_header->log_size );
 
-		byte_stream_copy_to_uint64_little_endian(
-		 ( (vhdi_image_header_t *) data )->log_offset,
-		 value_64bit );
 		libcnotify_printf(
 		 "%s: log offset\t\t\t\t: %" PRIu64 "\n",
 		 function,
-		 value_64bit );
+		 image_header->log_offset );
 
 		libcnotify_printf(
 		 "%s: unknown1:\n",
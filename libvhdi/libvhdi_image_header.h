@@ -51,6 +51,18 @@ struct libvhdi_image_header
 	/* The data write identifier
 	 */
 	uint8_t data_write_identifier[ 16 ];
+
+	/* The log identifier, which is stored as on-disk (little-endian) GUID
+	 */
+	uint8_t log_identifier[ 16 ];
+
+	/* The log size
+	 */
+	uint32_t log_size;
+
+	/* The log offset
+	 */
+	uint64_t log_offset;
 };
 
 int libvhdi_image_header_initialize(
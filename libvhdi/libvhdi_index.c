@@ -0,0 +1,1039 @@
+/*
+ * Sidecar index functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#include "libvhdi_block_allocation_table.h"
+#include "libvhdi_checksum.h"
+#include "libvhdi_definitions.h"
+#include "libvhdi_index.h"
+#include "libvhdi_libbfio.h"
+#include "libvhdi_libcerror.h"
+#include "libvhdi_libcnotify.h"
+#include "libvhdi_memory_map.h"
+
+#include "vhdi_index.h"
+
+/* Creates an index
+ * Make sure the value index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_index_initialize(
+     libvhdi_index_t **index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_index_initialize";
+
+	if( index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*index = memory_allocate_structure(
+	          libvhdi_index_t );
+
+	if( *index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *index,
+	     0,
+	     sizeof( libvhdi_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *index != NULL )
+	{
+		memory_free(
+		 *index );
+
+		*index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an index
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_index_free(
+     libvhdi_index_t **index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_index_free";
+
+	if( index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index != NULL )
+	{
+		memory_free(
+		 *index );
+
+		*index = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads the index data into the block allocation table
+ * The index values and the block allocation table geometry must be set before the call
+ * The entries are stored in native byte order and are not copied, the block allocation
+ * table references them in the index data, which must remain valid while the table is used
+ * Returns 1 if successful, 0 if the index data does not match the index values or -1 on error
+ */
+int libvhdi_index_read_data(
+     libvhdi_index_t *index,
+     libvhdi_block_allocation_table_t *block_allocation_table,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function                      = "libvhdi_index_read_data";
+	size_t data_offset                         = 0;
+	size64_t file_size                         = 0;
+	uint64_t expected_data_size                = 0;
+	uint64_t value_64bit                       = 0;
+	uint32_t block_size                        = 0;
+	uint32_t byte_order                        = 0;
+	uint32_t bytes_per_sector                  = 0;
+	uint32_t calculated_checksum               = 0;
+	uint32_t disk_type                         = 0;
+	uint32_t expected_number_of_sector_bitmaps = 0;
+	uint32_t file_type                         = 0;
+	uint32_t format_version                    = 0;
+	uint32_t number_of_entries                 = 0;
+	uint32_t number_of_sector_bitmaps          = 0;
+	uint32_t stored_checksum                   = 0;
+	off64_t block_allocation_table_offset      = 0;
+
+	if( index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_allocation_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block allocation table.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_allocation_table->block_file_offsets != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block allocation table - block file offsets value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < sizeof( vhdi_index_header_t ) )
+	{
+		return( 0 );
+	}
+	if( memory_compare(
+	     ( (vhdi_index_header_t *) data )->signature,
+	     "vhdindex",
+	     8 ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vhdi_index_header_t *) data )->format_version,
+	 format_version );
+
+	/* The byte order mark is stored in the byte order of the system that wrote the index
+	 */
+	if( memory_copy(
+	     &byte_order,
+	     ( (vhdi_index_header_t *) data )->byte_order,
+	     4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy byte order.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vhdi_index_header_t *) data )->file_type,
+	 file_type );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vhdi_index_header_t *) data )->disk_type,
+	 disk_type );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vhdi_index_header_t *) data )->block_size,
+	 block_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vhdi_index_header_t *) data )->bytes_per_sector,
+	 bytes_per_sector );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vhdi_index_header_t *) data )->number_of_entries,
+	 number_of_entries );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vhdi_index_header_t *) data )->number_of_sector_bitmaps,
+	 number_of_sector_bitmaps );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vhdi_index_header_t *) data )->file_size,
+	 file_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vhdi_index_header_t *) data )->block_allocation_table_offset,
+	 value_64bit );
+
+	block_allocation_table_offset = (off64_t) value_64bit;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vhdi_index_header_t *) data )->checksum,
+	 stored_checksum );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: format version\t\t\t: %" PRIu32 "\n",
+		 function,
+		 format_version );
+
+		libcnotify_printf(
+		 "%s: byte order\t\t\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 byte_order );
+
+		libcnotify_printf(
+		 "%s: number of entries\t\t\t: %" PRIu32 "\n",
+		 function,
+		 number_of_entries );
+
+		libcnotify_printf(
+		 "%s: number of sector bitmaps\t\t: %" PRIu32 "\n",
+		 function,
+		 number_of_sector_bitmaps );
+
+		libcnotify_printf(
+		 "%s: file size\t\t\t\t: %" PRIu64 "\n",
+		 function,
+		 file_size );
+
+		libcnotify_printf(
+		 "%s: checksum\t\t\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 stored_checksum );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+	/* An index written by an earlier format version or on a system with a different
+	 * byte order is treated as stale and is rewritten
+	 */
+	if( ( format_version != 2 )
+	 || ( byte_order != 0x01020304UL ) )
+	{
+		return( 0 );
+	}
+	/* The index is stale if the image or its parent changed since the index was written
+	 */
+	if( ( (int) file_type != index->file_type )
+	 || ( disk_type != index->disk_type )
+	 || ( block_size != index->block_size )
+	 || ( bytes_per_sector != index->bytes_per_sector )
+	 || ( file_size != index->file_size )
+	 || ( block_allocation_table_offset != index->block_allocation_table_offset ) )
+	{
+		return( 0 );
+	}
+	if( memory_compare(
+	     ( (vhdi_index_header_t *) data )->identifier,
+	     index->identifier,
+	     16 ) != 0 )
+	{
+		return( 0 );
+	}
+	if( memory_compare(
+	     ( (vhdi_index_header_t *) data )->parent_identifier,
+	     index->parent_identifier,
+	     16 ) != 0 )
+	{
+		return( 0 );
+	}
+	if( ( block_allocation_table->file_type == LIBVHDI_FILE_TYPE_VHDX )
+	 && ( block_allocation_table->disk_type == LIBVHDI_DISK_TYPE_DIFFERENTIAL ) )
+	{
+		expected_number_of_sector_bitmaps = block_allocation_table->number_of_chunks;
+	}
+	if( ( number_of_entries == 0 )
+	 || ( number_of_entries != block_allocation_table->number_of_entries )
+	 || ( number_of_sector_bitmaps != expected_number_of_sector_bitmaps ) )
+	{
+		return( 0 );
+	}
+	expected_data_size = sizeof( vhdi_index_header_t )
+	                   + ( (uint64_t) number_of_entries * ( sizeof( off64_t ) + sizeof( uint8_t ) ) )
+	                   + ( (uint64_t) number_of_sector_bitmaps * sizeof( off64_t ) );
+
+	if( expected_data_size != (uint64_t) data_size )
+	{
+		return( 0 );
+	}
+	if( libvhdi_checksum_calculate_crc32(
+	     &calculated_checksum,
+	     data,
+	     sizeof( vhdi_index_header_t ) - 4,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate CRC-32.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_checksum_calculate_crc32(
+	     &calculated_checksum,
+	     &( data[ sizeof( vhdi_index_header_t ) ] ),
+	     data_size - sizeof( vhdi_index_header_t ),
+	     calculated_checksum,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate CRC-32.",
+		 function );
+
+		return( -1 );
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		return( 0 );
+	}
+	/* The offsets are referenced in place and must be aligned for off64_t
+	 */
+	data_offset = sizeof( vhdi_index_header_t );
+
+	if( ( (intptr_t) &( data[ data_offset ] ) % sizeof( off64_t ) ) != 0 )
+	{
+		return( 0 );
+	}
+	block_allocation_table->block_file_offsets = (off64_t *) &( data[ data_offset ] );
+
+	data_offset += (size_t) number_of_entries * sizeof( off64_t );
+
+	if( number_of_sector_bitmaps > 0 )
+	{
+		block_allocation_table->sector_bitmap_file_offsets = (off64_t *) &( data[ data_offset ] );
+
+		data_offset += (size_t) number_of_sector_bitmaps * sizeof( off64_t );
+	}
+	block_allocation_table->block_states = (uint8_t *) &( data[ data_offset ] );
+
+	return( 1 );
+}
+
+/* Reads an index file into the block allocation table
+ * The index file is memory mapped and the block allocation table takes ownership
+ * of the memory map, since its entries reference the mapped data
+ * Returns 1 if successful, 0 if the index file does not exist or is stale or -1 on error
+ */
+int libvhdi_index_read_file(
+     libvhdi_index_t *index,
+     libvhdi_block_allocation_table_t *block_allocation_table,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libvhdi_memory_map_t *memory_map = NULL;
+	static char *function            = "libvhdi_index_read_file";
+	size_t filename_length           = 0;
+	int result                       = 0;
+
+	if( block_allocation_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block allocation table.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_allocation_table->memory_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block allocation table - memory map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = libbfio_handle_exists(
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if index file exists.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libvhdi_memory_map_initialize(
+	     &memory_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create memory map.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvhdi_memory_map_open(
+	     memory_map,
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to memory map index file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	result = libvhdi_index_read_data(
+	          index,
+	          block_allocation_table,
+	          memory_map->data,
+	          memory_map->data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index data.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != 0 )
+	{
+		block_allocation_table->memory_map = memory_map;
+	}
+	else if( libvhdi_memory_map_free(
+	          &memory_map,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free memory map.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( memory_map != NULL )
+	{
+		libvhdi_memory_map_free(
+		 &memory_map,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the block allocation table to an index file
+ * An existing index file is overwritten
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_index_write_file(
+     libvhdi_index_t *index,
+     libvhdi_block_allocation_table_t *block_allocation_table,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle  = NULL;
+	uint8_t *data                     = NULL;
+	static char *function             = "libvhdi_index_write_file";
+	size_t data_offset                = 0;
+	size_t data_size                  = 0;
+	size_t filename_length            = 0;
+	ssize_t write_count               = 0;
+	uint32_t byte_order               = 0x01020304UL;
+	uint64_t index_data_size          = 0;
+	uint32_t calculated_checksum      = 0;
+	uint32_t number_of_entries        = 0;
+	uint32_t number_of_sector_bitmaps = 0;
+
+	if( index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	/* An image without block allocation table, or with a table that is too large
+	 * to be decoded, is written as an index without entries
+	 */
+	if( ( block_allocation_table != NULL )
+	 && ( block_allocation_table->block_file_offsets != NULL )
+	 && ( block_allocation_table->block_states != NULL ) )
+	{
+		number_of_entries = block_allocation_table->number_of_entries;
+
+		if( block_allocation_table->sector_bitmap_file_offsets != NULL )
+		{
+			number_of_sector_bitmaps = block_allocation_table->number_of_chunks;
+		}
+	}
+	index_data_size = sizeof( vhdi_index_header_t )
+	                + ( (uint64_t) number_of_entries * ( sizeof( off64_t ) + sizeof( uint8_t ) ) )
+	                + ( (uint64_t) number_of_sector_bitmaps * sizeof( off64_t ) );
+
+	if( index_data_size > (uint64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid index data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	data_size = (size_t) index_data_size;
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     sizeof( vhdi_index_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index header.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     ( (vhdi_index_header_t *) data )->signature,
+	     "vhdindex",
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (vhdi_index_header_t *) data )->format_version,
+	 2 );
+
+	if( memory_copy(
+	     ( (vhdi_index_header_t *) data )->byte_order,
+	     &byte_order,
+	     4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy byte order.",
+		 function );
+
+		goto on_error;
+	}
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (vhdi_index_header_t *) data )->file_type,
+	 (uint32_t) index->file_type );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (vhdi_index_header_t *) data )->disk_type,
+	 index->disk_type );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (vhdi_index_header_t *) data )->block_size,
+	 index->block_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (vhdi_index_header_t *) data )->bytes_per_sector,
+	 index->bytes_per_sector );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (vhdi_index_header_t *) data )->number_of_entries,
+	 number_of_entries );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (vhdi_index_header_t *) data )->number_of_sector_bitmaps,
+	 number_of_sector_bitmaps );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (vhdi_index_header_t *) data )->file_size,
+	 index->file_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (vhdi_index_header_t *) data )->block_allocation_table_offset,
+	 (uint64_t) index->block_allocation_table_offset );
+
+	if( memory_copy(
+	     ( (vhdi_index_header_t *) data )->identifier,
+	     index->identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy identifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     ( (vhdi_index_header_t *) data )->parent_identifier,
+	     index->parent_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy parent identifier.",
+		 function );
+
+		goto on_error;
+	}
+	/* The entries are stored in native byte order so that they can be referenced
+	 * in place when the index file is memory mapped
+	 */
+	data_offset = sizeof( vhdi_index_header_t );
+
+	if( number_of_entries > 0 )
+	{
+		if( memory_copy(
+		     &( data[ data_offset ] ),
+		     block_allocation_table->block_file_offsets,
+		     (size_t) number_of_entries * sizeof( off64_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy block file offsets.",
+			 function );
+
+			goto on_error;
+		}
+		data_offset += (size_t) number_of_entries * sizeof( off64_t );
+	}
+	if( number_of_sector_bitmaps > 0 )
+	{
+		if( memory_copy(
+		     &( data[ data_offset ] ),
+		     block_allocation_table->sector_bitmap_file_offsets,
+		     (size_t) number_of_sector_bitmaps * sizeof( off64_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy sector bitmap file offsets.",
+			 function );
+
+			goto on_error;
+		}
+		data_offset += (size_t) number_of_sector_bitmaps * sizeof( off64_t );
+	}
+	if( number_of_entries > 0 )
+	{
+		if( memory_copy(
+		     &( data[ data_offset ] ),
+		     block_allocation_table->block_states,
+		     (size_t) number_of_entries ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy block states.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvhdi_checksum_calculate_crc32(
+	     &calculated_checksum,
+	     data,
+	     sizeof( vhdi_index_header_t ) - 4,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate CRC-32.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvhdi_checksum_calculate_crc32(
+	     &calculated_checksum,
+	     &( data[ sizeof( vhdi_index_header_t ) ] ),
+	     data_size - sizeof( vhdi_index_header_t ),
+	     calculated_checksum,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate CRC-32.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (vhdi_index_header_t *) data )->checksum,
+	 calculated_checksum );
+
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               data,
+	               data_size,
+	               error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close index file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
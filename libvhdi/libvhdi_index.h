@@ -0,0 +1,104 @@
+/*
+ * Sidecar index functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVHDI_INDEX_H )
+#define _LIBVHDI_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvhdi_block_allocation_table.h"
+#include "libvhdi_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvhdi_index libvhdi_index_t;
+
+struct libvhdi_index
+{
+	/* The file type
+	 */
+	int file_type;
+
+	/* The disk type
+	 */
+	uint32_t disk_type;
+
+	/* The block size
+	 */
+	uint32_t block_size;
+
+	/* The number of bytes per sector
+	 */
+	uint32_t bytes_per_sector;
+
+	/* The image file size
+	 */
+	size64_t file_size;
+
+	/* The block allocation table file offset
+	 */
+	off64_t block_allocation_table_offset;
+
+	/* The image identifier
+	 */
+	uint8_t identifier[ 16 ];
+
+	/* The parent identifier
+	 */
+	uint8_t parent_identifier[ 16 ];
+};
+
+int libvhdi_index_initialize(
+     libvhdi_index_t **index,
+     libcerror_error_t **error );
+
+int libvhdi_index_free(
+     libvhdi_index_t **index,
+     libcerror_error_t **error );
+
+int libvhdi_index_read_data(
+     libvhdi_index_t *index,
+     libvhdi_block_allocation_table_t *block_allocation_table,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvhdi_index_read_file(
+     libvhdi_index_t *index,
+     libvhdi_block_allocation_table_t *block_allocation_table,
+     const char *filename,
+     libcerror_error_t **error );
+
+int libvhdi_index_write_file(
+     libvhdi_index_t *index,
+     libvhdi_block_allocation_table_t *block_allocation_table,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVHDI_INDEX_H ) */
+
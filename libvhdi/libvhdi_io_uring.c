@@ -0,0 +1,1073 @@
+/*
+ * io_uring functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include <errno.h>
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_LINUX_IO_URING_H ) && defined( HAVE_SYS_SYSCALL_H )
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+
+#include "libvhdi_io_uring.h"
+#include "libvhdi_libcerror.h"
+
+/* The io_uring system calls are used directly, instead of liburing, and require
+ * IORING_OP_READ which is supported by kernels that support IORING_FEAT_RW_CUR_POS
+ */
+#if defined( HAVE_LINUX_IO_URING_H ) && defined( HAVE_SYS_SYSCALL_H ) && defined( HAVE_SYS_MMAN_H ) && defined( HAVE_SYSCALL ) && defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && defined( HAVE_OPEN ) && defined( HAVE_CLOSE )
+#if defined( __NR_io_uring_setup ) && defined( __NR_io_uring_enter ) && defined( IORING_FEAT_RW_CUR_POS ) && defined( __GNUC__ )
+#define LIBVHDI_HAVE_IO_URING	1
+#endif
+#endif
+
+/* Creates an io_uring
+ * Make sure the value io_uring is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_io_uring_initialize(
+     libvhdi_io_uring_t **io_uring,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_io_uring_initialize";
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_uring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid io_uring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*io_uring = memory_allocate_structure(
+	             libvhdi_io_uring_t );
+
+	if( *io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create io_uring.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *io_uring,
+	     0,
+	     sizeof( libvhdi_io_uring_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear io_uring.",
+		 function );
+
+		goto on_error;
+	}
+	( *io_uring )->file_descriptor = -1;
+	( *io_uring )->ring_descriptor = -1;
+
+	return( 1 );
+
+on_error:
+	if( *io_uring != NULL )
+	{
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an io_uring
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_io_uring_free(
+     libvhdi_io_uring_t **io_uring,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_io_uring_free";
+	int result            = 1;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_uring != NULL )
+	{
+		if( libvhdi_io_uring_close(
+		     *io_uring,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to close io_uring.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+	}
+	return( result );
+}
+
+/* Opens a file for reading and sets up the io_uring
+ * The io_uring is not available if it is not supported on this platform,
+ * or by the kernel, or if its use is not permitted
+ * Returns 1 if successful, 0 if the io_uring is not available or -1 on error
+ */
+int libvhdi_io_uring_open(
+     libvhdi_io_uring_t *io_uring,
+     const char *filename,
+     uint32_t number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_io_uring_open";
+
+#if defined( LIBVHDI_HAVE_IO_URING )
+	struct io_uring_params parameters;
+
+	void *completion_ring    = NULL;
+	void *submission_entries = NULL;
+	void *submission_ring    = NULL;
+	int file_descriptor      = -1;
+	int flags                = O_RDONLY;
+	int mapping_flags        = MAP_SHARED;
+	int ring_descriptor      = -1;
+	int result               = -1;
+#endif
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_uring->ring_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid io_uring - ring descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of entries value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBVHDI_HAVE_IO_URING )
+	if( memory_set(
+	     &parameters,
+	     0,
+	     sizeof( struct io_uring_params ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear parameters.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( O_CLOEXEC )
+	flags |= O_CLOEXEC;
+#endif
+#if defined( MAP_POPULATE )
+	mapping_flags |= MAP_POPULATE;
+#endif
+	file_descriptor = open(
+	                   filename,
+	                   flags );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	ring_descriptor = (int) syscall(
+	                         __NR_io_uring_setup,
+	                         number_of_entries,
+	                         &parameters );
+
+	if( ring_descriptor == -1 )
+	{
+		/* The kernel does not support io_uring, or its use is not permitted,
+		 * for example by the kernel.io_uring_disabled sysctl or a seccomp filter
+		 */
+		if( ( errno == ENOSYS )
+		 || ( errno == EPERM )
+		 || ( errno == EACCES )
+		 || ( errno == EINVAL ) )
+		{
+			result = 0;
+		}
+		else
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 errno,
+			 "%s: unable to set up io_uring.",
+			 function );
+		}
+		goto on_error;
+	}
+	/* Kernels that do not support IORING_FEAT_RW_CUR_POS do not support IORING_OP_READ
+	 */
+	if( ( parameters.features & IORING_FEAT_RW_CUR_POS ) == 0 )
+	{
+		result = 0;
+
+		goto on_error;
+	}
+	io_uring->submission_ring_size    = (size_t) parameters.sq_off.array + ( parameters.sq_entries * sizeof( uint32_t ) );
+	io_uring->submission_entries_size = parameters.sq_entries * sizeof( struct io_uring_sqe );
+	io_uring->completion_ring_size    = (size_t) parameters.cq_off.cqes + ( parameters.cq_entries * sizeof( struct io_uring_cqe ) );
+
+	submission_ring = mmap(
+	                   NULL,
+	                   io_uring->submission_ring_size,
+	                   PROT_READ | PROT_WRITE,
+	                   mapping_flags,
+	                   ring_descriptor,
+	                   (off_t) IORING_OFF_SQ_RING );
+
+	if( submission_ring == MAP_FAILED )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 errno,
+		 "%s: unable to map submission queue ring.",
+		 function );
+
+		submission_ring = NULL;
+
+		goto on_error;
+	}
+	submission_entries = mmap(
+	                      NULL,
+	                      io_uring->submission_entries_size,
+	                      PROT_READ | PROT_WRITE,
+	                      mapping_flags,
+	                      ring_descriptor,
+	                      (off_t) IORING_OFF_SQES );
+
+	if( submission_entries == MAP_FAILED )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 errno,
+		 "%s: unable to map submission queue entries.",
+		 function );
+
+		submission_entries = NULL;
+
+		goto on_error;
+	}
+	completion_ring = mmap(
+	                   NULL,
+	                   io_uring->completion_ring_size,
+	                   PROT_READ | PROT_WRITE,
+	                   mapping_flags,
+	                   ring_descriptor,
+	                   (off_t) IORING_OFF_CQ_RING );
+
+	if( completion_ring == MAP_FAILED )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 errno,
+		 "%s: unable to map completion queue ring.",
+		 function );
+
+		completion_ring = NULL;
+
+		goto on_error;
+	}
+	io_uring->file_descriptor              = file_descriptor;
+	io_uring->ring_descriptor              = ring_descriptor;
+	io_uring->submission_ring              = (uint8_t *) submission_ring;
+	io_uring->submission_entries           = (uint8_t *) submission_entries;
+	io_uring->completion_ring              = (uint8_t *) completion_ring;
+	io_uring->submission_head              = (uint32_t *) &( io_uring->submission_ring[ parameters.sq_off.head ] );
+	io_uring->submission_tail              = (uint32_t *) &( io_uring->submission_ring[ parameters.sq_off.tail ] );
+	io_uring->submission_array             = (uint32_t *) &( io_uring->submission_ring[ parameters.sq_off.array ] );
+	io_uring->submission_mask              = *( (uint32_t *) &( io_uring->submission_ring[ parameters.sq_off.ring_mask ] ) );
+	io_uring->number_of_submission_entries = parameters.sq_entries;
+	io_uring->completion_head              = (uint32_t *) &( io_uring->completion_ring[ parameters.cq_off.head ] );
+	io_uring->completion_tail              = (uint32_t *) &( io_uring->completion_ring[ parameters.cq_off.tail ] );
+	io_uring->completion_entries           = &( io_uring->completion_ring[ parameters.cq_off.cqes ] );
+	io_uring->completion_mask              = *( (uint32_t *) &( io_uring->completion_ring[ parameters.cq_off.ring_mask ] ) );
+	io_uring->number_of_queued_reads       = 0;
+	io_uring->number_of_outstanding_reads  = 0;
+
+	return( 1 );
+
+on_error:
+	if( completion_ring != NULL )
+	{
+		munmap(
+		 completion_ring,
+		 io_uring->completion_ring_size );
+	}
+	if( submission_entries != NULL )
+	{
+		munmap(
+		 submission_entries,
+		 io_uring->submission_entries_size );
+	}
+	if( submission_ring != NULL )
+	{
+		munmap(
+		 submission_ring,
+		 io_uring->submission_ring_size );
+	}
+	if( ring_descriptor != -1 )
+	{
+		close(
+		 ring_descriptor );
+	}
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	io_uring->submission_ring_size    = 0;
+	io_uring->submission_entries_size = 0;
+	io_uring->completion_ring_size    = 0;
+
+	return( result );
+#else
+	return( 0 );
+#endif
+}
+
+/* Closes the io_uring and the file
+ * The reads must have completed before the io_uring is closed
+ * Returns 0 if successful or -1 on error
+ */
+int libvhdi_io_uring_close(
+     libvhdi_io_uring_t *io_uring,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_io_uring_close";
+	int result            = 0;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_uring->ring_descriptor == -1 )
+	{
+		return( 0 );
+	}
+#if defined( LIBVHDI_HAVE_IO_URING )
+	if( munmap(
+	     io_uring->completion_ring,
+	     io_uring->completion_ring_size ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to unmap completion queue ring.",
+		 function );
+
+		result = -1;
+	}
+	if( munmap(
+	     io_uring->submission_entries,
+	     io_uring->submission_entries_size ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to unmap submission queue entries.",
+		 function );
+
+		result = -1;
+	}
+	if( munmap(
+	     io_uring->submission_ring,
+	     io_uring->submission_ring_size ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to unmap submission queue ring.",
+		 function );
+
+		result = -1;
+	}
+	if( close(
+	     io_uring->ring_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close ring descriptor.",
+		 function );
+
+		result = -1;
+	}
+	if( close(
+	     io_uring->file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file descriptor.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	io_uring->file_descriptor              = -1;
+	io_uring->ring_descriptor              = -1;
+	io_uring->submission_ring              = NULL;
+	io_uring->submission_ring_size         = 0;
+	io_uring->submission_entries           = NULL;
+	io_uring->submission_entries_size      = 0;
+	io_uring->completion_ring              = NULL;
+	io_uring->completion_ring_size         = 0;
+	io_uring->submission_head              = NULL;
+	io_uring->submission_tail              = NULL;
+	io_uring->submission_array             = NULL;
+	io_uring->completion_head              = NULL;
+	io_uring->completion_tail              = NULL;
+	io_uring->completion_entries           = NULL;
+	io_uring->number_of_submission_entries = 0;
+	io_uring->number_of_queued_reads       = 0;
+	io_uring->number_of_outstanding_reads  = 0;
+
+	return( result );
+}
+
+/* Queues a read of the file at a specific (file) offset
+ * The read is added to the submission queue but not submitted to the kernel,
+ * which allows the reads that are queued at the same time to be submitted at once
+ * The user data is returned with the completion of the read
+ * This function is not multi-thread safe, the caller must serialize access to the io_uring
+ * Returns 1 if successful, 0 if the submission queue is full or -1 on error
+ */
+int libvhdi_io_uring_queue_read(
+     libvhdi_io_uring_t *io_uring,
+     void *buffer,
+     size_t buffer_size,
+     off64_t file_offset,
+     uint64_t user_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_io_uring_queue_read";
+
+#if defined( LIBVHDI_HAVE_IO_URING )
+	struct io_uring_sqe *entry = NULL;
+	uint32_t entry_index       = 0;
+	uint32_t submission_head   = 0;
+	uint32_t submission_tail   = 0;
+#endif
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_uring->ring_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid io_uring - missing ring descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	/* The result of a completion is a 32-bit signed integer
+	 */
+	if( buffer_size > (size_t) INT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBVHDI_HAVE_IO_URING )
+	/* The number of outstanding reads is limited to the number of submission queue entries
+	 * so that the completion queue, which is larger, cannot overflow
+	 */
+	if( io_uring->number_of_outstanding_reads >= io_uring->number_of_submission_entries )
+	{
+		return( 0 );
+	}
+	/* The submission queue head is updated by the kernel
+	 */
+	submission_head = __atomic_load_n(
+	                   io_uring->submission_head,
+	                   __ATOMIC_ACQUIRE );
+
+	submission_tail = *( io_uring->submission_tail );
+
+	if( ( submission_tail - submission_head ) >= io_uring->number_of_submission_entries )
+	{
+		return( 0 );
+	}
+	entry_index = submission_tail & io_uring->submission_mask;
+
+	entry = &( ( (struct io_uring_sqe *) io_uring->submission_entries )[ entry_index ] );
+
+	if( memory_set(
+	     entry,
+	     0,
+	     sizeof( struct io_uring_sqe ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear submission queue entry.",
+		 function );
+
+		return( -1 );
+	}
+	entry->opcode    = IORING_OP_READ;
+	entry->fd        = io_uring->file_descriptor;
+	entry->off       = (uint64_t) file_offset;
+	entry->addr      = (uint64_t) (uintptr_t) buffer;
+	entry->len       = (uint32_t) buffer_size;
+	entry->user_data = user_data;
+
+	io_uring->submission_array[ entry_index ] = entry_index;
+
+	/* The entry must be visible to the kernel before the tail is updated
+	 */
+	__atomic_store_n(
+	 io_uring->submission_tail,
+	 submission_tail + 1,
+	 __ATOMIC_RELEASE );
+
+	io_uring->number_of_queued_reads      += 1;
+	io_uring->number_of_outstanding_reads += 1;
+
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: io_uring is not supported on this platform.",
+	 function );
+
+	return( -1 );
+#endif
+}
+
+/* Submits the queued reads to the kernel with a single system call
+ * If the minimum number of completions is set this function waits until at least
+ * that number of completions is available
+ * This function is not multi-thread safe, the caller must serialize access to the io_uring
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_io_uring_submit(
+     libvhdi_io_uring_t *io_uring,
+     uint32_t minimum_number_of_completions,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_io_uring_submit";
+
+#if defined( LIBVHDI_HAVE_IO_URING )
+	unsigned int flags    = 0;
+	int result            = 0;
+#endif
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_uring->ring_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid io_uring - missing ring descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( minimum_number_of_completions > io_uring->number_of_outstanding_reads )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid minimum number of completions value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBVHDI_HAVE_IO_URING )
+	if( minimum_number_of_completions > 0 )
+	{
+		flags = IORING_ENTER_GETEVENTS;
+	}
+	do
+	{
+		if( ( io_uring->number_of_queued_reads == 0 )
+		 && ( flags == 0 ) )
+		{
+			break;
+		}
+		result = (int) syscall(
+		                __NR_io_uring_enter,
+		                io_uring->ring_descriptor,
+		                io_uring->number_of_queued_reads,
+		                minimum_number_of_completions,
+		                flags,
+		                NULL,
+		                0 );
+
+		if( result == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to submit reads.",
+			 function );
+
+			return( -1 );
+		}
+		if( (uint32_t) result > io_uring->number_of_queued_reads )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of submitted reads value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( result == 0 )
+		 && ( io_uring->number_of_queued_reads > 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to submit reads.",
+			 function );
+
+			return( -1 );
+		}
+		io_uring->number_of_queued_reads -= (uint32_t) result;
+
+		/* The completions were waited for by the first system call
+		 */
+		flags = 0;
+
+		minimum_number_of_completions = 0;
+	}
+	while( io_uring->number_of_queued_reads > 0 );
+
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: io_uring is not supported on this platform.",
+	 function );
+
+	return( -1 );
+#endif
+}
+
+/* Waits until at least the minimum number of completions is available
+ * The reads must have been submitted before, the queued reads are not submitted
+ * This function does not change the io_uring and can be called concurrently with the other
+ * functions, except for close, which allows to wait without serializing access to the io_uring
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_io_uring_wait(
+     libvhdi_io_uring_t *io_uring,
+     uint32_t minimum_number_of_completions,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_io_uring_wait";
+
+#if defined( LIBVHDI_HAVE_IO_URING )
+	int result            = 0;
+#endif
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_uring->ring_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid io_uring - missing ring descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBVHDI_HAVE_IO_URING )
+	if( minimum_number_of_completions == 0 )
+	{
+		return( 1 );
+	}
+	do
+	{
+		result = (int) syscall(
+		                __NR_io_uring_enter,
+		                io_uring->ring_descriptor,
+		                0,
+		                minimum_number_of_completions,
+		                IORING_ENTER_GETEVENTS,
+		                NULL,
+		                0 );
+	}
+	while( ( result == -1 )
+	    && ( errno == EINTR ) );
+
+	if( result == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 errno,
+		 "%s: unable to wait for completions.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: io_uring is not supported on this platform.",
+	 function );
+
+	return( -1 );
+#endif
+}
+
+/* Retrieves the available completions of submitted reads
+ * The user data and result of every completion are stored in user_data and results,
+ * where the result is the number of bytes read or a negative errno value if the read failed
+ * This function is not multi-thread safe, the caller must serialize access to the io_uring
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_io_uring_get_completions(
+     libvhdi_io_uring_t *io_uring,
+     uint64_t *user_data,
+     int32_t *results,
+     int maximum_number_of_completions,
+     int *number_of_completions,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_io_uring_get_completions";
+
+#if defined( LIBVHDI_HAVE_IO_URING )
+	struct io_uring_cqe *entry = NULL;
+	uint32_t completion_head   = 0;
+	uint32_t completion_tail   = 0;
+	int completion_index       = 0;
+#endif
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_uring->ring_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid io_uring - missing ring descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( user_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid user data.",
+		 function );
+
+		return( -1 );
+	}
+	if( results == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid results.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_completions <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of completions value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_completions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of completions.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBVHDI_HAVE_IO_URING )
+	completion_head = *( io_uring->completion_head );
+
+	/* The completion queue tail is updated by the kernel
+	 */
+	completion_tail = __atomic_load_n(
+	                   io_uring->completion_tail,
+	                   __ATOMIC_ACQUIRE );
+
+	while( ( completion_head != completion_tail )
+	    && ( completion_index < maximum_number_of_completions ) )
+	{
+		entry = &( ( (struct io_uring_cqe *) io_uring->completion_entries )[ completion_head & io_uring->completion_mask ] );
+
+		user_data[ completion_index ] = entry->user_data;
+		results[ completion_index ]   = entry->res;
+
+		completion_head++;
+		completion_index++;
+	}
+	/* The entries must have been read before the kernel can reuse them
+	 */
+	__atomic_store_n(
+	 io_uring->completion_head,
+	 completion_head,
+	 __ATOMIC_RELEASE );
+
+	if( (uint32_t) completion_index > io_uring->number_of_outstanding_reads )
+	{
+		io_uring->number_of_outstanding_reads = 0;
+	}
+	else
+	{
+		io_uring->number_of_outstanding_reads -= (uint32_t) completion_index;
+	}
+	*number_of_completions = completion_index;
+
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: io_uring is not supported on this platform.",
+	 function );
+
+	return( -1 );
+#endif
+}
+
@@ -0,0 +1,152 @@
+/*
+ * io_uring functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVHDI_IO_URING_H )
+#define _LIBVHDI_IO_URING_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvhdi_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvhdi_io_uring libvhdi_io_uring_t;
+
+struct libvhdi_io_uring
+{
+	/* The file descriptor of the file that is read
+	 */
+	int file_descriptor;
+
+	/* The file descriptor of the io_uring
+	 */
+	int ring_descriptor;
+
+	/* The mapped submission queue ring
+	 */
+	uint8_t *submission_ring;
+
+	/* The mapped submission queue ring size
+	 */
+	size_t submission_ring_size;
+
+	/* The mapped submission queue entries
+	 */
+	uint8_t *submission_entries;
+
+	/* The mapped submission queue entries size
+	 */
+	size_t submission_entries_size;
+
+	/* The mapped completion queue ring
+	 */
+	uint8_t *completion_ring;
+
+	/* The mapped completion queue ring size
+	 */
+	size_t completion_ring_size;
+
+	/* The submission queue head, tail and array, which reference the submission queue ring
+	 */
+	uint32_t *submission_head;
+	uint32_t *submission_tail;
+	uint32_t *submission_array;
+
+	/* The submission queue index mask
+	 */
+	uint32_t submission_mask;
+
+	/* The number of submission queue entries
+	 */
+	uint32_t number_of_submission_entries;
+
+	/* The completion queue head, tail and entries, which reference the completion queue ring
+	 */
+	uint32_t *completion_head;
+	uint32_t *completion_tail;
+	uint8_t *completion_entries;
+
+	/* The completion queue index mask
+	 */
+	uint32_t completion_mask;
+
+	/* The number of queued reads that were not yet submitted
+	 */
+	uint32_t number_of_queued_reads;
+
+	/* The number of queued reads whose completion was not yet retrieved
+	 */
+	uint32_t number_of_outstanding_reads;
+};
+
+int libvhdi_io_uring_initialize(
+     libvhdi_io_uring_t **io_uring,
+     libcerror_error_t **error );
+
+int libvhdi_io_uring_free(
+     libvhdi_io_uring_t **io_uring,
+     libcerror_error_t **error );
+
+int libvhdi_io_uring_open(
+     libvhdi_io_uring_t *io_uring,
+     const char *filename,
+     uint32_t number_of_entries,
+     libcerror_error_t **error );
+
+int libvhdi_io_uring_close(
+     libvhdi_io_uring_t *io_uring,
+     libcerror_error_t **error );
+
+int libvhdi_io_uring_queue_read(
+     libvhdi_io_uring_t *io_uring,
+     void *buffer,
+     size_t buffer_size,
+     off64_t file_offset,
+     uint64_t user_data,
+     libcerror_error_t **error );
+
+int libvhdi_io_uring_submit(
+     libvhdi_io_uring_t *io_uring,
+     uint32_t minimum_number_of_completions,
+     libcerror_error_t **error );
+
+int libvhdi_io_uring_wait(
+     libvhdi_io_uring_t *io_uring,
+     uint32_t minimum_number_of_completions,
+     libcerror_error_t **error );
+
+int libvhdi_io_uring_get_completions(
+     libvhdi_io_uring_t *io_uring,
+     uint64_t *user_data,
+     int32_t *results,
+     int maximum_number_of_completions,
+     int *number_of_completions,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVHDI_IO_URING_H ) */
+
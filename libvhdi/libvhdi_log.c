@@ -0,0 +1,1569 @@
+/*
+ * VHDX log functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvhdi_checksum.h"
+#include "libvhdi_definitions.h"
+#include "libvhdi_libbfio.h"
+#include "libvhdi_libcerror.h"
+#include "libvhdi_libcnotify.h"
+#include "libvhdi_log.h"
+
+#include "vhdi_log.h"
+
+/* Creates a log
+ * Make sure the value log is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_log_initialize(
+     libvhdi_log_t **log,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_log_initialize";
+
+	if( log == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log.",
+		 function );
+
+		return( -1 );
+	}
+	if( *log != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid log value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*log = memory_allocate_structure(
+	        libvhdi_log_t );
+
+	if( *log == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create log.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *log,
+	     0,
+	     sizeof( libvhdi_log_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear log.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *log != NULL )
+	{
+		memory_free(
+		 *log );
+
+		*log = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a log
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_log_free(
+     libvhdi_log_t **log,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_log_free";
+
+	if( log == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log.",
+		 function );
+
+		return( -1 );
+	}
+	if( *log != NULL )
+	{
+		if( ( *log )->ranges != NULL )
+		{
+			memory_free(
+			 ( *log )->ranges );
+		}
+		if( ( *log )->wrapped_entry_data != NULL )
+		{
+			memory_free(
+			 ( *log )->wrapped_entry_data );
+		}
+		if( ( *log )->data != NULL )
+		{
+			memory_free(
+			 ( *log )->data );
+		}
+		memory_free(
+		 *log );
+
+		*log = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the data of the log entry at a specific offset
+ * The log is a circular buffer, the data of a log entry that wraps around the end of the log
+ * is copied into the wrapped entry data of the log, which is reused for the next wrapped log entry
+ * Returns 1 if successful, 0 if the offset does not contain a log entry header or -1 on error
+ */
+int libvhdi_log_get_entry_data(
+     libvhdi_log_t *log,
+     size_t entry_offset,
+     uint8_t **entry_data,
+     size_t *entry_data_size,
+     libcerror_error_t **error )
+{
+	void *reallocation    = NULL;
+	static char *function = "libvhdi_log_get_entry_data";
+	size_t leading_size   = 0;
+	uint32_t entry_size   = 0;
+
+	if( log == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log.",
+		 function );
+
+		return( -1 );
+	}
+	if( log->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid log - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_offset >= log->data_size )
+	 || ( ( log->data_size - entry_offset ) < LIBVHDI_LOG_SECTOR_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry data.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry data size.",
+		 function );
+
+		return( -1 );
+	}
+	/* The log entry header is stored in the first sector of the log entry
+	 */
+	if( memory_compare(
+	     ( (vhdi_log_entry_header_t *) &( log->data[ entry_offset ] ) )->signature,
+	     "loge",
+	     4 ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vhdi_log_entry_header_t *) &( log->data[ entry_offset ] ) )->entry_size,
+	 entry_size );
+
+	if( ( entry_size == 0 )
+	 || ( ( entry_size % LIBVHDI_LOG_SECTOR_SIZE ) != 0 )
+	 || ( (size_t) entry_size > log->data_size ) )
+	{
+		return( 0 );
+	}
+	if( (size_t) entry_size <= ( log->data_size - entry_offset ) )
+	{
+		*entry_data      = &( log->data[ entry_offset ] );
+		*entry_data_size = (size_t) entry_size;
+
+		return( 1 );
+	}
+	if( (size_t) entry_size > log->wrapped_entry_data_size )
+	{
+		reallocation = memory_reallocate(
+		                log->wrapped_entry_data,
+		                sizeof( uint8_t ) * entry_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize wrapped entry data.",
+			 function );
+
+			return( -1 );
+		}
+		log->wrapped_entry_data      = (uint8_t *) reallocation;
+		log->wrapped_entry_data_size = (size_t) entry_size;
+	}
+	leading_size = log->data_size - entry_offset;
+
+	if( memory_copy(
+	     log->wrapped_entry_data,
+	     &( log->data[ entry_offset ] ),
+	     leading_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy leading entry data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     &( log->wrapped_entry_data[ leading_size ] ),
+	     log->data,
+	     (size_t) entry_size - leading_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy trailing entry data.",
+		 function );
+
+		return( -1 );
+	}
+	*entry_data      = log->wrapped_entry_data;
+	*entry_data_size = (size_t) entry_size;
+
+	return( 1 );
+}
+
+/* Checks if the log entry data contains a valid log entry
+ * A log entry is valid if its signature, log identifier, checksum, descriptors and data sectors are consistent
+ * Returns 1 if valid, 0 if not or -1 on error
+ */
+int libvhdi_log_check_entry_data(
+     const uint8_t *entry_data,
+     size_t entry_data_size,
+     size_t log_data_size,
+     const uint8_t *log_identifier,
+     uint32_t *tail_offset,
+     uint64_t *sequence_number,
+     libcerror_error_t **error )
+{
+	uint8_t empty_checksum[ 4 ]         = { 0, 0, 0, 0 };
+
+	const uint8_t *descriptor_data      = NULL;
+	const uint8_t *sector_data          = NULL;
+	static char *function               = "libvhdi_log_check_entry_data";
+	size_t descriptors_size             = 0;
+	size_t sector_offset                = 0;
+	uint64_t descriptor_sequence_number = 0;
+	uint64_t safe_sequence_number       = 0;
+	uint64_t value_64bit                = 0;
+	uint32_t calculated_checksum        = 0;
+	uint32_t descriptor_index           = 0;
+	uint32_t number_of_descriptors      = 0;
+	uint32_t safe_entry_size            = 0;
+	uint32_t safe_tail_offset           = 0;
+	uint32_t sequence_number_lower      = 0;
+	uint32_t sequence_number_upper      = 0;
+	uint32_t stored_checksum            = 0;
+
+	if( entry_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_data_size < LIBVHDI_LOG_SECTOR_SIZE )
+	 || ( entry_data_size > log_data_size )
+	 || ( log_data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( log_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( tail_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tail offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( sequence_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sequence number.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     ( (vhdi_log_entry_header_t *) entry_data )->signature,
+	     "loge",
+	     4 ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vhdi_log_entry_header_t *) entry_data )->checksum,
+	 stored_checksum );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vhdi_log_entry_header_t *) entry_data )->entry_size,
+	 safe_entry_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vhdi_log_entry_header_t *) entry_data )->tail_offset,
+	 safe_tail_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vhdi_log_entry_header_t *) entry_data )->sequence_number,
+	 safe_sequence_number );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vhdi_log_entry_header_t *) entry_data )->number_of_descriptors,
+	 number_of_descriptors );
+
+	/* A log entry that wraps around the end of the log is provided as contiguous entry data
+	 */
+	if( (size_t) safe_entry_size != entry_data_size )
+	{
+		return( 0 );
+	}
+	if( ( ( safe_tail_offset % LIBVHDI_LOG_SECTOR_SIZE ) != 0 )
+	 || ( (size_t) safe_tail_offset >= log_data_size ) )
+	{
+		return( 0 );
+	}
+	/* Log entries of a previous log have a different log identifier
+	 */
+	if( memory_compare(
+	     ( (vhdi_log_entry_header_t *) entry_data )->log_identifier,
+	     log_identifier,
+	     16 ) != 0 )
+	{
+		return( 0 );
+	}
+	if( number_of_descriptors > ( ( safe_entry_size - sizeof( vhdi_log_entry_header_t ) ) / sizeof( vhdi_log_data_descriptor_t ) ) )
+	{
+		return( 0 );
+	}
+	descriptors_size = sizeof( vhdi_log_entry_header_t )
+	                 + ( (size_t) number_of_descriptors * sizeof( vhdi_log_data_descriptor_t ) );
+
+	if( ( descriptors_size % LIBVHDI_LOG_SECTOR_SIZE ) != 0 )
+	{
+		descriptors_size += LIBVHDI_LOG_SECTOR_SIZE - ( descriptors_size % LIBVHDI_LOG_SECTOR_SIZE );
+	}
+	/* The checksum is calculated over the entry with the checksum value set to 0
+	 */
+	if( libvhdi_checksum_calculate_crc32(
+	     &calculated_checksum,
+	     entry_data,
+	     4,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate CRC-32.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_checksum_calculate_crc32(
+	     &calculated_checksum,
+	     empty_checksum,
+	     4,
+	     calculated_checksum,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate CRC-32.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_checksum_calculate_crc32(
+	     &calculated_checksum,
+	     &( entry_data[ 8 ] ),
+	     (size_t) safe_entry_size - 8,
+	     calculated_checksum,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate CRC-32.",
+		 function );
+
+		return( -1 );
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		return( 0 );
+	}
+	sector_offset = descriptors_size;
+
+	for( descriptor_index = 0;
+	     descriptor_index < number_of_descriptors;
+	     descriptor_index++ )
+	{
+		descriptor_data = &( entry_data[ sizeof( vhdi_log_entry_header_t ) + ( descriptor_index * sizeof( vhdi_log_data_descriptor_t ) ) ] );
+
+		if( memory_compare(
+		     descriptor_data,
+		     "desc",
+		     4 ) == 0 )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (vhdi_log_data_descriptor_t *) descriptor_data )->file_offset,
+			 value_64bit );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (vhdi_log_data_descriptor_t *) descriptor_data )->sequence_number,
+			 descriptor_sequence_number );
+
+			if( sector_offset >= (size_t) safe_entry_size )
+			{
+				return( 0 );
+			}
+			sector_data = &( entry_data[ sector_offset ] );
+
+			if( memory_compare(
+			     ( (vhdi_log_data_sector_t *) sector_data )->signature,
+			     "data",
+			     4 ) != 0 )
+			{
+				return( 0 );
+			}
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (vhdi_log_data_sector_t *) sector_data )->sequence_number_upper,
+			 sequence_number_upper );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (vhdi_log_data_sector_t *) sector_data )->sequence_number_lower,
+			 sequence_number_lower );
+
+			if( ( sequence_number_upper != (uint32_t) ( safe_sequence_number >> 32 ) )
+			 || ( sequence_number_lower != (uint32_t) ( safe_sequence_number & 0xffffffffUL ) ) )
+			{
+				return( 0 );
+			}
+			sector_offset += LIBVHDI_LOG_SECTOR_SIZE;
+		}
+		else if( memory_compare(
+		          descriptor_data,
+		          "zero",
+		          4 ) == 0 )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (vhdi_log_zero_descriptor_t *) descriptor_data )->zero_size,
+			 value_64bit );
+
+			if( ( value_64bit % LIBVHDI_LOG_SECTOR_SIZE ) != 0 )
+			{
+				return( 0 );
+			}
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (vhdi_log_zero_descriptor_t *) descriptor_data )->file_offset,
+			 value_64bit );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (vhdi_log_zero_descriptor_t *) descriptor_data )->sequence_number,
+			 descriptor_sequence_number );
+		}
+		else
+		{
+			return( 0 );
+		}
+		if( ( ( value_64bit % LIBVHDI_LOG_SECTOR_SIZE ) != 0 )
+		 || ( value_64bit > (uint64_t) INT64_MAX ) )
+		{
+			return( 0 );
+		}
+		if( descriptor_sequence_number != safe_sequence_number )
+		{
+			return( 0 );
+		}
+	}
+	*tail_offset     = safe_tail_offset;
+	*sequence_number = safe_sequence_number;
+
+	return( 1 );
+}
+
+/* Replays the data of a valid log entry
+ * The data sectors of the entry are restored in-place and referenced by the ranges of the log
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_log_replay_entry_data(
+     libvhdi_log_t *log,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *descriptor_data = NULL;
+	uint8_t *sector_data           = NULL;
+	static char *function          = "libvhdi_log_replay_entry_data";
+	size_t descriptors_size        = 0;
+	size_t sector_offset           = 0;
+	size64_t range_size            = 0;
+	uint64_t last_file_offset      = 0;
+	uint32_t descriptor_index      = 0;
+	uint32_t number_of_descriptors = 0;
+	off64_t range_file_offset      = 0;
+
+	if( log == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < LIBVHDI_LOG_SECTOR_SIZE )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vhdi_log_entry_header_t *) data )->number_of_descriptors,
+	 number_of_descriptors );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vhdi_log_entry_header_t *) data )->last_file_offset,
+	 last_file_offset );
+
+	descriptors_size = sizeof( vhdi_log_entry_header_t )
+	                 + ( (size_t) number_of_descriptors * sizeof( vhdi_log_data_descriptor_t ) );
+
+	if( ( descriptors_size % LIBVHDI_LOG_SECTOR_SIZE ) != 0 )
+	{
+		descriptors_size += LIBVHDI_LOG_SECTOR_SIZE - ( descriptors_size % LIBVHDI_LOG_SECTOR_SIZE );
+	}
+	if( descriptors_size > data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of descriptors value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	sector_offset = descriptors_size;
+
+	for( descriptor_index = 0;
+	     descriptor_index < number_of_descriptors;
+	     descriptor_index++ )
+	{
+		descriptor_data = &( data[ sizeof( vhdi_log_entry_header_t ) + ( descriptor_index * sizeof( vhdi_log_data_descriptor_t ) ) ] );
+
+		if( memory_compare(
+		     descriptor_data,
+		     "desc",
+		     4 ) == 0 )
+		{
+			if( ( sector_offset >= data_size )
+			 || ( ( data_size - sector_offset ) < LIBVHDI_LOG_SECTOR_SIZE ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid data sector offset value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (vhdi_log_data_descriptor_t *) descriptor_data )->file_offset,
+			 range_file_offset );
+
+			sector_data = &( data[ sector_offset ] );
+
+			/* The signature and upper sequence number of the data sector are stored in the descriptor
+			 * as leading bytes and the lower sequence number as trailing bytes
+			 */
+			if( memory_copy(
+			     sector_data,
+			     ( (vhdi_log_data_descriptor_t *) descriptor_data )->leading_bytes,
+			     8 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy leading bytes.",
+				 function );
+
+				return( -1 );
+			}
+			if( memory_copy(
+			     &( sector_data[ LIBVHDI_LOG_SECTOR_SIZE - 4 ] ),
+			     ( (vhdi_log_data_descriptor_t *) descriptor_data )->trailing_bytes,
+			     4 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy trailing bytes.",
+				 function );
+
+				return( -1 );
+			}
+			range_size     = LIBVHDI_LOG_SECTOR_SIZE;
+			sector_offset += LIBVHDI_LOG_SECTOR_SIZE;
+		}
+		else if( memory_compare(
+		          descriptor_data,
+		          "zero",
+		          4 ) == 0 )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (vhdi_log_zero_descriptor_t *) descriptor_data )->file_offset,
+			 range_file_offset );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (vhdi_log_zero_descriptor_t *) descriptor_data )->zero_size,
+			 range_size );
+
+			sector_data = NULL;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported descriptor signature.",
+			 function );
+
+			return( -1 );
+		}
+		if( range_size == 0 )
+		{
+			continue;
+		}
+		if( libvhdi_log_insert_range(
+		     log,
+		     range_file_offset,
+		     range_size,
+		     sector_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert range: %" PRIu32 ".",
+			 function,
+			 descriptor_index );
+
+			return( -1 );
+		}
+		if( ( (size64_t) range_file_offset + range_size ) > log->file_size )
+		{
+			log->file_size = (size64_t) range_file_offset + range_size;
+		}
+	}
+	if( last_file_offset > log->file_size )
+	{
+		log->file_size = last_file_offset;
+	}
+	return( 1 );
+}
+
+/* Inserts a range of the file that is updated by the log
+ * Parts of previously inserted ranges that overlap with the range are replaced
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_log_insert_range(
+     libvhdi_log_t *log,
+     off64_t file_offset,
+     size64_t size,
+     const uint8_t *data,
+     libcerror_error_t **error )
+{
+	libvhdi_log_range_t leading_range;
+	libvhdi_log_range_t trailing_range;
+
+	libvhdi_log_range_t *range   = NULL;
+	void *reallocation           = NULL;
+	static char *function        = "libvhdi_log_insert_range";
+	off64_t range_end_offset     = 0;
+	int first_range_index        = 0;
+	int has_leading_range        = 0;
+	int has_trailing_range       = 0;
+	int last_range_index         = 0;
+	int maximum_number_of_ranges = 0;
+	int number_of_new_ranges     = 0;
+	int number_of_ranges         = 0;
+	int range_index              = 0;
+
+	if( log == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size64_t) ( INT64_MAX - file_offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	range_end_offset = file_offset + (off64_t) size;
+
+	/* Determine the ranges that overlap with the new range
+	 */
+	first_range_index = 0;
+	last_range_index  = log->number_of_ranges;
+
+	while( first_range_index < last_range_index )
+	{
+		range_index = first_range_index + ( ( last_range_index - first_range_index ) / 2 );
+
+		range = &( log->ranges[ range_index ] );
+
+		if( ( range->file_offset + (off64_t) range->size ) > file_offset )
+		{
+			last_range_index = range_index;
+		}
+		else
+		{
+			first_range_index = range_index + 1;
+		}
+	}
+	for( range_index = first_range_index;
+	     range_index < log->number_of_ranges;
+	     range_index++ )
+	{
+		if( log->ranges[ range_index ].file_offset >= range_end_offset )
+		{
+			break;
+		}
+	}
+	last_range_index = range_index;
+
+	if( first_range_index < last_range_index )
+	{
+		range = &( log->ranges[ first_range_index ] );
+
+		if( range->file_offset < file_offset )
+		{
+			leading_range.file_offset = range->file_offset;
+			leading_range.size        = (size64_t) ( file_offset - range->file_offset );
+			leading_range.data        = range->data;
+
+			has_leading_range = 1;
+		}
+		range = &( log->ranges[ last_range_index - 1 ] );
+
+		if( ( range->file_offset + (off64_t) range->size ) > range_end_offset )
+		{
+			trailing_range.file_offset = range_end_offset;
+			trailing_range.size        = (size64_t) ( range->file_offset + (off64_t) range->size - range_end_offset );
+			trailing_range.data        = NULL;
+
+			if( range->data != NULL )
+			{
+				trailing_range.data = &( range->data[ range_end_offset - range->file_offset ] );
+			}
+			has_trailing_range = 1;
+		}
+	}
+	number_of_new_ranges = has_leading_range + 1 + has_trailing_range;
+	number_of_ranges     = log->number_of_ranges - ( last_range_index - first_range_index ) + number_of_new_ranges;
+
+	if( number_of_ranges > log->maximum_number_of_ranges )
+	{
+		if( log->maximum_number_of_ranges == 0 )
+		{
+			maximum_number_of_ranges = 64;
+		}
+		else
+		{
+			maximum_number_of_ranges = log->maximum_number_of_ranges * 2;
+		}
+		if( ( maximum_number_of_ranges < number_of_ranges )
+		 || ( (size_t) maximum_number_of_ranges > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libvhdi_log_range_t ) ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid maximum number of ranges value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                log->ranges,
+		                sizeof( libvhdi_log_range_t ) * maximum_number_of_ranges );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize ranges.",
+			 function );
+
+			return( -1 );
+		}
+		log->ranges                   = (libvhdi_log_range_t *) reallocation;
+		log->maximum_number_of_ranges = maximum_number_of_ranges;
+	}
+	/* Move the ranges that follow the overlapping ranges, the source and destination can overlap
+	 */
+	if( ( first_range_index + number_of_new_ranges ) > last_range_index )
+	{
+		for( range_index = log->number_of_ranges - 1;
+		     range_index >= last_range_index;
+		     range_index-- )
+		{
+			log->ranges[ range_index + first_range_index + number_of_new_ranges - last_range_index ] = log->ranges[ range_index ];
+		}
+	}
+	else if( ( first_range_index + number_of_new_ranges ) < last_range_index )
+	{
+		for( range_index = last_range_index;
+		     range_index < log->number_of_ranges;
+		     range_index++ )
+		{
+			log->ranges[ range_index + first_range_index + number_of_new_ranges - last_range_index ] = log->ranges[ range_index ];
+		}
+	}
+	range_index = first_range_index;
+
+	if( has_leading_range != 0 )
+	{
+		log->ranges[ range_index++ ] = leading_range;
+	}
+	range = &( log->ranges[ range_index++ ] );
+
+	range->file_offset = file_offset;
+	range->size        = size;
+	range->data        = data;
+
+	if( has_trailing_range != 0 )
+	{
+		log->ranges[ range_index ] = trailing_range;
+	}
+	log->number_of_ranges = number_of_ranges;
+
+	return( 1 );
+}
+
+/* Reads the log
+ * Returns 1 if successful, 0 if the log contains no log entries to replay or -1 on error
+ */
+int libvhdi_log_read_file_io_handle(
+     libvhdi_log_t *log,
+     libbfio_handle_t *file_io_handle,
+     off64_t log_offset,
+     size64_t log_size,
+     const uint8_t *log_identifier,
+     libcerror_error_t **error )
+{
+	uint8_t *entry_data                 = NULL;
+	static char *function               = "libvhdi_log_read_file_io_handle";
+	size_t candidate_offset             = 0;
+	size_t entry_data_size              = 0;
+	size_t entry_offset                 = 0;
+	size_t head_offset                  = 0;
+	size_t sequence_offset              = 0;
+	size_t tail_offset                  = 0;
+	ssize_t read_count                  = 0;
+	uint64_t entry_sequence_number      = 0;
+	uint64_t head_sequence_number       = 0;
+	uint64_t sequence_number            = 0;
+	uint32_t entry_size                 = 0;
+	uint32_t entry_tail_offset          = 0;
+	uint32_t head_tail_offset           = 0;
+	uint32_t number_of_entries          = 0;
+	uint32_t sequence_number_of_entries = 0;
+	int has_wrapped_entry               = 0;
+	int result                          = 0;
+	int sequence_has_tail               = 0;
+
+	if( log == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log.",
+		 function );
+
+		return( -1 );
+	}
+	if( log->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid log - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( log_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid log offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( log_size == 0 )
+	 || ( ( log_size % LIBVHDI_LOG_SECTOR_SIZE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported log size: %" PRIu64 ".",
+		 function,
+		 log_size );
+
+		return( -1 );
+	}
+	if( ( log_size > (size64_t) LIBVHDI_MAXIMUM_LOG_SIZE )
+	 || ( log_size > (size64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid log size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( log_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log identifier.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading log at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIu64 "\n",
+		 function,
+		 log_offset,
+		 log_offset,
+		 log_size );
+	}
+#endif
+	log->data_size = (size_t) log_size;
+
+	log->data = (uint8_t *) memory_allocate(
+	                         sizeof( uint8_t ) * log->data_size );
+
+	if( log->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create log data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              log->data,
+	              log->data_size,
+	              log_offset,
+	              error );
+
+	if( read_count != (ssize_t) log->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read log data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 log_offset,
+		 log_offset );
+
+		goto on_error;
+	}
+	/* The log is a circular buffer, the active sequence of log entries is the sequence
+	 * of consecutive valid log entries with the largest sequence number of which
+	 * the tail of the last (head) log entry refers to a log entry in the sequence
+	 */
+	while( candidate_offset < log->data_size )
+	{
+		result = libvhdi_log_get_entry_data(
+		          log,
+		          candidate_offset,
+		          &entry_data,
+		          &entry_data_size,
+		          error );
+
+		if( result == 1 )
+		{
+			result = libvhdi_log_check_entry_data(
+			          entry_data,
+			          entry_data_size,
+			          log->data_size,
+			          log_identifier,
+			          &entry_tail_offset,
+			          &entry_sequence_number,
+			          error );
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to check log entry at offset: %" PRIzd ".",
+			 function,
+			 candidate_offset );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			candidate_offset += LIBVHDI_LOG_SECTOR_SIZE;
+
+			continue;
+		}
+		entry_size                 = (uint32_t) entry_data_size;
+		sequence_offset            = candidate_offset;
+		sequence_number            = entry_sequence_number;
+		sequence_number_of_entries = 1;
+		entry_offset               = candidate_offset;
+		head_offset                = candidate_offset;
+		head_tail_offset           = entry_tail_offset;
+
+		/* The sequence numbers of consecutive log entries are incremental
+		 * hence the sequence ends before it would wrap around to a previous log entry
+		 */
+		while( 1 )
+		{
+			entry_offset = ( entry_offset + entry_size ) % log->data_size;
+
+			if( entry_offset == sequence_offset )
+			{
+				break;
+			}
+			result = libvhdi_log_get_entry_data(
+			          log,
+			          entry_offset,
+			          &entry_data,
+			          &entry_data_size,
+			          error );
+
+			if( result == 1 )
+			{
+				result = libvhdi_log_check_entry_data(
+				          entry_data,
+				          entry_data_size,
+				          log->data_size,
+				          log_identifier,
+				          &entry_tail_offset,
+				          &entry_sequence_number,
+				          error );
+			}
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to check log entry at offset: %" PRIzd ".",
+				 function,
+				 entry_offset );
+
+				goto on_error;
+			}
+			else if( ( result == 0 )
+			      || ( entry_sequence_number != ( sequence_number + 1 ) ) )
+			{
+				break;
+			}
+			entry_size       = (uint32_t) entry_data_size;
+			sequence_number  = entry_sequence_number;
+			head_offset      = entry_offset;
+			head_tail_offset = entry_tail_offset;
+
+			sequence_number_of_entries++;
+		}
+		/* Determine if the tail of the head log entry refers to a log entry in the sequence
+		 */
+		sequence_has_tail = 0;
+		entry_offset      = sequence_offset;
+
+		for( number_of_entries = 0;
+		     number_of_entries < sequence_number_of_entries;
+		     number_of_entries++ )
+		{
+			if( entry_offset == (size_t) head_tail_offset )
+			{
+				sequence_has_tail = 1;
+
+				break;
+			}
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (vhdi_log_entry_header_t *) &( log->data[ entry_offset ] ) )->entry_size,
+			 entry_size );
+
+			entry_offset = ( entry_offset + entry_size ) % log->data_size;
+		}
+		if( ( sequence_has_tail != 0 )
+		 && ( sequence_number > head_sequence_number ) )
+		{
+			tail_offset          = (size_t) head_tail_offset;
+			head_sequence_number = sequence_number;
+
+			log->number_of_entries = sequence_number_of_entries - number_of_entries;
+		}
+		/* The log entries in the sequence cannot start a sequence with a larger sequence number
+		 */
+		if( head_offset < sequence_offset )
+		{
+			break;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (vhdi_log_entry_header_t *) &( log->data[ head_offset ] ) )->entry_size,
+		 entry_size );
+
+		candidate_offset = head_offset + entry_size;
+	}
+	if( head_sequence_number == 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: no active log entry sequence found.\n",
+			 function );
+		}
+#endif
+		return( 0 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: replaying: %" PRIu32 " log entries up to sequence number: %" PRIu64 ".\n",
+		 function,
+		 log->number_of_entries,
+		 head_sequence_number );
+	}
+#endif
+	/* Replay the log entries from the tail to the head
+	 * The ranges of a replayed log entry reference its entry data, hence the wrapped
+	 * entry data can only be used by a single replayed log entry
+	 */
+	entry_offset = tail_offset;
+
+	for( number_of_entries = 0;
+	     number_of_entries < log->number_of_entries;
+	     number_of_entries++ )
+	{
+		if( libvhdi_log_get_entry_data(
+		     log,
+		     entry_offset,
+		     &entry_data,
+		     &entry_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve log entry data at offset: %" PRIzd ".",
+			 function,
+			 entry_offset );
+
+			goto on_error;
+		}
+		if( entry_data == log->wrapped_entry_data )
+		{
+			if( has_wrapped_entry != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported log - more than one log entry wraps around the end of the log.",
+				 function );
+
+				goto on_error;
+			}
+			has_wrapped_entry = 1;
+		}
+		entry_size = (uint32_t) entry_data_size;
+
+		if( libvhdi_log_replay_entry_data(
+		     log,
+		     entry_data,
+		     entry_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to replay log entry at offset: %" PRIzd ".",
+			 function,
+			 entry_offset );
+
+			goto on_error;
+		}
+		entry_offset = ( entry_offset + entry_size ) % log->data_size;
+	}
+	log->sequence_number = head_sequence_number;
+
+	return( 1 );
+
+on_error:
+	if( log->ranges != NULL )
+	{
+		memory_free(
+		 log->ranges );
+
+		log->ranges = NULL;
+	}
+	log->number_of_ranges         = 0;
+	log->maximum_number_of_ranges = 0;
+
+	if( log->wrapped_entry_data != NULL )
+	{
+		memory_free(
+		 log->wrapped_entry_data );
+
+		log->wrapped_entry_data = NULL;
+	}
+	log->wrapped_entry_data_size = 0;
+
+	if( log->data != NULL )
+	{
+		memory_free(
+		 log->data );
+
+		log->data = NULL;
+	}
+	log->data_size = 0;
+
+	return( -1 );
+}
+
+/* Reads the data of the ranges of the file that are updated by the log into a buffer
+ * Parts of the buffer that are not updated by the log are left unchanged
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_log_read_buffer_at_offset(
+     libvhdi_log_t *log,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t file_offset,
+     libcerror_error_t **error )
+{
+	libvhdi_log_range_t *range = NULL;
+	static char *function      = "libvhdi_log_read_buffer_at_offset";
+	size_t copy_size           = 0;
+	off64_t buffer_end_offset  = 0;
+	off64_t copy_end_offset    = 0;
+	off64_t copy_offset        = 0;
+	int first_range_index      = 0;
+	int last_range_index       = 0;
+	int range_index            = 0;
+
+	if( log == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	buffer_end_offset = file_offset + (off64_t) buffer_size;
+
+	/* Determine the first range that ends after the file offset
+	 */
+	first_range_index = 0;
+	last_range_index  = log->number_of_ranges;
+
+	while( first_range_index < last_range_index )
+	{
+		range_index = first_range_index + ( ( last_range_index - first_range_index ) / 2 );
+
+		range = &( log->ranges[ range_index ] );
+
+		if( ( range->file_offset + (off64_t) range->size ) > file_offset )
+		{
+			last_range_index = range_index;
+		}
+		else
+		{
+			first_range_index = range_index + 1;
+		}
+	}
+	for( range_index = first_range_index;
+	     range_index < log->number_of_ranges;
+	     range_index++ )
+	{
+		range = &( log->ranges[ range_index ] );
+
+		if( range->file_offset >= buffer_end_offset )
+		{
+			break;
+		}
+		copy_offset     = range->file_offset;
+		copy_end_offset = range->file_offset + (off64_t) range->size;
+
+		if( copy_offset < file_offset )
+		{
+			copy_offset = file_offset;
+		}
+		if( copy_end_offset > buffer_end_offset )
+		{
+			copy_end_offset = buffer_end_offset;
+		}
+		copy_size = (size_t) ( copy_end_offset - copy_offset );
+
+		if( range->data == NULL )
+		{
+			if( memory_set(
+			     &( buffer[ copy_offset - file_offset ] ),
+			     0,
+			     copy_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			if( memory_copy(
+			     &( buffer[ copy_offset - file_offset ] ),
+			     &( range->data[ copy_offset - range->file_offset ] ),
+			     copy_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy range data to buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,154 @@
+/*
+ * VHDX log functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVHDI_LOG_H )
+#define _LIBVHDI_LOG_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvhdi_libbfio.h"
+#include "libvhdi_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvhdi_log_range libvhdi_log_range_t;
+
+struct libvhdi_log_range
+{
+	/* The file offset
+	 */
+	off64_t file_offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The data, where NULL represents the range contains 0-byte values
+	 */
+	const uint8_t *data;
+};
+
+typedef struct libvhdi_log libvhdi_log_t;
+
+struct libvhdi_log
+{
+	/* The log data
+	 */
+	uint8_t *data;
+
+	/* The log data size
+	 */
+	size_t data_size;
+
+	/* The data of the log entry that wraps around the end of the log
+	 */
+	uint8_t *wrapped_entry_data;
+
+	/* The wrapped log entry data size
+	 */
+	size_t wrapped_entry_data_size;
+
+	/* The sequence number of the last replayed log entry
+	 */
+	uint64_t sequence_number;
+
+	/* The number of replayed log entries
+	 */
+	uint32_t number_of_entries;
+
+	/* The ranges of the file that are updated by the replayed log entries, sorted by file offset
+	 */
+	libvhdi_log_range_t *ranges;
+
+	/* The number of ranges
+	 */
+	int number_of_ranges;
+
+	/* The maximum number of ranges
+	 */
+	int maximum_number_of_ranges;
+
+	/* The file size after the log entries have been replayed
+	 */
+	size64_t file_size;
+};
+
+int libvhdi_log_initialize(
+     libvhdi_log_t **log,
+     libcerror_error_t **error );
+
+int libvhdi_log_free(
+     libvhdi_log_t **log,
+     libcerror_error_t **error );
+
+int libvhdi_log_get_entry_data(
+     libvhdi_log_t *log,
+     size_t entry_offset,
+     uint8_t **entry_data,
+     size_t *entry_data_size,
+     libcerror_error_t **error );
+
+int libvhdi_log_check_entry_data(
+     const uint8_t *entry_data,
+     size_t entry_data_size,
+     size_t log_data_size,
+     const uint8_t *log_identifier,
+     uint32_t *tail_offset,
+     uint64_t *sequence_number,
+     libcerror_error_t **error );
+
+int libvhdi_log_replay_entry_data(
+     libvhdi_log_t *log,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvhdi_log_insert_range(
+     libvhdi_log_t *log,
+     off64_t file_offset,
+     size64_t size,
+     const uint8_t *data,
+     libcerror_error_t **error );
+
+int libvhdi_log_read_file_io_handle(
+     libvhdi_log_t *log,
+     libbfio_handle_t *file_io_handle,
+     off64_t log_offset,
+     size64_t log_size,
+     const uint8_t *log_identifier,
+     libcerror_error_t **error );
+
+int libvhdi_log_read_buffer_at_offset(
+     libvhdi_log_t *log,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t file_offset,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVHDI_LOG_H ) */
+
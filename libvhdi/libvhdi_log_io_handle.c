@@ -0,0 +1,870 @@
+/*
+ * Log IO handle functions, which read a file with the VHDX log applied
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvhdi_definitions.h"
+#include "libvhdi_libbfio.h"
+#include "libvhdi_libcerror.h"
+#include "libvhdi_log.h"
+#include "libvhdi_log_io_handle.h"
+#include "libvhdi_unused.h"
+
+/* Creates a log IO handle
+ * Make sure the value log_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_log_io_handle_initialize(
+     libvhdi_log_io_handle_t **log_io_handle,
+     libbfio_handle_t *file_io_handle,
+     libvhdi_log_t *log,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_log_io_handle_initialize";
+
+	if( log_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *log_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid log IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( log == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log.",
+		 function );
+
+		return( -1 );
+	}
+	*log_io_handle = memory_allocate_structure(
+	                  libvhdi_log_io_handle_t );
+
+	if( *log_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create log IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *log_io_handle,
+	     0,
+	     sizeof( libvhdi_log_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear log IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *log_io_handle )->file_io_handle = file_io_handle;
+	( *log_io_handle )->log            = log;
+
+	return( 1 );
+
+on_error:
+	if( *log_io_handle != NULL )
+	{
+		memory_free(
+		 *log_io_handle );
+
+		*log_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Creates a file IO handle that reads a file with the log applied
+ * The file IO handle and log are not managed by the log file IO handle
+ * Make sure the value log_file_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_log_io_handle_initialize_file_io_handle(
+     libbfio_handle_t **log_file_io_handle,
+     libbfio_handle_t *file_io_handle,
+     libvhdi_log_t *log,
+     libcerror_error_t **error )
+{
+	libvhdi_log_io_handle_t *log_io_handle = NULL;
+	static char *function                  = "libvhdi_log_io_handle_initialize_file_io_handle";
+
+	if( log_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_log_io_handle_initialize(
+	     &log_io_handle,
+	     file_io_handle,
+	     log,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create log IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     log_file_io_handle,
+	     (intptr_t *) log_io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libvhdi_log_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libvhdi_log_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libvhdi_log_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libvhdi_log_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libvhdi_log_io_handle_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libvhdi_log_io_handle_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libvhdi_log_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libvhdi_log_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libvhdi_log_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libvhdi_log_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create log file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( log_io_handle != NULL )
+	{
+		libvhdi_log_io_handle_free(
+		 &log_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a log IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_log_io_handle_free(
+     libvhdi_log_io_handle_t **log_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_log_io_handle_free";
+	int result            = 1;
+
+	if( log_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *log_io_handle != NULL )
+	{
+		if( ( *log_io_handle )->file_io_handle_opened != 0 )
+		{
+			if( libbfio_handle_close(
+			     ( *log_io_handle )->file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *log_io_handle )->file_io_handle_is_managed != 0 )
+		{
+			if( libbfio_handle_free(
+			     &( ( *log_io_handle )->file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		/* The log is referenced and freed elsewhere
+		 */
+		memory_free(
+		 *log_io_handle );
+
+		*log_io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the log IO handle
+ * The destination log IO handle uses a clone of the file IO handle and shares the log with the source
+ * The destination log IO handle is not opened
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_log_io_handle_clone(
+     libvhdi_log_io_handle_t **destination_log_io_handle,
+     libvhdi_log_io_handle_t *source_log_io_handle,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libvhdi_log_io_handle_clone";
+
+	if( destination_log_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination log IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_log_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination log IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_log_io_handle == NULL )
+	{
+		*destination_log_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libbfio_handle_clone(
+	     &file_io_handle,
+	     source_log_io_handle->file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to create destination file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvhdi_log_io_handle_initialize(
+	     destination_log_io_handle,
+	     file_io_handle,
+	     source_log_io_handle->log,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination log IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *destination_log_io_handle )->file_io_handle_is_managed = 1;
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens the log IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_log_io_handle_open(
+     libvhdi_log_io_handle_t *log_io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_log_io_handle_open";
+	int result            = 0;
+
+	if( log_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( log_io_handle->is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid log IO handle - already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access not supported.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfio_handle_is_open(
+	          log_io_handle->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		if( libbfio_handle_open(
+		     log_io_handle->file_io_handle,
+		     access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			return( -1 );
+		}
+		log_io_handle->file_io_handle_opened = 1;
+	}
+	log_io_handle->is_open        = 1;
+	log_io_handle->current_offset = 0;
+
+	return( 1 );
+}
+
+/* Closes the log IO handle
+ * The file IO handle is only closed if it was opened by the log IO handle
+ * Returns 0 if successful or -1 on error
+ */
+int libvhdi_log_io_handle_close(
+     libvhdi_log_io_handle_t *log_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_log_io_handle_close";
+	int result            = 0;
+
+	if( log_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( log_io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid log IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( log_io_handle->file_io_handle_opened != 0 )
+	{
+		if( libbfio_handle_close(
+		     log_io_handle->file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		log_io_handle->file_io_handle_opened = 0;
+	}
+	log_io_handle->is_open        = 0;
+	log_io_handle->current_offset = 0;
+
+	return( result );
+}
+
+/* Reads a buffer from the log IO handle
+ * The data is read from the file IO handle and the ranges updated by the log are applied
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libvhdi_log_io_handle_read(
+         libvhdi_log_io_handle_t *log_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libvhdi_log_io_handle_read";
+	size_t fill_size      = 0;
+	ssize_t read_count    = 0;
+
+	if( log_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( log_io_handle->log == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid log IO handle - missing log.",
+		 function );
+
+		return( -1 );
+	}
+	if( log_io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid log IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              log_io_handle->file_io_handle,
+	              buffer,
+	              size,
+	              log_io_handle->current_offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer from file IO handle at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 log_io_handle->current_offset,
+		 log_io_handle->current_offset );
+
+		return( -1 );
+	}
+	/* The log can extend the file, data beyond the end of the file
+	 * that is not updated by the log consists of 0-byte values
+	 */
+	if( ( (size_t) read_count < size )
+	 && ( (size64_t) ( log_io_handle->current_offset + read_count ) < log_io_handle->log->file_size ) )
+	{
+		fill_size = size - (size_t) read_count;
+
+		if( (size64_t) fill_size > ( log_io_handle->log->file_size - (size64_t) ( log_io_handle->current_offset + read_count ) ) )
+		{
+			fill_size = (size_t) ( log_io_handle->log->file_size - (size64_t) ( log_io_handle->current_offset + read_count ) );
+		}
+		if( memory_set(
+		     &( buffer[ read_count ] ),
+		     0,
+		     fill_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear buffer.",
+			 function );
+
+			return( -1 );
+		}
+		read_count += (ssize_t) fill_size;
+	}
+	if( libvhdi_log_read_buffer_at_offset(
+	     log_io_handle->log,
+	     buffer,
+	     (size_t) read_count,
+	     log_io_handle->current_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read log data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 log_io_handle->current_offset,
+		 log_io_handle->current_offset );
+
+		return( -1 );
+	}
+	log_io_handle->current_offset += (off64_t) read_count;
+
+	return( read_count );
+}
+
+/* Writes a buffer to the log IO handle
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libvhdi_log_io_handle_write(
+         libvhdi_log_io_handle_t *log_io_handle LIBVHDI_ATTRIBUTE_UNUSED,
+         const uint8_t *buffer LIBVHDI_ATTRIBUTE_UNUSED,
+         size_t size LIBVHDI_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error )
+{
+	static char *function = "libvhdi_log_io_handle_write";
+
+	LIBVHDI_UNREFERENCED_PARAMETER( log_io_handle )
+	LIBVHDI_UNREFERENCED_PARAMETER( buffer )
+	LIBVHDI_UNREFERENCED_PARAMETER( size )
+
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: write access not supported.",
+	 function );
+
+	return( -1 );
+}
+
+/* Seeks a certain offset within the log IO handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libvhdi_log_io_handle_seek_offset(
+         libvhdi_log_io_handle_t *log_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libvhdi_log_io_handle_seek_offset";
+	size64_t size         = 0;
+
+	if( log_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += log_io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		if( libvhdi_log_io_handle_get_size(
+		     log_io_handle,
+		     &size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size.",
+			 function );
+
+			return( -1 );
+		}
+		offset += (off64_t) size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	log_io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if a file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libvhdi_log_io_handle_exists(
+     libvhdi_log_io_handle_t *log_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_log_io_handle_exists";
+	int result            = 0;
+
+	if( log_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfio_handle_exists(
+	          log_io_handle->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if file IO handle exists.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Check if the log IO handle is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libvhdi_log_io_handle_is_open(
+     libvhdi_log_io_handle_t *log_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_log_io_handle_is_open";
+
+	if( log_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( log_io_handle->is_open == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of the log IO handle
+ * The size is the size of the file or the size of the file after the log is applied if larger
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_log_io_handle_get_size(
+     libvhdi_log_io_handle_t *log_io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_log_io_handle_get_size";
+	size64_t file_size    = 0;
+
+	if( log_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid log IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( log_io_handle->log == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid log IO handle - missing log.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     log_io_handle->file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		return( -1 );
+	}
+	if( log_io_handle->log->file_size > file_size )
+	{
+		file_size = log_io_handle->log->file_size;
+	}
+	*size = file_size;
+
+	return( 1 );
+}
+
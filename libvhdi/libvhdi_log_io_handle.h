@@ -0,0 +1,131 @@
+/*
+ * Log IO handle functions, which read a file with the VHDX log applied
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVHDI_LOG_IO_HANDLE_H )
+#define _LIBVHDI_LOG_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvhdi_libbfio.h"
+#include "libvhdi_libcerror.h"
+#include "libvhdi_log.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvhdi_log_io_handle libvhdi_log_io_handle_t;
+
+struct libvhdi_log_io_handle
+{
+	/* The file IO handle of the file without the log applied
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* Value to indicate if the file IO handle is managed by the log IO handle
+	 */
+	uint8_t file_io_handle_is_managed;
+
+	/* Value to indicate if the file IO handle was opened by the log IO handle
+	 */
+	uint8_t file_io_handle_opened;
+
+	/* The log, which is shared with clones of the log IO handle and not managed by the log IO handle
+	 */
+	libvhdi_log_t *log;
+
+	/* Value to indicate if the log IO handle is open
+	 */
+	uint8_t is_open;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+};
+
+int libvhdi_log_io_handle_initialize(
+     libvhdi_log_io_handle_t **log_io_handle,
+     libbfio_handle_t *file_io_handle,
+     libvhdi_log_t *log,
+     libcerror_error_t **error );
+
+int libvhdi_log_io_handle_initialize_file_io_handle(
+     libbfio_handle_t **log_file_io_handle,
+     libbfio_handle_t *file_io_handle,
+     libvhdi_log_t *log,
+     libcerror_error_t **error );
+
+int libvhdi_log_io_handle_free(
+     libvhdi_log_io_handle_t **log_io_handle,
+     libcerror_error_t **error );
+
+int libvhdi_log_io_handle_clone(
+     libvhdi_log_io_handle_t **destination_log_io_handle,
+     libvhdi_log_io_handle_t *source_log_io_handle,
+     libcerror_error_t **error );
+
+int libvhdi_log_io_handle_open(
+     libvhdi_log_io_handle_t *log_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libvhdi_log_io_handle_close(
+     libvhdi_log_io_handle_t *log_io_handle,
+     libcerror_error_t **error );
+
+ssize_t libvhdi_log_io_handle_read(
+         libvhdi_log_io_handle_t *log_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libvhdi_log_io_handle_write(
+         libvhdi_log_io_handle_t *log_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libvhdi_log_io_handle_seek_offset(
+         libvhdi_log_io_handle_t *log_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libvhdi_log_io_handle_exists(
+     libvhdi_log_io_handle_t *log_io_handle,
+     libcerror_error_t **error );
+
+int libvhdi_log_io_handle_is_open(
+     libvhdi_log_io_handle_t *log_io_handle,
+     libcerror_error_t **error );
+
+int libvhdi_log_io_handle_get_size(
+     libvhdi_log_io_handle_t *log_io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVHDI_LOG_IO_HANDLE_H ) */
+
@@ -0,0 +1,993 @@
+/*
+ * Read-ahead functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvhdi_definitions.h"
+#include "libvhdi_libcerror.h"
+#include "libvhdi_libcthreads.h"
+#include "libvhdi_read_ahead.h"
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+
+/* Creates a read-ahead
+ * Make sure the value read_ahead is referencing, is set to NULL
+ * The read data function is called from the read-ahead thread, hence it must support concurrent reads
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_read_ahead_initialize(
+     libvhdi_read_ahead_t **read_ahead,
+     size_t buffer_size,
+     size64_t data_size,
+     intptr_t *data_handle,
+     ssize_t (*read_data)(
+            intptr_t *data_handle,
+            uint8_t *buffer,
+            size_t buffer_size,
+            off64_t offset,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_read_ahead_initialize";
+	int buffer_index      = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read-ahead value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) LIBVHDI_MAXIMUM_READ_AHEAD_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read data function.",
+		 function );
+
+		return( -1 );
+	}
+	*read_ahead = memory_allocate_structure(
+	               libvhdi_read_ahead_t );
+
+	if( *read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_ahead,
+	     0,
+	     sizeof( libvhdi_read_ahead_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read-ahead.",
+		 function );
+
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+
+		return( -1 );
+	}
+	for( buffer_index = 0;
+	     buffer_index < LIBVHDI_READ_AHEAD_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		( *read_ahead )->buffers[ buffer_index ].data = (uint8_t *) memory_allocate(
+		                                                             sizeof( uint8_t ) * buffer_size );
+
+		if( ( *read_ahead )->buffers[ buffer_index ].data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer: %d data.",
+			 function,
+			 buffer_index );
+
+			goto on_error;
+		}
+		( *read_ahead )->buffers[ buffer_index ].state = LIBVHDI_READ_AHEAD_BUFFER_STATE_EMPTY;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_ahead )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *read_ahead )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	( *read_ahead )->data_handle          = data_handle;
+	( *read_ahead )->read_data            = read_data;
+	( *read_ahead )->data_size            = data_size;
+	( *read_ahead )->buffer_size          = buffer_size;
+	( *read_ahead )->last_read_end_offset = -1;
+
+	if( libcthreads_thread_create(
+	     &( ( *read_ahead )->thread ),
+	     NULL,
+	     &libvhdi_read_ahead_thread_function,
+	     (void *) *read_ahead,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *read_ahead != NULL )
+	{
+		if( ( *read_ahead )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *read_ahead )->condition ),
+			 NULL );
+		}
+		if( ( *read_ahead )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *read_ahead )->mutex ),
+			 NULL );
+		}
+		for( buffer_index = 0;
+		     buffer_index < LIBVHDI_READ_AHEAD_NUMBER_OF_BUFFERS;
+		     buffer_index++ )
+		{
+			if( ( *read_ahead )->buffers[ buffer_index ].data != NULL )
+			{
+				memory_free(
+				 ( *read_ahead )->buffers[ buffer_index ].data );
+			}
+		}
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read-ahead
+ * This stops the read-ahead thread and waits for it to finish
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_read_ahead_free(
+     libvhdi_read_ahead_t **read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_read_ahead_free";
+	int buffer_index      = 0;
+	int result            = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     ( *read_ahead )->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		( *read_ahead )->abort = 1;
+
+		if( libcthreads_condition_broadcast(
+		     ( *read_ahead )->condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_release(
+		     ( *read_ahead )->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+		if( libcthreads_thread_join(
+		     &( ( *read_ahead )->thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_condition_free(
+		     &( ( *read_ahead )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *read_ahead )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		for( buffer_index = 0;
+		     buffer_index < LIBVHDI_READ_AHEAD_NUMBER_OF_BUFFERS;
+		     buffer_index++ )
+		{
+			memory_free(
+			 ( *read_ahead )->buffers[ buffer_index ].data );
+		}
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+	}
+	return( result );
+}
+
+/* The read-ahead thread function
+ * Reads the data of pending buffers, in order of offset, until the read-ahead is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_read_ahead_thread_function(
+     void *arguments )
+{
+	libvhdi_read_ahead_buffer_t *read_ahead_buffer = NULL;
+	libvhdi_read_ahead_t *read_ahead               = NULL;
+	libcerror_error_t *error                       = NULL;
+	static char *function                          = "libvhdi_read_ahead_thread_function";
+	size_t read_size                               = 0;
+	ssize_t read_count                             = 0;
+	int buffer_index                               = 0;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	read_ahead = (libvhdi_read_ahead_t *) arguments;
+
+	if( libcthreads_mutex_grab(
+	     read_ahead->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	while( read_ahead->abort == 0 )
+	{
+		read_ahead_buffer = NULL;
+
+		for( buffer_index = 0;
+		     buffer_index < LIBVHDI_READ_AHEAD_NUMBER_OF_BUFFERS;
+		     buffer_index++ )
+		{
+			if( read_ahead->buffers[ buffer_index ].state != LIBVHDI_READ_AHEAD_BUFFER_STATE_PENDING )
+			{
+				continue;
+			}
+			if( ( read_ahead_buffer == NULL )
+			 || ( read_ahead->buffers[ buffer_index ].offset < read_ahead_buffer->offset ) )
+			{
+				read_ahead_buffer = &( read_ahead->buffers[ buffer_index ] );
+			}
+		}
+		if( read_ahead_buffer == NULL )
+		{
+			if( libcthreads_condition_wait(
+			     read_ahead->condition,
+			     read_ahead->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				goto on_error_locked;
+			}
+			continue;
+		}
+		read_ahead_buffer->state = LIBVHDI_READ_AHEAD_BUFFER_STATE_READING;
+
+		read_size = read_ahead->buffer_size;
+
+		if( (size64_t) read_size > ( read_ahead->data_size - read_ahead_buffer->offset ) )
+		{
+			read_size = (size_t) ( read_ahead->data_size - read_ahead_buffer->offset );
+		}
+		if( libcthreads_mutex_release(
+		     read_ahead->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		/* The data is read without holding the mutex, the buffer is owned by
+		 * this thread while it is in the reading state
+		 */
+		read_count = read_ahead->read_data(
+		              read_ahead->data_handle,
+		              read_ahead_buffer->data,
+		              read_size,
+		              read_ahead_buffer->offset,
+		              &error );
+
+		if( read_count == -1 )
+		{
+			/* A failed read-ahead is not fatal, the data is read again on demand
+			 */
+			libcerror_error_free(
+			 &error );
+		}
+		if( libcthreads_mutex_grab(
+		     read_ahead->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( read_count == -1 )
+		{
+			read_ahead_buffer->data_size = 0;
+			read_ahead_buffer->state     = LIBVHDI_READ_AHEAD_BUFFER_STATE_FAILED;
+		}
+		else
+		{
+			read_ahead_buffer->data_size = (size_t) read_count;
+			read_ahead_buffer->state     = LIBVHDI_READ_AHEAD_BUFFER_STATE_READ;
+		}
+		if( libcthreads_condition_broadcast(
+		     read_ahead->condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			goto on_error_locked;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_ahead->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error_locked:
+	libcthreads_mutex_release(
+	 read_ahead->mutex,
+	 NULL );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Flushes the read-ahead
+ * Discards the buffers and waits for a pending read of the read-ahead thread to finish
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_read_ahead_flush(
+     libvhdi_read_ahead_t *read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_read_ahead_flush";
+	int buffer_index      = 0;
+	int is_reading        = 0;
+	int result            = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		is_reading = 0;
+
+		for( buffer_index = 0;
+		     buffer_index < LIBVHDI_READ_AHEAD_NUMBER_OF_BUFFERS;
+		     buffer_index++ )
+		{
+			if( read_ahead->buffers[ buffer_index ].state == LIBVHDI_READ_AHEAD_BUFFER_STATE_READING )
+			{
+				is_reading = 1;
+			}
+			else
+			{
+				read_ahead->buffers[ buffer_index ].state = LIBVHDI_READ_AHEAD_BUFFER_STATE_EMPTY;
+			}
+		}
+		if( is_reading != 0 )
+		{
+			if( libcthreads_condition_wait(
+			     read_ahead->condition,
+			     read_ahead->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+	}
+	while( is_reading != 0 );
+
+	read_ahead->last_read_end_offset       = -1;
+	read_ahead->number_of_sequential_reads = 0;
+
+	if( libcthreads_mutex_release(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Schedules the empty buffers to read the data following a specific offset
+ * This function is not multi-thread safe acquire the mutex before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_read_ahead_schedule_buffers(
+     libvhdi_read_ahead_t *read_ahead,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_read_ahead_schedule_buffers";
+	int buffer_index      = 0;
+	int is_scheduled      = 0;
+	int number_of_buffers = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	/* Skip the data that is already scheduled
+	 */
+	do
+	{
+		is_scheduled = 0;
+
+		for( buffer_index = 0;
+		     buffer_index < LIBVHDI_READ_AHEAD_NUMBER_OF_BUFFERS;
+		     buffer_index++ )
+		{
+			if( ( read_ahead->buffers[ buffer_index ].state != LIBVHDI_READ_AHEAD_BUFFER_STATE_EMPTY )
+			 && ( offset >= read_ahead->buffers[ buffer_index ].offset )
+			 && ( offset < ( read_ahead->buffers[ buffer_index ].offset + (off64_t) read_ahead->buffer_size ) ) )
+			{
+				offset       = read_ahead->buffers[ buffer_index ].offset + (off64_t) read_ahead->buffer_size;
+				is_scheduled = 1;
+			}
+		}
+	}
+	while( is_scheduled != 0 );
+
+	for( buffer_index = 0;
+	     buffer_index < LIBVHDI_READ_AHEAD_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		if( (size64_t) offset >= read_ahead->data_size )
+		{
+			break;
+		}
+		if( read_ahead->buffers[ buffer_index ].state != LIBVHDI_READ_AHEAD_BUFFER_STATE_EMPTY )
+		{
+			continue;
+		}
+		read_ahead->buffers[ buffer_index ].offset    = offset;
+		read_ahead->buffers[ buffer_index ].data_size = 0;
+		read_ahead->buffers[ buffer_index ].state     = LIBVHDI_READ_AHEAD_BUFFER_STATE_PENDING;
+
+		offset += read_ahead->buffer_size;
+
+		number_of_buffers++;
+	}
+	if( number_of_buffers > 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     read_ahead->condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads data at a specific offset into a buffer
+ * The data is copied from the read-ahead buffers where available and read on demand otherwise
+ * Once a number of sequential reads is detected the data following the read is read ahead
+ * by the read-ahead thread
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvhdi_read_ahead_read_buffer(
+         libvhdi_read_ahead_t *read_ahead,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libvhdi_read_ahead_buffer_t *read_ahead_buffer = NULL;
+	static char *function                          = "libvhdi_read_ahead_read_buffer";
+	size_t buffer_offset                           = 0;
+	size_t read_size                               = 0;
+	ssize_t read_count                             = 0;
+	int buffer_index                               = 0;
+	int result                                     = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == read_ahead->last_read_end_offset )
+	{
+		if( read_ahead->number_of_sequential_reads < LIBVHDI_READ_AHEAD_SEQUENTIAL_READS_THRESHOLD )
+		{
+			read_ahead->number_of_sequential_reads++;
+		}
+	}
+	else
+	{
+		read_ahead->number_of_sequential_reads = 0;
+	}
+	while( buffer_offset < buffer_size )
+	{
+		read_ahead_buffer = NULL;
+
+		for( buffer_index = 0;
+		     buffer_index < LIBVHDI_READ_AHEAD_NUMBER_OF_BUFFERS;
+		     buffer_index++ )
+		{
+			if( ( read_ahead->buffers[ buffer_index ].state != LIBVHDI_READ_AHEAD_BUFFER_STATE_EMPTY )
+			 && ( offset >= read_ahead->buffers[ buffer_index ].offset )
+			 && ( offset < ( read_ahead->buffers[ buffer_index ].offset + (off64_t) read_ahead->buffer_size ) ) )
+			{
+				read_ahead_buffer = &( read_ahead->buffers[ buffer_index ] );
+
+				break;
+			}
+		}
+		if( read_ahead_buffer == NULL )
+		{
+			break;
+		}
+		if( ( read_ahead_buffer->state == LIBVHDI_READ_AHEAD_BUFFER_STATE_PENDING )
+		 || ( read_ahead_buffer->state == LIBVHDI_READ_AHEAD_BUFFER_STATE_READING ) )
+		{
+			if( libcthreads_condition_wait(
+			     read_ahead->condition,
+			     read_ahead->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			/* The buffers can have changed while waiting
+			 */
+			continue;
+		}
+		if( ( read_ahead_buffer->state != LIBVHDI_READ_AHEAD_BUFFER_STATE_READ )
+		 || ( offset >= ( read_ahead_buffer->offset + (off64_t) read_ahead_buffer->data_size ) ) )
+		{
+			break;
+		}
+		read_size = (size_t) ( read_ahead_buffer->offset + read_ahead_buffer->data_size - offset );
+
+		if( read_size > ( buffer_size - buffer_offset ) )
+		{
+			read_size = buffer_size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( buffer[ buffer_offset ] ),
+		     &( read_ahead_buffer->data[ offset - read_ahead_buffer->offset ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy read-ahead data.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		offset        += read_size;
+		buffer_offset += read_size;
+	}
+	/* Release the buffers that were consumed or that are no longer
+	 * part of the read-ahead window
+	 */
+	for( buffer_index = 0;
+	     buffer_index < LIBVHDI_READ_AHEAD_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		read_ahead_buffer = &( read_ahead->buffers[ buffer_index ] );
+
+		if( ( read_ahead_buffer->state == LIBVHDI_READ_AHEAD_BUFFER_STATE_EMPTY )
+		 || ( read_ahead_buffer->state == LIBVHDI_READ_AHEAD_BUFFER_STATE_READING ) )
+		{
+			continue;
+		}
+		if( ( read_ahead->number_of_sequential_reads == 0 )
+		 || ( read_ahead_buffer->state == LIBVHDI_READ_AHEAD_BUFFER_STATE_FAILED )
+		 || ( ( read_ahead_buffer->offset + (off64_t) read_ahead->buffer_size ) <= offset ) )
+		{
+			read_ahead_buffer->state = LIBVHDI_READ_AHEAD_BUFFER_STATE_EMPTY;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	if( buffer_offset < buffer_size )
+	{
+		read_count = read_ahead->read_data(
+		              read_ahead->data_handle,
+		              &( buffer[ buffer_offset ] ),
+		              buffer_size - buffer_offset,
+		              offset,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		offset        += read_count;
+		buffer_offset += (size_t) read_count;
+	}
+	if( libcthreads_mutex_grab(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	read_ahead->last_read_end_offset = offset;
+
+	if( read_ahead->number_of_sequential_reads >= LIBVHDI_READ_AHEAD_SEQUENTIAL_READS_THRESHOLD )
+	{
+		if( libvhdi_read_ahead_schedule_buffers(
+		     read_ahead,
+		     offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to schedule read-ahead buffers.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+#endif /* defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT ) */
+
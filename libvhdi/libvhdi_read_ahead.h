@@ -0,0 +1,156 @@
+/*
+ * Read-ahead functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVHDI_READ_AHEAD_H )
+#define _LIBVHDI_READ_AHEAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvhdi_definitions.h"
+#include "libvhdi_libcerror.h"
+#include "libvhdi_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+
+typedef struct libvhdi_read_ahead_buffer libvhdi_read_ahead_buffer_t;
+
+struct libvhdi_read_ahead_buffer
+{
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The (media) offset of the data
+	 */
+	off64_t offset;
+
+	/* The size of the data that was read
+	 */
+	size_t data_size;
+
+	/* The state
+	 */
+	int state;
+};
+
+typedef struct libvhdi_read_ahead libvhdi_read_ahead_t;
+
+struct libvhdi_read_ahead
+{
+	/* The data handle
+	 */
+	intptr_t *data_handle;
+
+	/* The read data function
+	 */
+	ssize_t (*read_data)(
+	           intptr_t *data_handle,
+	           uint8_t *buffer,
+	           size_t buffer_size,
+	           off64_t offset,
+	           libcerror_error_t **error );
+
+	/* The (media) data size
+	 */
+	size64_t data_size;
+
+	/* The size of a buffer, which is the read-ahead window
+	 */
+	size_t buffer_size;
+
+	/* The buffers
+	 */
+	libvhdi_read_ahead_buffer_t buffers[ LIBVHDI_READ_AHEAD_NUMBER_OF_BUFFERS ];
+
+	/* The end offset of the last read
+	 */
+	off64_t last_read_end_offset;
+
+	/* The number of sequential reads
+	 */
+	int number_of_sequential_reads;
+
+	/* Value to indicate the read-ahead thread should stop
+	 */
+	uint8_t abort;
+
+	/* The read-ahead thread
+	 */
+	libcthreads_thread_t *thread;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition, which is signalled when the state of a buffer changes
+	 */
+	libcthreads_condition_t *condition;
+};
+
+int libvhdi_read_ahead_initialize(
+     libvhdi_read_ahead_t **read_ahead,
+     size_t buffer_size,
+     size64_t data_size,
+     intptr_t *data_handle,
+     ssize_t (*read_data)(
+            intptr_t *data_handle,
+            uint8_t *buffer,
+            size_t buffer_size,
+            off64_t offset,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libvhdi_read_ahead_free(
+     libvhdi_read_ahead_t **read_ahead,
+     libcerror_error_t **error );
+
+int libvhdi_read_ahead_thread_function(
+     void *arguments );
+
+int libvhdi_read_ahead_flush(
+     libvhdi_read_ahead_t *read_ahead,
+     libcerror_error_t **error );
+
+int libvhdi_read_ahead_schedule_buffers(
+     libvhdi_read_ahead_t *read_ahead,
+     off64_t offset,
+     libcerror_error_t **error );
+
+ssize_t libvhdi_read_ahead_read_buffer(
+         libvhdi_read_ahead_t *read_ahead,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVHDI_READ_AHEAD_H ) */
+
@@ -0,0 +1,2220 @@
+/*
+ * Read queue functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvhdi_definitions.h"
+#include "libvhdi_io_uring.h"
+#include "libvhdi_libcdata.h"
+#include "libvhdi_libcerror.h"
+#include "libvhdi_libcnotify.h"
+#include "libvhdi_libcthreads.h"
+#include "libvhdi_read_queue.h"
+#include "libvhdi_read_request.h"
+
+/* Creates a read queue
+ * Make sure the value read_queue is referencing, is set to NULL
+ * The read buffers function is called from the read queue threads, hence it must support concurrent reads
+ * The get file range function is optional and is used to determine if a read request can be read
+ * using the io_uring. It returns 1 and the file offset if the (media) data is stored contiguously
+ * in the file opened by libvhdi_read_queue_open_io_uring or 0 otherwise
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_read_queue_initialize(
+     libvhdi_read_queue_t **read_queue,
+     intptr_t *data_handle,
+     int (*read_buffers)(
+            intptr_t *data_handle,
+            void **buffers,
+            const size_t *buffer_sizes,
+            const off64_t *offsets,
+            ssize_t *read_counts,
+            int number_of_buffers,
+            libcerror_error_t **error ),
+     int (*get_file_range)(
+            intptr_t *data_handle,
+            off64_t offset,
+            size_t size,
+            off64_t *file_offset,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_read_queue_initialize";
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_queue != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read queue value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read buffers function.",
+		 function );
+
+		return( -1 );
+	}
+	*read_queue = memory_allocate_structure(
+	               libvhdi_read_queue_t );
+
+	if( *read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_queue,
+	     0,
+	     sizeof( libvhdi_read_queue_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read queue.",
+		 function );
+
+		memory_free(
+		 *read_queue );
+
+		*read_queue = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *read_queue )->pending_requests_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create pending requests array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *read_queue )->completed_requests_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create completed requests array.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_queue )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *read_queue )->pending_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create pending condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *read_queue )->completed_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create completed condition.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *read_queue )->data_handle    = data_handle;
+	( *read_queue )->read_buffers   = read_buffers;
+	( *read_queue )->get_file_range = get_file_range;
+
+	return( 1 );
+
+on_error:
+	if( *read_queue != NULL )
+	{
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+		if( ( *read_queue )->pending_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *read_queue )->pending_condition ),
+			 NULL );
+		}
+		if( ( *read_queue )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *read_queue )->mutex ),
+			 NULL );
+		}
+#endif
+		if( ( *read_queue )->completed_requests_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *read_queue )->completed_requests_array ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *read_queue )->pending_requests_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *read_queue )->pending_requests_array ),
+			 NULL,
+			 NULL );
+		}
+		memory_free(
+		 *read_queue );
+
+		*read_queue = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read queue
+ * This stops the read queue threads and discards the read requests
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_read_queue_free(
+     libvhdi_read_queue_t **read_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_read_queue_free";
+	int result            = 1;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_queue != NULL )
+	{
+		if( libvhdi_read_queue_flush(
+		     *read_queue,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to flush read queue.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( *read_queue )->io_uring != NULL )
+		{
+			if( libvhdi_io_uring_free(
+			     &( ( *read_queue )->io_uring ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free io_uring.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+		if( libcthreads_condition_free(
+		     &( ( *read_queue )->completed_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free completed condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_condition_free(
+		     &( ( *read_queue )->pending_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free pending condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *read_queue )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( libcdata_array_free(
+		     &( ( *read_queue )->completed_requests_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvhdi_read_request_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free completed requests array.",
+			 function );
+
+			result = -1;
+		}
+		if( libcdata_array_free(
+		     &( ( *read_queue )->pending_requests_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvhdi_read_request_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free pending requests array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *read_queue );
+
+		*read_queue = NULL;
+	}
+	return( result );
+}
+
+/* Opens the io_uring
+ * The read requests of which the data is stored contiguously in the file are read using
+ * the io_uring, the other read requests are read by the read queue threads
+ * This function is not multi-thread safe and should be called before read requests are pushed
+ * Returns 1 if successful, 0 if the io_uring is not available or -1 on error
+ */
+int libvhdi_read_queue_open_io_uring(
+     libvhdi_read_queue_t *read_queue,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libvhdi_io_uring_t *io_uring = NULL;
+	static char *function        = "libvhdi_read_queue_open_io_uring";
+	int result                   = 0;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_queue->io_uring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read queue - io_uring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_queue->get_file_range == NULL )
+	{
+		return( 0 );
+	}
+	if( libvhdi_io_uring_initialize(
+	     &io_uring,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create io_uring.",
+		 function );
+
+		goto on_error;
+	}
+	result = libvhdi_io_uring_open(
+	          io_uring,
+	          filename,
+	          LIBVHDI_READ_QUEUE_NUMBER_OF_IO_URING_ENTRIES,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open io_uring.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libvhdi_io_uring_free(
+		     &io_uring,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free io_uring.",
+			 function );
+
+			goto on_error;
+		}
+		return( 0 );
+	}
+	read_queue->io_uring = io_uring;
+
+	return( 1 );
+
+on_error:
+	if( io_uring != NULL )
+	{
+		libvhdi_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes the io_uring
+ * This flushes the read queue, which waits for the reads submitted to the io_uring to complete
+ * Returns 0 if successful or -1 on error
+ */
+int libvhdi_read_queue_close_io_uring(
+     libvhdi_read_queue_t *read_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_read_queue_close_io_uring";
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_queue->io_uring == NULL )
+	{
+		return( 0 );
+	}
+	if( libvhdi_read_queue_flush(
+	     read_queue,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to flush read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_io_uring_free(
+	     &( read_queue->io_uring ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+
+/* The read queue thread function
+ * Takes batches of pending read requests, reads them and marks them as completed,
+ * until the threads are stopped
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_read_queue_thread_function(
+     void *arguments )
+{
+	libvhdi_read_request_t *read_requests[ LIBVHDI_READ_QUEUE_MAXIMUM_BATCH_SIZE ];
+
+	libvhdi_read_queue_t *read_queue = NULL;
+	libcerror_error_t *error         = NULL;
+	static char *function            = "libvhdi_read_queue_thread_function";
+	int entry_index                  = 0;
+	int number_of_pending_requests   = 0;
+	int number_of_read_requests      = 0;
+	int read_request_index           = 0;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	read_queue = (libvhdi_read_queue_t *) arguments;
+
+	if( libcthreads_mutex_grab(
+	     read_queue->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	while( read_queue->abort == 0 )
+	{
+		if( libcdata_array_get_number_of_entries(
+		     read_queue->pending_requests_array,
+		     &number_of_pending_requests,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of pending requests.",
+			 function );
+
+			goto on_error_locked;
+		}
+		if( number_of_pending_requests == 0 )
+		{
+			if( libcthreads_condition_wait(
+			     read_queue->pending_condition,
+			     read_queue->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				goto on_error_locked;
+			}
+			continue;
+		}
+		number_of_read_requests = number_of_pending_requests;
+
+		if( number_of_read_requests > LIBVHDI_READ_QUEUE_MAXIMUM_BATCH_SIZE )
+		{
+			number_of_read_requests = LIBVHDI_READ_QUEUE_MAXIMUM_BATCH_SIZE;
+		}
+		for( read_request_index = 0;
+		     read_request_index < number_of_read_requests;
+		     read_request_index++ )
+		{
+			read_requests[ read_request_index ] = NULL;
+
+			if( libcdata_array_remove_entry(
+			     read_queue->pending_requests_array,
+			     0,
+			     (intptr_t **) &( read_requests[ read_request_index ] ),
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to remove pending request.",
+				 function );
+
+				number_of_read_requests = read_request_index;
+
+				goto on_error_locked;
+			}
+		}
+		if( libcthreads_mutex_release(
+		     read_queue->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		/* The data is read without holding the mutex, the read requests are owned by
+		 * this thread until they are marked as completed
+		 */
+		if( libvhdi_read_queue_read_requests(
+		     read_queue,
+		     read_requests,
+		     number_of_read_requests,
+		     &error ) != 1 )
+		{
+			/* A failed read is reported by the read count of the completion
+			 */
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_print_error_backtrace(
+				 error );
+			}
+#endif
+			libcerror_error_free(
+			 &error );
+		}
+		if( libcthreads_mutex_grab(
+		     read_queue->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		for( read_request_index = 0;
+		     read_request_index < number_of_read_requests;
+		     read_request_index++ )
+		{
+			if( libcdata_array_append_entry(
+			     read_queue->completed_requests_array,
+			     &entry_index,
+			     (intptr_t *) read_requests[ read_request_index ],
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append completed request.",
+				 function );
+
+				goto on_error_locked;
+			}
+			read_requests[ read_request_index ] = NULL;
+		}
+		number_of_read_requests = 0;
+
+		if( libcthreads_condition_broadcast(
+		     read_queue->completed_condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			goto on_error_locked;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_queue->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error_locked:
+	libcthreads_mutex_release(
+	 read_queue->mutex,
+	 NULL );
+
+on_error:
+	for( read_request_index = 0;
+	     read_request_index < number_of_read_requests;
+	     read_request_index++ )
+	{
+		if( read_requests[ read_request_index ] != NULL )
+		{
+			libvhdi_read_request_free(
+			 &( read_requests[ read_request_index ] ),
+			 NULL );
+		}
+	}
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Starts the read queue threads
+ * This function is not multi-thread safe acquire the mutex before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_read_queue_start_threads(
+     libvhdi_read_queue_t *read_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_read_queue_start_threads";
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	while( read_queue->number_of_threads < LIBVHDI_READ_QUEUE_NUMBER_OF_THREADS )
+	{
+		if( libcthreads_thread_create(
+		     &( read_queue->threads[ read_queue->number_of_threads ] ),
+		     NULL,
+		     &libvhdi_read_queue_thread_function,
+		     (void *) read_queue,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread: %d.",
+			 function,
+			 read_queue->number_of_threads );
+
+			return( -1 );
+		}
+		read_queue->number_of_threads++;
+	}
+	return( 1 );
+}
+
+/* Stops the read queue threads
+ * This waits for the reads in progress to finish, pending read requests remain pending
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_read_queue_stop_threads(
+     libvhdi_read_queue_t *read_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_read_queue_stop_threads";
+	int result            = 1;
+	int thread_index      = 0;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	read_queue->abort = 1;
+
+	if( libcthreads_condition_broadcast(
+	     read_queue->pending_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	/* The threads are joined without holding the mutex since they need it to finish
+	 */
+	for( thread_index = 0;
+	     thread_index < read_queue->number_of_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_join(
+		     &( read_queue->threads[ thread_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread: %d.",
+			 function,
+			 thread_index );
+
+			result = -1;
+		}
+	}
+	read_queue->number_of_threads = 0;
+	read_queue->abort             = 0;
+
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT ) */
+
+/* Reads the data of read requests
+ * The read requests are read with a single call of the read buffers function, which
+ * allows the reads to be coalesced, the read count of every read request is set
+ * and is -1 for all the read requests if the read failed
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_read_queue_read_requests(
+     libvhdi_read_queue_t *read_queue,
+     libvhdi_read_request_t **read_requests,
+     int number_of_read_requests,
+     libcerror_error_t **error )
+{
+	void *buffers[ LIBVHDI_READ_QUEUE_MAXIMUM_BATCH_SIZE ];
+	size_t buffer_sizes[ LIBVHDI_READ_QUEUE_MAXIMUM_BATCH_SIZE ];
+	off64_t offsets[ LIBVHDI_READ_QUEUE_MAXIMUM_BATCH_SIZE ];
+	ssize_t read_counts[ LIBVHDI_READ_QUEUE_MAXIMUM_BATCH_SIZE ];
+
+	static char *function  = "libvhdi_read_queue_read_requests";
+	int read_request_index = 0;
+	int result             = 0;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_queue->read_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read queue - missing read buffers function.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read requests.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_read_requests <= 0 )
+	 || ( number_of_read_requests > LIBVHDI_READ_QUEUE_MAXIMUM_BATCH_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of read requests value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( read_request_index = 0;
+	     read_request_index < number_of_read_requests;
+	     read_request_index++ )
+	{
+		if( read_requests[ read_request_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid read request: %d.",
+			 function,
+			 read_request_index );
+
+			return( -1 );
+		}
+		buffers[ read_request_index ]      = read_requests[ read_request_index ]->buffer;
+		buffer_sizes[ read_request_index ] = read_requests[ read_request_index ]->buffer_size;
+		offsets[ read_request_index ]      = read_requests[ read_request_index ]->offset;
+		read_counts[ read_request_index ]  = -1;
+	}
+	result = read_queue->read_buffers(
+	          read_queue->data_handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          number_of_read_requests,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffers.",
+		 function );
+	}
+	for( read_request_index = 0;
+	     read_request_index < number_of_read_requests;
+	     read_request_index++ )
+	{
+		if( result != 1 )
+		{
+			read_requests[ read_request_index ]->read_count = -1;
+		}
+		else
+		{
+			read_requests[ read_request_index ]->read_count = read_counts[ read_request_index ];
+		}
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Pushes a read request onto the io_uring
+ * The read is queued and submitted together with the other queued reads when a batch
+ * of reads was queued or when the completions are popped
+ * If the read was queued the read request is managed by the read queue and set to NULL,
+ * after which this function no longer fails, since the kernel can write into the buffer
+ * of the read request until its completion was read
+ * This function is not multi-thread safe acquire the mutex before call
+ * Returns 1 if successful, 0 if the io_uring is full or -1 on error
+ */
+int libvhdi_read_queue_push_io_uring_request(
+     libvhdi_read_queue_t *read_queue,
+     libvhdi_read_request_t **read_request,
+     off64_t file_offset,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *submit_error = NULL;
+	static char *function           = "libvhdi_read_queue_push_io_uring_request";
+	int result                      = 0;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	libcerror_error_t *broadcast_error = NULL;
+#endif
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_queue->io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read queue - missing io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: missing read request.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvhdi_io_uring_queue_read(
+	          read_queue->io_uring,
+	          ( *read_request )->buffer,
+	          ( *read_request )->buffer_size,
+	          file_offset,
+	          (uint64_t) (intptr_t) *read_request,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to queue read at file offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	/* The io_uring now manages the read request, which is returned with its completion
+	 */
+	*read_request = NULL;
+
+	read_queue->number_of_requests += 1;
+
+	if( read_queue->io_uring->number_of_queued_reads >= LIBVHDI_READ_QUEUE_MAXIMUM_BATCH_SIZE )
+	{
+		/* If the submit fails the reads remain queued and are submitted again when
+		 * the completions are popped, which reports the error
+		 */
+		if( libvhdi_io_uring_submit(
+		     read_queue->io_uring,
+		     0,
+		     &submit_error ) != 1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_print_error_backtrace(
+				 submit_error );
+			}
+#endif
+			libcerror_error_free(
+			 &submit_error );
+		}
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	/* Wake up threads that are waiting for completions of the read queue threads,
+	 * so that they wait for the completions of the io_uring instead
+	 */
+	if( libcthreads_condition_broadcast(
+	     read_queue->completed_condition,
+	     &broadcast_error ) != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 broadcast_error );
+		}
+#endif
+		libcerror_error_free(
+		 &broadcast_error );
+	}
+#endif
+	return( 1 );
+}
+
+/* Reads the completions of the io_uring
+ * This submits the queued reads and waits until at least the minimum number of reads
+ * has completed, after which the read requests of the completed reads are marked as completed
+ * The data of a read request is stored contiguously in the file, hence a read that did not
+ * read the entire buffer is reported as failed
+ * If another thread is waiting for completions of the io_uring the queued reads are only submitted,
+ * since that thread could otherwise wait for a completion that was already read
+ * This function is not multi-thread safe acquire the mutex before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_read_queue_read_io_uring_completions(
+     libvhdi_read_queue_t *read_queue,
+     uint32_t minimum_number_of_completions,
+     libcerror_error_t **error )
+{
+	uint64_t user_data[ LIBVHDI_READ_QUEUE_MAXIMUM_BATCH_SIZE ];
+	int32_t results[ LIBVHDI_READ_QUEUE_MAXIMUM_BATCH_SIZE ];
+
+	libvhdi_read_request_t *read_request = NULL;
+	static char *function                = "libvhdi_read_queue_read_io_uring_completions";
+	int completion_index                 = 0;
+	int entry_index                      = 0;
+	int number_of_completions            = 0;
+	int number_of_read_completions       = 0;
+	int result                           = 1;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_queue->io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read queue - missing io_uring.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( read_queue->io_uring_waiting != 0 )
+	{
+		if( minimum_number_of_completions > 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid read queue - io_uring completions are already waited for.",
+			 function );
+
+			return( -1 );
+		}
+		if( libvhdi_io_uring_submit(
+		     read_queue->io_uring,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to submit queued reads.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
+	if( libvhdi_io_uring_submit(
+	     read_queue->io_uring,
+	     minimum_number_of_completions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to submit queued reads.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		if( libvhdi_io_uring_get_completions(
+		     read_queue->io_uring,
+		     user_data,
+		     results,
+		     LIBVHDI_READ_QUEUE_MAXIMUM_BATCH_SIZE,
+		     &number_of_completions,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve completions.",
+			 function );
+
+			return( -1 );
+		}
+		/* The completions were removed from the io_uring and all of them must be handled
+		 */
+		for( completion_index = 0;
+		     completion_index < number_of_completions;
+		     completion_index++ )
+		{
+			read_request = (libvhdi_read_request_t *) (intptr_t) user_data[ completion_index ];
+
+			if( read_request == NULL )
+			{
+				continue;
+			}
+			if( ( results[ completion_index ] < 0 )
+			 || ( (size_t) results[ completion_index ] != read_request->buffer_size ) )
+			{
+				read_request->read_count = -1;
+			}
+			else
+			{
+				read_request->read_count = (ssize_t) results[ completion_index ];
+			}
+			if( libcdata_array_append_entry(
+			     read_queue->completed_requests_array,
+			     &entry_index,
+			     (intptr_t *) read_request,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append completed request.",
+				 function );
+
+				libvhdi_read_request_free(
+				 &read_request,
+				 NULL );
+
+				read_queue->number_of_requests -= 1;
+
+				result = -1;
+			}
+		}
+		number_of_read_completions += number_of_completions;
+	}
+	while( number_of_completions == LIBVHDI_READ_QUEUE_MAXIMUM_BATCH_SIZE );
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( number_of_read_completions > 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     read_queue->completed_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	return( result );
+}
+
+/* Flushes the read queue
+ * Stops the threads, which waits for the reads in progress to finish, waits for the reads
+ * submitted to the io_uring to complete and discards the pending and completed read requests
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_read_queue_flush(
+     libvhdi_read_queue_t *read_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_read_queue_flush";
+	int result            = 1;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( read_queue->number_of_threads > 0 )
+	{
+		if( libvhdi_read_queue_stop_threads(
+		     read_queue,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop threads.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_grab(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* The kernel can write into the buffers of the read requests until their reads have completed
+	 */
+	if( read_queue->io_uring != NULL )
+	{
+		while( read_queue->io_uring->number_of_outstanding_reads > 0 )
+		{
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+			if( read_queue->io_uring_waiting != 0 )
+			{
+				if( libcthreads_condition_wait(
+				     read_queue->completed_condition,
+				     read_queue->mutex,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to wait for condition.",
+					 function );
+
+					result = -1;
+
+					break;
+				}
+				continue;
+			}
+#endif
+			if( libvhdi_read_queue_read_io_uring_completions(
+			     read_queue,
+			     read_queue->io_uring->number_of_outstanding_reads,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read io_uring completions.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+	}
+	if( libcdata_array_empty(
+	     read_queue->pending_requests_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libvhdi_read_request_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty pending requests array.",
+		 function );
+
+		result = -1;
+	}
+	if( libcdata_array_empty(
+	     read_queue->completed_requests_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libvhdi_read_request_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty completed requests array.",
+		 function );
+
+		result = -1;
+	}
+	read_queue->number_of_requests = 0;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	/* Wake up threads that are waiting for completions that will no longer come
+	 */
+	if( libcthreads_condition_broadcast(
+	     read_queue->completed_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Pushes a read request onto the read queue
+ * The data is read using the io_uring if it is stored contiguously in the file, otherwise
+ * the data is read by the read queue threads, without multi-thread support the data is
+ * read before this function returns
+ * The buffer must remain available until the completion of the read request was popped
+ * Returns 1 if successful, 0 if the read queue is full or -1 on error
+ */
+int libvhdi_read_queue_push_request(
+     libvhdi_read_queue_t *read_queue,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     uint64_t request_identifier,
+     libcerror_error_t **error )
+{
+	libvhdi_read_request_t *read_request = NULL;
+	static char *function                = "libvhdi_read_queue_push_request";
+	off64_t file_offset                  = 0;
+	uint8_t use_io_uring                 = 0;
+	int entry_index                      = 0;
+	int result                           = 1;
+
+#if !defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	libcerror_error_t *read_error        = NULL;
+#endif
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_read_request_initialize(
+	     &read_request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read request.",
+		 function );
+
+		goto on_error;
+	}
+	read_request->request_identifier = request_identifier;
+	read_request->offset             = offset;
+	read_request->buffer             = buffer;
+	read_request->buffer_size        = buffer_size;
+	read_request->read_count         = -1;
+
+	/* The file range is determined before the mutex is grabbed since the get file range
+	 * function grabs the read/write lock of the file, which is also done by the read queue threads
+	 */
+	if( ( read_queue->io_uring != NULL )
+	 && ( buffer_size > 0 )
+	 && ( buffer_size <= (size_t) INT32_MAX ) )
+	{
+		result = read_queue->get_file_range(
+		          read_queue->data_handle,
+		          offset,
+		          buffer_size,
+		          &file_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			goto on_error;
+		}
+		use_io_uring = (uint8_t) result;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_queue->number_of_requests >= LIBVHDI_READ_QUEUE_MAXIMUM_NUMBER_OF_REQUESTS )
+	{
+		result = 0;
+	}
+	else
+	{
+		/* If the io_uring is full the read request is read by the read queue threads
+		 */
+		if( use_io_uring != 0 )
+		{
+			result = libvhdi_read_queue_push_io_uring_request(
+			          read_queue,
+			          &read_request,
+			          file_offset,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push io_uring request.",
+				 function );
+			}
+			else
+			{
+				result = 1;
+			}
+		}
+		if( ( result == 1 )
+		 && ( read_request != NULL ) )
+		{
+			if( libcdata_array_append_entry(
+			     read_queue->pending_requests_array,
+			     &entry_index,
+			     (intptr_t *) read_request,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append pending request.",
+				 function );
+
+				result = -1;
+			}
+			else
+			{
+				/* The pending requests array now manages the read request
+				 */
+				read_request = NULL;
+
+				read_queue->number_of_requests += 1;
+
+				if( read_queue->number_of_threads == 0 )
+				{
+					if( libvhdi_read_queue_start_threads(
+					     read_queue,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+						 "%s: unable to start threads.",
+						 function );
+
+						result = -1;
+					}
+				}
+				if( libcthreads_condition_signal(
+				     read_queue->pending_condition,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to signal condition.",
+					 function );
+
+					result = -1;
+				}
+			}
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+#else
+	if( read_queue->number_of_requests >= LIBVHDI_READ_QUEUE_MAXIMUM_NUMBER_OF_REQUESTS )
+	{
+		result = 0;
+	}
+	else
+	{
+		/* If the io_uring is full the read request is read before this function returns
+		 */
+		if( use_io_uring != 0 )
+		{
+			result = libvhdi_read_queue_push_io_uring_request(
+			          read_queue,
+			          &read_request,
+			          file_offset,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push io_uring request.",
+				 function );
+
+				goto on_error;
+			}
+			result = 1;
+		}
+		if( read_request != NULL )
+		{
+			if( libvhdi_read_queue_read_requests(
+			     read_queue,
+			     &read_request,
+			     1,
+			     &read_error ) != 1 )
+			{
+				/* A failed read is reported by the read count of the completion
+				 */
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_print_error_backtrace(
+					 read_error );
+				}
+#endif
+				libcerror_error_free(
+				 &read_error );
+			}
+			if( libcdata_array_append_entry(
+			     read_queue->completed_requests_array,
+			     &entry_index,
+			     (intptr_t *) read_request,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append completed request.",
+				 function );
+
+				goto on_error;
+			}
+			/* The completed requests array now manages the read request
+			 */
+			read_request = NULL;
+
+			read_queue->number_of_requests += 1;
+		}
+	}
+#endif /* defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT ) */
+
+	if( read_request != NULL )
+	{
+		libvhdi_read_request_free(
+		 &read_request,
+		 NULL );
+	}
+	return( result );
+
+on_error:
+	if( read_request != NULL )
+	{
+		libvhdi_read_request_free(
+		 &read_request,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Pops the completions of read requests from the read queue
+ * The request identifier and read count of every completion are stored in request_identifiers
+ * and read_counts, where the read count is -1 if the read failed
+ * The reads that were queued on the io_uring are submitted, as a batch, by this function
+ * If wait for completion is set and no completions are available this function waits until
+ * a read request completes, unless there are no outstanding read requests
+ * A single thread waits for the completions of the io_uring, without holding the mutex,
+ * other threads wait until it signals the completed condition
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_read_queue_pop_completions(
+     libvhdi_read_queue_t *read_queue,
+     uint64_t *request_identifiers,
+     ssize_t *read_counts,
+     int maximum_number_of_completions,
+     int *number_of_completions,
+     uint8_t wait_for_completion,
+     libcerror_error_t **error )
+{
+	libvhdi_read_request_t *read_request = NULL;
+	static char *function                = "libvhdi_read_queue_pop_completions";
+	int completion_index                 = 0;
+	int number_of_completed_requests     = 0;
+	int result                           = 1;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( request_identifiers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request identifiers.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_counts == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read counts.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_completions <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of completions value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_completions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of completions.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_completions = 0;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	do
+	{
+		/* This also submits the reads that were queued on the io_uring
+		 */
+		if( ( read_queue->io_uring != NULL )
+		 && ( read_queue->io_uring->number_of_outstanding_reads > 0 ) )
+		{
+			if( libvhdi_read_queue_read_io_uring_completions(
+			     read_queue,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read io_uring completions.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+		if( libcdata_array_get_number_of_entries(
+		     read_queue->completed_requests_array,
+		     &number_of_completed_requests,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of completed requests.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+		if( ( number_of_completed_requests == 0 )
+		 && ( wait_for_completion != 0 )
+		 && ( read_queue->io_uring != NULL )
+		 && ( read_queue->io_uring->number_of_outstanding_reads > 0 )
+		 && ( read_queue->io_uring_waiting == 0 ) )
+		{
+			/* The reads must be submitted before waiting for their completions
+			 */
+			if( libvhdi_io_uring_submit(
+			     read_queue->io_uring,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to submit queued reads.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			read_queue->io_uring_waiting = 1;
+
+			if( libcthreads_mutex_release(
+			     read_queue->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release mutex.",
+				 function );
+
+				return( -1 );
+			}
+			result = libvhdi_io_uring_wait(
+			          read_queue->io_uring,
+			          1,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to wait for io_uring completions.",
+				 function );
+
+				result = -1;
+			}
+			if( libcthreads_mutex_grab(
+			     read_queue->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab mutex.",
+				 function );
+
+				return( -1 );
+			}
+			read_queue->io_uring_waiting = 0;
+
+			if( result == 1 )
+			{
+				if( libvhdi_read_queue_read_io_uring_completions(
+				     read_queue,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read io_uring completions.",
+					 function );
+
+					result = -1;
+				}
+			}
+			/* Wake up the threads that are waiting for this thread, so that one of them
+			 * can wait for the completions of the io_uring instead
+			 */
+			if( libcthreads_condition_broadcast(
+			     read_queue->completed_condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast condition.",
+				 function );
+
+				result = -1;
+			}
+			if( result != 1 )
+			{
+				break;
+			}
+			continue;
+		}
+		if( ( number_of_completed_requests == 0 )
+		 && ( wait_for_completion != 0 )
+		 && ( read_queue->number_of_requests > 0 ) )
+		{
+			if( libcthreads_condition_wait(
+			     read_queue->completed_condition,
+			     read_queue->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			continue;
+		}
+#else
+		if( ( number_of_completed_requests == 0 )
+		 && ( wait_for_completion != 0 )
+		 && ( read_queue->io_uring != NULL )
+		 && ( read_queue->io_uring->number_of_outstanding_reads > 0 ) )
+		{
+			if( libvhdi_read_queue_read_io_uring_completions(
+			     read_queue,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read io_uring completions.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			continue;
+		}
+#endif /* defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT ) */
+
+		break;
+	}
+	while( 1 );
+
+	while( ( result == 1 )
+	    && ( completion_index < number_of_completed_requests )
+	    && ( completion_index < maximum_number_of_completions ) )
+	{
+		read_request = NULL;
+
+		if( libcdata_array_remove_entry(
+		     read_queue->completed_requests_array,
+		     0,
+		     (intptr_t **) &read_request,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove completed request.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		read_queue->number_of_requests -= 1;
+
+		if( read_request == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing completed request.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		request_identifiers[ completion_index ] = read_request->request_identifier;
+		read_counts[ completion_index ]         = read_request->read_count;
+
+		if( libvhdi_read_request_free(
+		     &read_request,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free completed request.",
+			 function );
+
+			result = -1;
+		}
+		completion_index++;
+	}
+	*number_of_completions = completion_index;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     read_queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
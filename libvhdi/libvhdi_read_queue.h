@@ -0,0 +1,204 @@
+/*
+ * Read queue functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVHDI_READ_QUEUE_H )
+#define _LIBVHDI_READ_QUEUE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvhdi_definitions.h"
+#include "libvhdi_io_uring.h"
+#include "libvhdi_libcdata.h"
+#include "libvhdi_libcerror.h"
+#include "libvhdi_libcthreads.h"
+#include "libvhdi_read_request.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvhdi_read_queue libvhdi_read_queue_t;
+
+struct libvhdi_read_queue
+{
+	/* The data handle
+	 */
+	intptr_t *data_handle;
+
+	/* The read buffers function
+	 */
+	int (*read_buffers)(
+	       intptr_t *data_handle,
+	       void **buffers,
+	       const size_t *buffer_sizes,
+	       const off64_t *offsets,
+	       ssize_t *read_counts,
+	       int number_of_buffers,
+	       libcerror_error_t **error );
+
+	/* The get file range function
+	 */
+	int (*get_file_range)(
+	       intptr_t *data_handle,
+	       off64_t offset,
+	       size_t size,
+	       off64_t *file_offset,
+	       libcerror_error_t **error );
+
+	/* The io_uring, which is NULL if the read requests are only read by the threads
+	 */
+	libvhdi_io_uring_t *io_uring;
+
+	/* The pending read requests array
+	 */
+	libcdata_array_t *pending_requests_array;
+
+	/* The completed read requests array
+	 */
+	libcdata_array_t *completed_requests_array;
+
+	/* The number of read requests that were submitted and not yet polled
+	 */
+	int number_of_requests;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	/* The threads
+	 */
+	libcthreads_thread_t *threads[ LIBVHDI_READ_QUEUE_NUMBER_OF_THREADS ];
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* Value to indicate the threads should stop
+	 */
+	uint8_t abort;
+
+	/* Value to indicate a thread is waiting for completions of the io_uring without holding the mutex
+	 */
+	uint8_t io_uring_waiting;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition, which is signalled when read requests are pending
+	 */
+	libcthreads_condition_t *pending_condition;
+
+	/* The condition, which is signalled when read requests are completed
+	 */
+	libcthreads_condition_t *completed_condition;
+#endif
+};
+
+int libvhdi_read_queue_initialize(
+     libvhdi_read_queue_t **read_queue,
+     intptr_t *data_handle,
+     int (*read_buffers)(
+            intptr_t *data_handle,
+            void **buffers,
+            const size_t *buffer_sizes,
+            const off64_t *offsets,
+            ssize_t *read_counts,
+            int number_of_buffers,
+            libcerror_error_t **error ),
+     int (*get_file_range)(
+            intptr_t *data_handle,
+            off64_t offset,
+            size_t size,
+            off64_t *file_offset,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libvhdi_read_queue_free(
+     libvhdi_read_queue_t **read_queue,
+     libcerror_error_t **error );
+
+int libvhdi_read_queue_open_io_uring(
+     libvhdi_read_queue_t *read_queue,
+     const char *filename,
+     libcerror_error_t **error );
+
+int libvhdi_read_queue_close_io_uring(
+     libvhdi_read_queue_t *read_queue,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+
+int libvhdi_read_queue_thread_function(
+     void *arguments );
+
+int libvhdi_read_queue_start_threads(
+     libvhdi_read_queue_t *read_queue,
+     libcerror_error_t **error );
+
+int libvhdi_read_queue_stop_threads(
+     libvhdi_read_queue_t *read_queue,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT ) */
+
+int libvhdi_read_queue_read_requests(
+     libvhdi_read_queue_t *read_queue,
+     libvhdi_read_request_t **read_requests,
+     int number_of_read_requests,
+     libcerror_error_t **error );
+
+int libvhdi_read_queue_push_io_uring_request(
+     libvhdi_read_queue_t *read_queue,
+     libvhdi_read_request_t **read_request,
+     off64_t file_offset,
+     libcerror_error_t **error );
+
+int libvhdi_read_queue_read_io_uring_completions(
+     libvhdi_read_queue_t *read_queue,
+     uint32_t minimum_number_of_completions,
+     libcerror_error_t **error );
+
+int libvhdi_read_queue_flush(
+     libvhdi_read_queue_t *read_queue,
+     libcerror_error_t **error );
+
+int libvhdi_read_queue_push_request(
+     libvhdi_read_queue_t *read_queue,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     uint64_t request_identifier,
+     libcerror_error_t **error );
+
+int libvhdi_read_queue_pop_completions(
+     libvhdi_read_queue_t *read_queue,
+     uint64_t *request_identifiers,
+     ssize_t *read_counts,
+     int maximum_number_of_completions,
+     int *number_of_completions,
+     uint8_t wait_for_completion,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVHDI_READ_QUEUE_H ) */
+
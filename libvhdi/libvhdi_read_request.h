@@ -0,0 +1,72 @@
+/*
+ * Read request functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVHDI_READ_REQUEST_H )
+#define _LIBVHDI_READ_REQUEST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvhdi_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvhdi_read_request libvhdi_read_request_t;
+
+struct libvhdi_read_request
+{
+	/* The request identifier
+	 */
+	uint64_t request_identifier;
+
+	/* The (media) offset
+	 */
+	off64_t offset;
+
+	/* The buffer
+	 */
+	void *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The read count, which is -1 if the read failed
+	 */
+	ssize_t read_count;
+};
+
+int libvhdi_read_request_initialize(
+     libvhdi_read_request_t **read_request,
+     libcerror_error_t **error );
+
+int libvhdi_read_request_free(
+     libvhdi_read_request_t **read_request,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVHDI_READ_REQUEST_H ) */
+
@@ -0,0 +1,52 @@
+/*
+ * Read segment functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include "libvhdi_read_segment.h"
+
+/* Compares two read segments by their file offset
+ * This function is used to sort read segments with qsort
+ * Returns -1 if the first read segment is stored before the second,
+ * 1 if it is stored after the second or 0 if both are stored at the same file offset
+ */
+int libvhdi_read_segment_compare_by_file_offset(
+     const void *first_read_segment,
+     const void *second_read_segment )
+{
+	off64_t first_file_offset  = 0;
+	off64_t second_file_offset = 0;
+
+	first_file_offset  = ( (const libvhdi_read_segment_t *) first_read_segment )->file_offset;
+	second_file_offset = ( (const libvhdi_read_segment_t *) second_read_segment )->file_offset;
+
+	if( first_file_offset < second_file_offset )
+	{
+		return( -1 );
+	}
+	else if( first_file_offset > second_file_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
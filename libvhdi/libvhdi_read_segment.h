@@ -0,0 +1,58 @@
+/*
+ * Read segment functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVHDI_READ_SEGMENT_H )
+#define _LIBVHDI_READ_SEGMENT_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvhdi_read_segment libvhdi_read_segment_t;
+
+struct libvhdi_read_segment
+{
+	/* The file offset
+	 */
+	off64_t file_offset;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+};
+
+int libvhdi_read_segment_compare_by_file_offset(
+     const void *first_read_segment,
+     const void *second_read_segment );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVHDI_READ_SEGMENT_H ) */
+
@@ -0,0 +1,77 @@
+/*
+ * Reference count functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVHDI_REFERENCE_COUNT_H )
+#define _LIBVHDI_REFERENCE_COUNT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvhdi_libcerror.h"
+#include "libvhdi_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvhdi_reference_count libvhdi_reference_count_t;
+
+struct libvhdi_reference_count
+{
+	/* The number of references
+	 */
+	int number_of_references;
+
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libvhdi_reference_count_initialize(
+     libvhdi_reference_count_t **reference_count,
+     libcerror_error_t **error );
+
+int libvhdi_reference_count_free(
+     libvhdi_reference_count_t **reference_count,
+     libcerror_error_t **error );
+
+int libvhdi_reference_count_get_number_of_references(
+     libvhdi_reference_count_t *reference_count,
+     int *number_of_references,
+     libcerror_error_t **error );
+
+int libvhdi_reference_count_increment(
+     libvhdi_reference_count_t *reference_count,
+     libcerror_error_t **error );
+
+int libvhdi_reference_count_decrement(
+     libvhdi_reference_count_t *reference_count,
+     int *number_of_references,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVHDI_REFERENCE_COUNT_H ) */
+
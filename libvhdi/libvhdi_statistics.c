@@ -0,0 +1,627 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#endif
+
+#include <time.h>
+
+#include "libvhdi_definitions.h"
+#include "libvhdi_libcerror.h"
+#include "libvhdi_libcthreads.h"
+#include "libvhdi_statistics.h"
+
+/* Creates statistics
+ * Make sure the value statistics is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_statistics_initialize(
+     libvhdi_statistics_t **statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_statistics_initialize";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *statistics != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid statistics value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*statistics = memory_allocate_structure(
+	               libvhdi_statistics_t );
+
+	if( *statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *statistics,
+	     0,
+	     sizeof( libvhdi_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
+		 function );
+
+		memory_free(
+		 *statistics );
+
+		*statistics = NULL;
+
+		return( -1 );
+	}
+#if defined( LIBVHDI_STATISTICS_HAVE_MUTEX )
+	if( libcthreads_mutex_initialize(
+	     &( ( *statistics )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *statistics != NULL )
+	{
+		memory_free(
+		 *statistics );
+
+		*statistics = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_statistics_free(
+     libvhdi_statistics_t **statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_statistics_free";
+	int result            = 1;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *statistics != NULL )
+	{
+#if defined( LIBVHDI_STATISTICS_HAVE_MUTEX )
+		if( libcthreads_mutex_free(
+		     &( ( *statistics )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *statistics );
+
+		*statistics = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves a timestamp of a monotonic clock in nanoseconds
+ * The timestamp is 0 if no monotonic clock is available
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_statistics_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	struct timespec time_structure;
+#endif
+
+	static char *function = "libvhdi_statistics_get_timestamp";
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve performance counter.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) ( counter.QuadPart / frequency.QuadPart ) * 1000000000 )
+	           + ( ( (uint64_t) ( counter.QuadPart % frequency.QuadPart ) * 1000000000 ) / (uint64_t) frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time structure.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) time_structure.tv_sec * 1000000000 ) + (uint64_t) time_structure.tv_nsec;
+
+#else
+	*timestamp = 0;
+
+#endif /* defined( WINAPI ) */
+
+	return( 1 );
+}
+
+/* Adds a value to a statistics value
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_statistics_add_value(
+     libvhdi_statistics_t *statistics,
+     int value_index,
+     uint64_t value,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_statistics_add_value";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_index < 0 )
+	 || ( value_index >= LIBVHDI_NUMBER_OF_STATISTICS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid value index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBVHDI_STATISTICS_HAVE_GNUC_ATOMICS )
+	__sync_fetch_and_add(
+	 &( statistics->values[ value_index ] ),
+	 value );
+
+#elif defined( LIBVHDI_STATISTICS_HAVE_WINAPI_ATOMICS )
+	InterlockedExchangeAdd64(
+	 (LONGLONG volatile *) &( statistics->values[ value_index ] ),
+	 (LONGLONG) value );
+
+#elif defined( LIBVHDI_STATISTICS_HAVE_MUTEX )
+	if( libcthreads_mutex_grab(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	statistics->values[ value_index ] += value;
+
+	if( libcthreads_mutex_release(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	statistics->values[ value_index ] += value;
+
+#endif
+	return( 1 );
+}
+
+/* Adds a read of the underlying file IO handle that started at the start timestamp
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_statistics_add_file_read(
+     libvhdi_statistics_t *statistics,
+     size_t read_size,
+     uint64_t start_timestamp,
+     libcerror_error_t **error )
+{
+	static char *function  = "libvhdi_statistics_add_file_read";
+	uint64_t end_timestamp = 0;
+
+	if( libvhdi_statistics_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	if( end_timestamp < start_timestamp )
+	{
+		end_timestamp = start_timestamp;
+	}
+	if( libvhdi_statistics_add_value(
+	     statistics,
+	     LIBVHDI_STATISTIC_NUMBER_OF_FILE_READS,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add number of file reads.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_statistics_add_value(
+	     statistics,
+	     LIBVHDI_STATISTIC_FILE_READ_SIZE,
+	     (uint64_t) read_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add file read size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_statistics_add_value(
+	     statistics,
+	     LIBVHDI_STATISTIC_FILE_READ_TIME,
+	     end_timestamp - start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add file read time.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Adds a range read from a parent file at a specific chain level
+ * Chain levels beyond the number of chain levels are added to the last chain level
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_statistics_add_parent_read(
+     libvhdi_statistics_t *statistics,
+     int chain_level,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_statistics_add_parent_read";
+
+	if( chain_level <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid chain level value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( chain_level > LIBVHDI_STATISTICS_NUMBER_OF_CHAIN_LEVELS )
+	{
+		chain_level = LIBVHDI_STATISTICS_NUMBER_OF_CHAIN_LEVELS;
+	}
+	if( libvhdi_statistics_add_value(
+	     statistics,
+	     LIBVHDI_STATISTIC_NUMBER_OF_PARENT_READS + chain_level - 1,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add number of parent reads of chain level: %d.",
+		 function,
+		 chain_level );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the statistics values
+ * At most number of values values are retrieved, values beyond LIBVHDI_NUMBER_OF_STATISTICS are set to 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_statistics_get_values(
+     libvhdi_statistics_t *statistics,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_statistics_get_values";
+	int value_index       = 0;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_values < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of values value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBVHDI_STATISTICS_HAVE_MUTEX )
+	if( libcthreads_mutex_grab(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( value_index = 0;
+	     value_index < number_of_values;
+	     value_index++ )
+	{
+		if( value_index >= LIBVHDI_NUMBER_OF_STATISTICS )
+		{
+			values[ value_index ] = 0;
+		}
+		else
+		{
+#if defined( LIBVHDI_STATISTICS_HAVE_GNUC_ATOMICS )
+			values[ value_index ] = __sync_fetch_and_add(
+			                         &( statistics->values[ value_index ] ),
+			                         0 );
+
+#elif defined( LIBVHDI_STATISTICS_HAVE_WINAPI_ATOMICS )
+			values[ value_index ] = (uint64_t) InterlockedCompareExchange64(
+			                                    (LONGLONG volatile *) &( statistics->values[ value_index ] ),
+			                                    0,
+			                                    0 );
+
+#else
+			values[ value_index ] = statistics->values[ value_index ];
+
+#endif
+		}
+	}
+#if defined( LIBVHDI_STATISTICS_HAVE_MUTEX )
+	if( libcthreads_mutex_release(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Resets the statistics values to 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvhdi_statistics_reset(
+     libvhdi_statistics_t *statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libvhdi_statistics_reset";
+	int value_index       = 0;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBVHDI_STATISTICS_HAVE_MUTEX )
+	if( libcthreads_mutex_grab(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( value_index = 0;
+	     value_index < LIBVHDI_NUMBER_OF_STATISTICS;
+	     value_index++ )
+	{
+#if defined( LIBVHDI_STATISTICS_HAVE_GNUC_ATOMICS )
+		__sync_fetch_and_and(
+		 &( statistics->values[ value_index ] ),
+		 0 );
+
+#elif defined( LIBVHDI_STATISTICS_HAVE_WINAPI_ATOMICS )
+		InterlockedExchange64(
+		 (LONGLONG volatile *) &( statistics->values[ value_index ] ),
+		 0 );
+
+#else
+		statistics->values[ value_index ] = 0;
+
+#endif
+	}
+#if defined( LIBVHDI_STATISTICS_HAVE_MUTEX )
+	if( libcthreads_mutex_release(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
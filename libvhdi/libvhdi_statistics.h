@@ -0,0 +1,111 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVHDI_STATISTICS_H )
+#define _LIBVHDI_STATISTICS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvhdi_definitions.h"
+#include "libvhdi_libcerror.h"
+#include "libvhdi_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The statistics values are updated with atomic operations if available
+ * otherwise, with multi-thread support, the updates are protected by a mutex
+ */
+#if defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define LIBVHDI_STATISTICS_HAVE_GNUC_ATOMICS	1
+
+#elif defined( _MSC_VER ) && defined( _WIN64 )
+#define LIBVHDI_STATISTICS_HAVE_WINAPI_ATOMICS	1
+
+#else
+#define LIBVHDI_STATISTICS_HAVE_MUTEX		1
+
+#endif
+#endif /* defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT ) */
+
+typedef struct libvhdi_statistics libvhdi_statistics_t;
+
+struct libvhdi_statistics
+{
+	/* The values
+	 */
+	uint64_t values[ LIBVHDI_NUMBER_OF_STATISTICS ];
+
+#if defined( LIBVHDI_STATISTICS_HAVE_MUTEX )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libvhdi_statistics_initialize(
+     libvhdi_statistics_t **statistics,
+     libcerror_error_t **error );
+
+int libvhdi_statistics_free(
+     libvhdi_statistics_t **statistics,
+     libcerror_error_t **error );
+
+int libvhdi_statistics_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error );
+
+int libvhdi_statistics_add_value(
+     libvhdi_statistics_t *statistics,
+     int value_index,
+     uint64_t value,
+     libcerror_error_t **error );
+
+int libvhdi_statistics_add_file_read(
+     libvhdi_statistics_t *statistics,
+     size_t read_size,
+     uint64_t start_timestamp,
+     libcerror_error_t **error );
+
+int libvhdi_statistics_add_parent_read(
+     libvhdi_statistics_t *statistics,
+     int chain_level,
+     libcerror_error_t **error );
+
+int libvhdi_statistics_get_values(
+     libvhdi_statistics_t *statistics,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error );
+
+int libvhdi_statistics_reset(
+     libvhdi_statistics_t *statistics,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVHDI_STATISTICS_H ) */
+
@@ -0,0 +1,128 @@
+/*
+ * The sidecar index file header definition
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _VHDI_INDEX_H )
+#define _VHDI_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct vhdi_index_header vhdi_index_header_t;
+
+struct vhdi_index_header
+{
+	/* The signature
+	 * Consists of 8 bytes
+	 * Consists of: vhdindex
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * Consists of 4 bytes
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The file type
+	 * Consists of 4 bytes
+	 */
+	uint8_t file_type[ 4 ];
+
+	/* The disk type
+	 * Consists of 4 bytes
+	 */
+	uint8_t disk_type[ 4 ];
+
+	/* The block size
+	 * Consists of 4 bytes
+	 */
+	uint8_t block_size[ 4 ];
+
+	/* The bytes per sector
+	 * Consists of 4 bytes
+	 */
+	uint8_t bytes_per_sector[ 4 ];
+
+	/* The number of block entries
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_entries[ 4 ];
+
+	/* The number of sector bitmap entries
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_sector_bitmaps[ 4 ];
+
+	/* The byte order mark
+	 * Consists of 4 bytes
+	 * Contains 0x01020304 in the byte order of the system that wrote the index
+	 */
+	uint8_t byte_order[ 4 ];
+
+	/* The image file size
+	 * Consists of 8 bytes
+	 */
+	uint8_t file_size[ 8 ];
+
+	/* The block allocation table file offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t block_allocation_table_offset[ 8 ];
+
+	/* The image identifier
+	 * Consists of 16 bytes
+	 * Contains a big-endian GUID
+	 */
+	uint8_t identifier[ 16 ];
+
+	/* The parent identifier
+	 * Consists of 16 bytes
+	 * Contains a big-endian GUID
+	 */
+	uint8_t parent_identifier[ 16 ];
+
+	/* Unknown (reserved)
+	 * Consists of 4 bytes
+	 */
+	uint8_t unknown2[ 4 ];
+
+	/* The checksum
+	 * Consists of 4 bytes
+	 * Contains a CRC-32 of the index header, without the checksum, and the index entries data
+	 */
+	uint8_t checksum[ 4 ];
+
+	/* The index entries data follows the header and consists of:
+	 * the block file offsets, the sector bitmap file offsets and the block states
+	 * The file offsets are stored as 64-bit values in the byte order of the system
+	 * that wrote the index
+	 */
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _VHDI_INDEX_H ) */
+
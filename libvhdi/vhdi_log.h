@@ -0,0 +1,182 @@
+/*
+ * The log definitions of a Virtual Hard Disk version 2 (VHDX) file
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _VHDI_LOG_H )
+#define _VHDI_LOG_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct vhdi_log_entry_header vhdi_log_entry_header_t;
+
+struct vhdi_log_entry_header
+{
+	/* The signature
+	 * Consists of 4 bytes
+	 * Consists of: loge
+	 */
+	uint8_t signature[ 4 ];
+
+	/* The checksum
+	 * Consists of 4 bytes
+	 */
+	uint8_t checksum[ 4 ];
+
+	/* The entry size
+	 * Consists of 4 bytes
+	 */
+	uint8_t entry_size[ 4 ];
+
+	/* The tail (entry) offset
+	 * Consists of 4 bytes
+	 */
+	uint8_t tail_offset[ 4 ];
+
+	/* The sequence number
+	 * Consists of 8 bytes
+	 */
+	uint8_t sequence_number[ 8 ];
+
+	/* The number of descriptors
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_descriptors[ 4 ];
+
+	/* Unknown (reserved)
+	 * Consists of 4 bytes
+	 */
+	uint8_t unknown1[ 4 ];
+
+	/* The log identifier
+	 * Consists of 16 bytes
+	 * Contains a GUID
+	 */
+	uint8_t log_identifier[ 16 ];
+
+	/* The flushed file offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t flushed_file_offset[ 8 ];
+
+	/* The last file offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t last_file_offset[ 8 ];
+};
+
+typedef struct vhdi_log_zero_descriptor vhdi_log_zero_descriptor_t;
+
+struct vhdi_log_zero_descriptor
+{
+	/* The signature
+	 * Consists of 4 bytes
+	 * Consists of: zero
+	 */
+	uint8_t signature[ 4 ];
+
+	/* Unknown (reserved)
+	 * Consists of 4 bytes
+	 */
+	uint8_t unknown1[ 4 ];
+
+	/* The size of the data that is zero
+	 * Consists of 8 bytes
+	 */
+	uint8_t zero_size[ 8 ];
+
+	/* The file offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t file_offset[ 8 ];
+
+	/* The sequence number
+	 * Consists of 8 bytes
+	 */
+	uint8_t sequence_number[ 8 ];
+};
+
+typedef struct vhdi_log_data_descriptor vhdi_log_data_descriptor_t;
+
+struct vhdi_log_data_descriptor
+{
+	/* The signature
+	 * Consists of 4 bytes
+	 * Consists of: desc
+	 */
+	uint8_t signature[ 4 ];
+
+	/* The trailing bytes of the data sector
+	 * Consists of 4 bytes
+	 */
+	uint8_t trailing_bytes[ 4 ];
+
+	/* The leading bytes of the data sector
+	 * Consists of 8 bytes
+	 */
+	uint8_t leading_bytes[ 8 ];
+
+	/* The file offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t file_offset[ 8 ];
+
+	/* The sequence number
+	 * Consists of 8 bytes
+	 */
+	uint8_t sequence_number[ 8 ];
+};
+
+typedef struct vhdi_log_data_sector vhdi_log_data_sector_t;
+
+struct vhdi_log_data_sector
+{
+	/* The signature
+	 * Consists of 4 bytes
+	 * Consists of: data
+	 */
+	uint8_t signature[ 4 ];
+
+	/* The upper 32-bit of the sequence number
+	 * Consists of 4 bytes
+	 */
+	uint8_t sequence_number_upper[ 4 ];
+
+	/* The data
+	 * Consists of 4084 bytes
+	 */
+	uint8_t data[ 4084 ];
+
+	/* The lower 32-bit of the sequence number
+	 * Consists of 4 bytes
+	 */
+	uint8_t sequence_number_lower[ 4 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _VHDI_LOG_H ) */
+
@@ -87,7 +87,8 @@ AC_DEFUN([AX_VHDITOOLS_CHECK_LOCAL],
   dnl Headers included in vhditools/vhdimount.c
   AC_CHECK_HEADERS([errno.h sys/time.h])
 
-  dnl Functions included in vhditools/mount_file_system.c and vhditools/mount_file_entry.c
+  dnl Functions included in vhditools/bench_worker.c, vhditools/mount_file_system.c
+  dnl and vhditools/mount_file_entry.c
   AS_IF(
     [test "x$ac_cv_enable_winapi" = xno],
     [AC_CHECK_FUNCS([clock_gettime getegid geteuid time])
@@ -1,6 +1,6 @@
 # Tests library functions and types.
 
-$LibraryTests = "block_allocation_table block_descriptor checksum dynamic_disk_header error file_footer file_information image_header io_handle metadata_table metadata_table_entry metadata_table_header metadata_values notify parent_locator parent_locator_entry parent_locator_header region_table region_table_entry region_table_header sector_range_descriptor"
+$LibraryTests = "block_allocation_table block_cache block_descriptor checksum dynamic_disk_header error file_footer file_information image_header io_handle io_uring log metadata_table metadata_table_entry metadata_table_header metadata_values notify parent_locator parent_locator_entry parent_locator_header read_ahead read_segment region_table region_table_entry region_table_header sector_range_descriptor statistics"
 $LibraryTestsWithInput = "file support"
 $OptionSets = "" -split " "
 
@@ -27,6 +27,8 @@
 #include <stdlib.h>
 #endif
 
+#include "vhdi_test_functions.h"
+#include "vhdi_test_libbfio.h"
 #include "vhdi_test_libcerror.h"
 #include "vhdi_test_libvhdi.h"
 #include "vhdi_test_macros.h"
@@ -35,6 +37,20 @@
 
 #include "../libvhdi/libvhdi_block_allocation_table.h"
 
+uint8_t vhdi_test_block_allocation_table_data1[ 16 ] = {
+	0x00, 0x00, 0x00, 0x03, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x10, 0xff, 0xff, 0xff, 0xff };
+
+uint8_t vhdi_test_block_allocation_table_data2[ 136 ] = {
+	0x06, 0x00, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
 #if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT )
 
 /* Tests the libvhdi_block_allocation_table_initialize function
@@ -275,6 +291,615 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvhdi_block_allocation_table_read_entries_file_io_handle function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_block_allocation_table_read_entries_file_io_handle(
+     void )
+{
+	libbfio_handle_t *file_io_handle                         = NULL;
+	libcerror_error_t *error                                 = NULL;
+	libvhdi_block_allocation_table_t *block_allocation_table = NULL;
+	int result                                               = 0;
+
+	/* Initialize test
+	 */
+	result = libvhdi_block_allocation_table_initialize(
+	          &block_allocation_table,
+	          4,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "block_allocation_table",
+	 block_allocation_table );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vhdi_test_open_file_io_handle(
+	          &file_io_handle,
+	          vhdi_test_block_allocation_table_data1,
+	          16,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_block_allocation_table_read_file_io_handle(
+	          block_allocation_table,
+	          file_io_handle,
+	          LIBVHDI_FILE_TYPE_VHD,
+	          LIBVHDI_DISK_TYPE_DYNAMIC,
+	          0,
+	          0x00200000UL,
+	          512,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvhdi_block_allocation_table_read_entries_file_io_handle(
+	          block_allocation_table,
+	          file_io_handle,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "block_allocation_table->block_file_offsets",
+	 block_allocation_table->block_file_offsets );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "block_allocation_table->block_file_offsets[ 0 ]",
+	 (int64_t) block_allocation_table->block_file_offsets[ 0 ],
+	 (int64_t) 2048 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "block_allocation_table->block_file_offsets[ 1 ]",
+	 (int64_t) block_allocation_table->block_file_offsets[ 1 ],
+	 (int64_t) -1 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "block_allocation_table->block_file_offsets[ 2 ]",
+	 (int64_t) block_allocation_table->block_file_offsets[ 2 ],
+	 (int64_t) 8704 );
+
+	/* Test error cases
+	 */
+	result = libvhdi_block_allocation_table_read_entries_file_io_handle(
+	          NULL,
+	          file_io_handle,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_allocation_table_read_entries_file_io_handle(
+	          block_allocation_table,
+	          file_io_handle,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvhdi_block_allocation_table_free(
+	          &block_allocation_table,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "block_allocation_table",
+	 block_allocation_table );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error case where the table data is too small
+	 */
+	result = libvhdi_block_allocation_table_initialize(
+	          &block_allocation_table,
+	          8,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "block_allocation_table",
+	 block_allocation_table );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	block_allocation_table->file_type          = LIBVHDI_FILE_TYPE_VHD;
+	block_allocation_table->disk_type          = LIBVHDI_DISK_TYPE_DYNAMIC;
+	block_allocation_table->block_size         = 0x00200000UL;
+	block_allocation_table->table_entry_size   = 4;
+	block_allocation_table->sector_bitmap_size = 512;
+	block_allocation_table->bytes_per_sector   = 512;
+
+	result = libvhdi_block_allocation_table_read_entries_file_io_handle(
+	          block_allocation_table,
+	          file_io_handle,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "block_allocation_table->block_file_offsets",
+	 block_allocation_table->block_file_offsets );
+
+	/* Clean up
+	 */
+	result = libvhdi_block_allocation_table_free(
+	          &block_allocation_table,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vhdi_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( block_allocation_table != NULL )
+	{
+		libvhdi_block_allocation_table_free(
+		 &block_allocation_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_block_allocation_table_get_entry_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_block_allocation_table_get_entry_by_index(
+     void )
+{
+	libbfio_handle_t *file_io_handle                         = NULL;
+	libcerror_error_t *error                                 = NULL;
+	libvhdi_block_allocation_table_t *block_allocation_table = NULL;
+	off64_t block_file_offset                                = 0;
+	off64_t sector_bitmap_file_offset                        = 0;
+	uint8_t block_state                                      = 0;
+	int result                                               = 0;
+
+	/* Initialize test
+	 */
+	result = libvhdi_block_allocation_table_initialize(
+	          &block_allocation_table,
+	          2,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "block_allocation_table",
+	 block_allocation_table );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vhdi_test_open_file_io_handle(
+	          &file_io_handle,
+	          vhdi_test_block_allocation_table_data2,
+	          136,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_block_allocation_table_read_file_io_handle(
+	          block_allocation_table,
+	          file_io_handle,
+	          LIBVHDI_FILE_TYPE_VHDX,
+	          LIBVHDI_DISK_TYPE_DIFFERENTIAL,
+	          0,
+	          0x10000000UL,
+	          512,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases with the entries read on demand
+	 */
+	result = libvhdi_block_allocation_table_get_entry_by_index(
+	          block_allocation_table,
+	          file_io_handle,
+	          1,
+	          &block_file_offset,
+	          &block_state,
+	          &sector_bitmap_file_offset,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "block_file_offset",
+	 (int64_t) block_file_offset,
+	 (int64_t) 0x00600000UL );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT8(
+	 "block_state",
+	 block_state,
+	 7 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "sector_bitmap_file_offset",
+	 (int64_t) sector_bitmap_file_offset,
+	 (int64_t) 0x00110000UL );
+
+	/* Test regular cases with the entries read in advance
+	 */
+	result = libvhdi_block_allocation_table_read_entries_file_io_handle(
+	          block_allocation_table,
+	          file_io_handle,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_block_allocation_table_get_entry_by_index(
+	          block_allocation_table,
+	          file_io_handle,
+	          0,
+	          &block_file_offset,
+	          &block_state,
+	          &sector_bitmap_file_offset,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "block_file_offset",
+	 (int64_t) block_file_offset,
+	 (int64_t) 0x00500000UL );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT8(
+	 "block_state",
+	 block_state,
+	 6 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "sector_bitmap_file_offset",
+	 (int64_t) sector_bitmap_file_offset,
+	 (int64_t) 0x00100000UL );
+
+	result = libvhdi_block_allocation_table_get_entry_by_index(
+	          block_allocation_table,
+	          file_io_handle,
+	          1,
+	          &block_file_offset,
+	          &block_state,
+	          &sector_bitmap_file_offset,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "block_file_offset",
+	 (int64_t) block_file_offset,
+	 (int64_t) 0x00600000UL );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT8(
+	 "block_state",
+	 block_state,
+	 7 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "sector_bitmap_file_offset",
+	 (int64_t) sector_bitmap_file_offset,
+	 (int64_t) 0x00110000UL );
+
+	/* Test error cases
+	 */
+	result = libvhdi_block_allocation_table_get_entry_by_index(
+	          NULL,
+	          file_io_handle,
+	          0,
+	          &block_file_offset,
+	          &block_state,
+	          &sector_bitmap_file_offset,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_allocation_table_get_entry_by_index(
+	          block_allocation_table,
+	          file_io_handle,
+	          2,
+	          &block_file_offset,
+	          &block_state,
+	          &sector_bitmap_file_offset,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_allocation_table_get_entry_by_index(
+	          block_allocation_table,
+	          file_io_handle,
+	          0,
+	          NULL,
+	          &block_state,
+	          &sector_bitmap_file_offset,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_allocation_table_get_entry_by_index(
+	          block_allocation_table,
+	          file_io_handle,
+	          0,
+	          &block_file_offset,
+	          NULL,
+	          &sector_bitmap_file_offset,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_allocation_table_get_entry_by_index(
+	          block_allocation_table,
+	          file_io_handle,
+	          0,
+	          &block_file_offset,
+	          &block_state,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvhdi_block_allocation_table_free(
+	          &block_allocation_table,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "block_allocation_table",
+	 block_allocation_table );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vhdi_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( block_allocation_table != NULL )
+	{
+		libvhdi_block_allocation_table_free(
+		 &block_allocation_table,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
 
 /* The main program
@@ -302,7 +927,19 @@ int main(
 	 "libvhdi_block_allocation_table_free",
 	 vhdi_test_block_allocation_table_free );
 
-	/* TODO: add tests for libvhdi_block_allocation_table_read_element_data */
+	/* TODO: add tests for libvhdi_block_allocation_table_read_file_io_handle */
+
+	VHDI_TEST_RUN(
+	 "libvhdi_block_allocation_table_read_entries_file_io_handle",
+	 vhdi_test_block_allocation_table_read_entries_file_io_handle );
+
+	/* TODO: add tests for libvhdi_block_allocation_table_read_table_entry_file_io_handle */
+
+	VHDI_TEST_RUN(
+	 "libvhdi_block_allocation_table_get_entry_by_index",
+	 vhdi_test_block_allocation_table_get_entry_by_index );
+
+	/* TODO: add tests for libvhdi_block_allocation_table_read_block_descriptor */
 
 #endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
 
@@ -0,0 +1,1081 @@
+/*
+ * Library block_cache type test program
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vhdi_test_libcerror.h"
+#include "vhdi_test_libvhdi.h"
+#include "vhdi_test_macros.h"
+#include "vhdi_test_memory.h"
+#include "vhdi_test_unused.h"
+
+#include "../libvhdi/libvhdi_block_cache.h"
+#include "../libvhdi/libvhdi_block_descriptor.h"
+
+uint8_t vhdi_test_block_cache_sector_bitmap_data1[ 4 ] = {
+	0xff, 0xff, 0x00, 0x00 };
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT )
+
+/* Creates a block descriptor for testing
+ * Returns 1 if successful or -1 on error
+ */
+int vhdi_test_block_cache_create_block_descriptor(
+     libvhdi_block_descriptor_t **block_descriptor,
+     off64_t file_offset,
+     libcerror_error_t **error )
+{
+	if( libvhdi_block_descriptor_initialize(
+	     block_descriptor,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	( *block_descriptor )->file_offset = file_offset;
+
+	if( libvhdi_block_descriptor_read_sector_bitmap_data(
+	     *block_descriptor,
+	     vhdi_test_block_cache_sector_bitmap_data1,
+	     4,
+	     LIBVHDI_FILE_TYPE_VHDX,
+	     512,
+	     error ) != 1 )
+	{
+		libvhdi_block_descriptor_free(
+		 block_descriptor,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libvhdi_block_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_block_cache_initialize(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libvhdi_block_cache_t *block_cache = NULL;
+	int result                         = 0;
+
+#if defined( HAVE_VHDI_TEST_MEMORY )
+	int number_of_malloc_fail_tests    = 6;
+	int number_of_memset_fail_tests    = 3;
+	int test_number                    = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvhdi_block_cache_initialize(
+	          &block_cache,
+	          256,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "block_cache",
+	 block_cache );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_block_cache_free(
+	          &block_cache,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "block_cache",
+	 block_cache );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_block_cache_initialize(
+	          NULL,
+	          256,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	block_cache = (libvhdi_block_cache_t *) 0x12345678UL;
+
+	result = libvhdi_block_cache_initialize(
+	          &block_cache,
+	          256,
+	          &error );
+
+	block_cache = NULL;
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_cache_initialize(
+	          &block_cache,
+	          0,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VHDI_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvhdi_block_cache_initialize with malloc failing
+		 */
+		vhdi_test_malloc_attempts_before_fail = test_number;
+
+		result = libvhdi_block_cache_initialize(
+		          &block_cache,
+		          1,
+		          &error );
+
+		if( vhdi_test_malloc_attempts_before_fail != -1 )
+		{
+			vhdi_test_malloc_attempts_before_fail = -1;
+
+			if( block_cache != NULL )
+			{
+				libvhdi_block_cache_free(
+				 &block_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VHDI_TEST_ASSERT_IS_NULL(
+			 "block_cache",
+			 block_cache );
+
+			VHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvhdi_block_cache_initialize with memset failing
+		 */
+		vhdi_test_memset_attempts_before_fail = test_number;
+
+		result = libvhdi_block_cache_initialize(
+		          &block_cache,
+		          1,
+		          &error );
+
+		if( vhdi_test_memset_attempts_before_fail != -1 )
+		{
+			vhdi_test_memset_attempts_before_fail = -1;
+
+			if( block_cache != NULL )
+			{
+				libvhdi_block_cache_free(
+				 &block_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VHDI_TEST_ASSERT_IS_NULL(
+			 "block_cache",
+			 block_cache );
+
+			VHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VHDI_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_cache != NULL )
+	{
+		libvhdi_block_cache_free(
+		 &block_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_block_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_block_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvhdi_block_cache_free(
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_block_cache_insert_block_descriptor and libvhdi_block_cache_get_range_at_offset functions
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_block_cache_insert_block_descriptor(
+     void )
+{
+	libcerror_error_t *error                     = NULL;
+	libvhdi_block_cache_t *block_cache           = NULL;
+	libvhdi_block_descriptor_t *block_descriptor = NULL;
+	off64_t range_file_offset                    = 0;
+	size_t range_size                            = 0;
+	uint32_t range_flags                         = 0;
+	int result                                   = 0;
+
+	/* Initialize test
+	 * A cache of 2 entries consists of 2 shards of 1 entry each
+	 */
+	result = libvhdi_block_cache_initialize(
+	          &block_cache,
+	          2,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "block_cache",
+	 block_cache );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vhdi_test_block_cache_create_block_descriptor(
+	          &block_descriptor,
+	          4096,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvhdi_block_cache_get_range_at_offset(
+	          block_cache,
+	          0,
+	          512,
+	          &range_file_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_block_cache_insert_block_descriptor(
+	          block_cache,
+	          0,
+	          &block_descriptor,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "block_descriptor",
+	 block_descriptor );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_block_cache_get_range_at_offset(
+	          block_cache,
+	          0,
+	          512,
+	          &range_file_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "range_file_offset",
+	 (int64_t) range_file_offset,
+	 (int64_t) 4608 );
+
+	VHDI_TEST_ASSERT_EQUAL_SIZE(
+	 "range_size",
+	 range_size,
+	 (size_t) 7680 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test inserting a block that is already cached
+	 */
+	result = vhdi_test_block_cache_create_block_descriptor(
+	          &block_descriptor,
+	          4096,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvhdi_block_cache_insert_block_descriptor(
+	          block_cache,
+	          0,
+	          &block_descriptor,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "block_descriptor",
+	 block_descriptor );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test eviction of block 0 by block 2 which maps to the same shard
+	 */
+	result = vhdi_test_block_cache_create_block_descriptor(
+	          &block_descriptor,
+	          8192,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvhdi_block_cache_insert_block_descriptor(
+	          block_cache,
+	          2,
+	          &block_descriptor,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_block_cache_get_range_at_offset(
+	          block_cache,
+	          0,
+	          512,
+	          &range_file_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_block_cache_get_range_at_offset(
+	          block_cache,
+	          2,
+	          8192,
+	          &range_file_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "range_file_offset",
+	 (int64_t) range_file_offset,
+	 (int64_t) 16384 );
+
+	/* The second half of the block is unallocated
+	 */
+	VHDI_TEST_ASSERT_EQUAL_SIZE(
+	 "range_size",
+	 range_size,
+	 (size_t) 8192 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) 0x00000001UL );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_block_cache_get_range_at_offset(
+	          NULL,
+	          0,
+	          512,
+	          &range_file_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_cache_insert_block_descriptor(
+	          NULL,
+	          0,
+	          &block_descriptor,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_cache_insert_block_descriptor(
+	          block_cache,
+	          0,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_cache_insert_block_descriptor(
+	          block_cache,
+	          0,
+	          &block_descriptor,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvhdi_block_cache_free(
+	          &block_cache,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "block_cache",
+	 block_cache );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_descriptor != NULL )
+	{
+		libvhdi_block_descriptor_free(
+		 &block_descriptor,
+		 NULL );
+	}
+	if( block_cache != NULL )
+	{
+		libvhdi_block_cache_free(
+		 &block_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_block_cache_get_range_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_block_cache_get_range_at_offset(
+     void )
+{
+	libcerror_error_t *error                     = NULL;
+	libvhdi_block_cache_t *block_cache           = NULL;
+	libvhdi_block_descriptor_t *block_descriptor = NULL;
+	off64_t range_file_offset                    = 0;
+	size_t range_size                            = 0;
+	uint32_t range_flags                         = 0;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libvhdi_block_cache_initialize(
+	          &block_cache,
+	          256,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vhdi_test_block_cache_create_block_descriptor(
+	          &block_descriptor,
+	          4096,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvhdi_block_cache_insert_block_descriptor(
+	          block_cache,
+	          7,
+	          &block_descriptor,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = libvhdi_block_cache_get_range_at_offset(
+	          block_cache,
+	          7,
+	          0,
+	          &range_file_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvhdi_block_cache_get_range_at_offset(
+	          block_cache,
+	          8,
+	          0,
+	          &range_file_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_block_cache_get_range_at_offset(
+	          NULL,
+	          7,
+	          0,
+	          &range_file_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvhdi_block_cache_free(
+	          &block_cache,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_descriptor != NULL )
+	{
+		libvhdi_block_descriptor_free(
+		 &block_descriptor,
+		 NULL );
+	}
+	if( block_cache != NULL )
+	{
+		libvhdi_block_cache_free(
+		 &block_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_block_cache_get_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_block_cache_get_statistics(
+     void )
+{
+	libcerror_error_t *error                     = NULL;
+	libvhdi_block_cache_t *block_cache           = NULL;
+	libvhdi_block_descriptor_t *block_descriptor = NULL;
+	off64_t range_file_offset                    = 0;
+	size_t range_size                            = 0;
+	uint64_t number_of_hits                      = 0;
+	uint64_t number_of_misses                    = 0;
+	uint32_t range_flags                         = 0;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libvhdi_block_cache_initialize(
+	          &block_cache,
+	          256,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vhdi_test_block_cache_create_block_descriptor(
+	          &block_descriptor,
+	          4096,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvhdi_block_cache_insert_block_descriptor(
+	          block_cache,
+	          7,
+	          &block_descriptor,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvhdi_block_cache_get_range_at_offset(
+	          block_cache,
+	          7,
+	          0,
+	          &range_file_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvhdi_block_cache_get_range_at_offset(
+	          block_cache,
+	          8,
+	          0,
+	          &range_file_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test regular cases
+	 */
+	result = libvhdi_block_cache_get_statistics(
+	          block_cache,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_hits",
+	 number_of_hits,
+	 (uint64_t) 1 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_misses",
+	 number_of_misses,
+	 (uint64_t) 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_block_cache_get_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_cache_get_statistics(
+	          block_cache,
+	          NULL,
+	          &number_of_misses,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_cache_get_statistics(
+	          block_cache,
+	          &number_of_hits,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvhdi_block_cache_free(
+	          &block_cache,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_descriptor != NULL )
+	{
+		libvhdi_block_descriptor_free(
+		 &block_descriptor,
+		 NULL );
+	}
+	if( block_cache != NULL )
+	{
+		libvhdi_block_cache_free(
+		 &block_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	VHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT )
+
+	VHDI_TEST_RUN(
+	 "libvhdi_block_cache_initialize",
+	 vhdi_test_block_cache_initialize );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_block_cache_free",
+	 vhdi_test_block_cache_free );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_block_cache_insert_block_descriptor",
+	 vhdi_test_block_cache_insert_block_descriptor );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_block_cache_get_range_at_offset",
+	 vhdi_test_block_cache_get_range_at_offset );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_block_cache_get_statistics",
+	 vhdi_test_block_cache_get_statistics );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
+}
+
@@ -289,6 +289,219 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvhdi_block_descriptor_get_sector_ranges_from_bitmap function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_block_descriptor_get_sector_ranges_from_bitmap(
+     void )
+{
+	uint32_t sector_range_end_offsets[ 31 ];
+
+	libcerror_error_t *error    = NULL;
+	int number_of_sector_ranges = 0;
+	int result                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libvhdi_block_descriptor_get_sector_ranges_from_bitmap(
+	          vhdi_test_block_descriptor_data1,
+	          256,
+	          LIBVHDI_FILE_TYPE_VHD,
+	          512,
+	          NULL,
+	          &number_of_sector_ranges,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_sector_ranges",
+	 number_of_sector_ranges,
+	 31 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_block_descriptor_get_sector_ranges_from_bitmap(
+	          vhdi_test_block_descriptor_data1,
+	          256,
+	          LIBVHDI_FILE_TYPE_VHD,
+	          512,
+	          sector_range_end_offsets,
+	          &number_of_sector_ranges,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT32(
+	 "sector_range_end_offsets[ 0 ]",
+	 sector_range_end_offsets[ 0 ],
+	 (uint32_t) 422400 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT32(
+	 "sector_range_end_offsets[ 1 ]",
+	 sector_range_end_offsets[ 1 ],
+	 (uint32_t) 422912 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT32(
+	 "sector_range_end_offsets[ 30 ]",
+	 sector_range_end_offsets[ 30 ],
+	 (uint32_t) 1048576 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_block_descriptor_get_sector_ranges_from_bitmap(
+	          vhdi_test_block_descriptor_data1,
+	          256,
+	          LIBVHDI_FILE_TYPE_VHDX,
+	          512,
+	          NULL,
+	          &number_of_sector_ranges,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_sector_ranges",
+	 number_of_sector_ranges,
+	 21 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_block_descriptor_get_sector_ranges_from_bitmap(
+	          NULL,
+	          256,
+	          LIBVHDI_FILE_TYPE_VHD,
+	          512,
+	          NULL,
+	          &number_of_sector_ranges,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_descriptor_get_sector_ranges_from_bitmap(
+	          vhdi_test_block_descriptor_data1,
+	          0,
+	          LIBVHDI_FILE_TYPE_VHD,
+	          512,
+	          NULL,
+	          &number_of_sector_ranges,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_descriptor_get_sector_ranges_from_bitmap(
+	          vhdi_test_block_descriptor_data1,
+	          256,
+	          -1,
+	          512,
+	          NULL,
+	          &number_of_sector_ranges,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_descriptor_get_sector_ranges_from_bitmap(
+	          vhdi_test_block_descriptor_data1,
+	          256,
+	          LIBVHDI_FILE_TYPE_VHD,
+	          512,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	number_of_sector_ranges = 2;
+
+	result = libvhdi_block_descriptor_get_sector_ranges_from_bitmap(
+	          vhdi_test_block_descriptor_data1,
+	          256,
+	          LIBVHDI_FILE_TYPE_VHD,
+	          512,
+	          sector_range_end_offsets,
+	          &number_of_sector_ranges,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libvhdi_block_descriptor_read_sector_bitmap_data function
  * Returns 1 if successful or 0 if not
  */
@@ -495,6 +708,261 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvhdi_block_descriptor_get_range_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_block_descriptor_get_range_at_offset(
+     void )
+{
+	libcerror_error_t *error                     = NULL;
+	libvhdi_block_descriptor_t *block_descriptor = NULL;
+	off64_t range_file_offset                    = 0;
+	size_t range_size                            = 0;
+	uint32_t range_flags                         = 0;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libvhdi_block_descriptor_initialize(
+	          &block_descriptor,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "block_descriptor",
+	 block_descriptor );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	block_descriptor->file_offset = 1024;
+
+	result = libvhdi_block_descriptor_read_sector_bitmap_data(
+	          block_descriptor,
+	          vhdi_test_block_descriptor_data1,
+	          256,
+	          LIBVHDI_FILE_TYPE_VHD,
+	          512,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvhdi_block_descriptor_get_range_at_offset(
+	          block_descriptor,
+	          512,
+	          &range_file_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "range_file_offset",
+	 (int64_t) range_file_offset,
+	 (int64_t) 1536 );
+
+	VHDI_TEST_ASSERT_EQUAL_SIZE(
+	 "range_size",
+	 range_size,
+	 (size_t) 421888 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_block_descriptor_get_range_at_offset(
+	          block_descriptor,
+	          422400,
+	          &range_file_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "range_file_offset",
+	 (int64_t) range_file_offset,
+	 (int64_t) 423424 );
+
+	VHDI_TEST_ASSERT_EQUAL_SIZE(
+	 "range_size",
+	 range_size,
+	 (size_t) 512 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) 0x00000001UL );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_block_descriptor_get_range_at_offset(
+	          NULL,
+	          512,
+	          &range_file_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_descriptor_get_range_at_offset(
+	          block_descriptor,
+	          256 * 8 * 512,
+	          &range_file_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_descriptor_get_range_at_offset(
+	          block_descriptor,
+	          512,
+	          NULL,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_descriptor_get_range_at_offset(
+	          block_descriptor,
+	          512,
+	          &range_file_offset,
+	          NULL,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_block_descriptor_get_range_at_offset(
+	          block_descriptor,
+	          512,
+	          &range_file_offset,
+	          &range_size,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvhdi_block_descriptor_free(
+	          &block_descriptor,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "block_descriptor",
+	 block_descriptor );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_descriptor != NULL )
+	{
+		libvhdi_block_descriptor_free(
+		 &block_descriptor,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
 
 /* The main program
@@ -524,13 +992,19 @@ int main(
 
 	/* TODO add tests for libvhdi_block_descriptor_read_table_entry */
 
+	VHDI_TEST_RUN(
+	 "libvhdi_block_descriptor_get_sector_ranges_from_bitmap",
+	 vhdi_test_block_descriptor_get_sector_ranges_from_bitmap );
+
 	VHDI_TEST_RUN(
 	 "libvhdi_block_descriptor_read_sector_bitmap_data",
 	 vhdi_test_block_descriptor_read_sector_bitmap_data );
 
 	/* TODO add tests for libvhdi_block_descriptor_read_sector_bitmap_file_io_handle */
 
-	/* TODO add tests for libvhdi_block_descriptor_get_sector_range_descriptor_at_offset */
+	VHDI_TEST_RUN(
+	 "libvhdi_block_descriptor_get_range_at_offset",
+	 vhdi_test_block_descriptor_get_range_at_offset );
 
 #endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
 
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -1179,6 +1180,37 @@ int vhdi_test_file_open(
 	libcerror_error_free(
 	 &error );
 
+	result = libvhdi_file_close(
+	          file,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_open(
+	          file,
+	          narrow_source,
+	          LIBVHDI_ACCESS_FLAG_READ | LIBVHDI_ACCESS_FLAG_MEMORY_MAP | LIBVHDI_ACCESS_FLAG_DIRECT_IO,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
 	/* Clean up
 	 */
 	result = libvhdi_file_free(
@@ -1570,6 +1602,256 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvhdi_file_clone function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_clone(
+     libvhdi_file_t *file )
+{
+	uint8_t buffer[ 16 ];
+	uint8_t reference_buffer[ 16 ];
+
+	libcerror_error_t *error         = NULL;
+	libvhdi_file_t *destination_file = NULL;
+	size64_t destination_size        = 0;
+	size64_t size                    = 0;
+	ssize_t read_count               = 0;
+	int result                       = 0;
+
+	/* Test regular cases
+	 */
+	result = libvhdi_file_clone(
+	          &destination_file,
+	          file,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "destination_file",
+	 destination_file );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_get_media_size(
+	          file,
+	          &size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_get_media_size(
+	          destination_file,
+	          &destination_size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "destination_size",
+	 (uint64_t) destination_size,
+	 (uint64_t) size );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( size > 16 )
+	{
+		read_count = libvhdi_file_read_buffer_at_offset(
+		              file,
+		              reference_buffer,
+		              16,
+		              0,
+		              &error );
+
+		VHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libvhdi_file_read_buffer(
+		              destination_file,
+		              buffer,
+		              16,
+		              &error );
+
+		VHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          reference_buffer,
+		          16 );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* The source file should remain usable after the clone is closed
+	 */
+	result = libvhdi_file_close(
+	          destination_file,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_free(
+	          &destination_file,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "destination_file",
+	 destination_file );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( size > 16 )
+	{
+		read_count = libvhdi_file_read_buffer_at_offset(
+		              file,
+		              buffer,
+		              16,
+		              0,
+		              &error );
+
+		VHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          reference_buffer,
+		          16 );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libvhdi_file_clone(
+	          NULL,
+	          file,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	destination_file = (libvhdi_file_t *) 0x12345678UL;
+
+	result = libvhdi_file_clone(
+	          &destination_file,
+	          file,
+	          &error );
+
+	destination_file = NULL;
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_clone(
+	          &destination_file,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "destination_file",
+	 destination_file );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( destination_file != NULL )
+	{
+		libvhdi_file_free(
+		 &destination_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libvhdi_file_read_buffer function
  * Returns 1 if successful or 0 if not
  */
@@ -1678,16 +1960,3519 @@ int vhdi_test_file_read_buffer(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libvhdi_file_read_buffer(
-	              file,
-	              NULL,
-	              16,
-	              &error );
+	read_count = libvhdi_file_read_buffer(
+	              file,
+	              NULL,
+	              16,
+	              &error );
+
+	VHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvhdi_file_read_buffer(
+	              file,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              &error );
+
+	VHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_file_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_read_buffer_at_offset(
+     libvhdi_file_t *file )
+{
+	uint8_t buffer[ 16 ];
+	uint8_t reference_buffer[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	ssize_t read_count       = 0;
+	off64_t offset           = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libvhdi_file_get_media_size(
+	          file,
+	          &size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( size > 32 )
+	{
+		offset = libvhdi_file_seek_offset(
+		          file,
+		          16,
+		          SEEK_SET,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 (int64_t) 16 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libvhdi_file_read_buffer(
+		              file,
+		              reference_buffer,
+		              16,
+		              &error );
+
+		VHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		offset = libvhdi_file_seek_offset(
+		          file,
+		          0,
+		          SEEK_SET,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 (int64_t) 0 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libvhdi_file_read_buffer_at_offset(
+		              file,
+		              buffer,
+		              16,
+		              16,
+		              &error );
+
+		VHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          reference_buffer,
+		          16 );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* The current offset should not have changed
+		 */
+		result = libvhdi_file_get_offset(
+		          file,
+		          &offset,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 (int64_t) 0 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Read beyond size boundary
+	 */
+	read_count = libvhdi_file_read_buffer_at_offset(
+	              file,
+	              buffer,
+	              16,
+	              (off64_t) size,
+	              &error );
+
+	VHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libvhdi_file_read_buffer_at_offset(
+	              NULL,
+	              buffer,
+	              16,
+	              0,
+	              &error );
+
+	VHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvhdi_file_read_buffer_at_offset(
+	              file,
+	              NULL,
+	              16,
+	              0,
+	              &error );
+
+	VHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvhdi_file_read_buffer_at_offset(
+	              file,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	VHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvhdi_file_read_buffer_at_offset(
+	              file,
+	              buffer,
+	              16,
+	              -1,
+	              &error );
+
+	VHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_file_read_buffers_at_offsets function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_read_buffers_at_offsets(
+     libvhdi_file_t *file )
+{
+	uint8_t buffer1[ 16 ];
+	uint8_t buffer2[ 32 ];
+	uint8_t buffer3[ 16 ];
+	uint8_t reference_buffer[ 48 ];
+	void *buffers[ 3 ];
+	size_t buffer_sizes[ 3 ];
+	off64_t offsets[ 3 ];
+	ssize_t read_counts[ 3 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	ssize_t read_count       = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libvhdi_file_get_media_size(
+	          file,
+	          &size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	buffers[ 0 ] = buffer1;
+	buffers[ 1 ] = buffer2;
+	buffers[ 2 ] = buffer3;
+
+	buffer_sizes[ 0 ] = 16;
+	buffer_sizes[ 1 ] = 32;
+	buffer_sizes[ 2 ] = 16;
+
+	/* Test regular cases
+	 */
+	if( size > 64 )
+	{
+		read_count = libvhdi_file_read_buffer_at_offset(
+		              file,
+		              reference_buffer,
+		              48,
+		              16,
+		              &error );
+
+		VHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 48 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The requests are adjacent but not ordered by offset
+		 */
+		offsets[ 0 ] = 48;
+		offsets[ 1 ] = 16;
+		offsets[ 2 ] = (off64_t) size;
+
+		result = libvhdi_file_read_buffers_at_offsets(
+		          file,
+		          buffers,
+		          buffer_sizes,
+		          offsets,
+		          read_counts,
+		          3,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_counts[ 0 ]",
+		 read_counts[ 0 ],
+		 (ssize_t) 16 );
+
+		VHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_counts[ 1 ]",
+		 read_counts[ 1 ],
+		 (ssize_t) 32 );
+
+		VHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_counts[ 2 ]",
+		 read_counts[ 2 ],
+		 (ssize_t) 0 );
+
+		result = memory_compare(
+		          buffer2,
+		          reference_buffer,
+		          32 );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = memory_compare(
+		          buffer1,
+		          &( reference_buffer[ 32 ] ),
+		          16 );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	offsets[ 0 ] = 0;
+	offsets[ 1 ] = 0;
+	offsets[ 2 ] = 0;
+
+	result = libvhdi_file_read_buffers_at_offsets(
+	          NULL,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          3,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_read_buffers_at_offsets(
+	          file,
+	          NULL,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          3,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_read_buffers_at_offsets(
+	          file,
+	          buffers,
+	          NULL,
+	          offsets,
+	          read_counts,
+	          3,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_read_buffers_at_offsets(
+	          file,
+	          buffers,
+	          buffer_sizes,
+	          NULL,
+	          read_counts,
+	          3,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_read_buffers_at_offsets(
+	          file,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          NULL,
+	          3,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_read_buffers_at_offsets(
+	          file,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          -1,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offsets[ 1 ] = -1;
+
+	result = libvhdi_file_read_buffers_at_offsets(
+	          file,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          3,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_file_submit_read_buffer_at_offset and libvhdi_file_poll_read_completions functions
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_submit_read_buffer_at_offset(
+     libvhdi_file_t *file )
+{
+	uint8_t buffer1[ 16 ];
+	uint8_t buffer2[ 32 ];
+	uint8_t reference_buffer[ 48 ];
+	uint64_t request_identifiers[ 4 ];
+	ssize_t read_counts[ 4 ];
+
+	libcerror_error_t *error  = NULL;
+	size64_t size             = 0;
+	ssize_t read_count        = 0;
+	int completion_index      = 0;
+	int number_of_completions = 0;
+	int total_completions     = 0;
+	int result                = 0;
+
+	/* Determine size
+	 */
+	result = libvhdi_file_get_media_size(
+	          file,
+	          &size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( size > 64 )
+	{
+		read_count = libvhdi_file_read_buffer_at_offset(
+		              file,
+		              reference_buffer,
+		              48,
+		              16,
+		              &error );
+
+		VHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 48 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvhdi_file_submit_read_buffer_at_offset(
+		          file,
+		          buffer1,
+		          16,
+		          48,
+		          1,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvhdi_file_submit_read_buffer_at_offset(
+		          file,
+		          buffer2,
+		          32,
+		          16,
+		          2,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		while( total_completions < 2 )
+		{
+			result = libvhdi_file_poll_read_completions(
+			          file,
+			          &( request_identifiers[ total_completions ] ),
+			          &( read_counts[ total_completions ] ),
+			          4 - total_completions,
+			          &number_of_completions,
+			          1,
+			          &error );
+
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VHDI_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			VHDI_TEST_ASSERT_NOT_EQUAL_INT(
+			 "number_of_completions",
+			 number_of_completions,
+			 0 );
+
+			total_completions += number_of_completions;
+		}
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "total_completions",
+		 total_completions,
+		 2 );
+
+		for( completion_index = 0;
+		     completion_index < total_completions;
+		     completion_index++ )
+		{
+			if( request_identifiers[ completion_index ] == 1 )
+			{
+				VHDI_TEST_ASSERT_EQUAL_SSIZE(
+				 "read_counts[ completion_index ]",
+				 read_counts[ completion_index ],
+				 (ssize_t) 16 );
+			}
+			else
+			{
+				VHDI_TEST_ASSERT_EQUAL_UINT64(
+				 "request_identifiers[ completion_index ]",
+				 request_identifiers[ completion_index ],
+				 (uint64_t) 2 );
+
+				VHDI_TEST_ASSERT_EQUAL_SSIZE(
+				 "read_counts[ completion_index ]",
+				 read_counts[ completion_index ],
+				 (ssize_t) 32 );
+			}
+		}
+		result = memory_compare(
+		          buffer2,
+		          reference_buffer,
+		          32 );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = memory_compare(
+		          buffer1,
+		          &( reference_buffer[ 32 ] ),
+		          16 );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Without outstanding reads polling does not wait
+	 */
+	result = libvhdi_file_poll_read_completions(
+	          file,
+	          request_identifiers,
+	          read_counts,
+	          4,
+	          &number_of_completions,
+	          1,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_completions",
+	 number_of_completions,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvhdi_file_submit_read_buffer_at_offset(
+	          NULL,
+	          buffer1,
+	          16,
+	          0,
+	          1,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_submit_read_buffer_at_offset(
+	          file,
+	          NULL,
+	          16,
+	          0,
+	          1,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_submit_read_buffer_at_offset(
+	          file,
+	          buffer1,
+	          16,
+	          -1,
+	          1,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_poll_read_completions(
+	          NULL,
+	          request_identifiers,
+	          read_counts,
+	          4,
+	          &number_of_completions,
+	          0,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_poll_read_completions(
+	          file,
+	          NULL,
+	          read_counts,
+	          4,
+	          &number_of_completions,
+	          0,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_poll_read_completions(
+	          file,
+	          request_identifiers,
+	          NULL,
+	          4,
+	          &number_of_completions,
+	          0,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_poll_read_completions(
+	          file,
+	          request_identifiers,
+	          read_counts,
+	          0,
+	          &number_of_completions,
+	          0,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_poll_read_completions(
+	          file,
+	          request_identifiers,
+	          read_counts,
+	          4,
+	          NULL,
+	          0,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_file_get_data_pointer function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_get_data_pointer(
+     libvhdi_file_t *file )
+{
+	const uint8_t *data      = NULL;
+	libcerror_error_t *error = NULL;
+	size_t data_size         = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvhdi_file_get_data_pointer(
+	          file,
+	          0,
+	          16,
+	          &data,
+	          &data_size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "data",
+	 data );
+
+	VHDI_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_file_get_data_pointer(
+	          NULL,
+	          0,
+	          16,
+	          &data,
+	          &data_size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_data_pointer(
+	          file,
+	          -1,
+	          16,
+	          &data,
+	          &data_size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_data_pointer(
+	          file,
+	          0,
+	          16,
+	          NULL,
+	          &data_size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_data_pointer(
+	          file,
+	          0,
+	          16,
+	          &data,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_MMAP )
+
+/* Tests the libvhdi_file_get_data_pointer function on a memory mapped file
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_get_data_pointer_memory_map(
+     const system_character_t *source )
+{
+	char narrow_source[ 256 ];
+	uint8_t buffer[ 16 ];
+
+	const uint8_t *data      = NULL;
+	libcerror_error_t *error = NULL;
+	libvhdi_file_t *file     = NULL;
+	size_t data_size         = 0;
+	ssize_t read_count       = 0;
+	uint32_t disk_type       = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = vhdi_test_file_get_narrow_source(
+	          source,
+	          narrow_source,
+	          256,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_initialize(
+	          &file,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "file",
+	 file );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_open(
+	          file,
+	          narrow_source,
+	          LIBVHDI_OPEN_READ_MEMORY_MAP,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_get_disk_type(
+	          file,
+	          &disk_type,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The data of a differential file requires the parent file
+	 */
+	if( disk_type != LIBVHDI_DISK_TYPE_DIFFERENTIAL )
+	{
+		result = libvhdi_file_get_data_pointer(
+		          file,
+		          0,
+		          16,
+		          &data,
+		          &data_size,
+		          &error );
+
+		VHDI_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( result != 0 )
+		{
+			VHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "data",
+			 data );
+
+			VHDI_TEST_ASSERT_NOT_EQUAL_SSIZE(
+			 "data_size",
+			 (ssize_t) data_size,
+			 (ssize_t) 0 );
+
+			read_count = libvhdi_file_read_buffer_at_offset(
+			              file,
+			              buffer,
+			              data_size,
+			              0,
+			              &error );
+
+			VHDI_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) data_size );
+
+			VHDI_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = memory_compare(
+			          data,
+			          buffer,
+			          data_size );
+
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+	}
+	/* Clean up
+	 */
+	result = libvhdi_file_close(
+	          file,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_free(
+	          &file,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "file",
+	 file );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file != NULL )
+	{
+		libvhdi_file_free(
+		 &file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MMAP ) */
+
+/* Tests the libvhdi_file_get_mapped_range function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_get_mapped_range(
+     libvhdi_file_t *file )
+{
+	libcerror_error_t *error   = NULL;
+	size64_t extent_size       = 0;
+	size64_t size              = 0;
+	size_t mapped_size         = 0;
+	off64_t extent_offset      = 0;
+	off64_t mapped_file_offset = 0;
+	uint32_t extent_flags      = 0;
+	int chain_level            = 0;
+	int result                 = 0;
+
+	/* Determine size
+	 */
+	result = libvhdi_file_get_media_size(
+	          file,
+	          &size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_get_next_extent(
+	          file,
+	          0,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvhdi_file_get_mapped_range(
+	          file,
+	          0,
+	          16,
+	          &chain_level,
+	          &mapped_file_offset,
+	          &mapped_size,
+	          &error );
+
+	VHDI_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( ( extent_flags & LIBVHDI_EXTENT_FLAG_IS_SPARSE ) != 0 )
+	{
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	if( result == 1 )
+	{
+		VHDI_TEST_ASSERT_NOT_EQUAL_SSIZE(
+		 "mapped_size",
+		 (ssize_t) mapped_size,
+		 (ssize_t) 0 );
+
+		VHDI_TEST_ASSERT_LESS_THAN_UINT64(
+		 "mapped_size",
+		 (uint64_t) mapped_size,
+		 (uint64_t) 17 );
+
+		if( ( extent_flags & LIBVHDI_EXTENT_FLAG_IS_PARENT ) == 0 )
+		{
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "chain_level",
+			 chain_level,
+			 0 );
+		}
+		else
+		{
+			VHDI_TEST_ASSERT_NOT_EQUAL_INT(
+			 "chain_level",
+			 chain_level,
+			 0 );
+		}
+	}
+	/* Test offset beyond the media size
+	 */
+	result = libvhdi_file_get_mapped_range(
+	          file,
+	          (off64_t) size,
+	          16,
+	          &chain_level,
+	          &mapped_file_offset,
+	          &mapped_size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VHDI_TEST_ASSERT_EQUAL_SIZE(
+	 "mapped_size",
+	 mapped_size,
+	 (size_t) 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_file_get_mapped_range(
+	          NULL,
+	          0,
+	          16,
+	          &chain_level,
+	          &mapped_file_offset,
+	          &mapped_size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_mapped_range(
+	          file,
+	          -1,
+	          16,
+	          &chain_level,
+	          &mapped_file_offset,
+	          &mapped_size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_mapped_range(
+	          file,
+	          0,
+	          16,
+	          NULL,
+	          &mapped_file_offset,
+	          &mapped_size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_mapped_range(
+	          file,
+	          0,
+	          16,
+	          &chain_level,
+	          NULL,
+	          &mapped_size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_mapped_range(
+	          file,
+	          0,
+	          16,
+	          &chain_level,
+	          &mapped_file_offset,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_file_get_next_extent function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_get_next_extent(
+     libvhdi_file_t *file )
+{
+	libcerror_error_t *error = NULL;
+	size64_t extent_size     = 0;
+	size64_t size            = 0;
+	off64_t extent_offset    = 0;
+	off64_t offset           = 0;
+	uint32_t extent_flags    = 0;
+	uint32_t previous_flags  = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libvhdi_file_get_media_size(
+	          file,
+	          &size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	while( (size64_t) offset < size )
+	{
+		result = libvhdi_file_get_next_extent(
+		          file,
+		          offset,
+		          &extent_offset,
+		          &extent_size,
+		          &extent_flags,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT64(
+		 "extent_offset",
+		 (int64_t) extent_offset,
+		 (int64_t) offset );
+
+		VHDI_TEST_ASSERT_NOT_EQUAL_INT64(
+		 "extent_size",
+		 (int64_t) extent_size,
+		 (int64_t) 0 );
+
+		VHDI_TEST_ASSERT_LESS_THAN_UINT64(
+		 "extent_size",
+		 (uint64_t) extent_size,
+		 (uint64_t) ( size - offset + 1 ) );
+
+		/* Successive extents should be of a different type
+		 */
+		if( offset > 0 )
+		{
+			VHDI_TEST_ASSERT_NOT_EQUAL_INT32(
+			 "extent_flags",
+			 (int32_t) extent_flags,
+			 (int32_t) previous_flags );
+		}
+		previous_flags = extent_flags;
+		offset        += (off64_t) extent_size;
+	}
+	result = libvhdi_file_get_next_extent(
+	          file,
+	          (off64_t) size,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_file_get_next_extent(
+	          NULL,
+	          0,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_next_extent(
+	          file,
+	          -1,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_next_extent(
+	          file,
+	          0,
+	          NULL,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_next_extent(
+	          file,
+	          0,
+	          &extent_offset,
+	          NULL,
+	          &extent_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_next_extent(
+	          file,
+	          0,
+	          &extent_offset,
+	          &extent_size,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_file_get_next_chain_extent function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_get_next_chain_extent(
+     libvhdi_file_t *file )
+{
+	libcerror_error_t *error = NULL;
+	size64_t extent_size     = 0;
+	size64_t size            = 0;
+	off64_t extent_offset    = 0;
+	off64_t offset           = 0;
+	uint32_t extent_flags    = 0;
+	uint32_t previous_flags  = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libvhdi_file_get_media_size(
+	          file,
+	          &size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	while( (size64_t) offset < size )
+	{
+		result = libvhdi_file_get_next_chain_extent(
+		          file,
+		          offset,
+		          &extent_offset,
+		          &extent_size,
+		          &extent_flags,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT64(
+		 "extent_offset",
+		 (int64_t) extent_offset,
+		 (int64_t) offset );
+
+		VHDI_TEST_ASSERT_NOT_EQUAL_INT64(
+		 "extent_size",
+		 (int64_t) extent_size,
+		 (int64_t) 0 );
+
+		VHDI_TEST_ASSERT_LESS_THAN_UINT64(
+		 "extent_size",
+		 (uint64_t) extent_size,
+		 (uint64_t) ( size - offset + 1 ) );
+
+		/* Successive extents should be of a different type
+		 */
+		if( offset > 0 )
+		{
+			VHDI_TEST_ASSERT_NOT_EQUAL_INT32(
+			 "extent_flags",
+			 (int32_t) extent_flags,
+			 (int32_t) previous_flags );
+		}
+		previous_flags = extent_flags;
+		offset        += (off64_t) extent_size;
+	}
+	result = libvhdi_file_get_next_chain_extent(
+	          file,
+	          (off64_t) size,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_file_get_next_chain_extent(
+	          NULL,
+	          0,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_next_chain_extent(
+	          file,
+	          -1,
+	          &extent_offset,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_next_chain_extent(
+	          file,
+	          0,
+	          NULL,
+	          &extent_size,
+	          &extent_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_next_chain_extent(
+	          file,
+	          0,
+	          &extent_offset,
+	          NULL,
+	          &extent_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_next_chain_extent(
+	          file,
+	          0,
+	          &extent_offset,
+	          &extent_size,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_file_get_block_range function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_get_block_range(
+     libvhdi_file_t *file )
+{
+	libcerror_error_t *error   = NULL;
+	size64_t size              = 0;
+	size_t range_size          = 0;
+	off64_t range_file_offset  = 0;
+	uint32_t block_data_size   = 0;
+	uint32_t block_data_offset = 0;
+	uint32_t block_size        = 0;
+	uint32_t range_flags       = 0;
+	int result                 = 0;
+
+	/* Determine size
+	 */
+	result = libvhdi_file_get_media_size(
+	          file,
+	          &size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_get_block_size(
+	          file,
+	          &block_size,
+	          &error );
+
+	VHDI_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( result == 0 )
+	{
+		result = libvhdi_file_get_block_range(
+		          file,
+		          0,
+		          0,
+		          &range_file_offset,
+		          &range_size,
+		          &range_flags,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	else if( size > 0 )
+	{
+		block_data_size = block_size;
+
+		if( size < (size64_t) block_size )
+		{
+			block_data_size = (uint32_t) size;
+		}
+		while( block_data_offset < block_data_size )
+		{
+			result = libvhdi_file_get_block_range(
+			          file,
+			          0,
+			          block_data_offset,
+			          &range_file_offset,
+			          &range_size,
+			          &range_flags,
+			          &error );
+
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VHDI_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			VHDI_TEST_ASSERT_NOT_EQUAL_SSIZE(
+			 "range_size",
+			 (ssize_t) range_size,
+			 (ssize_t) 0 );
+
+			VHDI_TEST_ASSERT_LESS_THAN_UINT64(
+			 "range_size",
+			 (uint64_t) range_size,
+			 (uint64_t) ( block_data_size - block_data_offset + 1 ) );
+
+			/* Only data allocated in the file has a file offset
+			 */
+			if( range_flags == 0 )
+			{
+				VHDI_TEST_ASSERT_NOT_EQUAL_INT64(
+				 "range_file_offset",
+				 (int64_t) range_file_offset,
+				 (int64_t) -1 );
+			}
+			else
+			{
+				VHDI_TEST_ASSERT_EQUAL_INT64(
+				 "range_file_offset",
+				 (int64_t) range_file_offset,
+				 (int64_t) -1 );
+			}
+			block_data_offset += (uint32_t) range_size;
+		}
+		result = libvhdi_file_get_block_range(
+		          file,
+		          ( size / block_size ) + 1,
+		          0,
+		          &range_file_offset,
+		          &range_size,
+		          &range_flags,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libvhdi_file_get_block_range(
+	          NULL,
+	          0,
+	          0,
+	          &range_file_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_block_range(
+	          file,
+	          0,
+	          0,
+	          NULL,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_block_range(
+	          file,
+	          0,
+	          0,
+	          &range_file_offset,
+	          NULL,
+	          &range_flags,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_block_range(
+	          file,
+	          0,
+	          0,
+	          &range_file_offset,
+	          &range_size,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_file_seek_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_seek_offset(
+     libvhdi_file_t *file )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	off64_t offset           = 0;
+
+	/* Test regular cases
+	 */
+	offset = libvhdi_file_seek_offset(
+	          file,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	VHDI_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size = (size64_t) offset;
+
+	offset = libvhdi_file_seek_offset(
+	          file,
+	          1024,
+	          SEEK_SET,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 1024 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libvhdi_file_seek_offset(
+	          file,
+	          -512,
+	          SEEK_CUR,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 512 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libvhdi_file_seek_offset(
+	          file,
+	          (off64_t) ( size + 512 ),
+	          SEEK_SET,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) ( size + 512 ) );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset offset to 0
+	 */
+	offset = libvhdi_file_seek_offset(
+	          file,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	offset = libvhdi_file_seek_offset(
+	          NULL,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libvhdi_file_seek_offset(
+	          file,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libvhdi_file_seek_offset(
+	          file,
+	          -1,
+	          SEEK_CUR,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	offset = libvhdi_file_seek_offset(
+	          file,
+	          (off64_t) ( -1 * ( size + 1 ) ),
+	          SEEK_END,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_file_get_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_get_offset(
+     libvhdi_file_t *file )
+{
+	libcerror_error_t *error = NULL;
+	off64_t offset           = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvhdi_file_get_offset(
+	          file,
+	          &offset,
+	          &error );
+
+	VHDI_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_file_get_offset(
+	          NULL,
+	          &offset,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_offset(
+	          file,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_file_get_block_cache_size and libvhdi_file_set_block_cache_size functions
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_set_block_cache_size(
+     libvhdi_file_t *file )
+{
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error       = NULL;
+	ssize_t read_count             = 0;
+	int number_of_entries          = 0;
+	int original_number_of_entries = 0;
+	int result                     = 0;
+
+	/* Test regular cases
+	 */
+	result = libvhdi_file_get_block_cache_size(
+	          file,
+	          &original_number_of_entries,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_set_block_cache_size(
+	          file,
+	          3,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_get_block_cache_size(
+	          file,
+	          &number_of_entries,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 3 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvhdi_file_read_buffer_at_offset(
+	              file,
+	              buffer,
+	              512,
+	              0,
+	              &error );
+
+	VHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_set_block_cache_size(
+	          file,
+	          original_number_of_entries,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_file_get_block_cache_size(
+	          NULL,
+	          &number_of_entries,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_block_cache_size(
+	          file,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_set_block_cache_size(
+	          NULL,
+	          3,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_set_block_cache_size(
+	          file,
+	          0,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_file_get_data_cache_size, libvhdi_file_set_data_cache_size and libvhdi_file_get_data_cache_statistics functions
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_set_data_cache_size(
+     libvhdi_file_t *file )
+{
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error  = NULL;
+	size_t data_cache_size    = 0;
+	ssize_t read_count        = 0;
+	uint64_t number_of_hits   = 0;
+	uint64_t number_of_misses = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libvhdi_file_set_data_cache_size(
+	          file,
+	          1024 * 1024,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_get_data_cache_size(
+	          file,
+	          &data_cache_size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_EQUAL_SIZE(
+	 "data_cache_size",
+	 data_cache_size,
+	 (size_t) 1024 * 1024 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvhdi_file_read_buffer_at_offset(
+	              file,
+	              buffer,
+	              512,
+	              0,
+	              &error );
+
+	VHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvhdi_file_read_buffer_at_offset(
+	              file,
+	              buffer,
+	              512,
+	              0,
+	              &error );
+
+	VHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_get_data_cache_statistics(
+	          file,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ( number_of_hits >= 1 );
+
+	VHDI_TEST_ASSERT_NOT_EQUAL_INT(
+	 "number_of_hits",
+	 result,
+	 0 );
+
+	result = libvhdi_file_set_data_cache_size(
+	          file,
+	          0,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_get_data_cache_statistics(
+	          file,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_file_get_data_cache_size(
+	          NULL,
+	          &data_cache_size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_data_cache_size(
+	          file,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_set_data_cache_size(
+	          NULL,
+	          1024 * 1024,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_set_data_cache_size(
+	          file,
+	          512,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_data_cache_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	libvhdi_file_set_data_cache_size(
+	 file,
+	 0,
+	 NULL );
+
+	return( 0 );
+}
+
+/* Tests the libvhdi_file_get_read_ahead_size and libvhdi_file_set_read_ahead_size functions
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_set_read_ahead_size(
+     libvhdi_file_t *file )
+{
+	uint8_t buffer[ 2048 ];
+	uint8_t read_ahead_buffer[ 2048 ];
+
+	libcerror_error_t *error = NULL;
+	size_t read_ahead_size   = 0;
+	ssize_t read_count       = 0;
+	off64_t offset           = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvhdi_file_get_read_ahead_size(
+	          file,
+	          &read_ahead_size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_EQUAL_SIZE(
+	 "read_ahead_size",
+	 read_ahead_size,
+	 (size_t) 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Setting a read-ahead size fails if the library was built without multi-thread support
+	 */
+	result = libvhdi_file_set_read_ahead_size(
+	          file,
+	          65536,
+	          &error );
+
+	VHDI_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	if( result == -1 )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	else
+	{
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvhdi_file_get_read_ahead_size(
+		          file,
+		          &read_ahead_size,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_EQUAL_SIZE(
+		 "read_ahead_size",
+		 read_ahead_size,
+		 (size_t) 65536 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read sequentially to trigger the read-ahead
+		 */
+		for( offset = 0;
+		     offset < 2048;
+		     offset += 512 )
+		{
+			read_count = libvhdi_file_read_buffer_at_offset(
+			              file,
+			              &( read_ahead_buffer[ offset ] ),
+			              512,
+			              offset,
+			              &error );
+
+			VHDI_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) 512 );
+
+			VHDI_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		result = libvhdi_file_set_read_ahead_size(
+		          file,
+		          0,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libvhdi_file_read_buffer_at_offset(
+		              file,
+		              buffer,
+		              2048,
+		              0,
+		              &error );
+
+		VHDI_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 2048 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          read_ahead_buffer,
+		          2048 );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libvhdi_file_get_read_ahead_size(
+	          NULL,
+	          &read_ahead_size,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_read_ahead_size(
+	          file,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_set_read_ahead_size(
+	          NULL,
+	          0,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_set_read_ahead_size(
+	          file,
+	          (size_t) ( 128 * 1024 * 1024 ),
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_file_get_maximum_number_of_file_io_handles and libvhdi_file_set_maximum_number_of_file_io_handles functions
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_set_maximum_number_of_file_io_handles(
+     libvhdi_file_t *file )
+{
+	libcerror_error_t *error              = NULL;
+	libvhdi_file_t *closed_file           = NULL;
+	int maximum_number_of_file_io_handles = 0;
+	int result                            = 0;
+
+	/* Test regular cases
+	 */
+	result = libvhdi_file_get_maximum_number_of_file_io_handles(
+	          file,
+	          &maximum_number_of_file_io_handles,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ( maximum_number_of_file_io_handles >= 1 );
+
+	VHDI_TEST_ASSERT_NOT_EQUAL_INT(
+	 "maximum_number_of_file_io_handles",
+	 result,
+	 0 );
+
+	result = libvhdi_file_initialize(
+	          &closed_file,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "closed_file",
+	 closed_file );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_set_maximum_number_of_file_io_handles(
+	          closed_file,
+	          1,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_get_maximum_number_of_file_io_handles(
+	          closed_file,
+	          &maximum_number_of_file_io_handles,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "maximum_number_of_file_io_handles",
+	 maximum_number_of_file_io_handles,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_free(
+	          &closed_file,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "closed_file",
+	 closed_file );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_file_get_maximum_number_of_file_io_handles(
+	          NULL,
+	          &maximum_number_of_file_io_handles,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_maximum_number_of_file_io_handles(
+	          file,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_set_maximum_number_of_file_io_handles(
+	          NULL,
+	          1,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_set_maximum_number_of_file_io_handles(
+	          file,
+	          0,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libvhdi_file_set_maximum_number_of_file_io_handles on an open file
+	 */
+	result = libvhdi_file_set_maximum_number_of_file_io_handles(
+	          file,
+	          1,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( closed_file != NULL )
+	{
+		libvhdi_file_free(
+		 &closed_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_file_set_index_filename function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_set_index_filename(
+     libvhdi_file_t *file )
+{
+	libcerror_error_t *error    = NULL;
+	libvhdi_file_t *closed_file = NULL;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = libvhdi_file_initialize(
+	          &closed_file,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "closed_file",
+	 closed_file );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvhdi_file_set_index_filename(
+	          closed_file,
+	          "image.vhdindex",
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_file_set_index_filename(
+	          closed_file,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_file_set_index_filename(
+	          NULL,
+	          "image.vhdindex",
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_set_index_filename(
+	          closed_file,
+	          "",
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libvhdi_file_set_index_filename on an open file
+	 */
+	result = libvhdi_file_set_index_filename(
+	          file,
+	          "image.vhdindex",
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libvhdi_file_write_index
+	 */
+	result = libvhdi_file_write_index(
+	          NULL,
+	          "image.vhdindex",
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_write_index(
+	          file,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_write_index(
+	          closed_file,
+	          "image.vhdindex",
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvhdi_file_free(
+	          &closed_file,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "closed_file",
+	 closed_file );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( closed_file != NULL )
+	{
+		libvhdi_file_free(
+		 &closed_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_file_get_block_cache_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_file_get_block_cache_statistics(
+     libvhdi_file_t *file )
+{
+	libcerror_error_t *error  = NULL;
+	uint64_t number_of_hits   = 0;
+	uint64_t number_of_misses = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libvhdi_file_get_block_cache_statistics(
+	          file,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VHDI_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_file_get_block_cache_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_get_block_cache_statistics(
+	          file,
+	          NULL,
+	          &number_of_misses,
+	          &error );
 
-	VHDI_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VHDI_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1696,16 +5481,16 @@ int vhdi_test_file_read_buffer(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libvhdi_file_read_buffer(
-	              file,
-	              buffer,
-	              (size_t) SSIZE_MAX + 1,
-	              &error );
+	result = libvhdi_file_get_block_cache_statistics(
+	          file,
+	          &number_of_hits,
+	          NULL,
+	          &error );
 
-	VHDI_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VHDI_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1725,109 +5510,128 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libvhdi_file_seek_offset function
+/* Tests the libvhdi_file_get_statistics and libvhdi_file_reset_statistics functions
  * Returns 1 if successful or 0 if not
  */
-int vhdi_test_file_seek_offset(
+int vhdi_test_file_get_statistics(
      libvhdi_file_t *file )
 {
+	uint8_t buffer[ 512 ];
+
+	uint64_t values[ LIBVHDI_NUMBER_OF_STATISTICS + 1 ];
+
 	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
-	off64_t offset           = 0;
+	ssize_t read_count       = 0;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	offset = libvhdi_file_seek_offset(
+	result = libvhdi_file_reset_statistics(
 	          file,
-	          0,
-	          SEEK_END,
 	          &error );
 
-	VHDI_TEST_ASSERT_NOT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	VHDI_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	size = (size64_t) offset;
-
-	offset = libvhdi_file_seek_offset(
-	          file,
-	          1024,
-	          SEEK_SET,
-	          &error );
+	read_count = libvhdi_file_read_buffer_at_offset(
+	              file,
+	              buffer,
+	              512,
+	              0,
+	              &error );
 
-	VHDI_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 1024 );
+	VHDI_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
 
 	VHDI_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	offset = libvhdi_file_seek_offset(
+	values[ LIBVHDI_NUMBER_OF_STATISTICS ] = 0xffffffffffffffffUL;
+
+	result = libvhdi_file_get_statistics(
 	          file,
-	          -512,
-	          SEEK_CUR,
+	          values,
+	          LIBVHDI_NUMBER_OF_STATISTICS + 1,
 	          &error );
 
-	VHDI_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 512 );
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	VHDI_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	offset = libvhdi_file_seek_offset(
+	VHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVHDI_STATISTIC_NUMBER_OF_READS ]",
+	 values[ LIBVHDI_STATISTIC_NUMBER_OF_READS ],
+	 (uint64_t) 1 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVHDI_STATISTIC_READ_SIZE ]",
+	 values[ LIBVHDI_STATISTIC_READ_SIZE ],
+	 (uint64_t) read_count );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVHDI_NUMBER_OF_STATISTICS ]",
+	 values[ LIBVHDI_NUMBER_OF_STATISTICS ],
+	 (uint64_t) 0 );
+
+	result = libvhdi_file_reset_statistics(
 	          file,
-	          (off64_t) ( size + 512 ),
-	          SEEK_SET,
 	          &error );
 
-	VHDI_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) ( size + 512 ) );
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	VHDI_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Reset offset to 0
-	 */
-	offset = libvhdi_file_seek_offset(
+	result = libvhdi_file_get_statistics(
 	          file,
-	          0,
-	          SEEK_SET,
+	          values,
+	          LIBVHDI_NUMBER_OF_STATISTICS,
 	          &error );
 
-	VHDI_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	VHDI_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
+	VHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVHDI_STATISTIC_NUMBER_OF_READS ]",
+	 values[ LIBVHDI_STATISTIC_NUMBER_OF_READS ],
+	 (uint64_t) 0 );
+
 	/* Test error cases
 	 */
-	offset = libvhdi_file_seek_offset(
+	result = libvhdi_file_get_statistics(
 	          NULL,
-	          0,
-	          SEEK_SET,
+	          values,
+	          LIBVHDI_NUMBER_OF_STATISTICS,
 	          &error );
 
-	VHDI_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VHDI_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1836,16 +5640,16 @@ int vhdi_test_file_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libvhdi_file_seek_offset(
+	result = libvhdi_file_get_statistics(
 	          file,
-	          -1,
-	          SEEK_SET,
+	          NULL,
+	          LIBVHDI_NUMBER_OF_STATISTICS,
 	          &error );
 
-	VHDI_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VHDI_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1854,31 +5658,32 @@ int vhdi_test_file_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libvhdi_file_seek_offset(
+	result = libvhdi_file_get_statistics(
 	          file,
+	          values,
 	          -1,
-	          SEEK_CUR,
 	          &error );
 
-	VHDI_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VHDI_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	offset = libvhdi_file_seek_offset(
-	          file,
-	          (off64_t) ( -1 * ( size + 1 ) ),
-	          SEEK_END,
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_file_reset_statistics(
+	          NULL,
 	          &error );
 
-	VHDI_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VHDI_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1898,21 +5703,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libvhdi_file_get_offset function
+/* Tests the libvhdi_file_get_media_size function
  * Returns 1 if successful or 0 if not
  */
-int vhdi_test_file_get_offset(
+int vhdi_test_file_get_media_size(
      libvhdi_file_t *file )
 {
 	libcerror_error_t *error = NULL;
-	off64_t offset           = 0;
+	size64_t media_size      = 0;
 	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libvhdi_file_get_offset(
+	result = libvhdi_file_get_media_size(
 	          file,
-	          &offset,
+	          &media_size,
 	          &error );
 
 	VHDI_TEST_ASSERT_NOT_EQUAL_INT(
@@ -1926,9 +5731,9 @@ int vhdi_test_file_get_offset(
 
 	/* Test error cases
 	 */
-	result = libvhdi_file_get_offset(
+	result = libvhdi_file_get_media_size(
 	          NULL,
-	          &offset,
+	          &media_size,
 	          &error );
 
 	VHDI_TEST_ASSERT_EQUAL_INT(
@@ -1943,7 +5748,7 @@ int vhdi_test_file_get_offset(
 	libcerror_error_free(
 	 &error );
 
-	result = libvhdi_file_get_offset(
+	result = libvhdi_file_get_media_size(
 	          file,
 	          NULL,
 	          &error );
@@ -1971,21 +5776,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libvhdi_file_get_media_size function
+/* Tests the libvhdi_file_get_disk_type function
  * Returns 1 if successful or 0 if not
  */
-int vhdi_test_file_get_media_size(
+int vhdi_test_file_get_disk_type(
      libvhdi_file_t *file )
 {
 	libcerror_error_t *error = NULL;
-	size64_t media_size      = 0;
+	uint32_t disk_type       = 0;
 	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libvhdi_file_get_media_size(
+	result = libvhdi_file_get_disk_type(
 	          file,
-	          &media_size,
+	          &disk_type,
 	          &error );
 
 	VHDI_TEST_ASSERT_NOT_EQUAL_INT(
@@ -1999,9 +5804,9 @@ int vhdi_test_file_get_media_size(
 
 	/* Test error cases
 	 */
-	result = libvhdi_file_get_media_size(
+	result = libvhdi_file_get_disk_type(
 	          NULL,
-	          &media_size,
+	          &disk_type,
 	          &error );
 
 	VHDI_TEST_ASSERT_EQUAL_INT(
@@ -2016,7 +5821,7 @@ int vhdi_test_file_get_media_size(
 	libcerror_error_free(
 	 &error );
 
-	result = libvhdi_file_get_media_size(
+	result = libvhdi_file_get_disk_type(
 	          file,
 	          NULL,
 	          &error );
@@ -2044,21 +5849,21 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libvhdi_file_get_disk_type function
+/* Tests the libvhdi_file_get_block_size function
  * Returns 1 if successful or 0 if not
  */
-int vhdi_test_file_get_disk_type(
+int vhdi_test_file_get_block_size(
      libvhdi_file_t *file )
 {
 	libcerror_error_t *error = NULL;
-	uint32_t disk_type       = 0;
+	uint32_t block_size      = 0;
 	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libvhdi_file_get_disk_type(
+	result = libvhdi_file_get_block_size(
 	          file,
-	          &disk_type,
+	          &block_size,
 	          &error );
 
 	VHDI_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2070,11 +5875,18 @@ int vhdi_test_file_get_disk_type(
 	 "error",
 	 error );
 
+	if( result != 0 )
+	{
+		VHDI_TEST_ASSERT_NOT_EQUAL_INT32(
+		 "block_size",
+		 (int32_t) block_size,
+		 (int32_t) 0 );
+	}
 	/* Test error cases
 	 */
-	result = libvhdi_file_get_disk_type(
+	result = libvhdi_file_get_block_size(
 	          NULL,
-	          &disk_type,
+	          &block_size,
 	          &error );
 
 	VHDI_TEST_ASSERT_EQUAL_INT(
@@ -2089,7 +5901,7 @@ int vhdi_test_file_get_disk_type(
 	libcerror_error_free(
 	 &error );
 
-	result = libvhdi_file_get_disk_type(
+	result = libvhdi_file_get_block_size(
 	          file,
 	          NULL,
 	          &error );
@@ -2827,6 +6639,15 @@ int main(
 		 vhdi_test_file_open_close,
 		 source );
 
+#if defined( HAVE_MMAP )
+
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_get_data_pointer_memory_map",
+		 vhdi_test_file_get_data_pointer_memory_map,
+		 source );
+
+#endif /* defined( HAVE_MMAP ) */
+
 		/* Initialize test
 		 */
 		result = vhdi_test_file_open_source(
@@ -2867,6 +6688,11 @@ int main(
 		 vhdi_test_file_signal_abort,
 		 file );
 
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_clone",
+		 vhdi_test_file_clone,
+		 file );
+
 #if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT )
 
 		/* TODO: add tests for libvhdi_internal_file_open_read */
@@ -2878,7 +6704,45 @@ int main(
 		 vhdi_test_file_read_buffer,
 		 file );
 
-		/* TODO: add tests for libvhdi_file_read_buffer_at_offset */
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_read_buffer_at_offset",
+		 vhdi_test_file_read_buffer_at_offset,
+		 file );
+
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_read_buffers_at_offsets",
+		 vhdi_test_file_read_buffers_at_offsets,
+		 file );
+
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_submit_read_buffer_at_offset",
+		 vhdi_test_file_submit_read_buffer_at_offset,
+		 file );
+
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_get_data_pointer",
+		 vhdi_test_file_get_data_pointer,
+		 file );
+
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_get_mapped_range",
+		 vhdi_test_file_get_mapped_range,
+		 file );
+
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_get_next_extent",
+		 vhdi_test_file_get_next_extent,
+		 file );
+
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_get_next_chain_extent",
+		 vhdi_test_file_get_next_chain_extent,
+		 file );
+
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_get_block_range",
+		 vhdi_test_file_get_block_range,
+		 file );
 
 		/* TODO: add tests for libvhdi_file_write_buffer */
 
@@ -2896,6 +6760,41 @@ int main(
 
 		/* TODO: add tests for libvhdi_file_set_parent_file */
 
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_set_block_cache_size",
+		 vhdi_test_file_set_block_cache_size,
+		 file );
+
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_get_block_cache_statistics",
+		 vhdi_test_file_get_block_cache_statistics,
+		 file );
+
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_get_statistics",
+		 vhdi_test_file_get_statistics,
+		 file );
+
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_set_data_cache_size",
+		 vhdi_test_file_set_data_cache_size,
+		 file );
+
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_set_read_ahead_size",
+		 vhdi_test_file_set_read_ahead_size,
+		 file );
+
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_set_maximum_number_of_file_io_handles",
+		 vhdi_test_file_set_maximum_number_of_file_io_handles,
+		 file );
+
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_set_index_filename",
+		 vhdi_test_file_set_index_filename,
+		 file );
+
 		VHDI_TEST_RUN_WITH_ARGS(
 		 "libvhdi_file_get_media_size",
 		 vhdi_test_file_get_media_size,
@@ -2908,6 +6807,13 @@ int main(
 		 vhdi_test_file_get_disk_type,
 		 file );
 
+		/* TODO: add tests for libvhdi_file_get_bytes_per_sector */
+
+		VHDI_TEST_RUN_WITH_ARGS(
+		 "libvhdi_file_get_block_size",
+		 vhdi_test_file_get_block_size,
+		 file );
+
 		VHDI_TEST_RUN_WITH_ARGS(
 		 "libvhdi_file_get_identifier",
 		 vhdi_test_file_get_identifier,
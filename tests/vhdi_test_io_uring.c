@@ -0,0 +1,1824 @@
+/*
+ * Library io_uring type test program
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vhdi_test_libcerror.h"
+#include "vhdi_test_libvhdi.h"
+#include "vhdi_test_macros.h"
+#include "vhdi_test_memory.h"
+#include "vhdi_test_unused.h"
+
+#include "../libvhdi/libvhdi_io_uring.h"
+#include "../libvhdi/libvhdi_read_queue.h"
+
+#define VHDI_TEST_IO_URING_FILENAME		"vhdi_test_io_uring.raw"
+#define VHDI_TEST_IO_URING_DATA_SIZE		( 64 * 1024 )
+#define VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES	4
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT )
+
+/* Fills a buffer with the test data at a specific offset,
+ * where every byte contains the lower 8 bits of the sum of its offset and its 4 KiB block number
+ */
+void vhdi_test_io_uring_fill_data(
+      uint8_t *buffer,
+      size_t buffer_size,
+      off64_t offset )
+{
+	size_t buffer_offset = 0;
+
+	for( buffer_offset = 0;
+	     buffer_offset < buffer_size;
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = (uint8_t) ( ( offset + buffer_offset + ( ( offset + buffer_offset ) / 4096 ) ) & 0xff );
+	}
+}
+
+/* Creates the test data file
+ * Returns 1 if successful or -1 on error
+ */
+int vhdi_test_io_uring_create_file(
+     void )
+{
+	uint8_t data[ VHDI_TEST_IO_URING_DATA_SIZE ];
+
+	FILE *file_stream = NULL;
+	size_t write_size = 0;
+
+	vhdi_test_io_uring_fill_data(
+	 data,
+	 VHDI_TEST_IO_URING_DATA_SIZE,
+	 0 );
+
+	file_stream = file_stream_open(
+	               VHDI_TEST_IO_URING_FILENAME,
+	               FILE_STREAM_BINARY_OPEN_WRITE );
+
+	if( file_stream == NULL )
+	{
+		return( -1 );
+	}
+	write_size = file_stream_write(
+	              file_stream,
+	              data,
+	              VHDI_TEST_IO_URING_DATA_SIZE );
+
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		return( -1 );
+	}
+	if( write_size != VHDI_TEST_IO_URING_DATA_SIZE )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads test data for the read queue
+ * Returns 1 if successful or -1 on error
+ */
+int vhdi_test_io_uring_read_buffers(
+     intptr_t *data_handle VHDI_TEST_ATTRIBUTE_UNUSED,
+     void **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_buffers,
+     libcerror_error_t **error VHDI_TEST_ATTRIBUTE_UNUSED )
+{
+	int buffer_index = 0;
+
+	VHDI_TEST_UNREFERENCED_PARAMETER( data_handle )
+	VHDI_TEST_UNREFERENCED_PARAMETER( error )
+
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		vhdi_test_io_uring_fill_data(
+		 (uint8_t *) buffers[ buffer_index ],
+		 buffer_sizes[ buffer_index ],
+		 offsets[ buffer_index ] );
+
+		read_counts[ buffer_index ] = (ssize_t) buffer_sizes[ buffer_index ];
+	}
+	return( 1 );
+}
+
+/* Retrieves the file range of test data for the read queue, which is stored contiguously
+ * Returns 1 if successful or -1 on error
+ */
+int vhdi_test_io_uring_get_file_range(
+     intptr_t *data_handle VHDI_TEST_ATTRIBUTE_UNUSED,
+     off64_t offset,
+     size_t size VHDI_TEST_ATTRIBUTE_UNUSED,
+     off64_t *file_offset,
+     libcerror_error_t **error VHDI_TEST_ATTRIBUTE_UNUSED )
+{
+	VHDI_TEST_UNREFERENCED_PARAMETER( data_handle )
+	VHDI_TEST_UNREFERENCED_PARAMETER( size )
+	VHDI_TEST_UNREFERENCED_PARAMETER( error )
+
+	*file_offset = offset;
+
+	return( 1 );
+}
+
+/* Tests the libvhdi_io_uring_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_io_uring_initialize(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libvhdi_io_uring_t *io_uring     = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_VHDI_TEST_MEMORY )
+	int number_of_malloc_fail_tests  = 1;
+	int number_of_memset_fail_tests  = 1;
+	int test_number                  = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvhdi_io_uring_initialize(
+	          &io_uring,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "io_uring",
+	 io_uring );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_io_uring_free(
+	          &io_uring,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "io_uring",
+	 io_uring );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_io_uring_initialize(
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	io_uring = (libvhdi_io_uring_t *) 0x12345678UL;
+
+	result = libvhdi_io_uring_initialize(
+	          &io_uring,
+	          &error );
+
+	io_uring = NULL;
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VHDI_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvhdi_io_uring_initialize with malloc failing
+		 */
+		vhdi_test_malloc_attempts_before_fail = test_number;
+
+		result = libvhdi_io_uring_initialize(
+		          &io_uring,
+		          &error );
+
+		if( vhdi_test_malloc_attempts_before_fail != -1 )
+		{
+			vhdi_test_malloc_attempts_before_fail = -1;
+
+			if( io_uring != NULL )
+			{
+				libvhdi_io_uring_free(
+				 &io_uring,
+				 NULL );
+			}
+		}
+		else
+		{
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VHDI_TEST_ASSERT_IS_NULL(
+			 "io_uring",
+			 io_uring );
+
+			VHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvhdi_io_uring_initialize with memset failing
+		 */
+		vhdi_test_memset_attempts_before_fail = test_number;
+
+		result = libvhdi_io_uring_initialize(
+		          &io_uring,
+		          &error );
+
+		if( vhdi_test_memset_attempts_before_fail != -1 )
+		{
+			vhdi_test_memset_attempts_before_fail = -1;
+
+			if( io_uring != NULL )
+			{
+				libvhdi_io_uring_free(
+				 &io_uring,
+				 NULL );
+			}
+		}
+		else
+		{
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VHDI_TEST_ASSERT_IS_NULL(
+			 "io_uring",
+			 io_uring );
+
+			VHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VHDI_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_uring != NULL )
+	{
+		libvhdi_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_io_uring_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_io_uring_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvhdi_io_uring_free(
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_io_uring_open and libvhdi_io_uring_close functions
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_io_uring_open(
+     void )
+{
+	libcerror_error_t *error     = NULL;
+	libvhdi_io_uring_t *io_uring = NULL;
+	int result                   = 0;
+
+	/* Initialize test
+	 */
+	result = libvhdi_io_uring_initialize(
+	          &io_uring,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "io_uring",
+	 io_uring );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_io_uring_open(
+	          NULL,
+	          VHDI_TEST_IO_URING_FILENAME,
+	          VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_io_uring_open(
+	          io_uring,
+	          NULL,
+	          VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_io_uring_open(
+	          io_uring,
+	          VHDI_TEST_IO_URING_FILENAME,
+	          0,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_io_uring_close(
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libvhdi_io_uring_open(
+	          io_uring,
+	          VHDI_TEST_IO_URING_FILENAME,
+	          VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES,
+	          &error );
+
+	VHDI_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The io_uring is not available if the kernel does not support it or its use is not permitted
+	 */
+	if( result != 0 )
+	{
+		/* Test error cases
+		 */
+		result = libvhdi_io_uring_open(
+		          io_uring,
+		          VHDI_TEST_IO_URING_FILENAME,
+		          VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		/* Test regular cases
+		 */
+		result = libvhdi_io_uring_close(
+		          io_uring,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Clean up
+	 */
+	result = libvhdi_io_uring_free(
+	          &io_uring,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "io_uring",
+	 io_uring );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_uring != NULL )
+	{
+		libvhdi_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_io_uring_queue_read function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_io_uring_queue_read(
+     void )
+{
+	uint8_t buffers[ VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES + 1 ][ 4096 ];
+	uint64_t user_data[ VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES ];
+	int32_t results[ VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES ];
+
+	libcerror_error_t *error        = NULL;
+	libvhdi_io_uring_t *io_uring    = NULL;
+	uint32_t number_of_queued_reads = 0;
+	int number_of_completions       = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libvhdi_io_uring_initialize(
+	          &io_uring,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "io_uring",
+	 io_uring );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_io_uring_open(
+	          io_uring,
+	          VHDI_TEST_IO_URING_FILENAME,
+	          VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES,
+	          &error );
+
+	VHDI_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result != 0 )
+	{
+		VHDI_TEST_ASSERT_EQUAL_UINT32(
+		 "io_uring->number_of_submission_entries",
+		 io_uring->number_of_submission_entries,
+		 (uint32_t) VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES );
+
+		/* Test regular cases
+		 */
+		for( number_of_queued_reads = 0;
+		     number_of_queued_reads < VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES;
+		     number_of_queued_reads++ )
+		{
+			result = libvhdi_io_uring_queue_read(
+			          io_uring,
+			          buffers[ number_of_queued_reads ],
+			          4096,
+			          (off64_t) number_of_queued_reads * 4096,
+			          (uint64_t) number_of_queued_reads + 1,
+			          &error );
+
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VHDI_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		VHDI_TEST_ASSERT_EQUAL_UINT32(
+		 "io_uring->number_of_queued_reads",
+		 io_uring->number_of_queued_reads,
+		 (uint32_t) VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES );
+
+		/* Test queue read beyond the number of submission queue entries
+		 */
+		result = libvhdi_io_uring_queue_read(
+		          io_uring,
+		          buffers[ VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES ],
+		          4096,
+		          0,
+		          (uint64_t) VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES + 1,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The reads remain outstanding after they were submitted until their completions are retrieved
+		 */
+		result = libvhdi_io_uring_submit(
+		          io_uring,
+		          0,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VHDI_TEST_ASSERT_EQUAL_UINT32(
+		 "io_uring->number_of_queued_reads",
+		 io_uring->number_of_queued_reads,
+		 0 );
+
+		result = libvhdi_io_uring_queue_read(
+		          io_uring,
+		          buffers[ VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES ],
+		          4096,
+		          0,
+		          (uint64_t) VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES + 1,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test error cases
+		 */
+		result = libvhdi_io_uring_queue_read(
+		          NULL,
+		          buffers[ 0 ],
+		          4096,
+		          0,
+		          1,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvhdi_io_uring_queue_read(
+		          io_uring,
+		          NULL,
+		          4096,
+		          0,
+		          1,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvhdi_io_uring_queue_read(
+		          io_uring,
+		          buffers[ 0 ],
+		          (size_t) INT32_MAX + 1,
+		          0,
+		          1,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvhdi_io_uring_queue_read(
+		          io_uring,
+		          buffers[ 0 ],
+		          4096,
+		          -1,
+		          1,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		/* The kernel can write into the buffers until the reads have completed
+		 */
+		while( io_uring->number_of_outstanding_reads > 0 )
+		{
+			result = libvhdi_io_uring_submit(
+			          io_uring,
+			          io_uring->number_of_outstanding_reads,
+			          &error );
+
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			result = libvhdi_io_uring_get_completions(
+			          io_uring,
+			          user_data,
+			          results,
+			          VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES,
+			          &number_of_completions,
+			          &error );
+
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VHDI_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		/* Clean up
+		 */
+		result = libvhdi_io_uring_close(
+		          io_uring,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libvhdi_io_uring_free(
+	          &io_uring,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "io_uring",
+	 io_uring );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_uring != NULL )
+	{
+		/* The close waits for the outstanding reads
+		 */
+		libvhdi_io_uring_close(
+		 io_uring,
+		 NULL );
+
+		libvhdi_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_io_uring_submit function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_io_uring_submit(
+     void )
+{
+	uint8_t buffer[ 4096 ];
+	uint64_t user_data[ 1 ];
+	int32_t results[ 1 ];
+
+	libcerror_error_t *error     = NULL;
+	libvhdi_io_uring_t *io_uring = NULL;
+	int number_of_completions    = 0;
+	int result                   = 0;
+
+	/* Initialize test
+	 */
+	result = libvhdi_io_uring_initialize(
+	          &io_uring,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "io_uring",
+	 io_uring );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_io_uring_submit(
+	          NULL,
+	          0,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_io_uring_submit(
+	          io_uring,
+	          0,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_io_uring_open(
+	          io_uring,
+	          VHDI_TEST_IO_URING_FILENAME,
+	          VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES,
+	          &error );
+
+	VHDI_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result != 0 )
+	{
+		result = libvhdi_io_uring_queue_read(
+		          io_uring,
+		          buffer,
+		          4096,
+		          0,
+		          1,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test error cases
+		 */
+		result = libvhdi_io_uring_submit(
+		          io_uring,
+		          2,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		/* Test regular cases
+		 */
+		result = libvhdi_io_uring_submit(
+		          io_uring,
+		          1,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VHDI_TEST_ASSERT_EQUAL_UINT32(
+		 "io_uring->number_of_queued_reads",
+		 io_uring->number_of_queued_reads,
+		 0 );
+
+		/* The submit waited for the completion
+		 */
+		result = libvhdi_io_uring_get_completions(
+		          io_uring,
+		          user_data,
+		          results,
+		          1,
+		          &number_of_completions,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "number_of_completions",
+		 number_of_completions,
+		 1 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VHDI_TEST_ASSERT_EQUAL_UINT32(
+		 "io_uring->number_of_outstanding_reads",
+		 io_uring->number_of_outstanding_reads,
+		 0 );
+
+		/* Clean up
+		 */
+		result = libvhdi_io_uring_close(
+		          io_uring,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libvhdi_io_uring_free(
+	          &io_uring,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "io_uring",
+	 io_uring );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_uring != NULL )
+	{
+		libvhdi_io_uring_close(
+		 io_uring,
+		 NULL );
+
+		libvhdi_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_io_uring_get_completions function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_io_uring_get_completions(
+     void )
+{
+	uint8_t buffers[ 3 ][ 4096 ];
+	uint8_t expected_data[ 4096 ];
+	uint64_t user_data[ VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES ];
+	int32_t results[ VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES ];
+	int32_t read_results[ 3 ]       = { -1, -1, -1 };
+
+	libcerror_error_t *error        = NULL;
+	libvhdi_io_uring_t *io_uring    = NULL;
+	int completion_index            = 0;
+	int number_of_completions       = 0;
+	int number_of_read_completions  = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libvhdi_io_uring_initialize(
+	          &io_uring,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "io_uring",
+	 io_uring );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_io_uring_open(
+	          io_uring,
+	          VHDI_TEST_IO_URING_FILENAME,
+	          VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES,
+	          &error );
+
+	VHDI_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result != 0 )
+	{
+		/* Queue a read of an entire buffer, a read that ends after the end of the file
+		 * and a read that starts at the end of the file
+		 */
+		result = libvhdi_io_uring_queue_read(
+		          io_uring,
+		          buffers[ 0 ],
+		          4096,
+		          4096,
+		          1,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libvhdi_io_uring_queue_read(
+		          io_uring,
+		          buffers[ 1 ],
+		          4096,
+		          VHDI_TEST_IO_URING_DATA_SIZE - 1024,
+		          2,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libvhdi_io_uring_queue_read(
+		          io_uring,
+		          buffers[ 2 ],
+		          4096,
+		          VHDI_TEST_IO_URING_DATA_SIZE,
+		          3,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvhdi_io_uring_submit(
+		          io_uring,
+		          3,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test regular cases
+		 */
+		result = libvhdi_io_uring_get_completions(
+		          io_uring,
+		          user_data,
+		          results,
+		          VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES,
+		          &number_of_completions,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "number_of_completions",
+		 number_of_completions,
+		 3 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VHDI_TEST_ASSERT_EQUAL_UINT32(
+		 "io_uring->number_of_outstanding_reads",
+		 io_uring->number_of_outstanding_reads,
+		 0 );
+
+		/* The completions are not necessarily in the order the reads were queued
+		 */
+		for( completion_index = 0;
+		     completion_index < number_of_completions;
+		     completion_index++ )
+		{
+			VHDI_TEST_ASSERT_GREATER_THAN_INT(
+			 "user_data",
+			 (int) user_data[ completion_index ],
+			 0 );
+
+			VHDI_TEST_ASSERT_LESS_THAN_INT(
+			 "user_data",
+			 (int) user_data[ completion_index ],
+			 4 );
+
+			read_results[ user_data[ completion_index ] - 1 ] = results[ completion_index ];
+
+			number_of_read_completions++;
+		}
+		VHDI_TEST_ASSERT_EQUAL_INT32(
+		 "read_results[ 0 ]",
+		 read_results[ 0 ],
+		 (int32_t) 4096 );
+
+		vhdi_test_io_uring_fill_data(
+		 expected_data,
+		 4096,
+		 4096 );
+
+		result = memory_compare(
+		          buffers[ 0 ],
+		          expected_data,
+		          4096 );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* A read that ends after the end of the file is a short read
+		 */
+		VHDI_TEST_ASSERT_EQUAL_INT32(
+		 "read_results[ 1 ]",
+		 read_results[ 1 ],
+		 (int32_t) 1024 );
+
+		vhdi_test_io_uring_fill_data(
+		 expected_data,
+		 1024,
+		 VHDI_TEST_IO_URING_DATA_SIZE - 1024 );
+
+		result = memory_compare(
+		          buffers[ 1 ],
+		          expected_data,
+		          1024 );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		VHDI_TEST_ASSERT_EQUAL_INT32(
+		 "read_results[ 2 ]",
+		 read_results[ 2 ],
+		 (int32_t) 0 );
+
+		/* Test get completions without completions
+		 */
+		result = libvhdi_io_uring_get_completions(
+		          io_uring,
+		          user_data,
+		          results,
+		          VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES,
+		          &number_of_completions,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "number_of_completions",
+		 number_of_completions,
+		 0 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test error cases
+		 */
+		result = libvhdi_io_uring_get_completions(
+		          NULL,
+		          user_data,
+		          results,
+		          VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES,
+		          &number_of_completions,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvhdi_io_uring_get_completions(
+		          io_uring,
+		          NULL,
+		          results,
+		          VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES,
+		          &number_of_completions,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvhdi_io_uring_get_completions(
+		          io_uring,
+		          user_data,
+		          NULL,
+		          VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES,
+		          &number_of_completions,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvhdi_io_uring_get_completions(
+		          io_uring,
+		          user_data,
+		          results,
+		          0,
+		          &number_of_completions,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvhdi_io_uring_get_completions(
+		          io_uring,
+		          user_data,
+		          results,
+		          VHDI_TEST_IO_URING_NUMBER_OF_ENTRIES,
+		          NULL,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VHDI_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		/* Clean up
+		 */
+		result = libvhdi_io_uring_close(
+		          io_uring,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libvhdi_io_uring_free(
+	          &io_uring,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "io_uring",
+	 io_uring );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_uring != NULL )
+	{
+		libvhdi_io_uring_close(
+		 io_uring,
+		 NULL );
+
+		libvhdi_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_read_queue_flush function with reads outstanding on the io_uring
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_io_uring_read_queue_flush(
+     void )
+{
+	uint8_t buffers[ 3 ][ 4096 ];
+	uint8_t expected_data[ 4096 ];
+	uint64_t request_identifiers[ 3 ];
+	ssize_t read_counts[ 3 ];
+
+	libcerror_error_t *error         = NULL;
+	libvhdi_read_queue_t *read_queue = NULL;
+	int buffer_index                 = 0;
+	int number_of_completions        = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libvhdi_read_queue_initialize(
+	          &read_queue,
+	          NULL,
+	          &vhdi_test_io_uring_read_buffers,
+	          &vhdi_test_io_uring_get_file_range,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "read_queue",
+	 read_queue );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_read_queue_open_io_uring(
+	          read_queue,
+	          VHDI_TEST_IO_URING_FILENAME,
+	          &error );
+
+	VHDI_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result != 0 )
+	{
+		if( memory_set(
+		     buffers,
+		     0,
+		     sizeof( buffers ) ) == NULL )
+		{
+			goto on_error;
+		}
+		/* The reads are queued on the io_uring and not yet submitted
+		 */
+		for( buffer_index = 0;
+		     buffer_index < 3;
+		     buffer_index++ )
+		{
+			result = libvhdi_read_queue_push_request(
+			          read_queue,
+			          buffers[ buffer_index ],
+			          4096,
+			          (off64_t) ( buffer_index + 1 ) * 4096,
+			          (uint64_t) buffer_index,
+			          &error );
+
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			VHDI_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		VHDI_TEST_ASSERT_EQUAL_UINT32(
+		 "read_queue->io_uring->number_of_outstanding_reads",
+		 read_queue->io_uring->number_of_outstanding_reads,
+		 3 );
+
+		/* Test regular cases
+		 */
+		result = libvhdi_read_queue_flush(
+		          read_queue,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VHDI_TEST_ASSERT_EQUAL_UINT32(
+		 "read_queue->io_uring->number_of_queued_reads",
+		 read_queue->io_uring->number_of_queued_reads,
+		 0 );
+
+		VHDI_TEST_ASSERT_EQUAL_UINT32(
+		 "read_queue->io_uring->number_of_outstanding_reads",
+		 read_queue->io_uring->number_of_outstanding_reads,
+		 0 );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "read_queue->number_of_requests",
+		 read_queue->number_of_requests,
+		 0 );
+
+		/* The flush waited for the reads to complete, hence the kernel no longer writes into the buffers
+		 */
+		for( buffer_index = 0;
+		     buffer_index < 3;
+		     buffer_index++ )
+		{
+			vhdi_test_io_uring_fill_data(
+			 expected_data,
+			 4096,
+			 (off64_t) ( buffer_index + 1 ) * 4096 );
+
+			result = memory_compare(
+			          buffers[ buffer_index ],
+			          expected_data,
+			          4096 );
+
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+		/* The completions of the flushed reads are discarded
+		 */
+		result = libvhdi_read_queue_pop_completions(
+		          read_queue,
+		          request_identifiers,
+		          read_counts,
+		          3,
+		          &number_of_completions,
+		          1,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "number_of_completions",
+		 number_of_completions,
+		 0 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Clean up
+		 */
+		result = libvhdi_read_queue_close_io_uring(
+		          read_queue,
+		          &error );
+
+		VHDI_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libvhdi_read_queue_flush(
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvhdi_read_queue_free(
+	          &read_queue,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "read_queue",
+	 read_queue );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_queue != NULL )
+	{
+		/* The flush waits for the outstanding reads
+		 */
+		libvhdi_read_queue_flush(
+		 read_queue,
+		 NULL );
+
+		libvhdi_read_queue_close_io_uring(
+		 read_queue,
+		 NULL );
+
+		libvhdi_read_queue_free(
+		 &read_queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	VHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT )
+
+	if( vhdi_test_io_uring_create_file() != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create test file.\n" );
+
+		goto on_error;
+	}
+	VHDI_TEST_RUN(
+	 "libvhdi_io_uring_initialize",
+	 vhdi_test_io_uring_initialize );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_io_uring_free",
+	 vhdi_test_io_uring_free );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_io_uring_open",
+	 vhdi_test_io_uring_open );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_io_uring_queue_read",
+	 vhdi_test_io_uring_queue_read );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_io_uring_submit",
+	 vhdi_test_io_uring_submit );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_io_uring_get_completions",
+	 vhdi_test_io_uring_get_completions );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_read_queue_flush",
+	 vhdi_test_io_uring_read_queue_flush );
+
+	remove(
+	 VHDI_TEST_IO_URING_FILENAME );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT )
+
+on_error:
+	remove(
+	 VHDI_TEST_IO_URING_FILENAME );
+
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
+}
+
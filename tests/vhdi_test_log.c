@@ -0,0 +1,1141 @@
+/*
+ * Library log type test program
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vhdi_test_functions.h"
+#include "vhdi_test_libbfio.h"
+#include "vhdi_test_libcerror.h"
+#include "vhdi_test_libvhdi.h"
+#include "vhdi_test_macros.h"
+#include "vhdi_test_memory.h"
+#include "vhdi_test_unused.h"
+
+#include "../libvhdi/libvhdi_checksum.h"
+#include "../libvhdi/libvhdi_log.h"
+
+uint8_t vhdi_test_log_range_data1[ 8 ] = {
+	'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H' };
+
+uint8_t vhdi_test_log_range_data2[ 4 ] = {
+	'w', 'x', 'y', 'z' };
+
+uint8_t vhdi_test_log_identifier[ 16 ] = {
+	0x4c, 0x6f, 0x67, 0x20, 0x69, 0x64, 0x65, 0x6e, 0x74, 0x69, 0x66, 0x69, 0x65, 0x72, 0x00, 0x01 };
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT )
+
+/* Tests the libvhdi_log_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_log_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libvhdi_log_t *log              = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_VHDI_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvhdi_log_initialize(
+	          &log,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "log",
+	 log );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_log_free(
+	          &log,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "log",
+	 log );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_log_initialize(
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	log = (libvhdi_log_t *) 0x12345678UL;
+
+	result = libvhdi_log_initialize(
+	          &log,
+	          &error );
+
+	log = NULL;
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VHDI_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvhdi_log_initialize with malloc failing
+		 */
+		vhdi_test_malloc_attempts_before_fail = test_number;
+
+		result = libvhdi_log_initialize(
+		          &log,
+		          &error );
+
+		if( vhdi_test_malloc_attempts_before_fail != -1 )
+		{
+			vhdi_test_malloc_attempts_before_fail = -1;
+
+			if( log != NULL )
+			{
+				libvhdi_log_free(
+				 &log,
+				 NULL );
+			}
+		}
+		else
+		{
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VHDI_TEST_ASSERT_IS_NULL(
+			 "log",
+			 log );
+
+			VHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvhdi_log_initialize with memset failing
+		 */
+		vhdi_test_memset_attempts_before_fail = test_number;
+
+		result = libvhdi_log_initialize(
+		          &log,
+		          &error );
+
+		if( vhdi_test_memset_attempts_before_fail != -1 )
+		{
+			vhdi_test_memset_attempts_before_fail = -1;
+
+			if( log != NULL )
+			{
+				libvhdi_log_free(
+				 &log,
+				 NULL );
+			}
+		}
+		else
+		{
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VHDI_TEST_ASSERT_IS_NULL(
+			 "log",
+			 log );
+
+			VHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VHDI_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( log != NULL )
+	{
+		libvhdi_log_free(
+		 &log,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_log_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_log_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvhdi_log_free(
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_log_insert_range function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_log_insert_range(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libvhdi_log_t *log       = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libvhdi_log_initialize(
+	          &log,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "log",
+	 log );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvhdi_log_insert_range(
+	          log,
+	          0,
+	          32,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "log->number_of_ranges",
+	 log->number_of_ranges,
+	 1 );
+
+	/* Test a range that splits an existing range
+	 */
+	result = libvhdi_log_insert_range(
+	          log,
+	          8,
+	          8,
+	          vhdi_test_log_range_data1,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "log->number_of_ranges",
+	 log->number_of_ranges,
+	 3 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "log->ranges[ 1 ].file_offset",
+	 (int64_t) log->ranges[ 1 ].file_offset,
+	 (int64_t) 8 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "log->ranges[ 2 ].size",
+	 (uint64_t) log->ranges[ 2 ].size,
+	 (uint64_t) 16 );
+
+	/* Test a range that overlaps the end of one range and the start of another
+	 */
+	result = libvhdi_log_insert_range(
+	          log,
+	          14,
+	          4,
+	          vhdi_test_log_range_data2,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "log->number_of_ranges",
+	 log->number_of_ranges,
+	 4 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "log->ranges[ 1 ].size",
+	 (uint64_t) log->ranges[ 1 ].size,
+	 (uint64_t) 6 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "log->ranges[ 3 ].file_offset",
+	 (int64_t) log->ranges[ 3 ].file_offset,
+	 (int64_t) 18 );
+
+	/* Test error cases
+	 */
+	result = libvhdi_log_insert_range(
+	          NULL,
+	          0,
+	          8,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_log_insert_range(
+	          log,
+	          -1,
+	          8,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvhdi_log_free(
+	          &log,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "log",
+	 log );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( log != NULL )
+	{
+		libvhdi_log_free(
+		 &log,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_log_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_log_read_buffer_at_offset(
+     void )
+{
+	uint8_t buffer[ 16 ];
+
+	uint8_t expected_data[ 16 ] = {
+		0xff, 0xff, 0x00, 0x00, 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 0x00, 0x00, 0xff, 0xff };
+
+	libcerror_error_t *error = NULL;
+	libvhdi_log_t *log       = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libvhdi_log_initialize(
+	          &log,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "log",
+	 log );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_log_insert_range(
+	          log,
+	          1026,
+	          12,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_log_insert_range(
+	          log,
+	          1028,
+	          8,
+	          vhdi_test_log_range_data1,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	memory_set(
+	 buffer,
+	 0xff,
+	 16 );
+
+	result = libvhdi_log_read_buffer_at_offset(
+	          log,
+	          buffer,
+	          16,
+	          1024,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          expected_data,
+	          16 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test a buffer that starts inside a range
+	 */
+	memory_set(
+	 buffer,
+	 0xff,
+	 16 );
+
+	result = libvhdi_log_read_buffer_at_offset(
+	          log,
+	          buffer,
+	          4,
+	          1034,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( expected_data[ 10 ] ),
+	          4 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test a buffer outside the ranges
+	 */
+	memory_set(
+	 buffer,
+	 0xff,
+	 16 );
+
+	result = libvhdi_log_read_buffer_at_offset(
+	          log,
+	          buffer,
+	          16,
+	          0,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 0xff );
+
+	/* Test error cases
+	 */
+	result = libvhdi_log_read_buffer_at_offset(
+	          NULL,
+	          buffer,
+	          16,
+	          1024,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_log_read_buffer_at_offset(
+	          log,
+	          NULL,
+	          16,
+	          1024,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_log_read_buffer_at_offset(
+	          log,
+	          buffer,
+	          16,
+	          -1,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvhdi_log_free(
+	          &log,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "log",
+	 log );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( log != NULL )
+	{
+		libvhdi_log_free(
+		 &log,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_log_read_file_io_handle function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_log_read_file_io_handle(
+     void )
+{
+	uint8_t buffer[ 4096 ];
+	uint8_t entry_data[ 8192 ];
+	uint8_t expected_data[ 4096 ];
+	uint8_t log_data[ 16384 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libvhdi_log_t *log               = NULL;
+	uint32_t checksum                = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 * The log consists of 4 sectors and contains a single log entry of 2 sectors at offset 12288
+	 * of which the data sector wraps around to the start of the log
+	 */
+	memory_set(
+	 expected_data,
+	 0x5a,
+	 4096 );
+
+	memory_copy(
+	 expected_data,
+	 vhdi_test_log_range_data1,
+	 8 );
+
+	memory_copy(
+	 &( expected_data[ 4092 ] ),
+	 vhdi_test_log_range_data2,
+	 4 );
+
+	memory_set(
+	 entry_data,
+	 0,
+	 8192 );
+
+	/* The log entry header
+	 */
+	memory_copy(
+	 entry_data,
+	 "loge",
+	 4 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( entry_data[ 8 ] ),
+	 8192 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( entry_data[ 12 ] ),
+	 12288 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( entry_data[ 16 ] ),
+	 (uint64_t) 5 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( entry_data[ 24 ] ),
+	 1 );
+
+	memory_copy(
+	 &( entry_data[ 32 ] ),
+	 vhdi_test_log_identifier,
+	 16 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( entry_data[ 48 ] ),
+	 (uint64_t) 1048576 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( entry_data[ 56 ] ),
+	 (uint64_t) 1048576 );
+
+	/* The data descriptor
+	 */
+	memory_copy(
+	 &( entry_data[ 64 ] ),
+	 "desc",
+	 4 );
+
+	memory_copy(
+	 &( entry_data[ 68 ] ),
+	 &( expected_data[ 4092 ] ),
+	 4 );
+
+	memory_copy(
+	 &( entry_data[ 72 ] ),
+	 expected_data,
+	 8 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( entry_data[ 80 ] ),
+	 (uint64_t) 8192 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( entry_data[ 88 ] ),
+	 (uint64_t) 5 );
+
+	/* The data sector
+	 */
+	memory_copy(
+	 &( entry_data[ 4096 ] ),
+	 expected_data,
+	 4096 );
+
+	memory_copy(
+	 &( entry_data[ 4096 ] ),
+	 "data",
+	 4 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( entry_data[ 4100 ] ),
+	 0 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( entry_data[ 8188 ] ),
+	 5 );
+
+	result = libvhdi_checksum_calculate_crc32(
+	          &checksum,
+	          entry_data,
+	          8192,
+	          0,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( entry_data[ 4 ] ),
+	 checksum );
+
+	memory_set(
+	 log_data,
+	 0,
+	 16384 );
+
+	memory_copy(
+	 &( log_data[ 12288 ] ),
+	 entry_data,
+	 4096 );
+
+	memory_copy(
+	 log_data,
+	 &( entry_data[ 4096 ] ),
+	 4096 );
+
+	result = vhdi_test_open_file_io_handle(
+	          &file_io_handle,
+	          log_data,
+	          16384,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_log_initialize(
+	          &log,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "log",
+	 log );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvhdi_log_read_file_io_handle(
+	          log,
+	          file_io_handle,
+	          0,
+	          16384,
+	          vhdi_test_log_identifier,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT32(
+	 "log->number_of_entries",
+	 log->number_of_entries,
+	 1 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "log->sequence_number",
+	 log->sequence_number,
+	 (uint64_t) 5 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "log->file_size",
+	 log->file_size,
+	 (uint64_t) 1048576 );
+
+	memory_set(
+	 buffer,
+	 0,
+	 4096 );
+
+	result = libvhdi_log_read_buffer_at_offset(
+	          log,
+	          buffer,
+	          4096,
+	          8192,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          expected_data,
+	          4096 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvhdi_log_read_file_io_handle(
+	          NULL,
+	          file_io_handle,
+	          0,
+	          16384,
+	          vhdi_test_log_identifier,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_log_read_file_io_handle(
+	          log,
+	          file_io_handle,
+	          0,
+	          16384,
+	          vhdi_test_log_identifier,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvhdi_log_free(
+	          &log,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "log",
+	 log );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vhdi_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( log != NULL )
+	{
+		libvhdi_log_free(
+		 &log,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	VHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT )
+
+	VHDI_TEST_RUN(
+	 "libvhdi_log_initialize",
+	 vhdi_test_log_initialize );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_log_free",
+	 vhdi_test_log_free );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_log_insert_range",
+	 vhdi_test_log_insert_range );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_log_read_buffer_at_offset",
+	 vhdi_test_log_read_buffer_at_offset );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_log_read_file_io_handle",
+	 vhdi_test_log_read_file_io_handle );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,575 @@
+/*
+ * Library read_ahead type test program
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vhdi_test_libcerror.h"
+#include "vhdi_test_libvhdi.h"
+#include "vhdi_test_macros.h"
+#include "vhdi_test_memory.h"
+#include "vhdi_test_unused.h"
+
+#include "../libvhdi/libvhdi_read_ahead.h"
+
+#define VHDI_TEST_READ_AHEAD_DATA_SIZE	( 64 * 1024 )
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) && defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+
+/* Reads test data, where every byte contains the lower 8 bits of its offset
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t vhdi_test_read_ahead_read_data(
+         intptr_t *data_handle VHDI_TEST_ATTRIBUTE_UNUSED,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	size_t buffer_offset = 0;
+
+	VHDI_TEST_UNREFERENCED_PARAMETER( data_handle )
+
+	if( ( buffer == NULL )
+	 || ( offset < 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "vhdi_test_read_ahead_read_data: invalid argument." );
+
+		return( -1 );
+	}
+	if( offset >= VHDI_TEST_READ_AHEAD_DATA_SIZE )
+	{
+		return( 0 );
+	}
+	if( buffer_size > (size_t) ( VHDI_TEST_READ_AHEAD_DATA_SIZE - offset ) )
+	{
+		buffer_size = (size_t) ( VHDI_TEST_READ_AHEAD_DATA_SIZE - offset );
+	}
+	for( buffer_offset = 0;
+	     buffer_offset < buffer_size;
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = (uint8_t) ( ( offset + buffer_offset ) & 0xff );
+	}
+	return( (ssize_t) buffer_size );
+}
+
+/* Tests the libvhdi_read_ahead_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_read_ahead_initialize(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libvhdi_read_ahead_t *read_ahead = NULL;
+	int result                       = 0;
+
+	/* Test regular cases
+	 */
+	result = libvhdi_read_ahead_initialize(
+	          &read_ahead,
+	          4096,
+	          VHDI_TEST_READ_AHEAD_DATA_SIZE,
+	          NULL,
+	          &vhdi_test_read_ahead_read_data,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "read_ahead",
+	 read_ahead );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_read_ahead_free(
+	          &read_ahead,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "read_ahead",
+	 read_ahead );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_read_ahead_initialize(
+	          NULL,
+	          4096,
+	          VHDI_TEST_READ_AHEAD_DATA_SIZE,
+	          NULL,
+	          &vhdi_test_read_ahead_read_data,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_ahead = (libvhdi_read_ahead_t *) 0x12345678UL;
+
+	result = libvhdi_read_ahead_initialize(
+	          &read_ahead,
+	          4096,
+	          VHDI_TEST_READ_AHEAD_DATA_SIZE,
+	          NULL,
+	          &vhdi_test_read_ahead_read_data,
+	          &error );
+
+	read_ahead = NULL;
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_read_ahead_initialize(
+	          &read_ahead,
+	          0,
+	          VHDI_TEST_READ_AHEAD_DATA_SIZE,
+	          NULL,
+	          &vhdi_test_read_ahead_read_data,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_read_ahead_initialize(
+	          &read_ahead,
+	          4096,
+	          VHDI_TEST_READ_AHEAD_DATA_SIZE,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_ahead != NULL )
+	{
+		libvhdi_read_ahead_free(
+		 &read_ahead,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_read_ahead_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_read_ahead_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvhdi_read_ahead_free(
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_read_ahead_read_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_read_ahead_read_buffer(
+     void )
+{
+	uint8_t buffer[ 3000 ];
+
+	libcerror_error_t *error         = NULL;
+	libvhdi_read_ahead_t *read_ahead = NULL;
+	size_t buffer_offset             = 0;
+	ssize_t read_count               = 0;
+	off64_t offset                   = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libvhdi_read_ahead_initialize(
+	          &read_ahead,
+	          4096,
+	          VHDI_TEST_READ_AHEAD_DATA_SIZE,
+	          NULL,
+	          &vhdi_test_read_ahead_read_data,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "read_ahead",
+	 read_ahead );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	while( offset < VHDI_TEST_READ_AHEAD_DATA_SIZE )
+	{
+		read_count = libvhdi_read_ahead_read_buffer(
+		              read_ahead,
+		              buffer,
+		              3000,
+		              offset,
+		              &error );
+
+		VHDI_TEST_ASSERT_NOT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		VHDI_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( buffer_offset = 0;
+		     buffer_offset < (size_t) read_count;
+		     buffer_offset++ )
+		{
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "buffer[ buffer_offset ]",
+			 (int) buffer[ buffer_offset ],
+			 (int) ( ( offset + buffer_offset ) & 0xff ) );
+		}
+		offset += read_count;
+	}
+	read_count = libvhdi_read_ahead_read_buffer(
+	              read_ahead,
+	              buffer,
+	              3000,
+	              VHDI_TEST_READ_AHEAD_DATA_SIZE,
+	              &error );
+
+	VHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a non-sequential read after the read-ahead was started
+	 */
+	read_count = libvhdi_read_ahead_read_buffer(
+	              read_ahead,
+	              buffer,
+	              3000,
+	              1234,
+	              &error );
+
+	VHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 3000 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "buffer[ 0 ]",
+	 (int) buffer[ 0 ],
+	 (int) ( 1234 & 0xff ) );
+
+	result = libvhdi_read_ahead_flush(
+	          read_ahead,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libvhdi_read_ahead_read_buffer(
+	              NULL,
+	              buffer,
+	              3000,
+	              0,
+	              &error );
+
+	VHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvhdi_read_ahead_read_buffer(
+	              read_ahead,
+	              NULL,
+	              3000,
+	              0,
+	              &error );
+
+	VHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvhdi_read_ahead_read_buffer(
+	              read_ahead,
+	              buffer,
+	              3000,
+	              -1,
+	              &error );
+
+	VHDI_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvhdi_read_ahead_free(
+	          &read_ahead,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "read_ahead",
+	 read_ahead );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_ahead != NULL )
+	{
+		libvhdi_read_ahead_free(
+		 &read_ahead,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_read_ahead_flush function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_read_ahead_flush(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvhdi_read_ahead_flush(
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) && defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	VHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) && defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+
+	VHDI_TEST_RUN(
+	 "libvhdi_read_ahead_initialize",
+	 vhdi_test_read_ahead_initialize );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_read_ahead_free",
+	 vhdi_test_read_ahead_free );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_read_ahead_read_buffer",
+	 vhdi_test_read_ahead_read_buffer );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_read_ahead_flush",
+	 vhdi_test_read_ahead_flush );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) && defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) && defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) && defined( HAVE_LIBVHDI_MULTI_THREAD_SUPPORT ) */
+}
+
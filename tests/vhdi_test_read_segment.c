@@ -0,0 +1,154 @@
+/*
+ * Library read_segment type test program
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vhdi_test_libcerror.h"
+#include "vhdi_test_libvhdi.h"
+#include "vhdi_test_macros.h"
+#include "vhdi_test_memory.h"
+#include "vhdi_test_unused.h"
+
+#include "../libvhdi/libvhdi_read_segment.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT )
+
+/* Tests the libvhdi_read_segment_compare_by_file_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_read_segment_compare_by_file_offset(
+     void )
+{
+	libvhdi_read_segment_t read_segments[ 3 ];
+
+	int result = 0;
+
+	read_segments[ 0 ].file_offset = 4096;
+	read_segments[ 0 ].size        = 512;
+	read_segments[ 0 ].buffer      = NULL;
+
+	read_segments[ 1 ].file_offset = 1024;
+	read_segments[ 1 ].size        = 512;
+	read_segments[ 1 ].buffer      = NULL;
+
+	read_segments[ 2 ].file_offset = 4096;
+	read_segments[ 2 ].size        = 1024;
+	read_segments[ 2 ].buffer      = NULL;
+
+	/* Test regular cases
+	 */
+	result = libvhdi_read_segment_compare_by_file_offset(
+	          &( read_segments[ 0 ] ),
+	          &( read_segments[ 1 ] ) );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvhdi_read_segment_compare_by_file_offset(
+	          &( read_segments[ 1 ] ),
+	          &( read_segments[ 0 ] ) );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libvhdi_read_segment_compare_by_file_offset(
+	          &( read_segments[ 0 ] ),
+	          &( read_segments[ 2 ] ) );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test sorting
+	 */
+	qsort(
+	 read_segments,
+	 3,
+	 sizeof( libvhdi_read_segment_t ),
+	 &libvhdi_read_segment_compare_by_file_offset );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "read_segments[ 0 ].file_offset",
+	 (int64_t) read_segments[ 0 ].file_offset,
+	 (int64_t) 1024 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "read_segments[ 1 ].file_offset",
+	 (int64_t) read_segments[ 1 ].file_offset,
+	 (int64_t) 4096 );
+
+	VHDI_TEST_ASSERT_EQUAL_INT64(
+	 "read_segments[ 2 ].file_offset",
+	 (int64_t) read_segments[ 2 ].file_offset,
+	 (int64_t) 4096 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	VHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT )
+
+	VHDI_TEST_RUN(
+	 "libvhdi_read_segment_compare_by_file_offset",
+	 vhdi_test_read_segment_compare_by_file_offset );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
+}
+
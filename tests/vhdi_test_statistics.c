@@ -0,0 +1,787 @@
+/*
+ * Library statistics type test program
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vhdi_test_libcerror.h"
+#include "vhdi_test_libvhdi.h"
+#include "vhdi_test_macros.h"
+#include "vhdi_test_memory.h"
+#include "vhdi_test_unused.h"
+
+#include "../libvhdi/libvhdi_statistics.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT )
+
+/* Tests the libvhdi_statistics_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_statistics_initialize(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libvhdi_statistics_t *statistics = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_VHDI_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvhdi_statistics_initialize(
+	          &statistics,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "statistics",
+	 statistics );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_statistics_free(
+	          &statistics,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "statistics",
+	 statistics );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvhdi_statistics_initialize(
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	statistics = (libvhdi_statistics_t *) 0x12345678UL;
+
+	result = libvhdi_statistics_initialize(
+	          &statistics,
+	          &error );
+
+	statistics = NULL;
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VHDI_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvhdi_statistics_initialize with malloc failing
+		 */
+		vhdi_test_malloc_attempts_before_fail = test_number;
+
+		result = libvhdi_statistics_initialize(
+		          &statistics,
+		          &error );
+
+		if( vhdi_test_malloc_attempts_before_fail != -1 )
+		{
+			vhdi_test_malloc_attempts_before_fail = -1;
+
+			if( statistics != NULL )
+			{
+				libvhdi_statistics_free(
+				 &statistics,
+				 NULL );
+			}
+		}
+		else
+		{
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VHDI_TEST_ASSERT_IS_NULL(
+			 "statistics",
+			 statistics );
+
+			VHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvhdi_statistics_initialize with memset failing
+		 */
+		vhdi_test_memset_attempts_before_fail = test_number;
+
+		result = libvhdi_statistics_initialize(
+		          &statistics,
+		          &error );
+
+		if( vhdi_test_memset_attempts_before_fail != -1 )
+		{
+			vhdi_test_memset_attempts_before_fail = -1;
+
+			if( statistics != NULL )
+			{
+				libvhdi_statistics_free(
+				 &statistics,
+				 NULL );
+			}
+		}
+		else
+		{
+			VHDI_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VHDI_TEST_ASSERT_IS_NULL(
+			 "statistics",
+			 statistics );
+
+			VHDI_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VHDI_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( statistics != NULL )
+	{
+		libvhdi_statistics_free(
+		 &statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_statistics_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_statistics_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvhdi_statistics_free(
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_statistics_add_value function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_statistics_add_value(
+     void )
+{
+	uint64_t values[ LIBVHDI_NUMBER_OF_STATISTICS ];
+
+	libcerror_error_t *error         = NULL;
+	libvhdi_statistics_t *statistics = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libvhdi_statistics_initialize(
+	          &statistics,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "statistics",
+	 statistics );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvhdi_statistics_add_value(
+	          statistics,
+	          LIBVHDI_STATISTIC_READ_SIZE,
+	          512,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_statistics_add_value(
+	          statistics,
+	          LIBVHDI_STATISTIC_READ_SIZE,
+	          1024,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_statistics_get_values(
+	          statistics,
+	          values,
+	          LIBVHDI_NUMBER_OF_STATISTICS,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVHDI_STATISTIC_READ_SIZE ]",
+	 values[ LIBVHDI_STATISTIC_READ_SIZE ],
+	 (uint64_t) 1536 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVHDI_STATISTIC_NUMBER_OF_READS ]",
+	 values[ LIBVHDI_STATISTIC_NUMBER_OF_READS ],
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libvhdi_statistics_add_value(
+	          NULL,
+	          LIBVHDI_STATISTIC_READ_SIZE,
+	          512,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_statistics_add_value(
+	          statistics,
+	          -1,
+	          512,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvhdi_statistics_add_value(
+	          statistics,
+	          LIBVHDI_NUMBER_OF_STATISTICS,
+	          512,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvhdi_statistics_free(
+	          &statistics,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "statistics",
+	 statistics );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( statistics != NULL )
+	{
+		libvhdi_statistics_free(
+		 &statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_statistics_add_parent_read function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_statistics_add_parent_read(
+     void )
+{
+	uint64_t values[ LIBVHDI_NUMBER_OF_STATISTICS ];
+
+	libcerror_error_t *error         = NULL;
+	libvhdi_statistics_t *statistics = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libvhdi_statistics_initialize(
+	          &statistics,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "statistics",
+	 statistics );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvhdi_statistics_add_parent_read(
+	          statistics,
+	          1,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a chain level beyond the number of chain levels
+	 */
+	result = libvhdi_statistics_add_parent_read(
+	          statistics,
+	          LIBVHDI_STATISTICS_NUMBER_OF_CHAIN_LEVELS + 4,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_statistics_get_values(
+	          statistics,
+	          values,
+	          LIBVHDI_NUMBER_OF_STATISTICS,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVHDI_STATISTIC_NUMBER_OF_PARENT_READS ]",
+	 values[ LIBVHDI_STATISTIC_NUMBER_OF_PARENT_READS ],
+	 (uint64_t) 1 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVHDI_NUMBER_OF_STATISTICS - 1 ]",
+	 values[ LIBVHDI_NUMBER_OF_STATISTICS - 1 ],
+	 (uint64_t) 1 );
+
+	/* Test error cases
+	 */
+	result = libvhdi_statistics_add_parent_read(
+	          statistics,
+	          0,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvhdi_statistics_free(
+	          &statistics,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "statistics",
+	 statistics );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( statistics != NULL )
+	{
+		libvhdi_statistics_free(
+		 &statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvhdi_statistics_reset function
+ * Returns 1 if successful or 0 if not
+ */
+int vhdi_test_statistics_reset(
+     void )
+{
+	uint64_t values[ LIBVHDI_NUMBER_OF_STATISTICS ];
+
+	libcerror_error_t *error         = NULL;
+	libvhdi_statistics_t *statistics = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libvhdi_statistics_initialize(
+	          &statistics,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "statistics",
+	 statistics );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_statistics_add_file_read(
+	          statistics,
+	          4096,
+	          0,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvhdi_statistics_reset(
+	          statistics,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvhdi_statistics_get_values(
+	          statistics,
+	          values,
+	          LIBVHDI_NUMBER_OF_STATISTICS,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVHDI_STATISTIC_NUMBER_OF_FILE_READS ]",
+	 values[ LIBVHDI_STATISTIC_NUMBER_OF_FILE_READS ],
+	 (uint64_t) 0 );
+
+	VHDI_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVHDI_STATISTIC_FILE_READ_SIZE ]",
+	 values[ LIBVHDI_STATISTIC_FILE_READ_SIZE ],
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libvhdi_statistics_reset(
+	          NULL,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VHDI_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvhdi_statistics_free(
+	          &statistics,
+	          &error );
+
+	VHDI_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "statistics",
+	 statistics );
+
+	VHDI_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( statistics != NULL )
+	{
+		libvhdi_statistics_free(
+		 &statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VHDI_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VHDI_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VHDI_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VHDI_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VHDI_TEST_UNREFERENCED_PARAMETER( argc )
+	VHDI_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT )
+
+	VHDI_TEST_RUN(
+	 "libvhdi_statistics_initialize",
+	 vhdi_test_statistics_initialize );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_statistics_free",
+	 vhdi_test_statistics_free );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_statistics_add_value",
+	 vhdi_test_statistics_add_value );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_statistics_add_parent_read",
+	 vhdi_test_statistics_add_parent_read );
+
+	VHDI_TEST_RUN(
+	 "libvhdi_statistics_reset",
+	 vhdi_test_statistics_reset );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVHDI_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,530 @@
+/*
+ * Allocation statistics
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "allocation_statistics.h"
+#include "vhditools_libcerror.h"
+
+/* Creates allocation statistics
+ * Make sure the value allocation_statistics is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int allocation_statistics_initialize(
+     allocation_statistics_t **allocation_statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "allocation_statistics_initialize";
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *allocation_statistics != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid allocation statistics value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*allocation_statistics = memory_allocate_structure(
+	                          allocation_statistics_t );
+
+	if( *allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create allocation statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *allocation_statistics,
+	     0,
+	     sizeof( allocation_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear allocation statistics.",
+		 function );
+
+		goto on_error;
+	}
+	( *allocation_statistics )->first_block_file_offset = -1;
+	( *allocation_statistics )->last_block_file_offset  = -1;
+
+	return( 1 );
+
+on_error:
+	if( *allocation_statistics != NULL )
+	{
+		memory_free(
+		 *allocation_statistics );
+
+		*allocation_statistics = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees allocation statistics
+ * Returns 1 if successful or -1 on error
+ */
+int allocation_statistics_free(
+     allocation_statistics_t **allocation_statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "allocation_statistics_free";
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *allocation_statistics != NULL )
+	{
+		memory_free(
+		 *allocation_statistics );
+
+		*allocation_statistics = NULL;
+	}
+	return( 1 );
+}
+
+/* Inserts a run into the largest runs
+ * The run is ignored if it is smaller than the currently known largest runs
+ * Returns 1 if successful or -1 on error
+ */
+int allocation_statistics_insert_largest_run(
+     allocation_statistics_t *allocation_statistics,
+     allocation_run_t *run,
+     libcerror_error_t **error )
+{
+	static char *function = "allocation_statistics_insert_largest_run";
+	int run_index         = 0;
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( allocation_statistics->number_of_largest_runs < 0 )
+	 || ( allocation_statistics->number_of_largest_runs > ALLOCATION_STATISTICS_NUMBER_OF_LARGEST_RUNS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid allocation statistics - number of largest runs value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( run == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run.",
+		 function );
+
+		return( -1 );
+	}
+	run_index = allocation_statistics->number_of_largest_runs;
+
+	if( run_index == ALLOCATION_STATISTICS_NUMBER_OF_LARGEST_RUNS )
+	{
+		if( run->size <= allocation_statistics->largest_runs[ run_index - 1 ].size )
+		{
+			return( 1 );
+		}
+		run_index--;
+	}
+	else
+	{
+		allocation_statistics->number_of_largest_runs += 1;
+	}
+	/* Runs of the same size remain in the order they were inserted
+	 */
+	while( ( run_index > 0 )
+	    && ( run->size > allocation_statistics->largest_runs[ run_index - 1 ].size ) )
+	{
+		allocation_statistics->largest_runs[ run_index ] = allocation_statistics->largest_runs[ run_index - 1 ];
+
+		run_index--;
+	}
+	allocation_statistics->largest_runs[ run_index ] = *run;
+
+	return( 1 );
+}
+
+/* Adds a block
+ * The blocks must be added in media order
+ * The block file offset is -1 if the block is not allocated in the file
+ * Returns 1 if successful or -1 on error
+ */
+int allocation_statistics_add_block(
+     allocation_statistics_t *allocation_statistics,
+     off64_t block_offset,
+     off64_t block_file_offset,
+     size64_t block_size,
+     size64_t allocated_size,
+     size64_t sparse_size,
+     size64_t parent_size,
+     libcerror_error_t **error )
+{
+	static char *function = "allocation_statistics_add_block";
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid block size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	allocation_statistics->number_of_blocks += 1;
+	allocation_statistics->allocated_size   += allocated_size;
+	allocation_statistics->sparse_size      += sparse_size;
+	allocation_statistics->parent_size      += parent_size;
+
+	if( block_file_offset < 0 )
+	{
+		return( 1 );
+	}
+	if( allocation_statistics->number_of_allocated_blocks == 0 )
+	{
+		allocation_statistics->first_block_file_offset = block_file_offset;
+	}
+	else if( block_file_offset < allocation_statistics->last_block_file_offset )
+	{
+		allocation_statistics->number_of_out_of_order_blocks += 1;
+	}
+	allocation_statistics->number_of_allocated_blocks += 1;
+	allocation_statistics->last_block_file_offset      = block_file_offset;
+
+	if( ( allocation_statistics->number_of_runs > 0 )
+	 && ( ( allocation_statistics->last_run.offset + (off64_t) allocation_statistics->last_run.size ) == block_offset )
+	 && ( ( allocation_statistics->last_run.file_offset + (off64_t) allocation_statistics->last_run.size ) == block_file_offset ) )
+	{
+		allocation_statistics->last_run.size += block_size;
+
+		if( allocation_statistics->number_of_runs == 1 )
+		{
+			allocation_statistics->first_run.size = allocation_statistics->last_run.size;
+		}
+		return( 1 );
+	}
+	if( allocation_statistics->number_of_runs > 0 )
+	{
+		if( allocation_statistics_insert_largest_run(
+		     allocation_statistics,
+		     &( allocation_statistics->last_run ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert largest run.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	allocation_statistics->last_run.offset      = block_offset;
+	allocation_statistics->last_run.file_offset = block_file_offset;
+	allocation_statistics->last_run.size        = block_size;
+
+	allocation_statistics->number_of_runs += 1;
+
+	if( allocation_statistics->number_of_runs == 1 )
+	{
+		allocation_statistics->first_run = allocation_statistics->last_run;
+	}
+	return( 1 );
+}
+
+/* Merges the allocation statistics of the blocks that directly follow
+ * A run that continues in the next allocation statistics is counted once
+ * Returns 1 if successful or -1 on error
+ */
+int allocation_statistics_merge(
+     allocation_statistics_t *allocation_statistics,
+     allocation_statistics_t *next_allocation_statistics,
+     libcerror_error_t **error )
+{
+	allocation_run_t run;
+
+	static char *function = "allocation_statistics_merge";
+	int is_contiguous     = 0;
+	int run_index         = 0;
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( next_allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid next allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( next_allocation_statistics->number_of_largest_runs < 0 )
+	 || ( next_allocation_statistics->number_of_largest_runs > ALLOCATION_STATISTICS_NUMBER_OF_LARGEST_RUNS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid next allocation statistics - number of largest runs value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	allocation_statistics->number_of_blocks += next_allocation_statistics->number_of_blocks;
+	allocation_statistics->allocated_size   += next_allocation_statistics->allocated_size;
+	allocation_statistics->sparse_size      += next_allocation_statistics->sparse_size;
+	allocation_statistics->parent_size      += next_allocation_statistics->parent_size;
+
+	if( next_allocation_statistics->number_of_allocated_blocks == 0 )
+	{
+		return( 1 );
+	}
+	if( allocation_statistics->number_of_allocated_blocks == 0 )
+	{
+		allocation_statistics->first_block_file_offset = next_allocation_statistics->first_block_file_offset;
+	}
+	else if( next_allocation_statistics->first_block_file_offset < allocation_statistics->last_block_file_offset )
+	{
+		allocation_statistics->number_of_out_of_order_blocks += 1;
+	}
+	allocation_statistics->number_of_allocated_blocks    += next_allocation_statistics->number_of_allocated_blocks;
+	allocation_statistics->number_of_out_of_order_blocks += next_allocation_statistics->number_of_out_of_order_blocks;
+	allocation_statistics->last_block_file_offset         = next_allocation_statistics->last_block_file_offset;
+
+	if( allocation_statistics->number_of_runs > 0 )
+	{
+		if( ( ( allocation_statistics->last_run.offset + (off64_t) allocation_statistics->last_run.size ) == next_allocation_statistics->first_run.offset )
+		 && ( ( allocation_statistics->last_run.file_offset + (off64_t) allocation_statistics->last_run.size ) == next_allocation_statistics->first_run.file_offset ) )
+		{
+			is_contiguous = 1;
+		}
+	}
+	for( run_index = 0;
+	     run_index < next_allocation_statistics->number_of_largest_runs;
+	     run_index++ )
+	{
+		/* The first run of the next allocation statistics is inserted as part of the combined run
+		 */
+		if( ( is_contiguous != 0 )
+		 && ( next_allocation_statistics->largest_runs[ run_index ].offset == next_allocation_statistics->first_run.offset ) )
+		{
+			continue;
+		}
+		if( allocation_statistics_insert_largest_run(
+		     allocation_statistics,
+		     &( next_allocation_statistics->largest_runs[ run_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert largest run: %d.",
+			 function,
+			 run_index );
+
+			return( -1 );
+		}
+	}
+	if( allocation_statistics->number_of_runs == 0 )
+	{
+		allocation_statistics->first_run      = next_allocation_statistics->first_run;
+		allocation_statistics->last_run       = next_allocation_statistics->last_run;
+		allocation_statistics->number_of_runs = next_allocation_statistics->number_of_runs;
+	}
+	else if( is_contiguous != 0 )
+	{
+		if( allocation_statistics->number_of_runs == 1 )
+		{
+			allocation_statistics->first_run.size += next_allocation_statistics->first_run.size;
+		}
+		if( next_allocation_statistics->number_of_runs == 1 )
+		{
+			allocation_statistics->last_run.size += next_allocation_statistics->first_run.size;
+		}
+		else
+		{
+			run       = allocation_statistics->last_run;
+			run.size += next_allocation_statistics->first_run.size;
+
+			if( allocation_statistics_insert_largest_run(
+			     allocation_statistics,
+			     &run,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert combined run.",
+				 function );
+
+				return( -1 );
+			}
+			allocation_statistics->last_run = next_allocation_statistics->last_run;
+		}
+		allocation_statistics->number_of_runs += next_allocation_statistics->number_of_runs - 1;
+	}
+	else
+	{
+		if( allocation_statistics_insert_largest_run(
+		     allocation_statistics,
+		     &( allocation_statistics->last_run ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert largest run.",
+			 function );
+
+			return( -1 );
+		}
+		allocation_statistics->last_run        = next_allocation_statistics->last_run;
+		allocation_statistics->number_of_runs += next_allocation_statistics->number_of_runs;
+	}
+	return( 1 );
+}
+
+/* Finalizes the allocation statistics
+ * This inserts the last run into the largest runs, hence no blocks should be added afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int allocation_statistics_finalize(
+     allocation_statistics_t *allocation_statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "allocation_statistics_finalize";
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_statistics->last_run.size == 0 )
+	{
+		return( 1 );
+	}
+	if( allocation_statistics_insert_largest_run(
+	     allocation_statistics,
+	     &( allocation_statistics->last_run ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert last run.",
+		 function );
+
+		return( -1 );
+	}
+	allocation_statistics->last_run.size = 0;
+
+	return( 1 );
+}
+
@@ -0,0 +1,149 @@
+/*
+ * Allocation statistics
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _ALLOCATION_STATISTICS_H )
+#define _ALLOCATION_STATISTICS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "vhditools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define ALLOCATION_STATISTICS_NUMBER_OF_LARGEST_RUNS	8
+
+typedef struct allocation_run allocation_run_t;
+
+struct allocation_run
+{
+	/* The (media) offset
+	 */
+	off64_t offset;
+
+	/* The file offset
+	 */
+	off64_t file_offset;
+
+	/* The size
+	 */
+	size64_t size;
+};
+
+typedef struct allocation_statistics allocation_statistics_t;
+
+struct allocation_statistics
+{
+	/* The number of blocks
+	 */
+	uint64_t number_of_blocks;
+
+	/* The number of blocks allocated in the file
+	 */
+	uint64_t number_of_allocated_blocks;
+
+	/* The number of bytes allocated in the file
+	 */
+	size64_t allocated_size;
+
+	/* The number of sparse bytes
+	 */
+	size64_t sparse_size;
+
+	/* The number of bytes stored in the parent file
+	 */
+	size64_t parent_size;
+
+	/* The number of runs, where a run consists of allocated blocks
+	 * that are contiguous in both the media and the file
+	 */
+	uint64_t number_of_runs;
+
+	/* The number of allocated blocks that are stored in the file
+	 * before the preceding allocated block
+	 */
+	uint64_t number_of_out_of_order_blocks;
+
+	/* The file offset of the first allocated block
+	 */
+	off64_t first_block_file_offset;
+
+	/* The file offset of the last allocated block
+	 */
+	off64_t last_block_file_offset;
+
+	/* The first run
+	 */
+	allocation_run_t first_run;
+
+	/* The last run, which is not part of the largest runs until finalized
+	 */
+	allocation_run_t last_run;
+
+	/* The largest runs, sorted by size in descending order
+	 */
+	allocation_run_t largest_runs[ ALLOCATION_STATISTICS_NUMBER_OF_LARGEST_RUNS ];
+
+	/* The number of largest runs
+	 */
+	int number_of_largest_runs;
+};
+
+int allocation_statistics_initialize(
+     allocation_statistics_t **allocation_statistics,
+     libcerror_error_t **error );
+
+int allocation_statistics_free(
+     allocation_statistics_t **allocation_statistics,
+     libcerror_error_t **error );
+
+int allocation_statistics_insert_largest_run(
+     allocation_statistics_t *allocation_statistics,
+     allocation_run_t *run,
+     libcerror_error_t **error );
+
+int allocation_statistics_add_block(
+     allocation_statistics_t *allocation_statistics,
+     off64_t block_offset,
+     off64_t block_file_offset,
+     size64_t block_size,
+     size64_t allocated_size,
+     size64_t sparse_size,
+     size64_t parent_size,
+     libcerror_error_t **error );
+
+int allocation_statistics_merge(
+     allocation_statistics_t *allocation_statistics,
+     allocation_statistics_t *next_allocation_statistics,
+     libcerror_error_t **error );
+
+int allocation_statistics_finalize(
+     allocation_statistics_t *allocation_statistics,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _ALLOCATION_STATISTICS_H ) */
+
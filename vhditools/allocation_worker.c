@@ -0,0 +1,620 @@
+/*
+ * Allocation worker
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "allocation_statistics.h"
+#include "allocation_worker.h"
+#include "vhditools_libcerror.h"
+#include "vhditools_libcnotify.h"
+#include "vhditools_libcthreads.h"
+#include "vhditools_libvhdi.h"
+
+/* Creates an allocation worker
+ * The blocks are divided over the workers in contiguous partitions in media order
+ * Make sure the value allocation_worker is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int allocation_worker_initialize(
+     allocation_worker_t **allocation_worker,
+     libvhdi_file_t *vhdi_file,
+     size64_t media_size,
+     uint32_t block_size,
+     int worker_index,
+     int number_of_workers,
+     libcerror_error_t **error )
+{
+	static char *function     = "allocation_worker_initialize";
+	uint64_t first_block      = 0;
+	uint64_t last_block       = 0;
+	uint64_t number_of_blocks = 0;
+
+	if( allocation_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( *allocation_worker != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid allocation worker value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( vhdi_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid block size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( worker_index < 0 )
+	 || ( worker_index >= number_of_workers ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid worker index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*allocation_worker = memory_allocate_structure(
+	                      allocation_worker_t );
+
+	if( *allocation_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create allocation worker.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *allocation_worker,
+	     0,
+	     sizeof( allocation_worker_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear allocation worker.",
+		 function );
+
+		memory_free(
+		 *allocation_worker );
+
+		*allocation_worker = NULL;
+
+		return( -1 );
+	}
+	if( allocation_statistics_initialize(
+	     &( ( *allocation_worker )->allocation_statistics ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create allocation statistics.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_blocks = media_size / block_size;
+
+	if( ( media_size % block_size ) != 0 )
+	{
+		number_of_blocks += 1;
+	}
+	/* Divide the remainder of the blocks over the first workers
+	 */
+	first_block = ( number_of_blocks / number_of_workers ) * worker_index;
+	last_block  = first_block + ( number_of_blocks / number_of_workers );
+
+	if( (uint64_t) worker_index < ( number_of_blocks % number_of_workers ) )
+	{
+		first_block += worker_index;
+		last_block  += worker_index + 1;
+	}
+	else
+	{
+		first_block += number_of_blocks % number_of_workers;
+		last_block  += number_of_blocks % number_of_workers;
+	}
+	( *allocation_worker )->vhdi_file          = vhdi_file;
+	( *allocation_worker )->media_size         = media_size;
+	( *allocation_worker )->block_size         = block_size;
+	( *allocation_worker )->first_block_number = first_block;
+	( *allocation_worker )->number_of_blocks   = last_block - first_block;
+
+	return( 1 );
+
+on_error:
+	if( *allocation_worker != NULL )
+	{
+		memory_free(
+		 *allocation_worker );
+
+		*allocation_worker = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an allocation worker
+ * Returns 1 if successful or -1 on error
+ */
+int allocation_worker_free(
+     allocation_worker_t **allocation_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "allocation_worker_free";
+	int result            = 1;
+
+	if( allocation_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( *allocation_worker != NULL )
+	{
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+		if( ( *allocation_worker )->thread != NULL )
+		{
+			( *allocation_worker )->abort = 1;
+
+			if( libcthreads_thread_join(
+			     &( ( *allocation_worker )->thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		/* The vhdi_file reference is freed elsewhere
+		 */
+		if( allocation_statistics_free(
+		     &( ( *allocation_worker )->allocation_statistics ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free allocation statistics.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *allocation_worker );
+
+		*allocation_worker = NULL;
+	}
+	return( result );
+}
+
+/* Signals the allocation worker to abort
+ * Returns 1 if successful or -1 on error
+ */
+int allocation_worker_signal_abort(
+     allocation_worker_t *allocation_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "allocation_worker_signal_abort";
+
+	if( allocation_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation worker.",
+		 function );
+
+		return( -1 );
+	}
+	allocation_worker->abort = 1;
+
+	return( 1 );
+}
+
+/* Scans the ranges of a specific block and adds the block to the allocation statistics
+ * Returns 1 if successful or -1 on error
+ */
+int allocation_worker_scan_block(
+     allocation_worker_t *allocation_worker,
+     uint64_t block_number,
+     libcerror_error_t **error )
+{
+	static char *function      = "allocation_worker_scan_block";
+	size64_t allocated_size    = 0;
+	size64_t parent_size       = 0;
+	size64_t sparse_size       = 0;
+	size_t range_size          = 0;
+	off64_t block_file_offset  = -1;
+	off64_t block_offset       = 0;
+	off64_t range_file_offset  = 0;
+	uint32_t block_data_offset = 0;
+	uint32_t block_data_size   = 0;
+	uint32_t range_flags       = 0;
+	int result                 = 0;
+
+	if( allocation_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_worker->block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid allocation worker - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_number >= ( allocation_worker->media_size / allocation_worker->block_size ) + 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	block_offset    = (off64_t) ( block_number * allocation_worker->block_size );
+	block_data_size = allocation_worker->block_size;
+
+	if( ( (size64_t) block_offset + block_data_size ) > allocation_worker->media_size )
+	{
+		block_data_size = (uint32_t) ( allocation_worker->media_size - (size64_t) block_offset );
+	}
+	while( block_data_offset < block_data_size )
+	{
+		result = libvhdi_file_get_block_range(
+		          allocation_worker->vhdi_file,
+		          block_number,
+		          block_data_offset,
+		          &range_file_offset,
+		          &range_size,
+		          &range_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range of block: %" PRIu64 " at offset: %" PRIu32 ".",
+			 function,
+			 block_number,
+			 block_data_offset );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( range_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid range size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( range_size > (size_t) ( block_data_size - block_data_offset ) )
+		{
+			range_size = (size_t) ( block_data_size - block_data_offset );
+		}
+		if( ( range_flags & LIBVHDI_EXTENT_FLAG_IS_PARENT ) != 0 )
+		{
+			parent_size += range_size;
+		}
+		else if( ( range_flags & LIBVHDI_EXTENT_FLAG_IS_SPARSE ) != 0 )
+		{
+			sparse_size += range_size;
+		}
+		else
+		{
+			/* The block is considered to start at the file offset of its first allocated range
+			 */
+			if( block_file_offset == -1 )
+			{
+				block_file_offset = range_file_offset - block_data_offset;
+			}
+			allocated_size += range_size;
+		}
+		block_data_offset += (uint32_t) range_size;
+	}
+	if( allocation_statistics_add_block(
+	     allocation_worker->allocation_statistics,
+	     block_offset,
+	     block_file_offset,
+	     (size64_t) block_data_size,
+	     allocated_size,
+	     sparse_size,
+	     parent_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to add block: %" PRIu64 " to allocation statistics.",
+		 function,
+		 block_number );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Scans the blocks of the worker until all blocks have been scanned or abort is signalled
+ * Returns 1 if successful or -1 on error
+ */
+int allocation_worker_run(
+     allocation_worker_t *allocation_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "allocation_worker_run";
+	uint64_t block_index  = 0;
+
+	if( allocation_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation worker.",
+		 function );
+
+		return( -1 );
+	}
+	for( block_index = 0;
+	     block_index < allocation_worker->number_of_blocks;
+	     block_index++ )
+	{
+		if( allocation_worker->abort != 0 )
+		{
+			break;
+		}
+		if( allocation_worker_scan_block(
+		     allocation_worker,
+		     allocation_worker->first_block_number + block_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to scan block: %" PRIu64 ".",
+			 function,
+			 allocation_worker->first_block_number + block_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+
+/* The allocation worker thread function
+ * Returns 1 if successful or -1 on error
+ */
+int allocation_worker_thread_function(
+     void *arguments )
+{
+	allocation_worker_t *allocation_worker = NULL;
+	libcerror_error_t *error               = NULL;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	allocation_worker = (allocation_worker_t *) arguments;
+
+	allocation_worker->result = allocation_worker_run(
+	                             allocation_worker,
+	                             &error );
+
+	if( allocation_worker->result != 1 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( allocation_worker->result );
+}
+
+/* Starts the allocation worker thread
+ * Returns 1 if successful or -1 on error
+ */
+int allocation_worker_start(
+     allocation_worker_t *allocation_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "allocation_worker_start";
+
+	if( allocation_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_worker->thread != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid allocation worker - thread value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_create(
+	     &( allocation_worker->thread ),
+	     NULL,
+	     &allocation_worker_thread_function,
+	     (void *) allocation_worker,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Waits for the allocation worker thread to finish
+ * Returns 1 if successful or -1 on error
+ */
+int allocation_worker_join(
+     allocation_worker_t *allocation_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "allocation_worker_join";
+
+	if( allocation_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_worker->thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid allocation worker - missing thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_join(
+	     &( allocation_worker->thread ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join thread.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT ) */
+
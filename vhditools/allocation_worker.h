@@ -0,0 +1,126 @@
+/*
+ * Allocation worker
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _ALLOCATION_WORKER_H )
+#define _ALLOCATION_WORKER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "allocation_statistics.h"
+#include "vhditools_libcerror.h"
+#include "vhditools_libcthreads.h"
+#include "vhditools_libvhdi.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct allocation_worker allocation_worker_t;
+
+struct allocation_worker
+{
+	/* The file
+	 */
+	libvhdi_file_t *vhdi_file;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The block size
+	 */
+	uint32_t block_size;
+
+	/* The first block number
+	 */
+	uint64_t first_block_number;
+
+	/* The number of blocks
+	 */
+	uint64_t number_of_blocks;
+
+	/* The allocation statistics
+	 */
+	allocation_statistics_t *allocation_statistics;
+
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+#endif
+
+	/* The result of the worker
+	 */
+	int result;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int allocation_worker_initialize(
+     allocation_worker_t **allocation_worker,
+     libvhdi_file_t *vhdi_file,
+     size64_t media_size,
+     uint32_t block_size,
+     int worker_index,
+     int number_of_workers,
+     libcerror_error_t **error );
+
+int allocation_worker_free(
+     allocation_worker_t **allocation_worker,
+     libcerror_error_t **error );
+
+int allocation_worker_signal_abort(
+     allocation_worker_t *allocation_worker,
+     libcerror_error_t **error );
+
+int allocation_worker_scan_block(
+     allocation_worker_t *allocation_worker,
+     uint64_t block_number,
+     libcerror_error_t **error );
+
+int allocation_worker_run(
+     allocation_worker_t *allocation_worker,
+     libcerror_error_t **error );
+
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+
+int allocation_worker_thread_function(
+     void *arguments );
+
+int allocation_worker_start(
+     allocation_worker_t *allocation_worker,
+     libcerror_error_t **error );
+
+int allocation_worker_join(
+     allocation_worker_t *allocation_worker,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _ALLOCATION_WORKER_H ) */
+
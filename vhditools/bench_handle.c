@@ -0,0 +1,2391 @@
+/*
+ * Benchmark handle
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "bench_handle.h"
+#include "bench_io_handle.h"
+#include "bench_worker.h"
+#include "byte_size_string.h"
+#include "vhditools_libbfio.h"
+#include "vhditools_libcdata.h"
+#include "vhditools_libcerror.h"
+#include "vhditools_libcpath.h"
+#include "vhditools_libvhdi.h"
+
+#define BENCH_HANDLE_NOTIFY_STREAM		stdout
+
+#define BENCH_HANDLE_MAXIMUM_IO_SIZE		( 64 * 1024 * 1024 )
+#define BENCH_HANDLE_MAXIMUM_NUMBER_OF_THREADS	256
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_system_string_decimal_copy_to_64_bit(
+     const system_character_t *string,
+     size_t string_length,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function     = "bench_handle_system_string_decimal_copy_to_64_bit";
+	size_t string_index       = 0;
+	uint64_t safe_value_64bit = 0;
+	uint8_t digit             = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( string_length == 0 )
+	 || ( string_length > 20 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid string length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	for( string_index = 0;
+	     string_index < string_length;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] < (system_character_t) '0' )
+		 || ( string[ string_index ] > (system_character_t) '9' ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value at index: %" PRIzd ".",
+			 function,
+			 string_index );
+
+			return( -1 );
+		}
+		digit = (uint8_t) ( string[ string_index ] - (system_character_t) '0' );
+
+		if( safe_value_64bit > ( ( UINT64_MAX - digit ) / 10 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		safe_value_64bit *= 10;
+		safe_value_64bit += digit;
+	}
+	*value_64bit = safe_value_64bit;
+
+	return( 1 );
+}
+
+/* Creates a benchmark handle
+ * Make sure the value bench_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_initialize(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_initialize";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid benchmark handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*bench_handle = memory_allocate_structure(
+	                 bench_handle_t );
+
+	if( *bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create benchmark handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *bench_handle,
+	     0,
+	     sizeof( bench_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear benchmark handle.",
+		 function );
+
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *bench_handle )->file_io_handles_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO handles array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *bench_handle )->bench_io_handles_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize benchmark IO handles array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *bench_handle )->files_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize files array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *bench_handle )->workers_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize workers array.",
+		 function );
+
+		goto on_error;
+	}
+	( *bench_handle )->access_pattern    = BENCH_WORKER_ACCESS_PATTERN_SEQUENTIAL;
+	( *bench_handle )->io_size           = 4096;
+	( *bench_handle )->number_of_threads = 1;
+	( *bench_handle )->duration          = 10;
+	( *bench_handle )->seed              = 1;
+	( *bench_handle )->notify_stream     = BENCH_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *bench_handle != NULL )
+	{
+		if( ( *bench_handle )->files_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *bench_handle )->files_array ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *bench_handle )->bench_io_handles_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *bench_handle )->bench_io_handles_array ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *bench_handle )->file_io_handles_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *bench_handle )->file_io_handles_array ),
+			 NULL,
+			 NULL );
+		}
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a benchmark handle
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_free(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_free";
+	int result            = 1;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_handle != NULL )
+	{
+		if( libcdata_array_free(
+		     &( ( *bench_handle )->workers_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &bench_worker_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free workers array.",
+			 function );
+
+			result = -1;
+		}
+		/* The files must be freed before the file IO handles they use
+		 */
+		if( libcdata_array_free(
+		     &( ( *bench_handle )->files_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvhdi_file_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free files array.",
+			 function );
+
+			result = -1;
+		}
+		if( libcdata_array_free(
+		     &( ( *bench_handle )->bench_io_handles_array ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free benchmark IO handles array.",
+			 function );
+
+			result = -1;
+		}
+		if( libcdata_array_free(
+		     &( ( *bench_handle )->file_io_handles_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libbfio_handle_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handles array.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *bench_handle )->basename != NULL )
+		{
+			memory_free(
+			 ( *bench_handle )->basename );
+		}
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the benchmark handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_signal_abort(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	bench_worker_t *bench_worker = NULL;
+	static char *function        = "bench_handle_signal_abort";
+	int number_of_workers        = 0;
+	int worker_index             = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->abort = 1;
+
+	if( libcdata_array_get_number_of_entries(
+	     bench_handle->workers_array,
+	     &number_of_workers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of workers.",
+		 function );
+
+		return( -1 );
+	}
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     bench_handle->workers_array,
+		     worker_index,
+		     (intptr_t **) &bench_worker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve worker: %d.",
+			 function,
+			 worker_index );
+
+			return( -1 );
+		}
+		if( bench_worker_signal_abort(
+		     bench_worker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal worker: %d to abort.",
+			 function,
+			 worker_index );
+
+			return( -1 );
+		}
+	}
+	if( bench_handle->input_file != NULL )
+	{
+		if( libvhdi_file_signal_abort(
+		     bench_handle->input_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input file to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the access pattern
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_access_pattern(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_access_pattern";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 6 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "random" ),
+		     6 ) == 0 )
+		{
+			bench_handle->access_pattern = BENCH_WORKER_ACCESS_PATTERN_RANDOM;
+			result                       = 1;
+		}
+	}
+	else if( string_length == 7 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "strided" ),
+		     7 ) == 0 )
+		{
+			bench_handle->access_pattern = BENCH_WORKER_ACCESS_PATTERN_STRIDED;
+			result                       = 1;
+		}
+	}
+	else if( string_length == 10 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "sequential" ),
+		     10 ) == 0 )
+		{
+			bench_handle->access_pattern = BENCH_WORKER_ACCESS_PATTERN_SEQUENTIAL;
+			result                       = 1;
+		}
+	}
+	return( result );
+}
+
+/* Sets the IO size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_io_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_io_size";
+	size_t string_length  = 0;
+	uint64_t size_value   = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( byte_size_string_convert(
+	     string,
+	     string_length,
+	     &size_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to determine IO size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size_value == 0 )
+	 || ( size_value > (uint64_t) BENCH_HANDLE_MAXIMUM_IO_SIZE ) )
+	{
+		return( 0 );
+	}
+	bench_handle->io_size = (size_t) size_value;
+
+	return( 1 );
+}
+
+/* Sets the stride
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_stride(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_stride";
+	size_t string_length  = 0;
+	uint64_t size_value   = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( byte_size_string_convert(
+	     string,
+	     string_length,
+	     &size_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to determine stride.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size_value == 0 )
+	 || ( size_value > (uint64_t) INT64_MAX ) )
+	{
+		return( 0 );
+	}
+	bench_handle->stride = (size64_t) size_value;
+
+	return( 1 );
+}
+
+/* Sets the number of threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_number_of_threads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( bench_handle_system_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to determine number of threads.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) BENCH_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+#else
+	if( value_64bit != 1 )
+#endif
+	{
+		return( 0 );
+	}
+	bench_handle->number_of_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the duration
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_duration(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_duration";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( bench_handle_system_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to determine duration.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) UINT32_MAX ) )
+	{
+		return( 0 );
+	}
+	bench_handle->duration = (uint32_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the seed
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_seed(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_seed";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( bench_handle_system_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to determine seed.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > (uint64_t) UINT32_MAX )
+	{
+		return( 0 );
+	}
+	bench_handle->seed = (uint32_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the basename
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_basename(
+     bench_handle_t *bench_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_basename";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->basename != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid benchmark handle - basename value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing basename.",
+		 function );
+
+		goto on_error;
+	}
+	if( basename_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid basename size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	bench_handle->basename = system_string_allocate(
+	                          basename_size );
+
+	if( bench_handle->basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create basename string.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     bench_handle->basename,
+	     basename,
+	     basename_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy basename.",
+		 function );
+
+		goto on_error;
+	}
+	bench_handle->basename[ basename_size - 1 ] = 0;
+
+	bench_handle->basename_size = basename_size;
+
+	return( 1 );
+
+on_error:
+	if( bench_handle->basename != NULL )
+	{
+		memory_free(
+		 bench_handle->basename );
+
+		bench_handle->basename = NULL;
+	}
+	bench_handle->basename_size = 0;
+
+	return( -1 );
+}
+
+/* Opens the input
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_open_input(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	libvhdi_file_t *vhdi_file              = NULL;
+	const system_character_t *basename_end = NULL;
+	static char *function                  = "bench_handle_open_input";
+	size_t basename_length                 = 0;
+	size_t filename_length                 = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->input_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid benchmark handle - input file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	basename_end = system_string_search_character_reverse(
+	                filename,
+	                (system_character_t) LIBCPATH_SEPARATOR,
+	                filename_length + 1 );
+
+	if( basename_end != NULL )
+	{
+		basename_length = (size_t) ( basename_end - filename ) + 1;
+	}
+	if( basename_length > 0 )
+	{
+		if( bench_handle_set_basename(
+		     bench_handle,
+		     filename,
+		     basename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set basename.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( bench_handle_open_file(
+	     bench_handle,
+	     filename,
+	     &vhdi_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle_open_parent(
+	     bench_handle,
+	     vhdi_file,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_file_get_media_size(
+	     vhdi_file,
+	     &( bench_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->input_file = vhdi_file;
+
+	return( 1 );
+}
+
+/* Opens a file using a benchmark IO handle that counts the reads of the file
+ * The file is managed by the benchmark handle
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_open_file(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     libvhdi_file_t **vhdi_file,
+     libcerror_error_t **error )
+{
+	bench_io_handle_t *bench_io_handle = NULL;
+	libbfio_handle_t *file_io_handle   = NULL;
+	libvhdi_file_t *safe_vhdi_file     = NULL;
+	static char *function              = "bench_handle_open_file";
+	int entry_index                    = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( vhdi_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_io_handle_initialize_file_io_handle(
+	     &file_io_handle,
+	     &bench_io_handle,
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvhdi_file_initialize(
+	     &safe_vhdi_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvhdi_file_open_file_io_handle(
+	     safe_vhdi_file,
+	     file_io_handle,
+	     LIBVHDI_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( libcdata_array_append_entry(
+	     bench_handle->file_io_handles_array,
+	     &entry_index,
+	     (intptr_t *) file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append file IO handle to array.",
+		 function );
+
+		goto on_error;
+	}
+	file_io_handle = NULL;
+
+	if( libcdata_array_append_entry(
+	     bench_handle->bench_io_handles_array,
+	     &entry_index,
+	     (intptr_t *) bench_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append benchmark IO handle to array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_append_entry(
+	     bench_handle->files_array,
+	     &entry_index,
+	     (intptr_t *) safe_vhdi_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append file to array.",
+		 function );
+
+		goto on_error;
+	}
+	*vhdi_file = safe_vhdi_file;
+
+	return( 1 );
+
+on_error:
+	if( safe_vhdi_file != NULL )
+	{
+		libvhdi_file_free(
+		 &safe_vhdi_file,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens a parent file
+ * The parent file is managed by the benchmark handle
+ * Returns 1 if successful, 0 if no parent or -1 on error
+ */
+int bench_handle_open_parent(
+     bench_handle_t *bench_handle,
+     libvhdi_file_t *vhdi_file,
+     libcerror_error_t **error )
+{
+	uint8_t guid[ 16 ];
+
+	libvhdi_file_t *parent_vhdi_file              = NULL;
+	const system_character_t *parent_basename_end = NULL;
+	system_character_t *parent_filename           = NULL;
+	system_character_t *parent_path               = NULL;
+	system_character_t *vhdi_parent_path          = NULL;
+	static char *function                         = "bench_handle_open_parent";
+	size_t parent_basename_length                 = 0;
+	size_t parent_filename_size                   = 0;
+	size_t parent_path_size                       = 0;
+	int result                                    = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvhdi_file_get_parent_identifier(
+	          vhdi_file,
+	          guid,
+	          16,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent content identifier.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 1 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvhdi_file_get_utf16_parent_filename_size(
+	          vhdi_file,
+	          &parent_filename_size,
+	          error );
+#else
+	result = libvhdi_file_get_utf8_parent_filename_size(
+	          vhdi_file,
+	          &parent_filename_size,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( parent_filename_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( parent_filename_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid parent filename size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	parent_filename = system_string_allocate(
+	                   parent_filename_size );
+
+	if( parent_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parent filename string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvhdi_file_get_utf16_parent_filename(
+	          vhdi_file,
+	          (uint16_t *) parent_filename,
+	          parent_filename_size,
+	          error );
+#else
+	result = libvhdi_file_get_utf8_parent_filename(
+	          vhdi_file,
+	          (uint8_t *) parent_filename,
+	          parent_filename_size,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	parent_basename_end = system_string_search_character_reverse(
+	                       parent_filename,
+	                       (system_character_t) '\\',
+	                       parent_filename_size );
+
+	if( parent_basename_end != NULL )
+	{
+		parent_basename_length = (size_t) ( parent_basename_end - parent_filename ) + 1;
+	}
+	if( bench_handle->basename == NULL )
+	{
+		vhdi_parent_path = &( parent_filename[ parent_basename_length ] );
+	}
+	else
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcpath_path_join_wide(
+		     &parent_path,
+		     &parent_path_size,
+		     bench_handle->basename,
+		     bench_handle->basename_size - 1,
+		     &( parent_filename[ parent_basename_length ] ),
+		     parent_filename_size - ( parent_basename_length + 1 ),
+		     error ) != 1 )
+#else
+		if( libcpath_path_join(
+		     &parent_path,
+		     &parent_path_size,
+		     bench_handle->basename,
+		     bench_handle->basename_size - 1,
+		     &( parent_filename[ parent_basename_length ] ),
+		     parent_filename_size - ( parent_basename_length + 1 ),
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create parent path.",
+			 function );
+
+			goto on_error;
+		}
+		vhdi_parent_path = parent_path;
+	}
+	if( bench_handle_open_file(
+	     bench_handle,
+	     vhdi_parent_path,
+	     &parent_vhdi_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent file: %" PRIs_SYSTEM ".",
+		 function,
+		 vhdi_parent_path );
+
+		goto on_error;
+	}
+	if( bench_handle_open_parent(
+	     bench_handle,
+	     parent_vhdi_file,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent file: %" PRIs_SYSTEM ".",
+		 function,
+		 vhdi_parent_path );
+
+		goto on_error;
+	}
+	if( libvhdi_file_set_parent_file(
+	     vhdi_file,
+	     parent_vhdi_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set parent file.",
+		 function );
+
+		goto on_error;
+	}
+	if( parent_path != NULL )
+	{
+		memory_free(
+		 parent_path );
+
+		parent_path = NULL;
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+
+		parent_filename = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( parent_path != NULL )
+	{
+		memory_free(
+		 parent_path );
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+	}
+	return( -1 );
+}
+
+/* Closes the benchmark handle
+ * Returns the 0 if successful or -1 on error
+ */
+int bench_handle_close(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	libvhdi_file_t *vhdi_file = NULL;
+	static char *function     = "bench_handle_close";
+	int file_index            = 0;
+	int number_of_files       = 0;
+	int result                = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     bench_handle->files_array,
+	     &number_of_files,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of files.",
+		 function );
+
+		return( -1 );
+	}
+	/* The files are closed from the input file towards its last parent
+	 */
+	for( file_index = 0;
+	     file_index < number_of_files;
+	     file_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     bench_handle->files_array,
+		     file_index,
+		     (intptr_t **) &vhdi_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file: %d.",
+			 function,
+			 file_index );
+
+			result = -1;
+
+			continue;
+		}
+		if( libvhdi_file_close(
+		     vhdi_file,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file: %d.",
+			 function,
+			 file_index );
+
+			result = -1;
+		}
+	}
+	bench_handle->input_file = NULL;
+
+	if( libcdata_array_empty(
+	     bench_handle->files_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libvhdi_file_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty files array.",
+		 function );
+
+		result = -1;
+	}
+	if( libcdata_array_empty(
+	     bench_handle->bench_io_handles_array,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty benchmark IO handles array.",
+		 function );
+
+		result = -1;
+	}
+	if( libcdata_array_empty(
+	     bench_handle->file_io_handles_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libbfio_handle_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty file IO handles array.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Retrieves the number of reads and bytes read of the underlying files
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_get_file_reads(
+     bench_handle_t *bench_handle,
+     uint64_t *number_of_reads,
+     uint64_t *number_of_bytes_read,
+     libcerror_error_t **error )
+{
+	bench_io_handle_t *bench_io_handle = NULL;
+	static char *function              = "bench_handle_get_file_reads";
+	uint64_t safe_number_of_bytes_read = 0;
+	uint64_t safe_number_of_reads      = 0;
+	int entry_index                    = 0;
+	int number_of_entries              = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_reads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of reads.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_bytes_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of bytes read.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     bench_handle->bench_io_handles_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of benchmark IO handles.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     bench_handle->bench_io_handles_array,
+		     entry_index,
+		     (intptr_t **) &bench_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve benchmark IO handle: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( bench_io_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing benchmark IO handle: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		safe_number_of_reads      += bench_io_handle->number_of_reads;
+		safe_number_of_bytes_read += bench_io_handle->number_of_bytes_read;
+	}
+	*number_of_reads      = safe_number_of_reads;
+	*number_of_bytes_read = safe_number_of_bytes_read;
+
+	return( 1 );
+}
+
+/* Runs the benchmark
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_run(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	bench_worker_t *bench_worker        = NULL;
+	static char *function               = "bench_handle_run";
+	size64_t stride                     = 0;
+	uint64_t end_timestamp              = 0;
+	uint64_t number_of_file_bytes_read  = 0;
+	uint64_t number_of_file_reads       = 0;
+	uint64_t start_number_of_bytes_read = 0;
+	uint64_t start_number_of_reads      = 0;
+	uint64_t start_timestamp            = 0;
+	int bucket_index                    = 0;
+	int entry_index                     = 0;
+	int worker_index                    = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->input_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid benchmark handle - missing input file.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) bench_handle->io_size > bench_handle->media_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid benchmark handle - IO size value exceeds media size.",
+		 function );
+
+		return( -1 );
+	}
+	stride = bench_handle->stride;
+
+	if( stride == 0 )
+	{
+		stride = (size64_t) bench_handle->io_size * 4;
+	}
+	for( worker_index = 0;
+	     worker_index < bench_handle->number_of_threads;
+	     worker_index++ )
+	{
+		if( bench_worker_initialize(
+		     &bench_worker,
+		     bench_handle->input_file,
+		     bench_handle->media_size,
+		     bench_handle->access_pattern,
+		     bench_handle->io_size,
+		     stride,
+		     worker_index,
+		     bench_handle->number_of_threads,
+		     bench_handle->seed,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     bench_handle->workers_array,
+		     &entry_index,
+		     (intptr_t *) bench_worker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append worker: %d to array.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		bench_worker = NULL;
+	}
+	if( bench_handle_get_file_reads(
+	     bench_handle,
+	     &start_number_of_reads,
+	     &start_number_of_bytes_read,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file reads.",
+		 function );
+
+		goto on_error;
+	}
+	if( bench_worker_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	end_timestamp = start_timestamp + ( (uint64_t) bench_handle->duration * 1000000000 );
+
+	for( worker_index = 0;
+	     worker_index < bench_handle->number_of_threads;
+	     worker_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     bench_handle->workers_array,
+		     worker_index,
+		     (intptr_t **) &bench_worker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve worker: %d.",
+			 function,
+			 worker_index );
+
+			bench_worker = NULL;
+
+			goto on_error;
+		}
+		bench_worker->end_timestamp = end_timestamp;
+		bench_worker->abort         = bench_handle->abort;
+
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+		if( bench_worker_start(
+		     bench_worker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start worker: %d.",
+			 function,
+			 worker_index );
+
+			bench_worker = NULL;
+
+			goto on_error;
+		}
+#else
+		bench_worker->result = bench_worker_run(
+		                        bench_worker,
+		                        error );
+
+		if( bench_worker->result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to run worker: %d.",
+			 function,
+			 worker_index );
+
+			bench_worker = NULL;
+
+			goto on_error;
+		}
+#endif
+	}
+	bench_worker = NULL;
+
+	if( libcdata_array_get_number_of_entries(
+	     bench_handle->workers_array,
+	     &entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of workers.",
+		 function );
+
+		goto on_error;
+	}
+	bench_handle->number_of_reads      = 0;
+	bench_handle->number_of_bytes_read = 0;
+	bench_handle->maximum_latency      = 0;
+
+	if( memory_set(
+	     bench_handle->latency_histogram,
+	     0,
+	     sizeof( uint64_t ) * BENCH_WORKER_NUMBER_OF_LATENCY_BUCKETS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear latency histogram.",
+		 function );
+
+		goto on_error;
+	}
+	for( worker_index = 0;
+	     worker_index < bench_handle->number_of_threads;
+	     worker_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     bench_handle->workers_array,
+		     worker_index,
+		     (intptr_t **) &bench_worker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve worker: %d.",
+			 function,
+			 worker_index );
+
+			bench_worker = NULL;
+
+			goto on_error;
+		}
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+		if( bench_worker_join(
+		     bench_worker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join worker: %d.",
+			 function,
+			 worker_index );
+
+			bench_worker = NULL;
+
+			goto on_error;
+		}
+		if( bench_worker->result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: worker: %d failed.",
+			 function,
+			 worker_index );
+
+			bench_worker = NULL;
+
+			goto on_error;
+		}
+#endif
+		for( bucket_index = 0;
+		     bucket_index < BENCH_WORKER_NUMBER_OF_LATENCY_BUCKETS;
+		     bucket_index++ )
+		{
+			bench_handle->latency_histogram[ bucket_index ] += bench_worker->latency_histogram[ bucket_index ];
+		}
+		if( bench_worker->maximum_latency > bench_handle->maximum_latency )
+		{
+			bench_handle->maximum_latency = bench_worker->maximum_latency;
+		}
+		bench_handle->number_of_reads      += bench_worker->number_of_reads;
+		bench_handle->number_of_bytes_read += bench_worker->number_of_bytes_read;
+	}
+	bench_worker = NULL;
+
+	if( bench_worker_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	bench_handle->elapsed_time = end_timestamp - start_timestamp;
+
+	if( bench_handle_get_file_reads(
+	     bench_handle,
+	     &number_of_file_reads,
+	     &number_of_file_bytes_read,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file reads.",
+		 function );
+
+		goto on_error;
+	}
+	bench_handle->number_of_file_reads      = number_of_file_reads - start_number_of_reads;
+	bench_handle->number_of_file_bytes_read = number_of_file_bytes_read - start_number_of_bytes_read;
+
+	if( libcdata_array_empty(
+	     bench_handle->workers_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &bench_worker_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty workers array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( bench_worker != NULL )
+	{
+		bench_worker_free(
+		 &bench_worker,
+		 NULL );
+	}
+	/* Freeing the workers signals the running worker threads to abort and joins them
+	 */
+	libcdata_array_empty(
+	 bench_handle->workers_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &bench_worker_free,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Retrieves a latency percentile
+ * The percentile is expressed in 1/1000th of a percent, for example 99900 for p99.9
+ * The latency is the upper bound of the latency histogram bucket that contains the percentile
+ * Returns 1 if successful, 0 if no reads were measured or -1 on error
+ */
+int bench_handle_get_latency_percentile(
+     bench_handle_t *bench_handle,
+     uint32_t percentile,
+     uint64_t *latency,
+     libcerror_error_t **error )
+{
+	static char *function    = "bench_handle_get_latency_percentile";
+	uint64_t lower_bound     = 0;
+	uint64_t number_of_reads = 0;
+	uint64_t percentile_rank = 0;
+	uint64_t upper_bound     = 0;
+	int bucket_index         = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( percentile == 0 )
+	 || ( percentile > 100000 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid percentile value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( latency == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid latency.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->number_of_reads == 0 )
+	{
+		return( 0 );
+	}
+	/* The rank is rounded up so that p100 corresponds to the last read
+	 */
+	percentile_rank = ( ( bench_handle->number_of_reads / 100000 ) * percentile )
+	                + ( ( ( bench_handle->number_of_reads % 100000 ) * percentile ) + 99999 ) / 100000;
+
+	for( bucket_index = 0;
+	     bucket_index < BENCH_WORKER_NUMBER_OF_LATENCY_BUCKETS;
+	     bucket_index++ )
+	{
+		number_of_reads += bench_handle->latency_histogram[ bucket_index ];
+
+		if( number_of_reads >= percentile_rank )
+		{
+			break;
+		}
+	}
+	if( bucket_index >= BENCH_WORKER_NUMBER_OF_LATENCY_BUCKETS )
+	{
+		bucket_index = BENCH_WORKER_NUMBER_OF_LATENCY_BUCKETS - 1;
+	}
+	if( bench_worker_get_latency_bucket_range(
+	     bucket_index,
+	     &lower_bound,
+	     &upper_bound,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve latency bucket: %d range.",
+		 function,
+		 bucket_index );
+
+		return( -1 );
+	}
+	if( upper_bound > bench_handle->maximum_latency )
+	{
+		upper_bound = bench_handle->maximum_latency;
+	}
+	*latency = upper_bound;
+
+	return( 1 );
+}
+
+/* Prints the benchmark results
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_results_fprint(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	const char *access_pattern_string = NULL;
+	static char *function             = "bench_handle_results_fprint";
+	double elapsed_time               = 0.0;
+	uint64_t latency                  = 0;
+	int result                        = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	switch( bench_handle->access_pattern )
+	{
+		case BENCH_WORKER_ACCESS_PATTERN_RANDOM:
+			access_pattern_string = "random";
+			break;
+
+		case BENCH_WORKER_ACCESS_PATTERN_SEQUENTIAL:
+			access_pattern_string = "sequential";
+			break;
+
+		case BENCH_WORKER_ACCESS_PATTERN_STRIDED:
+			access_pattern_string = "strided";
+			break;
+
+		default:
+			access_pattern_string = "unknown";
+			break;
+	}
+	elapsed_time = (double) bench_handle->elapsed_time / 1000000000.0;
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "Benchmark results:\n" );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tAccess pattern\t\t: %s\n",
+	 access_pattern_string );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tIO size\t\t\t: %" PRIzd " bytes\n",
+	 bench_handle->io_size );
+
+	if( bench_handle->access_pattern == BENCH_WORKER_ACCESS_PATTERN_STRIDED )
+	{
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tStride\t\t\t: %" PRIu64 " bytes\n",
+		 ( bench_handle->stride != 0 ) ? bench_handle->stride : (size64_t) bench_handle->io_size * 4 );
+	}
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tNumber of threads\t: %d\n",
+	 bench_handle->number_of_threads );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tElapsed time\t\t: %.3f seconds\n",
+	 elapsed_time );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tNumber of reads\t\t: %" PRIu64 "\n",
+	 bench_handle->number_of_reads );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tBytes read\t\t: %" PRIu64 " bytes\n",
+	 bench_handle->number_of_bytes_read );
+
+	if( elapsed_time > 0.0 )
+	{
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tThroughput\t\t: %.1f MiB/s\n",
+		 (double) bench_handle->number_of_bytes_read / ( elapsed_time * 1048576.0 ) );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tIOPS\t\t\t: %.0f\n",
+		 (double) bench_handle->number_of_reads / elapsed_time );
+	}
+	result = bench_handle_get_latency_percentile(
+	          bench_handle,
+	          50000,
+	          &latency,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve p50 latency.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tLatency p50\t\t: %.1f us\n",
+		 (double) latency / 1000.0 );
+
+		if( bench_handle_get_latency_percentile(
+		     bench_handle,
+		     99000,
+		     &latency,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve p99 latency.",
+			 function );
+
+			return( -1 );
+		}
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tLatency p99\t\t: %.1f us\n",
+		 (double) latency / 1000.0 );
+
+		if( bench_handle_get_latency_percentile(
+		     bench_handle,
+		     99900,
+		     &latency,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve p99.9 latency.",
+			 function );
+
+			return( -1 );
+		}
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tLatency p99.9\t\t: %.1f us\n",
+		 (double) latency / 1000.0 );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tLatency maximum\t\t: %.1f us\n",
+		 (double) bench_handle->maximum_latency / 1000.0 );
+	}
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tFile reads\t\t: %" PRIu64 "\n",
+	 bench_handle->number_of_file_reads );
+
+	if( bench_handle->number_of_reads > 0 )
+	{
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tFile reads per read\t: %.2f\n",
+		 (double) bench_handle->number_of_file_reads / (double) bench_handle->number_of_reads );
+	}
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tFile bytes read\t\t: %" PRIu64 " bytes\n",
+	 bench_handle->number_of_file_bytes_read );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
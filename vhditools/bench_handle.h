@@ -0,0 +1,235 @@
+/*
+ * Benchmark handle
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BENCH_HANDLE_H )
+#define _BENCH_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "bench_worker.h"
+#include "vhditools_libcdata.h"
+#include "vhditools_libcerror.h"
+#include "vhditools_libvhdi.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct bench_handle bench_handle_t;
+
+struct bench_handle
+{
+	/* The basename
+	 */
+	system_character_t *basename;
+
+	/* The basename size
+	 */
+	size_t basename_size;
+
+	/* The file IO handles array
+	 */
+	libcdata_array_t *file_io_handles_array;
+
+	/* The benchmark IO handles array
+	 * The benchmark IO handles are managed by the file IO handles
+	 */
+	libcdata_array_t *bench_io_handles_array;
+
+	/* The files array
+	 */
+	libcdata_array_t *files_array;
+
+	/* The input file
+	 */
+	libvhdi_file_t *input_file;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The access pattern
+	 */
+	int access_pattern;
+
+	/* The IO size
+	 */
+	size_t io_size;
+
+	/* The stride
+	 */
+	size64_t stride;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The duration in seconds
+	 */
+	uint32_t duration;
+
+	/* The seed
+	 */
+	uint32_t seed;
+
+	/* The workers array
+	 */
+	libcdata_array_t *workers_array;
+
+	/* The elapsed time in nano seconds
+	 */
+	uint64_t elapsed_time;
+
+	/* The number of reads
+	 */
+	uint64_t number_of_reads;
+
+	/* The number of bytes read
+	 */
+	uint64_t number_of_bytes_read;
+
+	/* The number of reads of the underlying files
+	 */
+	uint64_t number_of_file_reads;
+
+	/* The number of bytes read of the underlying files
+	 */
+	uint64_t number_of_file_bytes_read;
+
+	/* The maximum latency in nano seconds
+	 */
+	uint64_t maximum_latency;
+
+	/* The latency histogram
+	 */
+	uint64_t latency_histogram[ BENCH_WORKER_NUMBER_OF_LATENCY_BUCKETS ];
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int bench_handle_system_string_decimal_copy_to_64_bit(
+     const system_character_t *string,
+     size_t string_length,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
+int bench_handle_initialize(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_free(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_signal_abort(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_set_access_pattern(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_io_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_stride(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_number_of_threads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_duration(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_seed(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_basename(
+     bench_handle_t *bench_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error );
+
+int bench_handle_open_input(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int bench_handle_open_file(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     libvhdi_file_t **vhdi_file,
+     libcerror_error_t **error );
+
+int bench_handle_open_parent(
+     bench_handle_t *bench_handle,
+     libvhdi_file_t *vhdi_file,
+     libcerror_error_t **error );
+
+int bench_handle_close(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_get_file_reads(
+     bench_handle_t *bench_handle,
+     uint64_t *number_of_reads,
+     uint64_t *number_of_bytes_read,
+     libcerror_error_t **error );
+
+int bench_handle_run(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_get_latency_percentile(
+     bench_handle_t *bench_handle,
+     uint32_t percentile,
+     uint64_t *latency,
+     libcerror_error_t **error );
+
+int bench_handle_results_fprint(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BENCH_HANDLE_H ) */
+
@@ -0,0 +1,1169 @@
+/*
+ * Synthetic benchmark image functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "bench_image.h"
+#include "vhditools_libbfio.h"
+#include "vhditools_libcerror.h"
+#include "vhditools_libcpath.h"
+#include "vhditools_libvhdi.h"
+
+/* Generates a synthetic image
+ * A differential image is generated together with a dynamic parent image
+ * named BENCH_IMAGE_PARENT_FILENAME in the same directory
+ * Returns 1 if successful or -1 on error
+ */
+int bench_image_generate(
+     const system_character_t *filename,
+     uint32_t disk_type,
+     size64_t media_size,
+     uint32_t seed,
+     libcerror_error_t **error )
+{
+	uint8_t identifier[ 16 ];
+	uint8_t parent_identifier[ 16 ];
+
+	const system_character_t *dirname_end = NULL;
+	system_character_t *parent_path       = NULL;
+	static char *function                 = "bench_image_generate";
+	size_t dirname_length                 = 0;
+	size_t filename_length                = 0;
+	size_t parent_path_size               = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( disk_type != LIBVHDI_DISK_TYPE_FIXED )
+	 && ( disk_type != LIBVHDI_DISK_TYPE_DYNAMIC )
+	 && ( disk_type != LIBVHDI_DISK_TYPE_DIFFERENTIAL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported disk type: 0x%08" PRIx32 ".",
+		 function,
+		 disk_type );
+
+		return( -1 );
+	}
+	if( ( media_size == 0 )
+	 || ( ( media_size % 512 ) != 0 )
+	 || ( media_size > (size64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_image_get_identifier(
+	     identifier,
+	     16,
+	     seed,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( disk_type == LIBVHDI_DISK_TYPE_DIFFERENTIAL )
+	{
+		if( bench_image_get_identifier(
+		     parent_identifier,
+		     16,
+		     seed,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent identifier.",
+			 function );
+
+			goto on_error;
+		}
+		filename_length = system_string_length(
+		                   filename );
+
+		dirname_end = system_string_search_character_reverse(
+		               filename,
+		               (system_character_t) LIBCPATH_SEPARATOR,
+		               filename_length + 1 );
+
+		if( dirname_end != NULL )
+		{
+			dirname_length = (size_t) ( dirname_end - filename );
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcpath_path_join_wide(
+		     &parent_path,
+		     &parent_path_size,
+		     filename,
+		     dirname_length,
+		     _SYSTEM_STRING( BENCH_IMAGE_PARENT_FILENAME ),
+		     sizeof( BENCH_IMAGE_PARENT_FILENAME ) - 1,
+		     error ) != 1 )
+#else
+		if( libcpath_path_join(
+		     &parent_path,
+		     &parent_path_size,
+		     filename,
+		     dirname_length,
+		     _SYSTEM_STRING( BENCH_IMAGE_PARENT_FILENAME ),
+		     sizeof( BENCH_IMAGE_PARENT_FILENAME ) - 1,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create parent path.",
+			 function );
+
+			goto on_error;
+		}
+		if( bench_image_generate_file(
+		     parent_path,
+		     LIBVHDI_DISK_TYPE_DYNAMIC,
+		     media_size,
+		     parent_identifier,
+		     NULL,
+		     seed + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to generate parent image: %" PRIs_SYSTEM ".",
+			 function,
+			 parent_path );
+
+			goto on_error;
+		}
+		memory_free(
+		 parent_path );
+
+		parent_path = NULL;
+	}
+	if( bench_image_generate_file(
+	     filename,
+	     disk_type,
+	     media_size,
+	     identifier,
+	     ( disk_type == LIBVHDI_DISK_TYPE_DIFFERENTIAL ) ? parent_identifier : NULL,
+	     seed,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to generate image: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( parent_path != NULL )
+	{
+		memory_free(
+		 parent_path );
+	}
+	return( -1 );
+}
+
+/* Generates a synthetic image file
+ * Returns 1 if successful or -1 on error
+ */
+int bench_image_generate_file(
+     const system_character_t *filename,
+     uint32_t disk_type,
+     size64_t media_size,
+     const uint8_t *identifier,
+     const uint8_t *parent_identifier,
+     uint32_t seed,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "bench_image_generate_file";
+	uint64_t block_table_offset      = 1536;
+	uint64_t next_offset             = 0xffffffffffffffffULL;
+	uint32_t number_of_blocks        = 0;
+	size_t filename_length           = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( media_size / BENCH_IMAGE_BLOCK_SIZE ) >= (size64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid media size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( disk_type == LIBVHDI_DISK_TYPE_FIXED )
+	{
+		if( bench_image_write_fixed_data(
+		     file_io_handle,
+		     media_size,
+		     seed,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write fixed data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		number_of_blocks = (uint32_t) ( media_size / BENCH_IMAGE_BLOCK_SIZE );
+
+		if( ( media_size % BENCH_IMAGE_BLOCK_SIZE ) != 0 )
+		{
+			number_of_blocks += 1;
+		}
+		next_offset = 512;
+
+		/* The copy of the file footer
+		 */
+		if( bench_image_write_file_footer(
+		     file_io_handle,
+		     disk_type,
+		     media_size,
+		     next_offset,
+		     identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write copy of file footer.",
+			 function );
+
+			goto on_error;
+		}
+		if( bench_image_write_dynamic_disk_header(
+		     file_io_handle,
+		     block_table_offset,
+		     number_of_blocks,
+		     parent_identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write dynamic disk header.",
+			 function );
+
+			goto on_error;
+		}
+		if( bench_image_write_sparse_data(
+		     file_io_handle,
+		     disk_type,
+		     block_table_offset,
+		     number_of_blocks,
+		     seed,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write sparse data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( bench_image_write_file_footer(
+	     file_io_handle,
+	     disk_type,
+	     media_size,
+	     next_offset,
+	     identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file footer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves a reproducible identifier
+ * The generation distinguishes the identifiers of the images in a chain
+ * Returns 1 if successful or -1 on error
+ */
+int bench_image_get_identifier(
+     uint8_t *identifier,
+     size_t identifier_size,
+     uint32_t seed,
+     uint8_t generation,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_image_get_identifier";
+
+	if( identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( identifier_size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid identifier size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_image_fill_data(
+	     identifier,
+	     16,
+	     (uint64_t) generation << 56,
+	     seed,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to fill identifier.",
+		 function );
+
+		return( -1 );
+	}
+	/* Mark the identifier as a random based (version 4) GUID
+	 */
+	identifier[ 6 ] = ( identifier[ 6 ] & 0x0f ) | 0x40;
+	identifier[ 8 ] = ( identifier[ 8 ] & 0x3f ) | 0x80;
+
+	return( 1 );
+}
+
+/* Fills data with a reproducible pattern that depends on the media offset and the seed
+ * Returns 1 if successful or -1 on error
+ */
+int bench_image_fill_data(
+     uint8_t *data,
+     size_t data_size,
+     uint64_t media_offset,
+     uint32_t seed,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_image_fill_data";
+	size_t data_offset    = 0;
+	uint64_t value_64bit  = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size > (size_t) SSIZE_MAX )
+	 || ( ( data_size % 8 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset += 8 )
+	{
+		/* Use the splitmix64 finalizer so that every 64-bit value differs
+		 */
+		value_64bit  = ( ( media_offset + data_offset ) ^ ( (uint64_t) seed << 32 ) ) + 0x9e3779b97f4a7c15ULL;
+		value_64bit  = ( value_64bit ^ ( value_64bit >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+		value_64bit  = ( value_64bit ^ ( value_64bit >> 27 ) ) * 0x94d049bb133111ebULL;
+		value_64bit ^= value_64bit >> 31;
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( data[ data_offset ] ),
+		 value_64bit );
+	}
+	return( 1 );
+}
+
+/* Writes a file footer at the current offset
+ * Returns 1 if successful or -1 on error
+ */
+int bench_image_write_file_footer(
+     libbfio_handle_t *file_io_handle,
+     uint32_t disk_type,
+     size64_t media_size,
+     uint64_t next_offset,
+     const uint8_t *identifier,
+     libcerror_error_t **error )
+{
+	uint8_t file_footer_data[ 512 ];
+
+	static char *function = "bench_image_write_file_footer";
+	size_t data_offset    = 0;
+	ssize_t write_count   = 0;
+	uint32_t checksum     = 0;
+
+	if( identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     file_footer_data,
+	     0,
+	     512 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file footer data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     file_footer_data,
+	     "conectix",
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		return( -1 );
+	}
+	/* The features contain the reserved flag which is always set
+	 */
+	byte_stream_copy_from_uint32_big_endian(
+	 &( file_footer_data[ 8 ] ),
+	 0x00000002UL );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( file_footer_data[ 12 ] ),
+	 0x00010000UL );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( file_footer_data[ 16 ] ),
+	 next_offset );
+
+	/* The modification time is left 0 so that the image is reproducible
+	 */
+	if( memory_copy(
+	     &( file_footer_data[ 28 ] ),
+	     "vhdi",
+	     4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy creator application.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( file_footer_data[ 32 ] ),
+	 0x00010000UL );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( file_footer_data[ 40 ] ),
+	 media_size );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( file_footer_data[ 48 ] ),
+	 media_size );
+
+	/* The disk geometry is not used to read the image and is left 0
+	 */
+	byte_stream_copy_from_uint32_big_endian(
+	 &( file_footer_data[ 60 ] ),
+	 disk_type );
+
+	if( memory_copy(
+	     &( file_footer_data[ 68 ] ),
+	     identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy identifier.",
+		 function );
+
+		return( -1 );
+	}
+	for( data_offset = 0;
+	     data_offset < 512;
+	     data_offset++ )
+	{
+		checksum += file_footer_data[ data_offset ];
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( file_footer_data[ 64 ] ),
+	 ~checksum );
+
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               file_footer_data,
+	               512,
+	               error );
+
+	if( write_count != (ssize_t) 512 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file footer data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes a dynamic disk header at the current offset
+ * The parent identifier is only set for a differential image
+ * Returns 1 if successful or -1 on error
+ */
+int bench_image_write_dynamic_disk_header(
+     libbfio_handle_t *file_io_handle,
+     uint64_t block_table_offset,
+     uint32_t number_of_blocks,
+     const uint8_t *parent_identifier,
+     libcerror_error_t **error )
+{
+	uint8_t dynamic_disk_header_data[ 1024 ];
+
+	const char *parent_filename = BENCH_IMAGE_PARENT_FILENAME;
+	static char *function       = "bench_image_write_dynamic_disk_header";
+	size_t data_offset          = 0;
+	ssize_t write_count         = 0;
+	uint32_t checksum           = 0;
+
+	if( memory_set(
+	     dynamic_disk_header_data,
+	     0,
+	     1024 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear dynamic disk header data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     dynamic_disk_header_data,
+	     "cxsparse",
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( dynamic_disk_header_data[ 8 ] ),
+	 0xffffffffffffffffULL );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( dynamic_disk_header_data[ 16 ] ),
+	 block_table_offset );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( dynamic_disk_header_data[ 24 ] ),
+	 0x00010000UL );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( dynamic_disk_header_data[ 28 ] ),
+	 number_of_blocks );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( dynamic_disk_header_data[ 32 ] ),
+	 BENCH_IMAGE_BLOCK_SIZE );
+
+	if( parent_identifier != NULL )
+	{
+		if( memory_copy(
+		     &( dynamic_disk_header_data[ 40 ] ),
+		     parent_identifier,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy parent identifier.",
+			 function );
+
+			return( -1 );
+		}
+		/* The parent filename is stored as an UTF-16 big-endian string
+		 */
+		for( data_offset = 0;
+		     parent_filename[ data_offset ] != 0;
+		     data_offset++ )
+		{
+			dynamic_disk_header_data[ 64 + ( data_offset * 2 ) + 1 ] = (uint8_t) parent_filename[ data_offset ];
+		}
+	}
+	for( data_offset = 0;
+	     data_offset < 1024;
+	     data_offset++ )
+	{
+		checksum += dynamic_disk_header_data[ data_offset ];
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( dynamic_disk_header_data[ 36 ] ),
+	 ~checksum );
+
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               dynamic_disk_header_data,
+	               1024,
+	               error );
+
+	if( write_count != (ssize_t) 1024 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write dynamic disk header data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes the data of a fixed image at the current offset
+ * Returns 1 if successful or -1 on error
+ */
+int bench_image_write_fixed_data(
+     libbfio_handle_t *file_io_handle,
+     size64_t media_size,
+     uint32_t seed,
+     libcerror_error_t **error )
+{
+	uint8_t *data         = NULL;
+	static char *function = "bench_image_write_fixed_data";
+	size64_t media_offset = 0;
+	size_t data_size      = 0;
+	ssize_t write_count   = 0;
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * BENCH_IMAGE_BLOCK_SIZE );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	while( media_offset < media_size )
+	{
+		data_size = BENCH_IMAGE_BLOCK_SIZE;
+
+		if( data_size > ( media_size - media_offset ) )
+		{
+			data_size = (size_t) ( media_size - media_offset );
+		}
+		if( bench_image_fill_data(
+		     data,
+		     data_size,
+		     media_offset,
+		     seed,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill data.",
+			 function );
+
+			goto on_error;
+		}
+		write_count = libbfio_handle_write_buffer(
+		               file_io_handle,
+		               data,
+		               data_size,
+		               error );
+
+		if( write_count != (ssize_t) data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data at media offset: %" PRIu64 " (0x%08" PRIx64 ").",
+			 function,
+			 media_offset,
+			 media_offset );
+
+			goto on_error;
+		}
+		media_offset += data_size;
+	}
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
+/* Writes the block allocation table and the blocks of a dynamic or differential image at the current offset
+ * A dynamic image has every other block allocated, which makes the other blocks sparse
+ * A differential image has every block allocated, of which every other block only contains
+ * every other run of 8 sectors, which makes the other runs resolve to the parent image
+ * Returns 1 if successful or -1 on error
+ */
+int bench_image_write_sparse_data(
+     libbfio_handle_t *file_io_handle,
+     uint32_t disk_type,
+     uint64_t block_table_offset,
+     uint32_t number_of_blocks,
+     uint32_t seed,
+     libcerror_error_t **error )
+{
+	uint8_t sector_bitmap[ 512 ];
+
+	uint8_t *data                = NULL;
+	static char *function        = "bench_image_write_sparse_data";
+	size_t block_table_size      = 0;
+	size_t data_offset           = 0;
+	size_t data_size             = 0;
+	ssize_t write_count          = 0;
+	uint64_t block_offset        = 0;
+	uint32_t block_index         = 0;
+	uint32_t block_sector_number = 0;
+	int block_is_allocated       = 0;
+
+	if( number_of_blocks == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	block_table_size = (size_t) number_of_blocks * 4;
+
+	if( ( block_table_size % 512 ) != 0 )
+	{
+		block_table_size = ( ( block_table_size / 512 ) + 1 ) * 512;
+	}
+	if( block_table_size > (size_t) ( BENCH_IMAGE_BLOCK_SIZE * 256 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid block allocation table size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* The data buffer is used for the block allocation table and then for the block data
+	 */
+	data_size = BENCH_IMAGE_BLOCK_SIZE;
+
+	if( data_size < block_table_size )
+	{
+		data_size = block_table_size;
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     data,
+	     0xff,
+	     block_table_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block allocation table.",
+		 function );
+
+		goto on_error;
+	}
+	block_offset = block_table_offset + block_table_size;
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		if( disk_type == LIBVHDI_DISK_TYPE_DIFFERENTIAL )
+		{
+			block_is_allocated = 1;
+		}
+		else
+		{
+			block_is_allocated = (int) ( ( block_index % 2 ) == 0 );
+		}
+		if( block_is_allocated != 0 )
+		{
+			block_sector_number = (uint32_t) ( block_offset / 512 );
+
+			byte_stream_copy_from_uint32_big_endian(
+			 &( data[ block_index * 4 ] ),
+			 block_sector_number );
+
+			block_offset += 512 + BENCH_IMAGE_BLOCK_SIZE;
+		}
+	}
+	if( block_offset > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid media size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               data,
+	               block_table_size,
+	               error );
+
+	if( write_count != (ssize_t) block_table_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write block allocation table.",
+		 function );
+
+		goto on_error;
+	}
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		if( disk_type == LIBVHDI_DISK_TYPE_DIFFERENTIAL )
+		{
+			block_is_allocated = 1;
+		}
+		else
+		{
+			block_is_allocated = (int) ( ( block_index % 2 ) == 0 );
+		}
+		if( block_is_allocated == 0 )
+		{
+			continue;
+		}
+		for( data_offset = 0;
+		     data_offset < 512;
+		     data_offset++ )
+		{
+			if( ( disk_type == LIBVHDI_DISK_TYPE_DIFFERENTIAL )
+			 && ( ( block_index % 2 ) == 0 )
+			 && ( ( data_offset % 2 ) != 0 ) )
+			{
+				sector_bitmap[ data_offset ] = 0x00;
+			}
+			else
+			{
+				sector_bitmap[ data_offset ] = 0xff;
+			}
+		}
+		write_count = libbfio_handle_write_buffer(
+		               file_io_handle,
+		               sector_bitmap,
+		               512,
+		               error );
+
+		if( write_count != (ssize_t) 512 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write sector bitmap of block: %" PRIu32 ".",
+			 function,
+			 block_index );
+
+			goto on_error;
+		}
+		if( bench_image_fill_data(
+		     data,
+		     BENCH_IMAGE_BLOCK_SIZE,
+		     (uint64_t) block_index * BENCH_IMAGE_BLOCK_SIZE,
+		     seed,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill data of block: %" PRIu32 ".",
+			 function,
+			 block_index );
+
+			goto on_error;
+		}
+		write_count = libbfio_handle_write_buffer(
+		               file_io_handle,
+		               data,
+		               BENCH_IMAGE_BLOCK_SIZE,
+		               error );
+
+		if( write_count != (ssize_t) BENCH_IMAGE_BLOCK_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data of block: %" PRIu32 ".",
+			 function,
+			 block_index );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
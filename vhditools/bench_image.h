@@ -0,0 +1,107 @@
+/*
+ * Synthetic benchmark image functions
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BENCH_IMAGE_H )
+#define _BENCH_IMAGE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "vhditools_libbfio.h"
+#include "vhditools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The block size of the synthetic dynamic and differential images
+ */
+#define BENCH_IMAGE_BLOCK_SIZE			2097152
+
+/* The name of the parent image of the synthetic differential image
+ */
+#define BENCH_IMAGE_PARENT_FILENAME		"vhdibench_parent.vhd"
+
+int bench_image_generate(
+     const system_character_t *filename,
+     uint32_t disk_type,
+     size64_t media_size,
+     uint32_t seed,
+     libcerror_error_t **error );
+
+int bench_image_generate_file(
+     const system_character_t *filename,
+     uint32_t disk_type,
+     size64_t media_size,
+     const uint8_t *identifier,
+     const uint8_t *parent_identifier,
+     uint32_t seed,
+     libcerror_error_t **error );
+
+int bench_image_get_identifier(
+     uint8_t *identifier,
+     size_t identifier_size,
+     uint32_t seed,
+     uint8_t generation,
+     libcerror_error_t **error );
+
+int bench_image_fill_data(
+     uint8_t *data,
+     size_t data_size,
+     uint64_t media_offset,
+     uint32_t seed,
+     libcerror_error_t **error );
+
+int bench_image_write_file_footer(
+     libbfio_handle_t *file_io_handle,
+     uint32_t disk_type,
+     size64_t media_size,
+     uint64_t next_offset,
+     const uint8_t *identifier,
+     libcerror_error_t **error );
+
+int bench_image_write_dynamic_disk_header(
+     libbfio_handle_t *file_io_handle,
+     uint64_t block_table_offset,
+     uint32_t number_of_blocks,
+     const uint8_t *parent_identifier,
+     libcerror_error_t **error );
+
+int bench_image_write_fixed_data(
+     libbfio_handle_t *file_io_handle,
+     size64_t media_size,
+     uint32_t seed,
+     libcerror_error_t **error );
+
+int bench_image_write_sparse_data(
+     libbfio_handle_t *file_io_handle,
+     uint32_t disk_type,
+     uint64_t block_table_offset,
+     uint32_t number_of_blocks,
+     uint32_t seed,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BENCH_IMAGE_H ) */
+
@@ -0,0 +1,721 @@
+/*
+ * Benchmark IO handle, which counts the reads of a file IO handle
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "bench_io_handle.h"
+#include "vhditools_libbfio.h"
+#include "vhditools_libcerror.h"
+
+/* Creates a benchmark IO handle
+ * Make sure the value bench_io_handle is referencing, is set to NULL
+ * The benchmark IO handle takes over management of the file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int bench_io_handle_initialize(
+     bench_io_handle_t **bench_io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_io_handle_initialize";
+
+	if( bench_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid benchmark IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	*bench_io_handle = memory_allocate_structure(
+	                    bench_io_handle_t );
+
+	if( *bench_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create benchmark IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *bench_io_handle,
+	     0,
+	     sizeof( bench_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear benchmark IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *bench_io_handle )->file_io_handle = file_io_handle;
+
+	return( 1 );
+
+on_error:
+	if( *bench_io_handle != NULL )
+	{
+		memory_free(
+		 *bench_io_handle );
+
+		*bench_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Creates a file IO handle that counts the reads of a file
+ * The benchmark IO handle is managed by the file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int bench_io_handle_initialize_file_io_handle(
+     libbfio_handle_t **file_io_handle,
+     bench_io_handle_t **bench_io_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_handle = NULL;
+	static char *function         = "bench_io_handle_initialize_file_io_handle";
+	size_t filename_length        = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	if( libbfio_file_initialize(
+	     &file_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     file_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     file_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( bench_io_handle_initialize(
+	     bench_io_handle,
+	     file_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create benchmark IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	file_handle = NULL;
+
+	if( libbfio_handle_initialize(
+	     file_io_handle,
+	     (intptr_t *) *bench_io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) bench_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) bench_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) bench_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) bench_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) bench_io_handle_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) bench_io_handle_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) bench_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) bench_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) bench_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) bench_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *bench_io_handle != NULL )
+	{
+		bench_io_handle_free(
+		 bench_io_handle,
+		 NULL );
+	}
+	if( file_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a benchmark IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int bench_io_handle_free(
+     bench_io_handle_t **bench_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_io_handle_free";
+	int result            = 1;
+
+	if( bench_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_io_handle != NULL )
+	{
+		if( libbfio_handle_free(
+		     &( ( *bench_io_handle )->file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *bench_io_handle );
+
+		*bench_io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the benchmark IO handle
+ * The read counters of the destination start at 0
+ * Returns 1 if successful or -1 on error
+ */
+int bench_io_handle_clone(
+     bench_io_handle_t **destination_bench_io_handle,
+     bench_io_handle_t *source_bench_io_handle,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "bench_io_handle_clone";
+
+	if( destination_bench_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination benchmark IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_bench_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination benchmark IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_bench_io_handle == NULL )
+	{
+		*destination_bench_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libbfio_handle_clone(
+	     &file_io_handle,
+	     source_bench_io_handle->file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to clone file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( bench_io_handle_initialize(
+	     destination_bench_io_handle,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination benchmark IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens the benchmark IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int bench_io_handle_open(
+     bench_io_handle_t *bench_io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_io_handle_open";
+
+	if( bench_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_open(
+	     bench_io_handle->file_io_handle,
+	     access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the benchmark IO handle
+ * Returns 0 if successful or -1 on error
+ */
+int bench_io_handle_close(
+     bench_io_handle_t *bench_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_io_handle_close";
+
+	if( bench_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_close(
+	     bench_io_handle->file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Reads a buffer from the benchmark IO handle
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t bench_io_handle_read(
+         bench_io_handle_t *bench_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "bench_io_handle_read";
+	ssize_t read_count    = 0;
+
+	if( bench_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer(
+	              bench_io_handle->file_io_handle,
+	              buffer,
+	              size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The reads are serialized by the file IO handle that manages
+	 * the benchmark IO handle
+	 */
+	bench_io_handle->number_of_reads      += 1;
+	bench_io_handle->number_of_bytes_read += (uint64_t) read_count;
+
+	return( read_count );
+}
+
+/* Writes a buffer to the benchmark IO handle
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t bench_io_handle_write(
+         bench_io_handle_t *bench_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "bench_io_handle_write";
+	ssize_t write_count   = 0;
+
+	if( bench_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libbfio_handle_write_buffer(
+	               bench_io_handle->file_io_handle,
+	               buffer,
+	               size,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write to file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
+/* Seeks a certain offset within the benchmark IO handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t bench_io_handle_seek_offset(
+         bench_io_handle_t *bench_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "bench_io_handle_seek_offset";
+
+	if( bench_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	offset = libbfio_handle_seek_offset(
+	          bench_io_handle->file_io_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset in file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( offset );
+}
+
+/* Function to determine if a file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int bench_io_handle_exists(
+     bench_io_handle_t *bench_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_io_handle_exists";
+	int result            = 0;
+
+	if( bench_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfio_handle_exists(
+	          bench_io_handle->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if file IO handle exists.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Check if the benchmark IO handle is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int bench_io_handle_is_open(
+     bench_io_handle_t *bench_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_io_handle_is_open";
+	int result            = 0;
+
+	if( bench_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfio_handle_is_open(
+	          bench_io_handle->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the size of the benchmark IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int bench_io_handle_get_size(
+     bench_io_handle_t *bench_io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_io_handle_get_size";
+
+	if( bench_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     bench_io_handle->file_io_handle,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size of file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,117 @@
+/*
+ * Benchmark IO handle, which counts the reads of a file IO handle
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BENCH_IO_HANDLE_H )
+#define _BENCH_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "vhditools_libbfio.h"
+#include "vhditools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct bench_io_handle bench_io_handle_t;
+
+struct bench_io_handle
+{
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The number of reads
+	 */
+	uint64_t number_of_reads;
+
+	/* The number of bytes read
+	 */
+	uint64_t number_of_bytes_read;
+};
+
+int bench_io_handle_initialize(
+     bench_io_handle_t **bench_io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int bench_io_handle_initialize_file_io_handle(
+     libbfio_handle_t **file_io_handle,
+     bench_io_handle_t **bench_io_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int bench_io_handle_free(
+     bench_io_handle_t **bench_io_handle,
+     libcerror_error_t **error );
+
+int bench_io_handle_clone(
+     bench_io_handle_t **destination_bench_io_handle,
+     bench_io_handle_t *source_bench_io_handle,
+     libcerror_error_t **error );
+
+int bench_io_handle_open(
+     bench_io_handle_t *bench_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int bench_io_handle_close(
+     bench_io_handle_t *bench_io_handle,
+     libcerror_error_t **error );
+
+ssize_t bench_io_handle_read(
+         bench_io_handle_t *bench_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t bench_io_handle_write(
+         bench_io_handle_t *bench_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t bench_io_handle_seek_offset(
+         bench_io_handle_t *bench_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int bench_io_handle_exists(
+     bench_io_handle_t *bench_io_handle,
+     libcerror_error_t **error );
+
+int bench_io_handle_is_open(
+     bench_io_handle_t *bench_io_handle,
+     libcerror_error_t **error );
+
+int bench_io_handle_get_size(
+     bench_io_handle_t *bench_io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BENCH_IO_HANDLE_H ) */
+
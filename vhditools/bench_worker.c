@@ -0,0 +1,848 @@
+/*
+ * Benchmark worker
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#endif
+
+#include <time.h>
+
+#include "bench_worker.h"
+#include "vhditools_libcerror.h"
+#include "vhditools_libcnotify.h"
+#include "vhditools_libcthreads.h"
+#include "vhditools_libvhdi.h"
+
+/* Creates a benchmark worker
+ * Make sure the value bench_worker is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int bench_worker_initialize(
+     bench_worker_t **bench_worker,
+     libvhdi_file_t *vhdi_file,
+     size64_t media_size,
+     int access_pattern,
+     size_t io_size,
+     size64_t stride,
+     int worker_index,
+     int number_of_workers,
+     uint32_t seed,
+     libcerror_error_t **error )
+{
+	static char *function           = "bench_worker_initialize";
+	uint64_t number_of_slots        = 0;
+	uint64_t number_of_region_slots = 0;
+	uint64_t random_state           = 0;
+
+	if( bench_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_worker != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid benchmark worker value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( vhdi_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_pattern != BENCH_WORKER_ACCESS_PATTERN_SEQUENTIAL )
+	 && ( access_pattern != BENCH_WORKER_ACCESS_PATTERN_RANDOM )
+	 && ( access_pattern != BENCH_WORKER_ACCESS_PATTERN_STRIDED ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access pattern.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_size == 0 )
+	 || ( io_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	 || ( (size64_t) io_size > media_size )
+	 || ( media_size > (size64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid IO size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( worker_index < 0 )
+	 || ( worker_index >= number_of_workers ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid worker index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*bench_worker = memory_allocate_structure(
+	                 bench_worker_t );
+
+	if( *bench_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create benchmark worker.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *bench_worker,
+	     0,
+	     sizeof( bench_worker_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear benchmark worker.",
+		 function );
+
+		memory_free(
+		 *bench_worker );
+
+		*bench_worker = NULL;
+
+		return( -1 );
+	}
+	( *bench_worker )->buffer = (uint8_t *) memory_allocate(
+	                                         sizeof( uint8_t ) * io_size );
+
+	if( ( *bench_worker )->buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_slots = media_size / io_size;
+
+	( *bench_worker )->vhdi_file      = vhdi_file;
+	( *bench_worker )->media_size     = media_size;
+	( *bench_worker )->access_pattern = access_pattern;
+	( *bench_worker )->io_size        = io_size;
+	( *bench_worker )->stride         = stride;
+	( *bench_worker )->first_offset   = 0;
+	( *bench_worker )->last_offset    = (off64_t) ( ( number_of_slots - 1 ) * io_size );
+
+	if( access_pattern == BENCH_WORKER_ACCESS_PATTERN_SEQUENTIAL )
+	{
+		/* Every worker reads its own region of the media sequentially
+		 */
+		number_of_region_slots = number_of_slots / number_of_workers;
+
+		if( number_of_region_slots > 0 )
+		{
+			( *bench_worker )->first_offset = (off64_t) ( worker_index * number_of_region_slots * io_size );
+			( *bench_worker )->last_offset  = ( *bench_worker )->first_offset + (off64_t) ( ( number_of_region_slots - 1 ) * io_size );
+		}
+		( *bench_worker )->current_offset = ( *bench_worker )->first_offset;
+	}
+	else if( access_pattern == BENCH_WORKER_ACCESS_PATTERN_STRIDED )
+	{
+		( *bench_worker )->current_offset = (off64_t) ( ( worker_index % number_of_slots ) * io_size );
+	}
+	/* Seed the random number generator with the splitmix64 finalizer
+	 * so that every worker has a different but reproducible state
+	 */
+	random_state  = ( ( (uint64_t) seed << 32 ) | (uint32_t) worker_index ) + 0x9e3779b97f4a7c15ULL;
+	random_state  = ( random_state ^ ( random_state >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+	random_state  = ( random_state ^ ( random_state >> 27 ) ) * 0x94d049bb133111ebULL;
+	random_state ^= random_state >> 31;
+
+	if( random_state == 0 )
+	{
+		random_state = 0x9e3779b97f4a7c15ULL;
+	}
+	( *bench_worker )->random_state = random_state;
+
+	return( 1 );
+
+on_error:
+	if( *bench_worker != NULL )
+	{
+		if( ( *bench_worker )->buffer != NULL )
+		{
+			memory_free(
+			 ( *bench_worker )->buffer );
+		}
+		memory_free(
+		 *bench_worker );
+
+		*bench_worker = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a benchmark worker
+ * Returns 1 if successful or -1 on error
+ */
+int bench_worker_free(
+     bench_worker_t **bench_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_worker_free";
+	int result            = 1;
+
+	if( bench_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_worker != NULL )
+	{
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+		if( ( *bench_worker )->thread != NULL )
+		{
+			( *bench_worker )->abort = 1;
+
+			if( libcthreads_thread_join(
+			     &( ( *bench_worker )->thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		/* The vhdi_file reference is freed elsewhere
+		 */
+		memory_free(
+		 ( *bench_worker )->buffer );
+
+		memory_free(
+		 *bench_worker );
+
+		*bench_worker = NULL;
+	}
+	return( result );
+}
+
+/* Signals the benchmark worker to abort
+ * Returns 1 if successful or -1 on error
+ */
+int bench_worker_signal_abort(
+     bench_worker_t *bench_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_worker_signal_abort";
+
+	if( bench_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark worker.",
+		 function );
+
+		return( -1 );
+	}
+	bench_worker->abort = 1;
+
+	return( 1 );
+}
+
+/* Retrieves a monotonic timestamp in nano seconds
+ * Returns 1 if successful or -1 on error
+ */
+int bench_worker_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	struct timespec time_structure;
+#endif
+
+	static char *function = "bench_worker_get_timestamp";
+
+#if !defined( WINAPI ) && !defined( HAVE_CLOCK_GETTIME )
+	time_t current_time   = 0;
+#endif
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve performance counter.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) ( counter.QuadPart / frequency.QuadPart ) * 1000000000 )
+	           + ( ( (uint64_t) ( counter.QuadPart % frequency.QuadPart ) * 1000000000 ) / (uint64_t) frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time structure.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) time_structure.tv_sec * 1000000000 ) + (uint64_t) time_structure.tv_nsec;
+
+#else
+	current_time = time( NULL );
+
+	if( current_time == (time_t) -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = (uint64_t) current_time * 1000000000;
+
+#endif /* defined( WINAPI ) */
+
+	return( 1 );
+}
+
+/* Retrieves the index of the latency histogram bucket of a latency
+ * Returns 1 if successful or -1 on error
+ */
+int bench_worker_get_latency_bucket_index(
+     uint64_t latency,
+     int *bucket_index,
+     libcerror_error_t **error )
+{
+	static char *function    = "bench_worker_get_latency_bucket_index";
+	uint64_t value_64bit     = 0;
+	int most_significant_bit = 0;
+
+	if( bucket_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bucket index.",
+		 function );
+
+		return( -1 );
+	}
+	if( latency < 16 )
+	{
+		*bucket_index = (int) latency;
+
+		return( 1 );
+	}
+	for( value_64bit = latency;
+	     value_64bit > 1;
+	     value_64bit >>= 1 )
+	{
+		most_significant_bit++;
+	}
+	*bucket_index = ( ( most_significant_bit - 3 ) * 16 ) + (int) ( ( latency >> ( most_significant_bit - 4 ) ) & 0x0f );
+
+	return( 1 );
+}
+
+/* Retrieves the range of latencies of a latency histogram bucket
+ * Returns 1 if successful or -1 on error
+ */
+int bench_worker_get_latency_bucket_range(
+     int bucket_index,
+     uint64_t *lower_bound,
+     uint64_t *upper_bound,
+     libcerror_error_t **error )
+{
+	static char *function    = "bench_worker_get_latency_bucket_range";
+	int most_significant_bit = 0;
+
+	if( ( bucket_index < 0 )
+	 || ( bucket_index >= BENCH_WORKER_NUMBER_OF_LATENCY_BUCKETS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bucket index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( lower_bound == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid lower bound.",
+		 function );
+
+		return( -1 );
+	}
+	if( upper_bound == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid upper bound.",
+		 function );
+
+		return( -1 );
+	}
+	if( bucket_index < 16 )
+	{
+		*lower_bound = (uint64_t) bucket_index;
+		*upper_bound = (uint64_t) bucket_index;
+
+		return( 1 );
+	}
+	most_significant_bit = ( bucket_index / 16 ) + 3;
+
+	*lower_bound = (uint64_t) ( 16 + ( bucket_index % 16 ) ) << ( most_significant_bit - 4 );
+	*upper_bound = *lower_bound + ( ( (uint64_t) 1 << ( most_significant_bit - 4 ) ) - 1 );
+
+	return( 1 );
+}
+
+/* Retrieves the offset of the next read
+ * Returns 1 if successful or -1 on error
+ */
+int bench_worker_get_next_offset(
+     bench_worker_t *bench_worker,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	static char *function    = "bench_worker_get_next_offset";
+	uint64_t number_of_slots = 0;
+	uint64_t random_value    = 0;
+
+	if( bench_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	switch( bench_worker->access_pattern )
+	{
+		case BENCH_WORKER_ACCESS_PATTERN_SEQUENTIAL:
+			*offset = bench_worker->current_offset;
+
+			bench_worker->current_offset += (off64_t) bench_worker->io_size;
+
+			if( bench_worker->current_offset > bench_worker->last_offset )
+			{
+				bench_worker->current_offset = bench_worker->first_offset;
+			}
+			break;
+
+		case BENCH_WORKER_ACCESS_PATTERN_RANDOM:
+			/* Use the xorshift64* random number generator
+			 */
+			bench_worker->random_state ^= bench_worker->random_state >> 12;
+			bench_worker->random_state ^= bench_worker->random_state << 25;
+			bench_worker->random_state ^= bench_worker->random_state >> 27;
+
+			random_value    = bench_worker->random_state * 0x2545f4914f6cdd1dULL;
+			number_of_slots = ( (uint64_t) bench_worker->last_offset / bench_worker->io_size ) + 1;
+
+			*offset = (off64_t) ( ( random_value % number_of_slots ) * bench_worker->io_size );
+
+			break;
+
+		case BENCH_WORKER_ACCESS_PATTERN_STRIDED:
+			*offset = bench_worker->current_offset;
+
+			bench_worker->current_offset = (off64_t) ( ( (uint64_t) bench_worker->current_offset + bench_worker->stride )
+			                             % ( (uint64_t) bench_worker->last_offset + bench_worker->io_size ) );
+
+			/* A stride that is not a multiple of the IO size can wrap
+			 * to an offset beyond the last offset
+			 */
+			if( bench_worker->current_offset > bench_worker->last_offset )
+			{
+				bench_worker->current_offset = 0;
+			}
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported access pattern.",
+			 function );
+
+			return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads from the file until the end timestamp is reached or abort is signalled
+ * Returns 1 if successful or -1 on error
+ */
+int bench_worker_run(
+     bench_worker_t *bench_worker,
+     libcerror_error_t **error )
+{
+	static char *function    = "bench_worker_run";
+	ssize_t read_count       = 0;
+	off64_t read_offset      = 0;
+	uint64_t end_timestamp   = 0;
+	uint64_t latency         = 0;
+	uint64_t start_timestamp = 0;
+	int bucket_index         = 0;
+
+	if( bench_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_worker_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	while( bench_worker->abort == 0 )
+	{
+		/* The timestamp at the end of the previous read is the timestamp at the start of the next
+		 */
+		start_timestamp = end_timestamp;
+
+		if( start_timestamp >= bench_worker->end_timestamp )
+		{
+			break;
+		}
+		if( bench_worker_get_next_offset(
+		     bench_worker,
+		     &read_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next offset.",
+			 function );
+
+			return( -1 );
+		}
+		read_count = libvhdi_file_read_buffer_at_offset(
+		              bench_worker->vhdi_file,
+		              bench_worker->buffer,
+		              bench_worker->io_size,
+		              read_offset,
+		              error );
+
+		if( read_count != (ssize_t) bench_worker->io_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_offset,
+			 read_offset );
+
+			return( -1 );
+		}
+		if( bench_worker_get_timestamp(
+		     &end_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		latency = end_timestamp - start_timestamp;
+
+		if( bench_worker_get_latency_bucket_index(
+		     latency,
+		     &bucket_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve latency bucket index.",
+			 function );
+
+			return( -1 );
+		}
+		bench_worker->latency_histogram[ bucket_index ] += 1;
+
+		if( latency > bench_worker->maximum_latency )
+		{
+			bench_worker->maximum_latency = latency;
+		}
+		bench_worker->number_of_reads      += 1;
+		bench_worker->number_of_bytes_read += (uint64_t) read_count;
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+
+/* The benchmark worker thread function
+ * Returns 1 if successful or -1 on error
+ */
+int bench_worker_thread_function(
+     void *arguments )
+{
+	bench_worker_t *bench_worker = NULL;
+	libcerror_error_t *error     = NULL;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	bench_worker = (bench_worker_t *) arguments;
+
+	bench_worker->result = bench_worker_run(
+	                        bench_worker,
+	                        &error );
+
+	if( bench_worker->result != 1 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( bench_worker->result );
+}
+
+/* Starts the benchmark worker thread
+ * Returns 1 if successful or -1 on error
+ */
+int bench_worker_start(
+     bench_worker_t *bench_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_worker_start";
+
+	if( bench_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_worker->thread != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid benchmark worker - thread value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_create(
+	     &( bench_worker->thread ),
+	     NULL,
+	     &bench_worker_thread_function,
+	     (void *) bench_worker,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Waits for the benchmark worker thread to finish
+ * Returns 1 if successful or -1 on error
+ */
+int bench_worker_join(
+     bench_worker_t *bench_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_worker_join";
+
+	if( bench_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_worker->thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid benchmark worker - missing thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_join(
+	     &( bench_worker->thread ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join thread.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT ) */
+
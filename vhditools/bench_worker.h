@@ -0,0 +1,191 @@
+/*
+ * Benchmark worker
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BENCH_WORKER_H )
+#define _BENCH_WORKER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "vhditools_libcerror.h"
+#include "vhditools_libcthreads.h"
+#include "vhditools_libvhdi.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The latency histogram consists of 16 linear buckets per power of 2
+ * of the latency in nano seconds
+ */
+#define BENCH_WORKER_NUMBER_OF_LATENCY_BUCKETS	976
+
+enum BENCH_WORKER_ACCESS_PATTERNS
+{
+	BENCH_WORKER_ACCESS_PATTERN_SEQUENTIAL	= 0,
+	BENCH_WORKER_ACCESS_PATTERN_RANDOM	= 1,
+	BENCH_WORKER_ACCESS_PATTERN_STRIDED	= 2
+};
+
+typedef struct bench_worker bench_worker_t;
+
+struct bench_worker
+{
+	/* The file
+	 */
+	libvhdi_file_t *vhdi_file;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The access pattern
+	 */
+	int access_pattern;
+
+	/* The IO size
+	 */
+	size_t io_size;
+
+	/* The stride
+	 */
+	size64_t stride;
+
+	/* The first offset
+	 */
+	off64_t first_offset;
+
+	/* The last offset
+	 */
+	off64_t last_offset;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The random number generator state
+	 */
+	uint64_t random_state;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The end timestamp in nano seconds
+	 */
+	uint64_t end_timestamp;
+
+	/* The number of reads
+	 */
+	uint64_t number_of_reads;
+
+	/* The number of bytes read
+	 */
+	uint64_t number_of_bytes_read;
+
+	/* The maximum latency in nano seconds
+	 */
+	uint64_t maximum_latency;
+
+	/* The latency histogram
+	 */
+	uint64_t latency_histogram[ BENCH_WORKER_NUMBER_OF_LATENCY_BUCKETS ];
+
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+#endif
+
+	/* The result of the worker
+	 */
+	int result;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int bench_worker_initialize(
+     bench_worker_t **bench_worker,
+     libvhdi_file_t *vhdi_file,
+     size64_t media_size,
+     int access_pattern,
+     size_t io_size,
+     size64_t stride,
+     int worker_index,
+     int number_of_workers,
+     uint32_t seed,
+     libcerror_error_t **error );
+
+int bench_worker_free(
+     bench_worker_t **bench_worker,
+     libcerror_error_t **error );
+
+int bench_worker_signal_abort(
+     bench_worker_t *bench_worker,
+     libcerror_error_t **error );
+
+int bench_worker_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error );
+
+int bench_worker_get_latency_bucket_index(
+     uint64_t latency,
+     int *bucket_index,
+     libcerror_error_t **error );
+
+int bench_worker_get_latency_bucket_range(
+     int bucket_index,
+     uint64_t *lower_bound,
+     uint64_t *upper_bound,
+     libcerror_error_t **error );
+
+int bench_worker_get_next_offset(
+     bench_worker_t *bench_worker,
+     off64_t *offset,
+     libcerror_error_t **error );
+
+int bench_worker_run(
+     bench_worker_t *bench_worker,
+     libcerror_error_t **error );
+
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+
+int bench_worker_thread_function(
+     void *arguments );
+
+int bench_worker_start(
+     bench_worker_t *bench_worker,
+     libcerror_error_t **error );
+
+int bench_worker_join(
+     bench_worker_t *bench_worker,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BENCH_WORKER_H ) */
+
@@ -0,0 +1,557 @@
+/*
+ * Digest context
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_context.h"
+#include "vhditools_libcerror.h"
+#include "vhditools_libhmac.h"
+
+/* Creates a digest context
+ * Make sure the value digest_context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_initialize(
+     digest_context_t **digest_context,
+     uint8_t calculate_md5,
+     uint8_t calculate_sha1,
+     uint8_t calculate_sha256,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_initialize";
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*digest_context = memory_allocate_structure(
+	                   digest_context_t );
+
+	if( *digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *digest_context,
+	     0,
+	     sizeof( digest_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digest context.",
+		 function );
+
+		memory_free(
+		 *digest_context );
+
+		*digest_context = NULL;
+
+		return( -1 );
+	}
+	( *digest_context )->calculate_md5    = calculate_md5;
+	( *digest_context )->calculate_sha1   = calculate_sha1;
+	( *digest_context )->calculate_sha256 = calculate_sha256;
+
+	if( digest_context_reset(
+	     *digest_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize digest contexts.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *digest_context != NULL )
+	{
+		digest_context_free(
+		 digest_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a digest context
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_free(
+     digest_context_t **digest_context,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_free";
+	int result            = 1;
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_context != NULL )
+	{
+		if( ( *digest_context )->md5_context != NULL )
+		{
+			if( libhmac_md5_free(
+			     &( ( *digest_context )->md5_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free MD5 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *digest_context )->sha1_context != NULL )
+		{
+			if( libhmac_sha1_free(
+			     &( ( *digest_context )->sha1_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA1 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *digest_context )->sha256_context != NULL )
+		{
+			if( libhmac_sha256_free(
+			     &( ( *digest_context )->sha256_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA256 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *digest_context );
+
+		*digest_context = NULL;
+	}
+	return( result );
+}
+
+/* Resets a digest context so that it can be used to calculate new digest hashes
+ * The libhmac contexts cannot be reused after being finalized and are therefore recreated
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_reset(
+     digest_context_t *digest_context,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_reset";
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_context->md5_context != NULL )
+	{
+		if( libhmac_md5_free(
+		     &( digest_context->md5_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free MD5 context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( digest_context->calculate_md5 != 0 )
+	{
+		if( libhmac_md5_initialize(
+		     &( digest_context->md5_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize MD5 context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( digest_context->sha1_context != NULL )
+	{
+		if( libhmac_sha1_free(
+		     &( digest_context->sha1_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA1 context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( digest_context->calculate_sha1 != 0 )
+	{
+		if( libhmac_sha1_initialize(
+		     &( digest_context->sha1_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA1 context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( digest_context->sha256_context != NULL )
+	{
+		if( libhmac_sha256_free(
+		     &( digest_context->sha256_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA256 context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( digest_context->calculate_sha256 != 0 )
+	{
+		if( libhmac_sha256_initialize(
+		     &( digest_context->sha256_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Updates the digest hashes with the data in a buffer
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_update(
+     digest_context_t *digest_context,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_update";
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_context->md5_context != NULL )
+	{
+		if( libhmac_md5_update(
+		     digest_context->md5_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update MD5 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( digest_context->sha1_context != NULL )
+	{
+		if( libhmac_sha1_update(
+		     digest_context->sha1_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA1 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( digest_context->sha256_context != NULL )
+	{
+		if( libhmac_sha256_update(
+		     digest_context->sha256_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Updates the digest hashes with a run of zero bytes
+ * The zero buffer is a buffer of zero bytes that is reused for the entire run
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_update_zero_bytes(
+     digest_context_t *digest_context,
+     const uint8_t *zero_buffer,
+     size_t zero_buffer_size,
+     size64_t number_of_zero_bytes,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_update_zero_bytes";
+	size_t update_size    = 0;
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( zero_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid zero buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( zero_buffer_size == 0 )
+	 || ( zero_buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid zero buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( number_of_zero_bytes > 0 )
+	{
+		update_size = zero_buffer_size;
+
+		if( (size64_t) update_size > number_of_zero_bytes )
+		{
+			update_size = (size_t) number_of_zero_bytes;
+		}
+		if( digest_context_update(
+		     digest_context,
+		     zero_buffer,
+		     update_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hashes.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_zero_bytes -= update_size;
+	}
+	return( 1 );
+}
+
+/* Finalizes the digest hashes
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_finalize(
+     digest_context_t *digest_context,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_finalize";
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_context->md5_context != NULL )
+	{
+		if( libhmac_md5_finalize(
+		     digest_context->md5_context,
+		     digest_context->md5_hash,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to finalize MD5 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( digest_context->sha1_context != NULL )
+	{
+		if( libhmac_sha1_finalize(
+		     digest_context->sha1_context,
+		     digest_context->sha1_hash,
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to finalize SHA1 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( digest_context->sha256_context != NULL )
+	{
+		if( libhmac_sha256_finalize(
+		     digest_context->sha256_context,
+		     digest_context->sha256_hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to finalize SHA256 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
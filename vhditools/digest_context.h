@@ -0,0 +1,113 @@
+/*
+ * Digest context
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIGEST_CONTEXT_H )
+#define _DIGEST_CONTEXT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "vhditools_libcerror.h"
+#include "vhditools_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct digest_context digest_context_t;
+
+struct digest_context
+{
+	/* Value to indicate if the MD5 digest hash should be calculated
+	 */
+	uint8_t calculate_md5;
+
+	/* The MD5 digest context
+	 */
+	libhmac_md5_context_t *md5_context;
+
+	/* The MD5 digest hash
+	 */
+	uint8_t md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
+
+	/* Value to indicate if the SHA1 digest hash should be calculated
+	 */
+	uint8_t calculate_sha1;
+
+	/* The SHA1 digest context
+	 */
+	libhmac_sha1_context_t *sha1_context;
+
+	/* The SHA1 digest hash
+	 */
+	uint8_t sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
+
+	/* Value to indicate if the SHA256 digest hash should be calculated
+	 */
+	uint8_t calculate_sha256;
+
+	/* The SHA256 digest context
+	 */
+	libhmac_sha256_context_t *sha256_context;
+
+	/* The SHA256 digest hash
+	 */
+	uint8_t sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+};
+
+int digest_context_initialize(
+     digest_context_t **digest_context,
+     uint8_t calculate_md5,
+     uint8_t calculate_sha1,
+     uint8_t calculate_sha256,
+     libcerror_error_t **error );
+
+int digest_context_free(
+     digest_context_t **digest_context,
+     libcerror_error_t **error );
+
+int digest_context_reset(
+     digest_context_t *digest_context,
+     libcerror_error_t **error );
+
+int digest_context_update(
+     digest_context_t *digest_context,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int digest_context_update_zero_bytes(
+     digest_context_t *digest_context,
+     const uint8_t *zero_buffer,
+     size_t zero_buffer_size,
+     size64_t number_of_zero_bytes,
+     libcerror_error_t **error );
+
+int digest_context_finalize(
+     digest_context_t *digest_context,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DIGEST_CONTEXT_H ) */
+
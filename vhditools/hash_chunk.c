@@ -0,0 +1,168 @@
+/*
+ * Hash chunk
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "hash_chunk.h"
+#include "vhditools_libcerror.h"
+
+/* Creates a hash chunk
+ * Make sure the value hash_chunk is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int hash_chunk_initialize(
+     hash_chunk_t **hash_chunk,
+     size_t allocated_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_chunk_initialize";
+
+	if( hash_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_chunk != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash chunk value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( allocated_data_size == 0 )
+	 || ( allocated_data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid allocated data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*hash_chunk = memory_allocate_structure(
+	               hash_chunk_t );
+
+	if( *hash_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *hash_chunk,
+	     0,
+	     sizeof( hash_chunk_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash chunk.",
+		 function );
+
+		memory_free(
+		 *hash_chunk );
+
+		*hash_chunk = NULL;
+
+		return( -1 );
+	}
+	( *hash_chunk )->data = (uint8_t *) memory_allocate(
+	                                     sizeof( uint8_t ) * allocated_data_size );
+
+	if( ( *hash_chunk )->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	( *hash_chunk )->allocated_data_size = allocated_data_size;
+
+	return( 1 );
+
+on_error:
+	if( *hash_chunk != NULL )
+	{
+		memory_free(
+		 *hash_chunk );
+
+		*hash_chunk = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a hash chunk
+ * Returns 1 if successful or -1 on error
+ */
+int hash_chunk_free(
+     hash_chunk_t **hash_chunk,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_chunk_free";
+
+	if( hash_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_chunk != NULL )
+	{
+		memory_free(
+		 ( *hash_chunk )->data );
+
+		memory_free(
+		 *hash_chunk );
+
+		*hash_chunk = NULL;
+	}
+	return( 1 );
+}
+
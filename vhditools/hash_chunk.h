@@ -0,0 +1,77 @@
+/*
+ * Hash chunk
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _HASH_CHUNK_H )
+#define _HASH_CHUNK_H
+
+#include <common.h>
+#include <types.h>
+
+#include "vhditools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct hash_chunk hash_chunk_t;
+
+struct hash_chunk
+{
+	/* The (media) offset
+	 */
+	off64_t offset;
+
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The allocated data size
+	 */
+	size_t allocated_data_size;
+
+	/* Value to indicate the data is sparse and was not read
+	 */
+	uint8_t is_sparse;
+
+	/* The result of reading the chunk
+	 */
+	int result;
+};
+
+int hash_chunk_initialize(
+     hash_chunk_t **hash_chunk,
+     size_t allocated_data_size,
+     libcerror_error_t **error );
+
+int hash_chunk_free(
+     hash_chunk_t **hash_chunk,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _HASH_CHUNK_H ) */
+
@@ -0,0 +1,2686 @@
+/*
+ * Hash handle
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#include "byte_size_string.h"
+#include "digest_context.h"
+#include "digest_hash.h"
+#include "hash_chunk.h"
+#include "hash_handle.h"
+#include "hash_reader.h"
+#include "vhditools_libcdata.h"
+#include "vhditools_libcerror.h"
+#include "vhditools_libcnotify.h"
+#include "vhditools_libcpath.h"
+#include "vhditools_libcthreads.h"
+#include "vhditools_libhmac.h"
+#include "vhditools_libvhdi.h"
+
+#define HASH_HANDLE_NOTIFY_STREAM		stdout
+
+#define HASH_HANDLE_DEFAULT_CHUNK_SIZE		2097152
+
+#define HASH_HANDLE_MAXIMUM_CHUNK_SIZE		67108864
+
+#define HASH_HANDLE_MAXIMUM_NUMBER_OF_THREADS	256
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_system_string_decimal_copy_to_64_bit(
+     const system_character_t *string,
+     size_t string_length,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function     = "hash_handle_system_string_decimal_copy_to_64_bit";
+	size_t string_index       = 0;
+	uint64_t safe_value_64bit = 0;
+	uint8_t digit             = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( string_length == 0 )
+	 || ( string_length > 20 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid string length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	for( string_index = 0;
+	     string_index < string_length;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] < (system_character_t) '0' )
+		 || ( string[ string_index ] > (system_character_t) '9' ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value at index: %" PRIzd ".",
+			 function,
+			 string_index );
+
+			return( -1 );
+		}
+		digit = (uint8_t) ( string[ string_index ] - (system_character_t) '0' );
+
+		if( safe_value_64bit > ( ( UINT64_MAX - digit ) / 10 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		safe_value_64bit *= 10;
+		safe_value_64bit += digit;
+	}
+	*value_64bit = safe_value_64bit;
+
+	return( 1 );
+}
+
+/* Creates a hash handle
+ * Make sure the value hash_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_initialize(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_initialize";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*hash_handle = memory_allocate_structure(
+	                hash_handle_t );
+
+	if( *hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *hash_handle,
+	     0,
+	     sizeof( hash_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash handle.",
+		 function );
+
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+
+		return( -1 );
+	}
+	if( libvhdi_file_initialize(
+	     &( ( *hash_handle )->input ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *hash_handle )->parent_files_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize parent files array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *hash_handle )->readers_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize readers array.",
+		 function );
+
+		goto on_error;
+	}
+	( *hash_handle )->chunk_size        = HASH_HANDLE_DEFAULT_CHUNK_SIZE;
+	( *hash_handle )->number_of_threads = 1;
+	( *hash_handle )->notify_stream     = HASH_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *hash_handle != NULL )
+	{
+		if( ( *hash_handle )->parent_files_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *hash_handle )->parent_files_array ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *hash_handle )->input != NULL )
+		{
+			libvhdi_file_free(
+			 &( ( *hash_handle )->input ),
+			 NULL );
+		}
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a hash handle
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_free(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_free";
+	int result            = 1;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_handle != NULL )
+	{
+		if( libcdata_array_free(
+		     &( ( *hash_handle )->readers_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &hash_reader_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free readers array.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *hash_handle )->zero_piece_digest_context != NULL )
+		{
+			if( digest_context_free(
+			     &( ( *hash_handle )->zero_piece_digest_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free zero piece digest context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *hash_handle )->piecewise_digest_context != NULL )
+		{
+			if( digest_context_free(
+			     &( ( *hash_handle )->piecewise_digest_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free piecewise digest context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *hash_handle )->digest_context != NULL )
+		{
+			if( digest_context_free(
+			     &( ( *hash_handle )->digest_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *hash_handle )->zero_buffer != NULL )
+		{
+			memory_free(
+			 ( *hash_handle )->zero_buffer );
+		}
+		if( ( *hash_handle )->input != NULL )
+		{
+			if( libvhdi_file_free(
+			     &( ( *hash_handle )->input ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input.",
+				 function );
+
+				result = -1;
+			}
+		}
+		/* The parent files must be freed after the input that references them
+		 */
+		if( libcdata_array_free(
+		     &( ( *hash_handle )->parent_files_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvhdi_file_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free parent files array.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *hash_handle )->basename != NULL )
+		{
+			memory_free(
+			 ( *hash_handle )->basename );
+		}
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the hash handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_signal_abort(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	hash_reader_t *hash_reader = NULL;
+	static char *function      = "hash_handle_signal_abort";
+	int number_of_readers      = 0;
+	int reader_index           = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->abort = 1;
+
+	if( libcdata_array_get_number_of_entries(
+	     hash_handle->readers_array,
+	     &number_of_readers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of readers.",
+		 function );
+
+		return( -1 );
+	}
+	for( reader_index = 0;
+	     reader_index < number_of_readers;
+	     reader_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     hash_handle->readers_array,
+		     reader_index,
+		     (intptr_t **) &hash_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reader: %d.",
+			 function,
+			 reader_index );
+
+			return( -1 );
+		}
+		if( hash_reader_signal_abort(
+		     hash_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal reader: %d to abort.",
+			 function,
+			 reader_index );
+
+			return( -1 );
+		}
+	}
+	if( hash_handle->input != NULL )
+	{
+		if( libvhdi_file_signal_abort(
+		     hash_handle->input,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the number of threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int hash_handle_set_number_of_threads(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( hash_handle_system_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to determine number of threads.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) HASH_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+#else
+	if( value_64bit != 1 )
+#endif
+	{
+		return( 0 );
+	}
+	hash_handle->number_of_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the chunk size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int hash_handle_set_chunk_size(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_chunk_size";
+	size_t string_length  = 0;
+	uint64_t size_value   = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( byte_size_string_convert(
+	     string,
+	     string_length,
+	     &size_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to determine chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size_value == 0 )
+	 || ( ( size_value % 512 ) != 0 )
+	 || ( size_value > (uint64_t) HASH_HANDLE_MAXIMUM_CHUNK_SIZE ) )
+	{
+		return( 0 );
+	}
+	hash_handle->chunk_size = (size_t) size_value;
+
+	return( 1 );
+}
+
+/* Sets the piecewise size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int hash_handle_set_piecewise_size(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_piecewise_size";
+	size_t string_length  = 0;
+	uint64_t size_value   = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( byte_size_string_convert(
+	     string,
+	     string_length,
+	     &size_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to determine piecewise size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size_value == 0 )
+	 || ( ( size_value % 512 ) != 0 )
+	 || ( size_value > (uint64_t) INT64_MAX ) )
+	{
+		return( 0 );
+	}
+	hash_handle->piecewise_size = (size64_t) size_value;
+
+	return( 1 );
+}
+
+/* Sets the additional digest types
+ * The digest types are separated by a comma, the MD5 digest hash is always calculated
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int hash_handle_set_additional_digest_types(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	const system_character_t *digest_type_string = NULL;
+	static char *function                        = "hash_handle_set_additional_digest_types";
+	size_t digest_type_string_length             = 0;
+	size_t string_index                          = 0;
+	size_t string_length                         = 0;
+	size_t string_segment_start                  = 0;
+	uint8_t calculate_sha1                       = 0;
+	uint8_t calculate_sha256                     = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	for( string_index = 0;
+	     string_index <= string_length;
+	     string_index++ )
+	{
+		if( ( string_index < string_length )
+		 && ( string[ string_index ] != (system_character_t) ',' ) )
+		{
+			continue;
+		}
+		digest_type_string        = &( string[ string_segment_start ] );
+		digest_type_string_length = string_index - string_segment_start;
+
+		string_segment_start = string_index + 1;
+
+		if( digest_type_string_length == 3 )
+		{
+			if( system_string_compare(
+			     digest_type_string,
+			     _SYSTEM_STRING( "md5" ),
+			     3 ) == 0 )
+			{
+				continue;
+			}
+		}
+		else if( digest_type_string_length == 4 )
+		{
+			if( system_string_compare(
+			     digest_type_string,
+			     _SYSTEM_STRING( "sha1" ),
+			     4 ) == 0 )
+			{
+				calculate_sha1 = 1;
+
+				continue;
+			}
+		}
+		else if( digest_type_string_length == 5 )
+		{
+			if( system_string_compare(
+			     digest_type_string,
+			     _SYSTEM_STRING( "sha-1" ),
+			     5 ) == 0 )
+			{
+				calculate_sha1 = 1;
+
+				continue;
+			}
+		}
+		else if( digest_type_string_length == 6 )
+		{
+			if( system_string_compare(
+			     digest_type_string,
+			     _SYSTEM_STRING( "sha256" ),
+			     6 ) == 0 )
+			{
+				calculate_sha256 = 1;
+
+				continue;
+			}
+		}
+		else if( digest_type_string_length == 7 )
+		{
+			if( system_string_compare(
+			     digest_type_string,
+			     _SYSTEM_STRING( "sha-256" ),
+			     7 ) == 0 )
+			{
+				calculate_sha256 = 1;
+
+				continue;
+			}
+		}
+		return( 0 );
+	}
+	hash_handle->calculate_sha1   = calculate_sha1;
+	hash_handle->calculate_sha256 = calculate_sha256;
+
+	return( 1 );
+}
+
+/* Sets the basename
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_basename(
+     hash_handle_t *hash_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_basename";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->basename != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle - basename value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing basename.",
+		 function );
+
+		goto on_error;
+	}
+	if( basename_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid basename size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	hash_handle->basename = system_string_allocate(
+	                         basename_size );
+
+	if( hash_handle->basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create basename string.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     hash_handle->basename,
+	     basename,
+	     basename_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy basename.",
+		 function );
+
+		goto on_error;
+	}
+	hash_handle->basename[ basename_size - 1 ] = 0;
+
+	hash_handle->basename_size = basename_size;
+
+	return( 1 );
+
+on_error:
+	if( hash_handle->basename != NULL )
+	{
+		memory_free(
+		 hash_handle->basename );
+
+		hash_handle->basename = NULL;
+	}
+	hash_handle->basename_size = 0;
+
+	return( -1 );
+}
+
+/* Opens the hash handle
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_open_input(
+     hash_handle_t *hash_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	const system_character_t *basename_end = NULL;
+	static char *function                  = "hash_handle_open_input";
+	size_t basename_length                 = 0;
+	size_t filename_length                 = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	basename_end = system_string_search_character_reverse(
+	                filename,
+	                (system_character_t) LIBCPATH_SEPARATOR,
+	                filename_length + 1 );
+
+	if( basename_end != NULL )
+	{
+		basename_length = (size_t) ( basename_end - filename ) + 1;
+	}
+	if( ( basename_length > 0 )
+	 && ( hash_handle->basename == NULL ) )
+	{
+		if( hash_handle_set_basename(
+		     hash_handle,
+		     filename,
+		     basename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set basename.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvhdi_file_open_wide(
+	     hash_handle->input,
+	     filename,
+	     LIBVHDI_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvhdi_file_open(
+	     hash_handle->input,
+	     filename,
+	     LIBVHDI_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens the parent file of a file and recursively its parents
+ * The parent files are managed by the hash handle
+ * Returns 1 if successful, 0 if no parent or -1 on error
+ */
+int hash_handle_open_parent(
+     hash_handle_t *hash_handle,
+     libvhdi_file_t *vhdi_file,
+     libcerror_error_t **error )
+{
+	uint8_t guid[ 16 ];
+
+	libvhdi_file_t *parent_vhdi_file              = NULL;
+	const system_character_t *parent_basename_end = NULL;
+	system_character_t *parent_filename           = NULL;
+	system_character_t *parent_path               = NULL;
+	system_character_t *vhdi_parent_path          = NULL;
+	static char *function                         = "hash_handle_open_parent";
+	size_t parent_basename_length                 = 0;
+	size_t parent_filename_size                   = 0;
+	size_t parent_path_size                       = 0;
+	int entry_index                               = 0;
+	int result                                    = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvhdi_file_get_parent_identifier(
+	          vhdi_file,
+	          guid,
+	          16,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent content identifier.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 1 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvhdi_file_get_utf16_parent_filename_size(
+	          vhdi_file,
+	          &parent_filename_size,
+	          error );
+#else
+	result = libvhdi_file_get_utf8_parent_filename_size(
+	          vhdi_file,
+	          &parent_filename_size,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( parent_filename_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( parent_filename_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid parent filename size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	parent_filename = system_string_allocate(
+	                   parent_filename_size );
+
+	if( parent_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parent filename string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvhdi_file_get_utf16_parent_filename(
+	          vhdi_file,
+	          (uint16_t *) parent_filename,
+	          parent_filename_size,
+	          error );
+#else
+	result = libvhdi_file_get_utf8_parent_filename(
+	          vhdi_file,
+	          (uint8_t *) parent_filename,
+	          parent_filename_size,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	parent_basename_end = system_string_search_character_reverse(
+	                       parent_filename,
+	                       (system_character_t) '\\',
+	                       parent_filename_size );
+
+	if( parent_basename_end != NULL )
+	{
+		parent_basename_length = (size_t) ( parent_basename_end - parent_filename ) + 1;
+	}
+	if( hash_handle->basename == NULL )
+	{
+		vhdi_parent_path = &( parent_filename[ parent_basename_length ] );
+	}
+	else
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcpath_path_join_wide(
+		     &parent_path,
+		     &parent_path_size,
+		     hash_handle->basename,
+		     hash_handle->basename_size - 1,
+		     &( parent_filename[ parent_basename_length ] ),
+		     parent_filename_size - ( parent_basename_length + 1 ),
+		     error ) != 1 )
+#else
+		if( libcpath_path_join(
+		     &parent_path,
+		     &parent_path_size,
+		     hash_handle->basename,
+		     hash_handle->basename_size - 1,
+		     &( parent_filename[ parent_basename_length ] ),
+		     parent_filename_size - ( parent_basename_length + 1 ),
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create parent path.",
+			 function );
+
+			goto on_error;
+		}
+		vhdi_parent_path = parent_path;
+	}
+	if( libvhdi_file_initialize(
+	     &parent_vhdi_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize parent file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvhdi_file_open_wide(
+	     parent_vhdi_file,
+	     vhdi_parent_path,
+	     LIBVHDI_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvhdi_file_open(
+	     parent_vhdi_file,
+	     vhdi_parent_path,
+	     LIBVHDI_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent file: %" PRIs_SYSTEM ".",
+		 function,
+		 vhdi_parent_path );
+
+		goto on_error;
+	}
+	if( libcdata_array_append_entry(
+	     hash_handle->parent_files_array,
+	     &entry_index,
+	     (intptr_t *) parent_vhdi_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append parent file to array.",
+		 function );
+
+		libvhdi_file_close(
+		 parent_vhdi_file,
+		 NULL );
+
+		goto on_error;
+	}
+	if( hash_handle_open_parent(
+	     hash_handle,
+	     parent_vhdi_file,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent file of: %" PRIs_SYSTEM ".",
+		 function,
+		 vhdi_parent_path );
+
+		/* The parent file is freed by the hash handle
+		 */
+		parent_vhdi_file = NULL;
+
+		goto on_error;
+	}
+	if( libvhdi_file_set_parent_file(
+	     vhdi_file,
+	     parent_vhdi_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set parent file.",
+		 function );
+
+		parent_vhdi_file = NULL;
+
+		goto on_error;
+	}
+	if( parent_path != NULL )
+	{
+		memory_free(
+		 parent_path );
+
+		parent_path = NULL;
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+
+		parent_filename = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( parent_vhdi_file != NULL )
+	{
+		libvhdi_file_free(
+		 &parent_vhdi_file,
+		 NULL );
+	}
+	if( parent_path != NULL )
+	{
+		memory_free(
+		 parent_path );
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+	}
+	return( -1 );
+}
+
+/* Closes the hash handle
+ * Returns the 0 if successful or -1 on error
+ */
+int hash_handle_close(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	libvhdi_file_t *parent_vhdi_file = NULL;
+	static char *function            = "hash_handle_close";
+	int file_index                   = 0;
+	int number_of_parent_files       = 0;
+	int result                       = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->input == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid hash handle - missing input.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_file_close(
+	     hash_handle->input,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input.",
+		 function );
+
+		result = -1;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     hash_handle->parent_files_array,
+	     &number_of_parent_files,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of parent files.",
+		 function );
+
+		return( -1 );
+	}
+	/* The parent files are closed from the input towards its last parent
+	 */
+	for( file_index = 0;
+	     file_index < number_of_parent_files;
+	     file_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     hash_handle->parent_files_array,
+		     file_index,
+		     (intptr_t **) &parent_vhdi_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent file: %d.",
+			 function,
+			 file_index );
+
+			result = -1;
+
+			continue;
+		}
+		if( libvhdi_file_close(
+		     parent_vhdi_file,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close parent file: %d.",
+			 function,
+			 file_index );
+
+			result = -1;
+		}
+	}
+	if( libcdata_array_empty(
+	     hash_handle->parent_files_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libvhdi_file_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty parent files array.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Prints the digest hashes of a piece to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_piece_fprint(
+     hash_handle_t *hash_handle,
+     digest_context_t *digest_context,
+     off64_t piece_offset,
+     size64_t piece_size,
+     libcerror_error_t **error )
+{
+	system_character_t digest_hash_string[ 2 * LIBHMAC_SHA256_HASH_SIZE + 1 ];
+
+	static char *function = "hash_handle_piece_fprint";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( piece_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid piece size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\t%" PRIi64 " - %" PRIi64 " (%" PRIu64 " bytes)",
+	 piece_offset,
+	 piece_offset + (off64_t) piece_size - 1,
+	 piece_size );
+
+	if( digest_context->calculate_md5 != 0 )
+	{
+		if( digest_hash_copy_to_string(
+		     digest_context->md5_hash,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     digest_hash_string,
+		     2 * LIBHMAC_SHA256_HASH_SIZE + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to create MD5 digest hash string.",
+			 function );
+
+			return( -1 );
+		}
+		fprintf(
+		 hash_handle->notify_stream,
+		 "\tMD5: %" PRIs_SYSTEM,
+		 digest_hash_string );
+	}
+	if( digest_context->calculate_sha1 != 0 )
+	{
+		if( digest_hash_copy_to_string(
+		     digest_context->sha1_hash,
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     digest_hash_string,
+		     2 * LIBHMAC_SHA256_HASH_SIZE + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to create SHA1 digest hash string.",
+			 function );
+
+			return( -1 );
+		}
+		fprintf(
+		 hash_handle->notify_stream,
+		 "\tSHA1: %" PRIs_SYSTEM,
+		 digest_hash_string );
+	}
+	if( digest_context->calculate_sha256 != 0 )
+	{
+		if( digest_hash_copy_to_string(
+		     digest_context->sha256_hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     digest_hash_string,
+		     2 * LIBHMAC_SHA256_HASH_SIZE + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to create SHA256 digest hash string.",
+			 function );
+
+			return( -1 );
+		}
+		fprintf(
+		 hash_handle->notify_stream,
+		 "\tSHA256: %" PRIs_SYSTEM,
+		 digest_hash_string );
+	}
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
+/* Finalizes the digest hashes of the current piece and prints them
+ * The digest hashes of a complete piece that consists entirely of sparse data
+ * are only calculated once
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_finalize_piece(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	digest_context_t *piece_digest_context = NULL;
+	static char *function                  = "hash_handle_finalize_piece";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->piecewise_digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid hash handle - missing piecewise digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( hash_handle->piece_data_size == hash_handle->piecewise_size )
+	 && ( hash_handle->piece_pending_zero_size == hash_handle->piece_data_size ) )
+	{
+		if( hash_handle->zero_piece_digest_context == NULL )
+		{
+			if( digest_context_initialize(
+			     &( hash_handle->zero_piece_digest_context ),
+			     1,
+			     hash_handle->calculate_sha1,
+			     hash_handle->calculate_sha256,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize zero piece digest context.",
+				 function );
+
+				return( -1 );
+			}
+			if( digest_context_update_zero_bytes(
+			     hash_handle->zero_piece_digest_context,
+			     hash_handle->zero_buffer,
+			     hash_handle->chunk_size,
+			     hash_handle->piecewise_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update zero piece digest hashes.",
+				 function );
+
+				return( -1 );
+			}
+			if( digest_context_finalize(
+			     hash_handle->zero_piece_digest_context,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to finalize zero piece digest hashes.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		piece_digest_context = hash_handle->zero_piece_digest_context;
+	}
+	else
+	{
+		if( hash_handle->piece_pending_zero_size > 0 )
+		{
+			if( digest_context_update_zero_bytes(
+			     hash_handle->piecewise_digest_context,
+			     hash_handle->zero_buffer,
+			     hash_handle->chunk_size,
+			     hash_handle->piece_pending_zero_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update piecewise digest hashes.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( digest_context_finalize(
+		     hash_handle->piecewise_digest_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize piecewise digest hashes.",
+			 function );
+
+			return( -1 );
+		}
+		piece_digest_context = hash_handle->piecewise_digest_context;
+	}
+	if( hash_handle_piece_fprint(
+	     hash_handle,
+	     piece_digest_context,
+	     hash_handle->piece_offset,
+	     hash_handle->piece_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print piece.",
+		 function );
+
+		return( -1 );
+	}
+	if( piece_digest_context == hash_handle->piecewise_digest_context )
+	{
+		if( digest_context_reset(
+		     hash_handle->piecewise_digest_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to reset piecewise digest context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	hash_handle->piece_offset           += (off64_t) hash_handle->piece_data_size;
+	hash_handle->piece_data_size         = 0;
+	hash_handle->piece_pending_zero_size = 0;
+
+	return( 1 );
+}
+
+/* Updates the digest hashes of the pieces with the data of a chunk
+ * Sparse data is not hashed until the piece contains data that is not sparse
+ * or the piece is finalized
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_update_piece(
+     hash_handle_t *hash_handle,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t is_sparse,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_update_piece";
+	size_t update_size    = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->piecewise_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid hash handle - missing piecewise size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data == NULL )
+	 && ( is_sparse == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_size > 0 )
+	{
+		update_size = data_size;
+
+		if( (size64_t) update_size > ( hash_handle->piecewise_size - hash_handle->piece_data_size ) )
+		{
+			update_size = (size_t) ( hash_handle->piecewise_size - hash_handle->piece_data_size );
+		}
+		if( is_sparse != 0 )
+		{
+			hash_handle->piece_pending_zero_size += update_size;
+		}
+		else
+		{
+			if( hash_handle->piece_pending_zero_size > 0 )
+			{
+				if( digest_context_update_zero_bytes(
+				     hash_handle->piecewise_digest_context,
+				     hash_handle->zero_buffer,
+				     hash_handle->chunk_size,
+				     hash_handle->piece_pending_zero_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to update piecewise digest hashes.",
+					 function );
+
+					return( -1 );
+				}
+				hash_handle->piece_pending_zero_size = 0;
+			}
+			if( digest_context_update(
+			     hash_handle->piecewise_digest_context,
+			     data,
+			     update_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update piecewise digest hashes.",
+				 function );
+
+				return( -1 );
+			}
+			data += update_size;
+		}
+		hash_handle->piece_data_size += update_size;
+		data_size                    -= update_size;
+
+		if( hash_handle->piece_data_size == hash_handle->piecewise_size )
+		{
+			if( hash_handle_finalize_piece(
+			     hash_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to finalize piece.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Updates the digest hashes with the data of a chunk
+ * The data of a sparse chunk is hashed from the zero buffer
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_hash_chunk(
+     hash_handle_t *hash_handle,
+     hash_chunk_t *hash_chunk,
+     libcerror_error_t **error )
+{
+	const uint8_t *data   = NULL;
+	static char *function = "hash_handle_hash_chunk";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_chunk->data_size > hash_handle->chunk_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash chunk - data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_chunk->is_sparse != 0 )
+	{
+		data = hash_handle->zero_buffer;
+	}
+	else
+	{
+		data = hash_chunk->data;
+	}
+	if( digest_context_update(
+	     hash_handle->digest_context,
+	     data,
+	     hash_chunk->data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest hashes.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->piecewise_size > 0 )
+	{
+		if( hash_handle_update_piece(
+		     hash_handle,
+		     data,
+		     hash_chunk->data_size,
+		     hash_chunk->is_sparse,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update piecewise digest hashes.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Calculates the digest hashes of the media data
+ * The chunks are read by the readers, where reader N reads every Nth chunk,
+ * and are hashed in media order as they become available
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_calculate(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	hash_chunk_t *hash_chunk   = NULL;
+	hash_reader_t *hash_reader = NULL;
+	static char *function      = "hash_handle_calculate";
+	uint64_t chunk_index       = 0;
+	uint64_t number_of_chunks  = 0;
+	int entry_index            = 0;
+	int number_of_readers      = 0;
+	int reader_index           = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->digest_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle - digest context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_file_get_media_size(
+	     hash_handle->input,
+	     &( hash_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( digest_context_initialize(
+	     &( hash_handle->digest_context ),
+	     1,
+	     hash_handle->calculate_sha1,
+	     hash_handle->calculate_sha256,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize digest context.",
+		 function );
+
+		goto on_error;
+	}
+	if( hash_handle->piecewise_size > 0 )
+	{
+		if( digest_context_initialize(
+		     &( hash_handle->piecewise_digest_context ),
+		     1,
+		     hash_handle->calculate_sha1,
+		     hash_handle->calculate_sha256,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize piecewise digest context.",
+			 function );
+
+			goto on_error;
+		}
+		fprintf(
+		 hash_handle->notify_stream,
+		 "Piecewise digest hashes:\n" );
+	}
+	/* The zero buffer is hashed instead of the data of sparse chunks
+	 */
+	hash_handle->zero_buffer = (uint8_t *) memory_allocate(
+	                                        sizeof( uint8_t ) * hash_handle->chunk_size );
+
+	if( hash_handle->zero_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create zero buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     hash_handle->zero_buffer,
+	     0,
+	     sizeof( uint8_t ) * hash_handle->chunk_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear zero buffer.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_chunks = hash_handle->media_size / hash_handle->chunk_size;
+
+	if( ( hash_handle->media_size % hash_handle->chunk_size ) != 0 )
+	{
+		number_of_chunks += 1;
+	}
+	number_of_readers = hash_handle->number_of_threads;
+
+	if( (uint64_t) number_of_readers > number_of_chunks )
+	{
+		number_of_readers = (int) number_of_chunks;
+	}
+	for( reader_index = 0;
+	     reader_index < number_of_readers;
+	     reader_index++ )
+	{
+		if( hash_reader_initialize(
+		     &hash_reader,
+		     hash_handle->input,
+		     hash_handle->media_size,
+		     hash_handle->chunk_size,
+		     reader_index,
+		     number_of_readers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create reader: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		hash_reader->abort = hash_handle->abort;
+
+		if( libcdata_array_append_entry(
+		     hash_handle->readers_array,
+		     &entry_index,
+		     (intptr_t *) hash_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append reader: %d to array.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		hash_reader = NULL;
+	}
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+	for( reader_index = 0;
+	     reader_index < number_of_readers;
+	     reader_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     hash_handle->readers_array,
+		     reader_index,
+		     (intptr_t **) &hash_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reader: %d.",
+			 function,
+			 reader_index );
+
+			hash_reader = NULL;
+
+			goto on_error;
+		}
+		if( hash_reader_start(
+		     hash_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start reader: %d.",
+			 function,
+			 reader_index );
+
+			hash_reader = NULL;
+
+			goto on_error;
+		}
+	}
+	hash_reader = NULL;
+#else
+	if( hash_chunk_initialize(
+	     &hash_chunk,
+	     hash_handle->chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk.",
+		 function );
+
+		goto on_error;
+	}
+#endif /* defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT ) */
+
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		if( hash_handle->abort != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+			 "%s: abort requested.",
+			 function );
+
+			goto on_error;
+		}
+		reader_index = (int) ( chunk_index % number_of_readers );
+
+		if( libcdata_array_get_entry_by_index(
+		     hash_handle->readers_array,
+		     reader_index,
+		     (intptr_t **) &hash_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reader: %d.",
+			 function,
+			 reader_index );
+
+			hash_reader = NULL;
+
+			goto on_error;
+		}
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+		if( hash_reader_get_read_chunk(
+		     hash_reader,
+		     &hash_chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " from reader: %d.",
+			 function,
+			 chunk_index,
+			 reader_index );
+
+			hash_reader = NULL;
+
+			goto on_error;
+		}
+#else
+		hash_chunk->result = hash_reader_read_chunk(
+		                      hash_reader,
+		                      hash_chunk,
+		                      chunk_index,
+		                      error );
+#endif
+		if( hash_chunk->result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			hash_reader = NULL;
+
+			goto on_error;
+		}
+		if( hash_handle_hash_chunk(
+		     hash_handle,
+		     hash_chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to hash chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			hash_reader = NULL;
+
+			goto on_error;
+		}
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+		if( hash_reader_release_chunk(
+		     hash_reader,
+		     hash_chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			hash_reader = NULL;
+
+			goto on_error;
+		}
+		hash_chunk = NULL;
+#endif
+	}
+	hash_reader = NULL;
+
+	if( hash_chunk != NULL )
+	{
+		if( hash_chunk_free(
+		     &hash_chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( reader_index = 0;
+	     reader_index < number_of_readers;
+	     reader_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     hash_handle->readers_array,
+		     reader_index,
+		     (intptr_t **) &hash_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reader: %d.",
+			 function,
+			 reader_index );
+
+			hash_reader = NULL;
+
+			goto on_error;
+		}
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+		if( hash_reader_join(
+		     hash_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join reader: %d.",
+			 function,
+			 reader_index );
+
+			hash_reader = NULL;
+
+			goto on_error;
+		}
+		if( hash_reader->result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: reader: %d failed.",
+			 function,
+			 reader_index );
+
+			hash_reader = NULL;
+
+			goto on_error;
+		}
+#endif
+		hash_handle->number_of_bytes_read   += hash_reader->number_of_bytes_read;
+		hash_handle->number_of_sparse_bytes += hash_reader->number_of_sparse_bytes;
+	}
+	hash_reader = NULL;
+
+	if( libcdata_array_empty(
+	     hash_handle->readers_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &hash_reader_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty readers array.",
+		 function );
+
+		goto on_error;
+	}
+	if( hash_handle->piece_data_size > 0 )
+	{
+		if( hash_handle_finalize_piece(
+		     hash_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize last piece.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( hash_handle->piecewise_size > 0 )
+	{
+		fprintf(
+		 hash_handle->notify_stream,
+		 "\n" );
+	}
+	if( digest_context_finalize(
+	     hash_handle->digest_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize digest hashes.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( hash_reader != NULL )
+	{
+		hash_reader_free(
+		 &hash_reader,
+		 NULL );
+	}
+	/* The chunk is owned by the hashing stage and not by a queue of a reader
+	 */
+	if( hash_chunk != NULL )
+	{
+		hash_chunk_free(
+		 &hash_chunk,
+		 NULL );
+	}
+	/* Freeing the readers signals the running reader threads to abort and joins them
+	 */
+	libcdata_array_empty(
+	 hash_handle->readers_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &hash_reader_free,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Prints a byte size value to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_byte_size_value_fprint(
+     hash_handle_t *hash_handle,
+     const char *description,
+     size64_t value_size,
+     libcerror_error_t **error )
+{
+	system_character_t byte_size_string[ 16 ];
+
+	static char *function = "hash_handle_byte_size_value_fprint";
+	int result            = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( description == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid description.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\t%s:",
+	 description );
+
+	result = byte_size_string_create(
+	          byte_size_string,
+	          16,
+	          value_size,
+	          BYTE_SIZE_STRING_UNIT_MEBIBYTE,
+	          NULL );
+
+	if( result == 1 )
+	{
+		fprintf(
+		 hash_handle->notify_stream,
+		 " %" PRIs_SYSTEM " (%" PRIu64 " bytes)",
+		 byte_size_string,
+		 value_size );
+	}
+	else
+	{
+		fprintf(
+		 hash_handle->notify_stream,
+		 " %" PRIu64 " bytes",
+		 value_size );
+	}
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
+/* Prints the results to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_results_fprint(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	system_character_t digest_hash_string[ 2 * LIBHMAC_SHA256_HASH_SIZE + 1 ];
+
+	static char *function = "hash_handle_results_fprint";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid hash handle - missing digest context.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 hash_handle->notify_stream,
+	 "Read statistics:\n" );
+
+	if( hash_handle_byte_size_value_fprint(
+	     hash_handle,
+	     "Media size\t\t",
+	     hash_handle->media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle_byte_size_value_fprint(
+	     hash_handle,
+	     "Data read\t\t",
+	     hash_handle->number_of_bytes_read,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print data read size.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle_byte_size_value_fprint(
+	     hash_handle,
+	     "Sparse data not read\t",
+	     hash_handle->number_of_sparse_bytes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print sparse data size.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\n" );
+
+	if( hash_handle->digest_context->calculate_md5 != 0 )
+	{
+		if( digest_hash_copy_to_string(
+		     hash_handle->digest_context->md5_hash,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     digest_hash_string,
+		     2 * LIBHMAC_SHA256_HASH_SIZE + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to create MD5 digest hash string.",
+			 function );
+
+			return( -1 );
+		}
+		fprintf(
+		 hash_handle->notify_stream,
+		 "MD5 hash calculated over data:\t\t%" PRIs_SYSTEM "\n",
+		 digest_hash_string );
+	}
+	if( hash_handle->digest_context->calculate_sha1 != 0 )
+	{
+		if( digest_hash_copy_to_string(
+		     hash_handle->digest_context->sha1_hash,
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     digest_hash_string,
+		     2 * LIBHMAC_SHA256_HASH_SIZE + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to create SHA1 digest hash string.",
+			 function );
+
+			return( -1 );
+		}
+		fprintf(
+		 hash_handle->notify_stream,
+		 "SHA1 hash calculated over data:\t\t%" PRIs_SYSTEM "\n",
+		 digest_hash_string );
+	}
+	if( hash_handle->digest_context->calculate_sha256 != 0 )
+	{
+		if( digest_hash_copy_to_string(
+		     hash_handle->digest_context->sha256_hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     digest_hash_string,
+		     2 * LIBHMAC_SHA256_HASH_SIZE + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to create SHA256 digest hash string.",
+			 function );
+
+			return( -1 );
+		}
+		fprintf(
+		 hash_handle->notify_stream,
+		 "SHA256 hash calculated over data:\t%" PRIs_SYSTEM "\n",
+		 digest_hash_string );
+	}
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
@@ -0,0 +1,232 @@
+/*
+ * Hash handle
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _HASH_HANDLE_H )
+#define _HASH_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "digest_context.h"
+#include "hash_chunk.h"
+#include "vhditools_libcdata.h"
+#include "vhditools_libcerror.h"
+#include "vhditools_libvhdi.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct hash_handle hash_handle_t;
+
+struct hash_handle
+{
+	/* The basename
+	 */
+	system_character_t *basename;
+
+	/* The basename size
+	 */
+	size_t basename_size;
+
+	/* The input
+	 */
+	libvhdi_file_t *input;
+
+	/* The parent files array
+	 */
+	libcdata_array_t *parent_files_array;
+
+	/* The chunk size
+	 */
+	size_t chunk_size;
+
+	/* The piecewise size, where 0 represents that no piecewise digest hashes are calculated
+	 */
+	size64_t piecewise_size;
+
+	/* Value to indicate if the SHA1 digest hash should be calculated
+	 */
+	uint8_t calculate_sha1;
+
+	/* Value to indicate if the SHA256 digest hash should be calculated
+	 */
+	uint8_t calculate_sha256;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The readers array
+	 */
+	libcdata_array_t *readers_array;
+
+	/* The buffer of zero bytes that is hashed instead of sparse data
+	 */
+	uint8_t *zero_buffer;
+
+	/* The digest context of the media data
+	 */
+	digest_context_t *digest_context;
+
+	/* The digest context of the current piece
+	 */
+	digest_context_t *piecewise_digest_context;
+
+	/* The digest context of a piece that consists entirely of zero bytes
+	 */
+	digest_context_t *zero_piece_digest_context;
+
+	/* The offset of the current piece
+	 */
+	off64_t piece_offset;
+
+	/* The size of the data of the current piece
+	 */
+	size64_t piece_data_size;
+
+	/* The number of zero bytes at the end of the current piece that still need to be hashed
+	 */
+	size64_t piece_pending_zero_size;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The number of bytes read
+	 */
+	uint64_t number_of_bytes_read;
+
+	/* The number of sparse bytes that were not read
+	 */
+	uint64_t number_of_sparse_bytes;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int hash_handle_system_string_decimal_copy_to_64_bit(
+     const system_character_t *string,
+     size_t string_length,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
+int hash_handle_initialize(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_free(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_signal_abort(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_set_number_of_threads(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_chunk_size(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_piecewise_size(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_additional_digest_types(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_basename(
+     hash_handle_t *hash_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error );
+
+int hash_handle_open_input(
+     hash_handle_t *hash_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int hash_handle_open_parent(
+     hash_handle_t *hash_handle,
+     libvhdi_file_t *vhdi_file,
+     libcerror_error_t **error );
+
+int hash_handle_close(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_piece_fprint(
+     hash_handle_t *hash_handle,
+     digest_context_t *digest_context,
+     off64_t piece_offset,
+     size64_t piece_size,
+     libcerror_error_t **error );
+
+int hash_handle_finalize_piece(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_update_piece(
+     hash_handle_t *hash_handle,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t is_sparse,
+     libcerror_error_t **error );
+
+int hash_handle_hash_chunk(
+     hash_handle_t *hash_handle,
+     hash_chunk_t *hash_chunk,
+     libcerror_error_t **error );
+
+int hash_handle_calculate(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_byte_size_value_fprint(
+     hash_handle_t *hash_handle,
+     const char *description,
+     size64_t value_size,
+     libcerror_error_t **error );
+
+int hash_handle_results_fprint(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _HASH_HANDLE_H ) */
+
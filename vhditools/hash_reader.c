@@ -0,0 +1,863 @@
+/*
+ * Hash reader
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "hash_chunk.h"
+#include "hash_reader.h"
+#include "vhditools_libcerror.h"
+#include "vhditools_libcnotify.h"
+#include "vhditools_libcthreads.h"
+#include "vhditools_libvhdi.h"
+
+/* Creates a hash reader
+ * Make sure the value hash_reader is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int hash_reader_initialize(
+     hash_reader_t **hash_reader,
+     libvhdi_file_t *vhdi_file,
+     size64_t media_size,
+     size_t chunk_size,
+     int reader_index,
+     int number_of_readers,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+	hash_chunk_t *hash_chunk = NULL;
+	int chunk_index          = 0;
+#endif
+
+	static char *function    = "hash_reader_initialize";
+
+	if( hash_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_reader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash reader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( vhdi_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	 || ( media_size > (size64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( reader_index < 0 )
+	 || ( reader_index >= number_of_readers ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid reader index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*hash_reader = memory_allocate_structure(
+	                hash_reader_t );
+
+	if( *hash_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash reader.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *hash_reader,
+	     0,
+	     sizeof( hash_reader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash reader.",
+		 function );
+
+		memory_free(
+		 *hash_reader );
+
+		*hash_reader = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+	/* The queues can contain every chunk of the reader including the spare chunk
+	 * so that pushing a chunk onto a queue never blocks
+	 */
+	if( libcthreads_queue_initialize(
+	     &( ( *hash_reader )->empty_chunks_queue ),
+	     HASH_READER_NUMBER_OF_CHUNKS + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize empty chunks queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_queue_initialize(
+	     &( ( *hash_reader )->read_chunks_queue ),
+	     HASH_READER_NUMBER_OF_CHUNKS + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read chunks queue.",
+		 function );
+
+		goto on_error;
+	}
+	for( chunk_index = 0;
+	     chunk_index < HASH_READER_NUMBER_OF_CHUNKS;
+	     chunk_index++ )
+	{
+		if( hash_chunk_initialize(
+		     &hash_chunk,
+		     chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk: %d.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( libcthreads_queue_push(
+		     ( *hash_reader )->empty_chunks_queue,
+		     (intptr_t *) hash_chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk: %d onto empty chunks queue.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		hash_chunk = NULL;
+	}
+	if( hash_chunk_initialize(
+	     &( ( *hash_reader )->spare_chunk ),
+	     chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create spare chunk.",
+		 function );
+
+		goto on_error;
+	}
+#endif /* defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT ) */
+
+	( *hash_reader )->vhdi_file         = vhdi_file;
+	( *hash_reader )->media_size        = media_size;
+	( *hash_reader )->chunk_size        = chunk_size;
+	( *hash_reader )->number_of_chunks  = media_size / chunk_size;
+	( *hash_reader )->first_chunk_index = (uint64_t) reader_index;
+	( *hash_reader )->number_of_readers = number_of_readers;
+
+	if( ( media_size % chunk_size ) != 0 )
+	{
+		( *hash_reader )->number_of_chunks += 1;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+	if( hash_chunk != NULL )
+	{
+		hash_chunk_free(
+		 &hash_chunk,
+		 NULL );
+	}
+#endif
+	if( *hash_reader != NULL )
+	{
+		hash_reader_free(
+		 hash_reader,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a hash reader
+ * Returns 1 if successful or -1 on error
+ */
+int hash_reader_free(
+     hash_reader_t **hash_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_reader_free";
+	int result            = 1;
+
+	if( hash_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_reader != NULL )
+	{
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+		if( ( *hash_reader )->thread != NULL )
+		{
+			( *hash_reader )->abort = 1;
+
+			/* Push the spare chunk onto the empty chunks queue to wake up
+			 * the reader in case it is waiting for a chunk to read into
+			 */
+			if( ( *hash_reader )->spare_chunk != NULL )
+			{
+				if( libcthreads_queue_push(
+				     ( *hash_reader )->empty_chunks_queue,
+				     (intptr_t *) ( *hash_reader )->spare_chunk,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to push spare chunk onto empty chunks queue.",
+					 function );
+
+					result = -1;
+				}
+				else
+				{
+					( *hash_reader )->spare_chunk = NULL;
+				}
+			}
+			if( libcthreads_thread_join(
+			     &( ( *hash_reader )->thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *hash_reader )->read_chunks_queue != NULL )
+		{
+			if( libcthreads_queue_free(
+			     &( ( *hash_reader )->read_chunks_queue ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &hash_chunk_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free read chunks queue.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *hash_reader )->empty_chunks_queue != NULL )
+		{
+			if( libcthreads_queue_free(
+			     &( ( *hash_reader )->empty_chunks_queue ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &hash_chunk_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free empty chunks queue.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *hash_reader )->spare_chunk != NULL )
+		{
+			if( hash_chunk_free(
+			     &( ( *hash_reader )->spare_chunk ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free spare chunk.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif /* defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT ) */
+
+		/* The vhdi_file reference is freed elsewhere
+		 */
+		memory_free(
+		 *hash_reader );
+
+		*hash_reader = NULL;
+	}
+	return( result );
+}
+
+/* Signals the hash reader to abort
+ * Returns 1 if successful or -1 on error
+ */
+int hash_reader_signal_abort(
+     hash_reader_t *hash_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_reader_signal_abort";
+
+	if( hash_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash reader.",
+		 function );
+
+		return( -1 );
+	}
+	hash_reader->abort = 1;
+
+	return( 1 );
+}
+
+/* Reads a specific chunk
+ * A chunk that is sparse in the file and all its parent files is not read,
+ * since its data consists of zero bytes
+ * Returns 1 if successful or -1 on error
+ */
+int hash_reader_read_chunk(
+     hash_reader_t *hash_reader,
+     hash_chunk_t *hash_chunk,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_reader_read_chunk";
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	off64_t chunk_offset  = 0;
+	int result            = 0;
+
+	if( hash_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_chunk->allocated_data_size < hash_reader->chunk_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid hash chunk - data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index >= hash_reader->number_of_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_offset = (off64_t) ( chunk_index * hash_reader->chunk_size );
+	read_size    = hash_reader->chunk_size;
+
+	if( (size64_t) read_size > ( hash_reader->media_size - chunk_offset ) )
+	{
+		read_size = (size_t) ( hash_reader->media_size - chunk_offset );
+	}
+	hash_chunk->offset    = chunk_offset;
+	hash_chunk->data_size = read_size;
+	hash_chunk->is_sparse = 0;
+
+	/* Since the chunks are read in increasing order the most recently retrieved extent
+	 * spans the chunk until the chunk is beyond the end of the extent
+	 */
+	if( ( chunk_offset < hash_reader->extent_offset )
+	 || ( (size64_t) ( chunk_offset - hash_reader->extent_offset ) >= hash_reader->extent_size ) )
+	{
+		result = libvhdi_file_get_next_chain_extent(
+		          hash_reader->vhdi_file,
+		          chunk_offset,
+		          &( hash_reader->extent_offset ),
+		          &( hash_reader->extent_size ),
+		          &( hash_reader->extent_flags ),
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 chunk_offset,
+			 chunk_offset );
+
+			hash_reader->extent_size = 0;
+
+			return( -1 );
+		}
+	}
+	if( ( ( hash_reader->extent_flags & LIBVHDI_EXTENT_FLAG_IS_SPARSE ) != 0 )
+	 && ( ( (size64_t) ( chunk_offset - hash_reader->extent_offset ) + read_size ) <= hash_reader->extent_size ) )
+	{
+		hash_chunk->is_sparse = 1;
+
+		hash_reader->number_of_sparse_bytes += read_size;
+
+		return( 1 );
+	}
+	read_count = libvhdi_file_read_buffer_at_offset(
+	              hash_reader->vhdi_file,
+	              hash_chunk->data,
+	              read_size,
+	              chunk_offset,
+	              error );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 chunk_offset,
+		 chunk_offset );
+
+		return( -1 );
+	}
+	hash_reader->number_of_bytes_read += (uint64_t) read_count;
+
+	return( 1 );
+}
+
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+
+/* Reads the chunks of the reader until all chunks are read or abort is signalled
+ * Every chunk is passed to the hashing stage by the read chunks queue, including
+ * the chunk that failed to read or was aborted, so that the hashing stage never
+ * waits for a chunk that will not be read
+ * Returns 1 if successful or -1 on error
+ */
+int hash_reader_run(
+     hash_reader_t *hash_reader,
+     libcerror_error_t **error )
+{
+	hash_chunk_t *hash_chunk = NULL;
+	static char *function    = "hash_reader_run";
+	uint64_t chunk_index     = 0;
+	int result               = 1;
+
+	if( hash_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash reader.",
+		 function );
+
+		return( -1 );
+	}
+	for( chunk_index = hash_reader->first_chunk_index;
+	     chunk_index < hash_reader->number_of_chunks;
+	     chunk_index += (uint64_t) hash_reader->number_of_readers )
+	{
+		if( libcthreads_queue_pop(
+		     hash_reader->empty_chunks_queue,
+		     (intptr_t **) &hash_chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to pop chunk from empty chunks queue.",
+			 function );
+
+			return( -1 );
+		}
+		if( hash_reader->abort != 0 )
+		{
+			hash_chunk->result = 0;
+		}
+		else
+		{
+			hash_chunk->result = hash_reader_read_chunk(
+			                      hash_reader,
+			                      hash_chunk,
+			                      chunk_index,
+			                      error );
+		}
+		result = hash_chunk->result;
+
+		if( libcthreads_queue_push(
+		     hash_reader->read_chunks_queue,
+		     (intptr_t *) hash_chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk onto read chunks queue.",
+			 function );
+
+			hash_chunk_free(
+			 &hash_chunk,
+			 NULL );
+
+			return( -1 );
+		}
+		hash_chunk = NULL;
+
+		if( result != 1 )
+		{
+			break;
+		}
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* The hash reader thread function
+ * Returns 1 if successful or -1 on error
+ */
+int hash_reader_thread_function(
+     void *arguments )
+{
+	hash_reader_t *hash_reader = NULL;
+	libcerror_error_t *error   = NULL;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	hash_reader = (hash_reader_t *) arguments;
+
+	hash_reader->result = hash_reader_run(
+	                       hash_reader,
+	                       &error );
+
+	if( hash_reader->result != 1 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( hash_reader->result );
+}
+
+/* Starts the hash reader thread
+ * Returns 1 if successful or -1 on error
+ */
+int hash_reader_start(
+     hash_reader_t *hash_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_reader_start";
+
+	if( hash_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_reader->thread != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash reader - thread value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_create(
+	     &( hash_reader->thread ),
+	     NULL,
+	     &hash_reader_thread_function,
+	     (void *) hash_reader,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Waits for the hash reader thread to finish
+ * Returns 1 if successful or -1 on error
+ */
+int hash_reader_join(
+     hash_reader_t *hash_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_reader_join";
+
+	if( hash_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_reader->thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid hash reader - missing thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_join(
+	     &( hash_reader->thread ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join thread.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the next read chunk, waiting until the reader has read it
+ * The chunk must be released after it has been hashed
+ * Returns 1 if successful or -1 on error
+ */
+int hash_reader_get_read_chunk(
+     hash_reader_t *hash_reader,
+     hash_chunk_t **hash_chunk,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_reader_get_read_chunk";
+
+	if( hash_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_queue_pop(
+	     hash_reader->read_chunks_queue,
+	     (intptr_t **) hash_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pop chunk from read chunks queue.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Releases a chunk so that the reader can read the next chunk into it
+ * Returns 1 if successful or -1 on error
+ */
+int hash_reader_release_chunk(
+     hash_reader_t *hash_reader,
+     hash_chunk_t *hash_chunk,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_reader_release_chunk";
+
+	if( hash_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_queue_push(
+	     hash_reader->empty_chunks_queue,
+	     (intptr_t *) hash_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push chunk onto empty chunks queue.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,173 @@
+/*
+ * Hash reader
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _HASH_READER_H )
+#define _HASH_READER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "hash_chunk.h"
+#include "vhditools_libcerror.h"
+#include "vhditools_libcthreads.h"
+#include "vhditools_libvhdi.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of chunks a reader can read ahead of the hashing stage
+ */
+#define HASH_READER_NUMBER_OF_CHUNKS	4
+
+typedef struct hash_reader hash_reader_t;
+
+struct hash_reader
+{
+	/* The file
+	 */
+	libvhdi_file_t *vhdi_file;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The chunk size
+	 */
+	size_t chunk_size;
+
+	/* The number of chunks in the media
+	 */
+	uint64_t number_of_chunks;
+
+	/* The index of the first chunk read by the reader
+	 */
+	uint64_t first_chunk_index;
+
+	/* The number of readers, where every reader reads every number of readers-th chunk
+	 */
+	int number_of_readers;
+
+	/* The offset of the most recently retrieved extent
+	 */
+	off64_t extent_offset;
+
+	/* The size of the most recently retrieved extent
+	 */
+	size64_t extent_size;
+
+	/* The flags of the most recently retrieved extent
+	 */
+	uint32_t extent_flags;
+
+	/* The number of bytes read
+	 */
+	uint64_t number_of_bytes_read;
+
+	/* The number of sparse bytes that were not read
+	 */
+	uint64_t number_of_sparse_bytes;
+
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+	/* The queue of chunks that are available to be read into
+	 */
+	libcthreads_queue_t *empty_chunks_queue;
+
+	/* The queue of chunks that have been read, in media order
+	 */
+	libcthreads_queue_t *read_chunks_queue;
+
+	/* The spare chunk, used to wake up the reader when it is aborted
+	 */
+	hash_chunk_t *spare_chunk;
+
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+#endif
+
+	/* The result of the reader
+	 */
+	int result;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int hash_reader_initialize(
+     hash_reader_t **hash_reader,
+     libvhdi_file_t *vhdi_file,
+     size64_t media_size,
+     size_t chunk_size,
+     int reader_index,
+     int number_of_readers,
+     libcerror_error_t **error );
+
+int hash_reader_free(
+     hash_reader_t **hash_reader,
+     libcerror_error_t **error );
+
+int hash_reader_signal_abort(
+     hash_reader_t *hash_reader,
+     libcerror_error_t **error );
+
+int hash_reader_read_chunk(
+     hash_reader_t *hash_reader,
+     hash_chunk_t *hash_chunk,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+
+int hash_reader_run(
+     hash_reader_t *hash_reader,
+     libcerror_error_t **error );
+
+int hash_reader_thread_function(
+     void *arguments );
+
+int hash_reader_start(
+     hash_reader_t *hash_reader,
+     libcerror_error_t **error );
+
+int hash_reader_join(
+     hash_reader_t *hash_reader,
+     libcerror_error_t **error );
+
+int hash_reader_get_read_chunk(
+     hash_reader_t *hash_reader,
+     hash_chunk_t **hash_chunk,
+     libcerror_error_t **error );
+
+int hash_reader_release_chunk(
+     hash_reader_t *hash_reader,
+     hash_chunk_t *hash_chunk,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _HASH_READER_H ) */
+
@@ -27,15 +27,108 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "allocation_statistics.h"
+#include "allocation_worker.h"
 #include "byte_size_string.h"
 #include "info_handle.h"
+#include "vhditools_libcdata.h"
 #include "vhditools_libcerror.h"
 #include "vhditools_libcnotify.h"
+#include "vhditools_libcpath.h"
+#include "vhditools_libcthreads.h"
 #include "vhditools_libfguid.h"
 #include "vhditools_libvhdi.h"
 
 #define INFO_HANDLE_NOTIFY_STREAM		stdout
 
+#define INFO_HANDLE_MAXIMUM_NUMBER_OF_THREADS	256
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_system_string_decimal_copy_to_64_bit(
+     const system_character_t *string,
+     size_t string_length,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function     = "info_handle_system_string_decimal_copy_to_64_bit";
+	size_t string_index       = 0;
+	uint64_t safe_value_64bit = 0;
+	uint8_t digit             = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( string_length == 0 )
+	 || ( string_length > 20 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid string length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	for( string_index = 0;
+	     string_index < string_length;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] < (system_character_t) '0' )
+		 || ( string[ string_index ] > (system_character_t) '9' ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value at index: %" PRIzd ".",
+			 function,
+			 string_index );
+
+			return( -1 );
+		}
+		digit = (uint8_t) ( string[ string_index ] - (system_character_t) '0' );
+
+		if( safe_value_64bit > ( ( UINT64_MAX - digit ) / 10 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		safe_value_64bit *= 10;
+		safe_value_64bit += digit;
+	}
+	*value_64bit = safe_value_64bit;
+
+	return( 1 );
+}
+
 /* Creates an info handle
  * Make sure the value info_handle is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -114,13 +207,55 @@ int info_handle_initialize(
 
 		goto on_error;
 	}
-	( *info_handle )->notify_stream = INFO_HANDLE_NOTIFY_STREAM;
+	if( libcdata_array_initialize(
+	     &( ( *info_handle )->parent_files_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize parent files array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *info_handle )->workers_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize workers array.",
+		 function );
+
+		goto on_error;
+	}
+	( *info_handle )->number_of_threads = 1;
+	( *info_handle )->notify_stream     = INFO_HANDLE_NOTIFY_STREAM;
 
 	return( 1 );
 
 on_error:
 	if( *info_handle != NULL )
 	{
+		if( ( *info_handle )->parent_files_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *info_handle )->parent_files_array ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *info_handle )->input != NULL )
+		{
+			libvhdi_file_free(
+			 &( ( *info_handle )->input ),
+			 NULL );
+		}
 		memory_free(
 		 *info_handle );
 
@@ -152,6 +287,20 @@ int info_handle_free(
 	}
 	if( *info_handle != NULL )
 	{
+		if( libcdata_array_free(
+		     &( ( *info_handle )->workers_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &allocation_worker_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free workers array.",
+			 function );
+
+			result = -1;
+		}
 		if( ( *info_handle )->input != NULL )
 		{
 			if( libvhdi_file_free(
@@ -168,6 +317,27 @@ int info_handle_free(
 				result = -1;
 			}
 		}
+		/* The parent files must be freed after the input that references them
+		 */
+		if( libcdata_array_free(
+		     &( ( *info_handle )->parent_files_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvhdi_file_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free parent files array.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *info_handle )->basename != NULL )
+		{
+			memory_free(
+			 ( *info_handle )->basename );
+		}
 		memory_free(
 		 *info_handle );
 
@@ -183,7 +353,10 @@ int info_handle_signal_abort(
      info_handle_t *info_handle,
      libcerror_error_t **error )
 {
-	static char *function = "info_handle_signal_abort";
+	allocation_worker_t *allocation_worker = NULL;
+	static char *function                  = "info_handle_signal_abort";
+	int number_of_workers                  = 0;
+	int worker_index                       = 0;
 
 	if( info_handle == NULL )
 	{
@@ -196,6 +369,57 @@ int info_handle_signal_abort(
 
 		return( -1 );
 	}
+	info_handle->abort = 1;
+
+	if( libcdata_array_get_number_of_entries(
+	     info_handle->workers_array,
+	     &number_of_workers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of workers.",
+		 function );
+
+		return( -1 );
+	}
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     info_handle->workers_array,
+		     worker_index,
+		     (intptr_t **) &allocation_worker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve worker: %d.",
+			 function,
+			 worker_index );
+
+			return( -1 );
+		}
+		if( allocation_worker_signal_abort(
+		     allocation_worker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal worker: %d to abort.",
+			 function,
+			 worker_index );
+
+			return( -1 );
+		}
+	}
 	if( info_handle->input != NULL )
 	{
 		if( libvhdi_file_signal_abort(
@@ -215,15 +439,17 @@ int info_handle_signal_abort(
 	return( 1 );
 }
 
-/* Opens the info handle
- * Returns 1 if successful or -1 on error
+/* Sets the number of threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
-int info_handle_open_input(
+int info_handle_set_number_of_threads(
      info_handle_t *info_handle,
-     const system_character_t *filename,
+     const system_character_t *string,
      libcerror_error_t **error )
 {
-	static char *function = "info_handle_open_input";
+	static char *function = "info_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
 
 	if( info_handle == NULL )
 	{
@@ -236,40 +462,59 @@ int info_handle_open_input(
 
 		return( -1 );
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libvhdi_file_open_wide(
-	     info_handle->input,
-	     filename,
-	     LIBVHDI_OPEN_READ,
-	     error ) != 1 )
-#else
-	if( libvhdi_file_open(
-	     info_handle->input,
-	     filename,
-	     LIBVHDI_OPEN_READ,
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( info_handle_system_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length,
+	     &value_64bit,
 	     error ) != 1 )
-#endif
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open input.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to determine number of threads.",
 		 function );
 
 		return( -1 );
 	}
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) INFO_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+#else
+	if( value_64bit != 1 )
+#endif
+	{
+		return( 0 );
+	}
+	info_handle->number_of_threads = (int) value_64bit;
+
 	return( 1 );
 }
 
-/* Closes the info handle
- * Returns the 0 if successful or -1 on error
+/* Sets the basename
+ * Returns 1 if successful or -1 on error
  */
-int info_handle_close(
+int info_handle_set_basename(
      info_handle_t *info_handle,
+     const system_character_t *basename,
+     size_t basename_size,
      libcerror_error_t **error )
 {
-	static char *function = "info_handle_close";
+	static char *function = "info_handle_set_basename";
 
 	if( info_handle == NULL )
 	{
@@ -282,55 +527,109 @@ int info_handle_close(
 
 		return( -1 );
 	}
-	if( info_handle->input == NULL )
+	if( info_handle->basename != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid info handle - missing input.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid info handle - basename value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( libvhdi_file_close(
-	     info_handle->input,
-	     error ) != 0 )
+	if( basename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-		 "%s: unable to close input.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
 		 function );
 
 		return( -1 );
 	}
-	return( 0 );
+	if( basename_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing basename.",
+		 function );
+
+		goto on_error;
+	}
+	if( basename_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid basename size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	info_handle->basename = system_string_allocate(
+	                         basename_size );
+
+	if( info_handle->basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create basename string.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     info_handle->basename,
+	     basename,
+	     basename_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy basename.",
+		 function );
+
+		goto on_error;
+	}
+	info_handle->basename[ basename_size - 1 ] = 0;
+
+	info_handle->basename_size = basename_size;
+
+	return( 1 );
+
+on_error:
+	if( info_handle->basename != NULL )
+	{
+		memory_free(
+		 info_handle->basename );
+
+		info_handle->basename = NULL;
+	}
+	info_handle->basename_size = 0;
+
+	return( -1 );
 }
 
-/* Prints the image information to a stream
+/* Opens the info handle
  * Returns 1 if successful or -1 on error
  */
-int info_handle_image_fprint(
+int info_handle_open_input(
      info_handle_t *info_handle,
+     const system_character_t *filename,
      libcerror_error_t **error )
 {
-	system_character_t byte_size_string[ 16 ];
-	system_character_t guid_string[ 48 ];
-	uint8_t guid_data[ 16 ];
-
-	libfguid_identifier_t *guid          = NULL;
-	system_character_t *disk_type_string = NULL;
-	system_character_t *value_string     = NULL;
-	static char *function                = "info_handle_image_fprint";
-	size64_t media_size                  = 0;
-	size_t value_string_size             = 0;
-	uint32_t value_32bit                 = 0;
-	uint16_t major_version               = 0;
-	uint16_t minor_version               = 0;
-	int file_type                        = 0;
-	int result                           = 0;
+	const system_character_t *basename_end = NULL;
+	static char *function                  = "info_handle_open_input";
+	size_t basename_length                 = 0;
+	size_t filename_length                 = 0;
 
 	if( info_handle == NULL )
 	{
@@ -343,445 +642,1851 @@ int info_handle_image_fprint(
 
 		return( -1 );
 	}
-	if( libvhdi_file_get_file_type(
-	     info_handle->input,
-	     &file_type,
-	     error ) != 1 )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file type.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	fprintf(
-	 info_handle->notify_stream,
-	 "Virtual Hard Disk image information:\n" );
+	filename_length = system_string_length(
+	                   filename );
 
-	fprintf(
-	 info_handle->notify_stream,
-	 "\tFormat\t\t\t:" );
+	basename_end = system_string_search_character_reverse(
+	                filename,
+	                (system_character_t) LIBCPATH_SEPARATOR,
+	                filename_length + 1 );
 
-	switch( file_type )
+	if( basename_end != NULL )
 	{
-		case LIBVHDI_FILE_TYPE_VHD:
-			fprintf(
-			 info_handle->notify_stream,
-			 " VHD (version 1)" );
-			break;
-
-		case LIBVHDI_FILE_TYPE_VHDX:
-			fprintf(
-			 info_handle->notify_stream,
-			 " VHDX (version 2)" );
-			break;
-
-		default:
-			fprintf(
-			 info_handle->notify_stream,
-			 " Unknown" );
-			break;
+		basename_length = (size_t) ( basename_end - filename ) + 1;
 	}
-	fprintf(
-	 info_handle->notify_stream,
-	 "\n" );
+	if( ( basename_length > 0 )
+	 && ( info_handle->basename == NULL ) )
+	{
+		if( info_handle_set_basename(
+		     info_handle,
+		     filename,
+		     basename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set basename.",
+			 function );
 
-	if( libvhdi_file_get_format_version(
+			return( -1 );
+		}
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvhdi_file_open_wide(
 	     info_handle->input,
-	     &major_version,
-	     &minor_version,
+	     filename,
+	     LIBVHDI_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvhdi_file_open(
+	     info_handle->input,
+	     filename,
+	     LIBVHDI_OPEN_READ,
 	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens the parent file of a file and recursively its parents
+ * The parent files are managed by the info handle
+ * Returns 1 if successful, 0 if no parent or -1 on error
+ */
+int info_handle_open_parent(
+     info_handle_t *info_handle,
+     libvhdi_file_t *vhdi_file,
+     libcerror_error_t **error )
+{
+	uint8_t guid[ 16 ];
+
+	libvhdi_file_t *parent_vhdi_file              = NULL;
+	const system_character_t *parent_basename_end = NULL;
+	system_character_t *parent_filename           = NULL;
+	system_character_t *parent_path               = NULL;
+	system_character_t *vhdi_parent_path          = NULL;
+	static char *function                         = "info_handle_open_parent";
+	size_t parent_basename_length                 = 0;
+	size_t parent_filename_size                   = 0;
+	size_t parent_path_size                       = 0;
+	int entry_index                               = 0;
+	int result                                    = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvhdi_file_get_parent_identifier(
+	          vhdi_file,
+	          guid,
+	          16,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve format version.",
+		 "%s: unable to retrieve parent content identifier.",
 		 function );
 
 		goto on_error;
 	}
-	fprintf(
-	 info_handle->notify_stream,
-	 "\tFormat version\t\t:" );
-
-	if( file_type == LIBVHDI_FILE_TYPE_VHD )
+	else if( result != 1 )
 	{
-		fprintf(
-		 info_handle->notify_stream,
-		 " %" PRIu16 ".%" PRIu16 "",
-		 major_version,
-		 minor_version );
+		return( 0 );
 	}
-	else if( file_type == LIBVHDI_FILE_TYPE_VHDX )
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvhdi_file_get_utf16_parent_filename_size(
+	          vhdi_file,
+	          &parent_filename_size,
+	          error );
+#else
+	result = libvhdi_file_get_utf8_parent_filename_size(
+	          vhdi_file,
+	          &parent_filename_size,
+	          error );
+#endif
+	if( result != 1 )
 	{
-		fprintf(
-		 info_handle->notify_stream,
-		 " %" PRIu16 "",
-		 major_version );
-	}
-	fprintf(
-	 info_handle->notify_stream,
-	 "\n" );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename size.",
+		 function );
 
-	if( libvhdi_file_get_disk_type(
-	     info_handle->input,
-	     &value_32bit,
-	     error ) != 1 )
+		goto on_error;
+	}
+	if( parent_filename_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve disk type.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing parent filename.",
 		 function );
 
 		goto on_error;
 	}
-	switch( value_32bit )
+	if( parent_filename_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) )
 	{
-		case LIBVHDI_DISK_TYPE_FIXED:
-			disk_type_string = "Fixed";
-			break;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid parent filename size value exceeds maximum.",
+		 function );
 
-		case LIBVHDI_DISK_TYPE_DYNAMIC:
-			disk_type_string = "Dynamic";
-			break;
+		goto on_error;
+	}
+	parent_filename = system_string_allocate(
+	                   parent_filename_size );
 
-		case LIBVHDI_DISK_TYPE_DIFFERENTIAL:
-			disk_type_string = "Differential";
-			break;
+	if( parent_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parent filename string.",
+		 function );
 
-		default:
-			disk_type_string = "Unknown";
-			break;
+		goto on_error;
 	}
-	fprintf(
-	 info_handle->notify_stream,
-	 "\tDisk type\t\t: %" PRIs_SYSTEM "\n",
-	 disk_type_string );
-
-	if( libvhdi_file_get_media_size(
-	     info_handle->input,
-	     &media_size,
-	     error ) != 1 )
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvhdi_file_get_utf16_parent_filename(
+	          vhdi_file,
+	          (uint16_t *) parent_filename,
+	          parent_filename_size,
+	          error );
+#else
+	result = libvhdi_file_get_utf8_parent_filename(
+	          vhdi_file,
+	          (uint8_t *) parent_filename,
+	          parent_filename_size,
+	          error );
+#endif
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve media size.",
+		 "%s: unable to retrieve parent filename.",
 		 function );
 
 		goto on_error;
 	}
-	fprintf(
-	 info_handle->notify_stream,
-	 "\tMedia size\t\t:" );
-
-	result = byte_size_string_create(
-	          byte_size_string,
-	          16,
-	          media_size,
-	          BYTE_SIZE_STRING_UNIT_MEBIBYTE,
-	          NULL );
+	parent_basename_end = system_string_search_character_reverse(
+	                       parent_filename,
+	                       (system_character_t) '\\',
+	                       parent_filename_size );
 
-	if( result == 1 )
+	if( parent_basename_end != NULL )
 	{
-		fprintf(
-		 info_handle->notify_stream,
-		 " %" PRIs_SYSTEM " (%" PRIu64 " bytes)",
-		 byte_size_string,
-		 media_size );
+		parent_basename_length = (size_t) ( parent_basename_end - parent_filename ) + 1;
+	}
+	if( info_handle->basename == NULL )
+	{
+		vhdi_parent_path = &( parent_filename[ parent_basename_length ] );
 	}
 	else
 	{
-		fprintf(
-		 info_handle->notify_stream,
-		 " %" PRIu64 " bytes",
-		 media_size );
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcpath_path_join_wide(
+		     &parent_path,
+		     &parent_path_size,
+		     info_handle->basename,
+		     info_handle->basename_size - 1,
+		     &( parent_filename[ parent_basename_length ] ),
+		     parent_filename_size - ( parent_basename_length + 1 ),
+		     error ) != 1 )
+#else
+		if( libcpath_path_join(
+		     &parent_path,
+		     &parent_path_size,
+		     info_handle->basename,
+		     info_handle->basename_size - 1,
+		     &( parent_filename[ parent_basename_length ] ),
+		     parent_filename_size - ( parent_basename_length + 1 ),
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create parent path.",
+			 function );
+
+			goto on_error;
+		}
+		vhdi_parent_path = parent_path;
 	}
-	fprintf(
-	 info_handle->notify_stream,
-	 "\n" );
+	if( libvhdi_file_initialize(
+	     &parent_vhdi_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize parent file.",
+		 function );
 
-	if( libvhdi_file_get_bytes_per_sector(
-	     info_handle->input,
-	     &value_32bit,
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvhdi_file_open_wide(
+	     parent_vhdi_file,
+	     vhdi_parent_path,
+	     LIBVHDI_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvhdi_file_open(
+	     parent_vhdi_file,
+	     vhdi_parent_path,
+	     LIBVHDI_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent file: %" PRIs_SYSTEM ".",
+		 function,
+		 vhdi_parent_path );
+
+		goto on_error;
+	}
+	if( libcdata_array_append_entry(
+	     info_handle->parent_files_array,
+	     &entry_index,
+	     (intptr_t *) parent_vhdi_file,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve bytes per sector.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append parent file to array.",
 		 function );
 
+		libvhdi_file_close(
+		 parent_vhdi_file,
+		 NULL );
+
+		goto on_error;
+	}
+	if( info_handle_open_parent(
+	     info_handle,
+	     parent_vhdi_file,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent file of: %" PRIs_SYSTEM ".",
+		 function,
+		 vhdi_parent_path );
+
+		/* The parent file is freed by the info handle
+		 */
+		parent_vhdi_file = NULL;
+
 		goto on_error;
 	}
+	if( libvhdi_file_set_parent_file(
+	     vhdi_file,
+	     parent_vhdi_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set parent file.",
+		 function );
+
+		parent_vhdi_file = NULL;
+
+		goto on_error;
+	}
+	if( parent_path != NULL )
+	{
+		memory_free(
+		 parent_path );
+
+		parent_path = NULL;
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+
+		parent_filename = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( parent_vhdi_file != NULL )
+	{
+		libvhdi_file_free(
+		 &parent_vhdi_file,
+		 NULL );
+	}
+	if( parent_path != NULL )
+	{
+		memory_free(
+		 parent_path );
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+	}
+	return( -1 );
+}
+
+/* Closes the info handle
+ * Returns the 0 if successful or -1 on error
+ */
+int info_handle_close(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	libvhdi_file_t *parent_vhdi_file = NULL;
+	static char *function            = "info_handle_close";
+	int file_index                   = 0;
+	int number_of_parent_files       = 0;
+	int result                       = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle->input == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid info handle - missing input.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_file_close(
+	     info_handle->input,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input.",
+		 function );
+
+		result = -1;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     info_handle->parent_files_array,
+	     &number_of_parent_files,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of parent files.",
+		 function );
+
+		return( -1 );
+	}
+	/* The parent files are closed from the input towards its last parent
+	 */
+	for( file_index = 0;
+	     file_index < number_of_parent_files;
+	     file_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     info_handle->parent_files_array,
+		     file_index,
+		     (intptr_t **) &parent_vhdi_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent file: %d.",
+			 function,
+			 file_index );
+
+			result = -1;
+
+			continue;
+		}
+		if( libvhdi_file_close(
+		     parent_vhdi_file,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close parent file: %d.",
+			 function,
+			 file_index );
+
+			result = -1;
+		}
+	}
+	if( libcdata_array_empty(
+	     info_handle->parent_files_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libvhdi_file_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty parent files array.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Prints the image information to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_image_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	system_character_t byte_size_string[ 16 ];
+	system_character_t guid_string[ 48 ];
+	uint8_t guid_data[ 16 ];
+
+	libfguid_identifier_t *guid          = NULL;
+	system_character_t *disk_type_string = NULL;
+	system_character_t *value_string     = NULL;
+	static char *function                = "info_handle_image_fprint";
+	size64_t media_size                  = 0;
+	size_t value_string_size             = 0;
+	uint32_t value_32bit                 = 0;
+	uint16_t major_version               = 0;
+	uint16_t minor_version               = 0;
+	int file_type                        = 0;
+	int result                           = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_file_get_file_type(
+	     info_handle->input,
+	     &file_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file type.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "Virtual Hard Disk image information:\n" );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tFormat\t\t\t:" );
+
+	switch( file_type )
+	{
+		case LIBVHDI_FILE_TYPE_VHD:
+			fprintf(
+			 info_handle->notify_stream,
+			 " VHD (version 1)" );
+			break;
+
+		case LIBVHDI_FILE_TYPE_VHDX:
+			fprintf(
+			 info_handle->notify_stream,
+			 " VHDX (version 2)" );
+			break;
+
+		default:
+			fprintf(
+			 info_handle->notify_stream,
+			 " Unknown" );
+			break;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	if( libvhdi_file_get_format_version(
+	     info_handle->input,
+	     &major_version,
+	     &minor_version,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve format version.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tFormat version\t\t:" );
+
+	if( file_type == LIBVHDI_FILE_TYPE_VHD )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 " %" PRIu16 ".%" PRIu16 "",
+		 major_version,
+		 minor_version );
+	}
+	else if( file_type == LIBVHDI_FILE_TYPE_VHDX )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 " %" PRIu16 "",
+		 major_version );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	if( libvhdi_file_get_disk_type(
+	     info_handle->input,
+	     &value_32bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve disk type.",
+		 function );
+
+		goto on_error;
+	}
+	switch( value_32bit )
+	{
+		case LIBVHDI_DISK_TYPE_FIXED:
+			disk_type_string = "Fixed";
+			break;
+
+		case LIBVHDI_DISK_TYPE_DYNAMIC:
+			disk_type_string = "Dynamic";
+			break;
+
+		case LIBVHDI_DISK_TYPE_DIFFERENTIAL:
+			disk_type_string = "Differential";
+			break;
+
+		default:
+			disk_type_string = "Unknown";
+			break;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tDisk type\t\t: %" PRIs_SYSTEM "\n",
+	 disk_type_string );
+
+	if( libvhdi_file_get_media_size(
+	     info_handle->input,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tMedia size\t\t:" );
+
+	result = byte_size_string_create(
+	          byte_size_string,
+	          16,
+	          media_size,
+	          BYTE_SIZE_STRING_UNIT_MEBIBYTE,
+	          NULL );
+
+	if( result == 1 )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 " %" PRIs_SYSTEM " (%" PRIu64 " bytes)",
+		 byte_size_string,
+		 media_size );
+	}
+	else
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 " %" PRIu64 " bytes",
+		 media_size );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	if( libvhdi_file_get_bytes_per_sector(
+	     info_handle->input,
+	     &value_32bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve bytes per sector.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tBytes per sector\t: %" PRIu32 " bytes\n",
+	 value_32bit );
+
+	if( libfguid_identifier_initialize(
+	     &guid,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create GUID.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvhdi_file_get_identifier(
+	     info_handle->input,
+	     guid_data,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfguid_identifier_copy_from_byte_stream(
+	     guid,
+	     guid_data,
+	     16,
+	     LIBFGUID_ENDIAN_BIG,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy byte stream to GUID.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libfguid_identifier_copy_to_utf16_string(
+		  guid,
+		  (uint16_t *) guid_string,
+		  48,
+		  LIBFGUID_STRING_FORMAT_FLAG_USE_LOWER_CASE,
+		  error );
+#else
+	result = libfguid_identifier_copy_to_utf8_string(
+		  guid,
+		  (uint8_t *) guid_string,
+		  48,
+		  LIBFGUID_STRING_FORMAT_FLAG_USE_LOWER_CASE,
+		  error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy GUID to string.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tIdentifier\t\t: %" PRIs_SYSTEM "\n",
+	 guid_string );
+
+	result = libvhdi_file_get_parent_identifier(
+	          info_handle->input,
+	          guid_data,
+	          16,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent identifier.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libfguid_identifier_copy_from_byte_stream(
+		     guid,
+		     guid_data,
+		     16,
+		     LIBFGUID_ENDIAN_BIG,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy byte stream to GUID.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libfguid_identifier_copy_to_utf16_string(
+		          guid,
+		          (uint16_t *) guid_string,
+		          48,
+		          LIBFGUID_STRING_FORMAT_FLAG_USE_LOWER_CASE,
+		          error );
+#else
+		result = libfguid_identifier_copy_to_utf8_string(
+		          guid,
+		          (uint8_t *) guid_string,
+		          48,
+		          LIBFGUID_STRING_FORMAT_FLAG_USE_LOWER_CASE,
+		          error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy GUID to string.",
+			 function );
+
+			goto on_error;
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tParent identifier\t: %" PRIs_SYSTEM "\n",
+		 guid_string );
+	}
+	if( libfguid_identifier_free(
+	     &guid,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free GUID.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvhdi_file_get_utf16_parent_filename_size(
+		  info_handle->input,
+		  &value_string_size,
+		  error );
+#else
+	result = libvhdi_file_get_utf8_parent_filename_size(
+		  info_handle->input,
+		  &value_string_size,
+		  error );
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename string size.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( value_string_size > (size_t) ( SSIZE_MAX / sizeof( system_character_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid parent filename size value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		value_string = system_string_allocate(
+				value_string_size );
+
+		if( value_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create parent filename string.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libvhdi_file_get_utf16_parent_filename(
+			  info_handle->input,
+			  (uint16_t *) value_string,
+			  value_string_size,
+			  error );
+#else
+		result = libvhdi_file_get_utf8_parent_filename(
+			  info_handle->input,
+			  (uint8_t *) value_string,
+			  value_string_size,
+			  error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent filename.",
+			 function );
+
+			goto on_error;
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tParent filename\t\t: %s\n",
+		 value_string );
+
+		memory_free(
+		 value_string );
+
+		value_string = NULL;
+	}
+/* TODO add more info */
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+
+on_error:
+	if( value_string != NULL )
+	{
+		memory_free(
+		 value_string );
+	}
+	if( guid != NULL )
+	{
+		libfguid_identifier_free(
+		 &guid,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Prints a byte size value to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_byte_size_value_fprint(
+     info_handle_t *info_handle,
+     const char *description,
+     size64_t value_size,
+     libcerror_error_t **error )
+{
+	system_character_t byte_size_string[ 16 ];
+
+	static char *function = "info_handle_byte_size_value_fprint";
+	int result            = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( description == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid description.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\t%s:",
+	 description );
+
+	result = byte_size_string_create(
+	          byte_size_string,
+	          16,
+	          value_size,
+	          BYTE_SIZE_STRING_UNIT_MEBIBYTE,
+	          NULL );
+
+	if( result == 1 )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 " %" PRIs_SYSTEM " (%" PRIu64 " bytes)",
+		 byte_size_string,
+		 value_size );
+	}
+	else
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 " %" PRIu64 " bytes",
+		 value_size );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
+/* Retrieves the allocation statistics of a file
+ * The blocks are scanned by the worker threads, each in its own partition of the media,
+ * after which the allocation statistics of the partitions are merged in media order
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_get_allocation_statistics(
+     info_handle_t *info_handle,
+     libvhdi_file_t *vhdi_file,
+     allocation_statistics_t *allocation_statistics,
+     libcerror_error_t **error )
+{
+	allocation_worker_t *allocation_worker = NULL;
+	static char *function                  = "info_handle_get_allocation_statistics";
+	size64_t media_size                    = 0;
+	uint64_t number_of_blocks              = 0;
+	uint32_t block_size                    = 0;
+	int entry_index                        = 0;
+	int number_of_workers                  = 0;
+	int result                             = 0;
+	int worker_index                       = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvhdi_file_get_media_size(
+	     vhdi_file,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	result = libvhdi_file_get_block_size(
+	          vhdi_file,
+	          &block_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block size.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		/* A fixed disk image stores the media data contiguously at the start of the file
+		 */
+		if( media_size > 0 )
+		{
+			if( allocation_statistics_add_block(
+			     allocation_statistics,
+			     0,
+			     0,
+			     media_size,
+			     media_size,
+			     0,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to add media data to allocation statistics.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	else
+	{
+		number_of_blocks = media_size / block_size;
+
+		if( ( media_size % block_size ) != 0 )
+		{
+			number_of_blocks += 1;
+		}
+		number_of_workers = info_handle->number_of_threads;
+
+		if( (uint64_t) number_of_workers > number_of_blocks )
+		{
+			number_of_workers = (int) number_of_blocks;
+		}
+		for( worker_index = 0;
+		     worker_index < number_of_workers;
+		     worker_index++ )
+		{
+			if( allocation_worker_initialize(
+			     &allocation_worker,
+			     vhdi_file,
+			     media_size,
+			     block_size,
+			     worker_index,
+			     number_of_workers,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create worker: %d.",
+				 function,
+				 worker_index );
+
+				goto on_error;
+			}
+			allocation_worker->abort = info_handle->abort;
+
+			if( libcdata_array_append_entry(
+			     info_handle->workers_array,
+			     &entry_index,
+			     (intptr_t *) allocation_worker,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append worker: %d to array.",
+				 function,
+				 worker_index );
+
+				goto on_error;
+			}
+			allocation_worker = NULL;
+		}
+		for( worker_index = 0;
+		     worker_index < number_of_workers;
+		     worker_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     info_handle->workers_array,
+			     worker_index,
+			     (intptr_t **) &allocation_worker,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve worker: %d.",
+				 function,
+				 worker_index );
+
+				allocation_worker = NULL;
+
+				goto on_error;
+			}
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+			if( allocation_worker_start(
+			     allocation_worker,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to start worker: %d.",
+				 function,
+				 worker_index );
+
+				allocation_worker = NULL;
+
+				goto on_error;
+			}
+#else
+			allocation_worker->result = allocation_worker_run(
+			                             allocation_worker,
+			                             error );
+
+			if( allocation_worker->result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to run worker: %d.",
+				 function,
+				 worker_index );
+
+				allocation_worker = NULL;
+
+				goto on_error;
+			}
+#endif
+		}
+		/* The partitions of the workers are merged in media order
+		 */
+		for( worker_index = 0;
+		     worker_index < number_of_workers;
+		     worker_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     info_handle->workers_array,
+			     worker_index,
+			     (intptr_t **) &allocation_worker,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve worker: %d.",
+				 function,
+				 worker_index );
+
+				allocation_worker = NULL;
+
+				goto on_error;
+			}
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+			if( allocation_worker_join(
+			     allocation_worker,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join worker: %d.",
+				 function,
+				 worker_index );
+
+				allocation_worker = NULL;
+
+				goto on_error;
+			}
+			if( allocation_worker->result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: worker: %d failed.",
+				 function,
+				 worker_index );
+
+				allocation_worker = NULL;
+
+				goto on_error;
+			}
+#endif
+			if( allocation_statistics_merge(
+			     allocation_statistics,
+			     allocation_worker->allocation_statistics,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to merge allocation statistics of worker: %d.",
+				 function,
+				 worker_index );
+
+				allocation_worker = NULL;
+
+				goto on_error;
+			}
+		}
+		allocation_worker = NULL;
+
+		if( libcdata_array_empty(
+		     info_handle->workers_array,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &allocation_worker_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty workers array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( allocation_statistics_finalize(
+	     allocation_statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize allocation statistics.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( allocation_worker != NULL )
+	{
+		allocation_worker_free(
+		 &allocation_worker,
+		 NULL );
+	}
+	/* Freeing the workers signals the running worker threads to abort and joins them
+	 */
+	libcdata_array_empty(
+	 info_handle->workers_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &allocation_worker_free,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Prints allocation statistics to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_allocation_statistics_fprint(
+     info_handle_t *info_handle,
+     allocation_statistics_t *allocation_statistics,
+     libcerror_error_t **error )
+{
+	allocation_run_t *run = NULL;
+	static char *function = "info_handle_allocation_statistics_fprint";
+	int run_index         = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tNumber of blocks\t: %" PRIu64 "\n",
+	 allocation_statistics->number_of_blocks );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tAllocated blocks\t: %" PRIu64 "\n",
+	 allocation_statistics->number_of_allocated_blocks );
+
+	if( info_handle_byte_size_value_fprint(
+	     info_handle,
+	     "Allocated\t\t",
+	     allocation_statistics->allocated_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print allocated size.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle_byte_size_value_fprint(
+	     info_handle,
+	     "Sparse\t\t\t",
+	     allocation_statistics->sparse_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print sparse size.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle_byte_size_value_fprint(
+	     info_handle,
+	     "Stored in parent\t",
+	     allocation_statistics->parent_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print parent size.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tNumber of runs\t\t: %" PRIu64 "\n",
+	 allocation_statistics->number_of_runs );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tOut of order blocks\t: %" PRIu64 "\n",
+	 allocation_statistics->number_of_out_of_order_blocks );
+
+	if( allocation_statistics->number_of_largest_runs > 0 )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tLargest runs:\n" );
+
+		for( run_index = 0;
+		     run_index < allocation_statistics->number_of_largest_runs;
+		     run_index++ )
+		{
+			run = &( allocation_statistics->largest_runs[ run_index ] );
+
+			fprintf(
+			 info_handle->notify_stream,
+			 "\t\toffset: 0x%08" PRIx64 " - 0x%08" PRIx64 " (size: %" PRIu64 ") at file offset: 0x%08" PRIx64 "\n",
+			 run->offset,
+			 run->offset + (off64_t) run->size,
+			 run->size,
+			 run->file_offset );
+		}
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
+/* Prints the allocation of the media data resolved in the chain of parent files to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_chain_allocation_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	static char *function   = "info_handle_chain_allocation_fprint";
+	size64_t allocated_size = 0;
+	size64_t extent_size    = 0;
+	size64_t parent_size    = 0;
+	size64_t sparse_size    = 0;
+	off64_t extent_offset   = 0;
+	off64_t offset          = 0;
+	uint32_t extent_flags   = 0;
+	int result              = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	while( info_handle->abort == 0 )
+	{
+		result = libvhdi_file_get_next_chain_extent(
+		          info_handle->input,
+		          offset,
+		          &extent_offset,
+		          &extent_size,
+		          &extent_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		else if( ( result == 0 )
+		      || ( extent_size == 0 ) )
+		{
+			break;
+		}
+		if( ( extent_flags & LIBVHDI_EXTENT_FLAG_IS_PARENT ) != 0 )
+		{
+			parent_size += extent_size;
+		}
+		else if( ( extent_flags & LIBVHDI_EXTENT_FLAG_IS_SPARSE ) != 0 )
+		{
+			sparse_size += extent_size;
+		}
+		else
+		{
+			allocated_size += extent_size;
+		}
+		offset = extent_offset + (off64_t) extent_size;
+	}
 	fprintf(
 	 info_handle->notify_stream,
-	 "\tBytes per sector\t: %" PRIu32 " bytes\n",
-	 value_32bit );
+	 "Chain:\n" );
 
-	if( libfguid_identifier_initialize(
-	     &guid,
+	if( info_handle_byte_size_value_fprint(
+	     info_handle,
+	     "Allocated in image\t",
+	     allocated_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create GUID.",
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print allocated size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libvhdi_file_get_identifier(
-	     info_handle->input,
-	     guid_data,
-	     16,
+	if( info_handle_byte_size_value_fprint(
+	     info_handle,
+	     "Allocated in parents\t",
+	     parent_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve identifier.",
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print parent size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfguid_identifier_copy_from_byte_stream(
-	     guid,
-	     guid_data,
-	     16,
-	     LIBFGUID_ENDIAN_BIG,
+	if( info_handle_byte_size_value_fprint(
+	     info_handle,
+	     "Sparse\t\t\t",
+	     sparse_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
-		 "%s: unable to copy byte stream to GUID.",
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print sparse size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libfguid_identifier_copy_to_utf16_string(
-		  guid,
-		  (uint16_t *) guid_string,
-		  48,
-		  LIBFGUID_STRING_FORMAT_FLAG_USE_LOWER_CASE,
-		  error );
-#else
-	result = libfguid_identifier_copy_to_utf8_string(
-		  guid,
-		  (uint8_t *) guid_string,
-		  48,
-		  LIBFGUID_STRING_FORMAT_FLAG_USE_LOWER_CASE,
-		  error );
-#endif
-	if( result != 1 )
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
+/* Prints the allocation and fragmentation information of the image and its parents to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_allocation_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	allocation_statistics_t *allocation_statistics = NULL;
+	libvhdi_file_t *vhdi_file                      = NULL;
+	static char *function                          = "info_handle_allocation_fprint";
+	uint32_t block_size                            = 0;
+	int layer_index                                = 0;
+	int number_of_parent_files                     = 0;
+	int result                                     = 0;
+
+	if( info_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
-		 "%s: unable to copy GUID to string.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	fprintf(
-	 info_handle->notify_stream,
-	 "\tIdentifier\t\t: %" PRIs_SYSTEM "\n",
-	 guid_string );
-
-	result = libvhdi_file_get_parent_identifier(
-	          info_handle->input,
-	          guid_data,
-	          16,
-	          error );
-
-	if( result == -1 )
+	if( libcdata_array_get_number_of_entries(
+	     info_handle->parent_files_array,
+	     &number_of_parent_files,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve parent identifier.",
+		 "%s: unable to retrieve number of parent files.",
 		 function );
 
 		goto on_error;
 	}
-	else if( result != 0 )
+	fprintf(
+	 info_handle->notify_stream,
+	 "Virtual Hard Disk image allocation information:\n" );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tNumber of layers\t: %d\n",
+	 number_of_parent_files + 1 );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	/* The layers are printed from the input towards its last parent
+	 */
+	for( layer_index = 0;
+	     layer_index <= number_of_parent_files;
+	     layer_index++ )
 	{
-		if( libfguid_identifier_copy_from_byte_stream(
-		     guid,
-		     guid_data,
-		     16,
-		     LIBFGUID_ENDIAN_BIG,
+		if( info_handle->abort != 0 )
+		{
+			break;
+		}
+		if( layer_index == 0 )
+		{
+			vhdi_file = info_handle->input;
+		}
+		else if( libcdata_array_get_entry_by_index(
+		          info_handle->parent_files_array,
+		          layer_index - 1,
+		          (intptr_t **) &vhdi_file,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent file: %d.",
+			 function,
+			 layer_index - 1 );
+
+			goto on_error;
+		}
+		if( allocation_statistics_initialize(
+		     &allocation_statistics,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
-			 "%s: unable to copy byte stream to GUID.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create allocation statistics.",
 			 function );
 
 			goto on_error;
 		}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libfguid_identifier_copy_to_utf16_string(
-		          guid,
-		          (uint16_t *) guid_string,
-		          48,
-		          LIBFGUID_STRING_FORMAT_FLAG_USE_LOWER_CASE,
-		          error );
-#else
-		result = libfguid_identifier_copy_to_utf8_string(
-		          guid,
-		          (uint8_t *) guid_string,
-		          48,
-		          LIBFGUID_STRING_FORMAT_FLAG_USE_LOWER_CASE,
-		          error );
-#endif
-		if( result != 1 )
+		if( info_handle_get_allocation_statistics(
+		     info_handle,
+		     vhdi_file,
+		     allocation_statistics,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
-			 "%s: unable to copy GUID to string.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve allocation statistics of layer: %d.",
+			 function,
+			 layer_index + 1 );
 
 			goto on_error;
 		}
 		fprintf(
 		 info_handle->notify_stream,
-		 "\tParent identifier\t: %" PRIs_SYSTEM "\n",
-		 guid_string );
-	}
-	if( libfguid_identifier_free(
-	     &guid,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free GUID.",
-		 function );
+		 "Layer: %d",
+		 layer_index + 1 );
 
-		goto on_error;
-	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libvhdi_file_get_utf16_parent_filename_size(
-		  info_handle->input,
-		  &value_string_size,
-		  error );
-#else
-	result = libvhdi_file_get_utf8_parent_filename_size(
-		  info_handle->input,
-		  &value_string_size,
-		  error );
-#endif
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve parent filename string size.",
-		 function );
+		if( layer_index == 0 )
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 " (image)" );
+		}
+		else
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 " (parent)" );
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "\n" );
 
-		goto on_error;
-	}
-	else if( result != 0 )
-	{
-		if( value_string_size > (size_t) ( SSIZE_MAX / sizeof( system_character_t ) ) )
+		result = libvhdi_file_get_block_size(
+		          vhdi_file,
+		          &block_size,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-			 "%s: invalid parent filename size value exceeds maximum.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block size.",
 			 function );
 
 			goto on_error;
 		}
-		value_string = system_string_allocate(
-				value_string_size );
+		else if( result != 0 )
+		{
+			if( info_handle_byte_size_value_fprint(
+			     info_handle,
+			     "Block size\t\t",
+			     (size64_t) block_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print block size.",
+				 function );
 
-		if( value_string == NULL )
+				goto on_error;
+			}
+		}
+		if( info_handle_allocation_statistics_fprint(
+		     info_handle,
+		     allocation_statistics,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create parent filename string.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print allocation statistics of layer: %d.",
+			 function,
+			 layer_index + 1 );
 
 			goto on_error;
 		}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libvhdi_file_get_utf16_parent_filename(
-			  info_handle->input,
-			  (uint16_t *) value_string,
-			  value_string_size,
-			  error );
-#else
-		result = libvhdi_file_get_utf8_parent_filename(
-			  info_handle->input,
-			  (uint8_t *) value_string,
-			  value_string_size,
-			  error );
-#endif
-		if( result != 1 )
+		if( allocation_statistics_free(
+		     &allocation_statistics,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve parent filename.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free allocation statistics.",
 			 function );
 
 			goto on_error;
 		}
-		fprintf(
-		 info_handle->notify_stream,
-		 "\tParent filename\t\t: %s\n",
-		 value_string );
-
-		memory_free(
-		 value_string );
-
-		value_string = NULL;
 	}
-/* TODO add more info */
-
-	fprintf(
-	 info_handle->notify_stream,
-	 "\n" );
+	if( number_of_parent_files > 0 )
+	{
+		if( info_handle_chain_allocation_fprint(
+		     info_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print chain allocation.",
+			 function );
 
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
-	if( value_string != NULL )
-	{
-		memory_free(
-		 value_string );
-	}
-	if( guid != NULL )
+	if( allocation_statistics != NULL )
 	{
-		libfguid_identifier_free(
-		 &guid,
+		allocation_statistics_free(
+		 &allocation_statistics,
 		 NULL );
 	}
 	return( -1 );
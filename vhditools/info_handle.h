@@ -26,6 +26,8 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "allocation_statistics.h"
+#include "vhditools_libcdata.h"
 #include "vhditools_libcerror.h"
 #include "vhditools_libcnotify.h"
 #include "vhditools_libvhdi.h"
@@ -38,15 +40,45 @@ typedef struct info_handle info_handle_t;
 
 struct info_handle
 {
+	/* The basename
+	 */
+	system_character_t *basename;
+
+	/* The basename size
+	 */
+	size_t basename_size;
+
 	/* The input
 	 */
 	libvhdi_file_t *input;
 
+	/* The parent files array
+	 */
+	libcdata_array_t *parent_files_array;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The workers array
+	 */
+	libcdata_array_t *workers_array;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
 };
 
+int info_handle_system_string_decimal_copy_to_64_bit(
+     const system_character_t *string,
+     size_t string_length,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
 int info_handle_initialize(
      info_handle_t **info_handle,
      libcerror_error_t **error );
@@ -59,11 +91,27 @@ int info_handle_signal_abort(
      info_handle_t *info_handle,
      libcerror_error_t **error );
 
+int info_handle_set_number_of_threads(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int info_handle_set_basename(
+     info_handle_t *info_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error );
+
 int info_handle_open_input(
      info_handle_t *info_handle,
      const system_character_t *filename,
      libcerror_error_t **error );
 
+int info_handle_open_parent(
+     info_handle_t *info_handle,
+     libvhdi_file_t *vhdi_file,
+     libcerror_error_t **error );
+
 int info_handle_close(
      info_handle_t *info_handle,
      libcerror_error_t **error );
@@ -72,6 +120,31 @@ int info_handle_image_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error );
 
+int info_handle_byte_size_value_fprint(
+     info_handle_t *info_handle,
+     const char *description,
+     size64_t value_size,
+     libcerror_error_t **error );
+
+int info_handle_get_allocation_statistics(
+     info_handle_t *info_handle,
+     libvhdi_file_t *vhdi_file,
+     allocation_statistics_t *allocation_statistics,
+     libcerror_error_t **error );
+
+int info_handle_allocation_statistics_fprint(
+     info_handle_t *info_handle,
+     allocation_statistics_t *allocation_statistics,
+     libcerror_error_t **error );
+
+int info_handle_chain_allocation_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
+int info_handle_allocation_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -880,6 +880,160 @@ ssize_t mount_file_entry_read_buffer_at_offset(
 	return( read_count );
 }
 
+/* Retrieves the next extent starting at a specific offset, resolved in the chain of parent files
+ * Returns 1 if successful, 0 if the offset is beyond the size or -1 on error
+ */
+int mount_file_entry_get_next_extent(
+     mount_file_entry_t *file_entry,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_get_next_extent";
+	int result            = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvhdi_file_get_next_chain_extent(
+	          file_entry->vhdi_file,
+	          offset,
+	          extent_offset,
+	          extent_size,
+	          extent_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent at offset: %" PRIi64 " (0x%08" PRIx64 ") from file.",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the mapped range of the data at a specific offset
+ * The file descriptor is the file descriptor of the image file that stores the data
+ * The mapped size is the number of bytes from the offset, up to size, that are stored contiguously in that file
+ * Returns 1 if successful, 0 if the data is not mapped or -1 on error
+ */
+int mount_file_entry_get_mapped_range(
+     mount_file_entry_t *file_entry,
+     off64_t offset,
+     size_t size,
+     int *file_descriptor,
+     off64_t *mapped_file_offset,
+     size_t *mapped_size,
+     libcerror_error_t **error )
+{
+	static char *function    = "mount_file_entry_get_mapped_range";
+	size_t safe_mapped_size  = 0;
+	off64_t safe_file_offset = 0;
+	int chain_level          = 0;
+	int result               = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapped_file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped file offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapped_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped size.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvhdi_file_get_mapped_range(
+	          file_entry->vhdi_file,
+	          offset,
+	          size,
+	          &chain_level,
+	          &safe_file_offset,
+	          &safe_mapped_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve mapped range at offset: %" PRIi64 " (0x%08" PRIx64 ") from file.",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		result = mount_file_system_get_file_descriptor(
+		          file_entry->file_system,
+		          file_entry->vhdi_file,
+		          chain_level,
+		          file_descriptor,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file descriptor of chain level: %d.",
+			 function,
+			 chain_level );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			*mapped_file_offset = safe_file_offset;
+			*mapped_size        = safe_mapped_size;
+		}
+	}
+	return( result );
+}
+
 /* Retrieves the size
  * Returns 1 if successful or -1 on error
  */
@@ -125,6 +125,23 @@ ssize_t mount_file_entry_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+int mount_file_entry_get_next_extent(
+     mount_file_entry_t *file_entry,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_flags,
+     libcerror_error_t **error );
+
+int mount_file_entry_get_mapped_range(
+     mount_file_entry_t *file_entry,
+     off64_t offset,
+     size_t size,
+     int *file_descriptor,
+     off64_t *mapped_file_offset,
+     size_t *mapped_size,
+     libcerror_error_t **error );
+
 int mount_file_entry_get_size(
      mount_file_entry_t *file_entry,
      size64_t *size,
@@ -36,6 +36,10 @@
 
 #include <time.h>
 
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
 #include "mount_file_system.h"
 #include "vhditools_libcdata.h"
 #include "vhditools_libcerror.h"
@@ -229,6 +233,7 @@ int mount_file_system_free(
      libcerror_error_t **error )
 {
 	static char *function = "mount_file_system_free";
+	int file_index        = 0;
 	int result            = 1;
 
 	if( file_system == NULL )
@@ -263,6 +268,23 @@ int mount_file_system_free(
 
 			result = -1;
 		}
+		if( ( *file_system )->file_descriptors != NULL )
+		{
+#if defined( HAVE_CLOSE )
+			for( file_index = 0;
+			     file_index < ( *file_system )->number_of_file_descriptors;
+			     file_index++ )
+			{
+				if( ( *file_system )->file_descriptors[ file_index ] != -1 )
+				{
+					close(
+					 ( *file_system )->file_descriptors[ file_index ] );
+				}
+			}
+#endif
+			memory_free(
+			 ( *file_system )->file_descriptors );
+		}
 		memory_free(
 		 *file_system );
 
@@ -715,14 +737,120 @@ int mount_file_system_get_file_by_path(
 	return( 1 );
 }
 
+/* Retrieves the file descriptor of a file in the chain of parent files of a specific file
+ * The chain level is the level in the chain, where 0 represents the file itself and 1 its parent file
+ * A parent file is appended to the file system before the file it is the parent of,
+ * hence the file at chain level 1 is the file preceding the file in the file system
+ * Returns 1 if successful, 0 if no file descriptor is available or -1 on error
+ */
+int mount_file_system_get_file_descriptor(
+     mount_file_system_t *file_system,
+     libvhdi_file_t *vhdi_file,
+     int chain_level,
+     int *file_descriptor,
+     libcerror_error_t **error )
+{
+	libvhdi_file_t *array_vhdi_file = NULL;
+	static char *function           = "mount_file_system_get_file_descriptor";
+	int file_index                  = 0;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( vhdi_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( chain_level < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid chain level value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	for( file_index = 0;
+	     file_index < file_system->number_of_file_descriptors;
+	     file_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     file_system->files_array,
+		     file_index,
+		     (intptr_t **) &array_vhdi_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file: %d.",
+			 function,
+			 file_index );
+
+			return( -1 );
+		}
+		if( array_vhdi_file == vhdi_file )
+		{
+			break;
+		}
+	}
+	if( ( file_index >= file_system->number_of_file_descriptors )
+	 || ( chain_level > file_index ) )
+	{
+		return( 0 );
+	}
+	file_index -= chain_level;
+
+	if( file_system->file_descriptors[ file_index ] == -1 )
+	{
+		return( 0 );
+	}
+	*file_descriptor = file_system->file_descriptors[ file_index ];
+
+	return( 1 );
+}
+
 /* Appends a file to the file system
+ * The file descriptor is used to read the data stored in the file directly or -1 if not available
+ * The file system takes over ownership of the file descriptor, also on error
  * Returns 1 if successful or -1 on error
  */
 int mount_file_system_append_file(
      mount_file_system_t *file_system,
      libvhdi_file_t *vhdi_file,
+     int file_descriptor,
      libcerror_error_t **error )
 {
+	int *file_descriptors = NULL;
 	static char *function = "mount_file_system_append_file";
 	int entry_index       = 0;
 
@@ -735,8 +863,25 @@ int mount_file_system_append_file(
 		 "%s: invalid file system.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	file_descriptors = (int *) memory_reallocate(
+	                            file_system->file_descriptors,
+	                            sizeof( int ) * ( file_system->number_of_file_descriptors + 1 ) );
+
+	if( file_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize file descriptors.",
+		 function );
+
+		goto on_error;
 	}
+	file_system->file_descriptors = file_descriptors;
+
 	if( libcdata_array_append_entry(
 	     file_system->files_array,
 	     &entry_index,
@@ -750,9 +895,23 @@ int mount_file_system_append_file(
 		 "%s: unable to append file to array.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
+	file_system->file_descriptors[ entry_index ] = file_descriptor;
+
+	file_system->number_of_file_descriptors = entry_index + 1;
+
 	return( 1 );
+
+on_error:
+#if defined( HAVE_CLOSE )
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+#endif
+	return( -1 );
 }
 
 /* Retrieves the path from a file index.
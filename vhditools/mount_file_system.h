@@ -51,6 +51,14 @@ struct mount_file_system
 	/* The files array
 	 */
 	libcdata_array_t *files_array;
+
+	/* The file descriptors of the files
+	 */
+	int *file_descriptors;
+
+	/* The number of file descriptors
+	 */
+	int number_of_file_descriptors;
 };
 
 int mount_file_system_initialize(
@@ -94,9 +102,17 @@ int mount_file_system_get_file_by_path(
      libvhdi_file_t **vhdi_file,
      libcerror_error_t **error );
 
+int mount_file_system_get_file_descriptor(
+     mount_file_system_t *file_system,
+     libvhdi_file_t *vhdi_file,
+     int chain_level,
+     int *file_descriptor,
+     libcerror_error_t **error );
+
 int mount_file_system_append_file(
      mount_file_system_t *file_system,
      libvhdi_file_t *vhdi_file,
+     int file_descriptor,
      libcerror_error_t **error );
 
 int mount_file_system_get_path_from_file_index(
@@ -54,6 +54,8 @@ extern mount_handle_t *vhdimount_mount_handle;
 #error Size of off_t not supported
 #endif
 
+#define MOUNT_FUSE_MAXIMUM_NUMBER_OF_BUFFERS	32
+
 /* Sets the values in a stat info structure
  * The time values are a signed 64-bit POSIX date and time value in number of nanoseconds
  * Returns 1 if successful or -1 on error
@@ -399,6 +401,13 @@ int mount_fuse_open(
 
 		goto on_error;
 	}
+	/* The image is not modified while mounted in immutable mode,
+	 * hence the kernel does not need to invalidate cached data on open
+	 */
+	if( vhdimount_mount_handle->is_immutable != 0 )
+	{
+		file_info->keep_cache = 1;
+	}
 	return( 0 );
 
 on_error:
@@ -521,6 +530,538 @@ on_error:
 	return( result );
 }
 
+#if defined( HAVE_MOUNT_FUSE_READ_BUF )
+
+/* Reads a buffer vector of data at the specified offset
+ * Data that is stored contiguously in an image file is returned as a reference to
+ * the file descriptor of the file, which allows FUSE to splice the data from the file,
+ * other data is read into memory
+ * Returns 0 if successful or a negative errno value otherwise
+ */
+int mount_fuse_read_buf(
+     const char *path,
+     struct fuse_bufvec **buffer_vector,
+     size_t size,
+     off_t offset,
+     struct fuse_file_info *file_info )
+{
+	struct fuse_bufvec *safe_buffer_vector = NULL;
+	libcerror_error_t *error               = NULL;
+	mount_file_entry_t *file_entry         = NULL;
+	uint8_t *buffer                        = NULL;
+	static char *function                  = "mount_fuse_read_buf";
+	size64_t extent_size                   = 0;
+	size64_t file_size                     = 0;
+	size_t buffer_index                    = 0;
+	size_t mapped_size                     = 0;
+	size_t read_size                       = 0;
+	ssize_t read_count                     = 0;
+	off64_t extent_offset                  = 0;
+	off64_t mapped_file_offset             = 0;
+	off64_t read_offset                    = 0;
+	uint32_t extent_flags                  = 0;
+	int file_descriptor                    = -1;
+	int result                             = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: %s\n",
+		 function,
+		 path );
+	}
+#endif
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( buffer_vector == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer vector.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( size > (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file information.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info->fh == (uint64_t) NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file information - missing file handle.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	file_entry = (mount_file_entry_t *) file_info->fh;
+
+	if( mount_file_entry_get_size(
+	     file_entry,
+	     &file_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry size.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	if( (size64_t) offset >= file_size )
+	{
+		size = 0;
+	}
+	else if( (size64_t) size > ( file_size - offset ) )
+	{
+		size = (size_t) ( file_size - offset );
+	}
+	safe_buffer_vector = (struct fuse_bufvec *) memory_allocate(
+	                                             sizeof( struct fuse_bufvec ) + ( sizeof( struct fuse_buf ) * ( MOUNT_FUSE_MAXIMUM_NUMBER_OF_BUFFERS - 1 ) ) );
+
+	if( safe_buffer_vector == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer vector.",
+		 function );
+
+		result = -ENOMEM;
+
+		goto on_error;
+	}
+	if( memory_set(
+	     safe_buffer_vector,
+	     0,
+	     sizeof( struct fuse_bufvec ) + ( sizeof( struct fuse_buf ) * ( MOUNT_FUSE_MAXIMUM_NUMBER_OF_BUFFERS - 1 ) ) ) == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffer vector.",
+		 function );
+
+		memory_free(
+		 safe_buffer_vector );
+
+		safe_buffer_vector = NULL;
+
+		result = -ENOMEM;
+
+		goto on_error;
+	}
+	read_offset = (off64_t) offset;
+
+	while( size > 0 )
+	{
+		result = 0;
+
+		/* The last buffer is used to read the remaining data into memory
+		 */
+		if( buffer_index < ( MOUNT_FUSE_MAXIMUM_NUMBER_OF_BUFFERS - 1 ) )
+		{
+			result = mount_file_entry_get_mapped_range(
+			          file_entry,
+			          read_offset,
+			          size,
+			          &file_descriptor,
+			          &mapped_file_offset,
+			          &mapped_size,
+			          &error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve mapped range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 read_offset,
+				 read_offset );
+
+				result = -EIO;
+
+				goto on_error;
+			}
+		}
+		if( result != 0 )
+		{
+			read_size = mapped_size;
+
+			safe_buffer_vector->buf[ buffer_index ].size  = read_size;
+			safe_buffer_vector->buf[ buffer_index ].flags = FUSE_BUF_IS_FD | FUSE_BUF_FD_SEEK;
+			safe_buffer_vector->buf[ buffer_index ].fd    = file_descriptor;
+			safe_buffer_vector->buf[ buffer_index ].pos   = (off_t) mapped_file_offset;
+		}
+		else
+		{
+			read_size = size;
+
+			if( buffer_index < ( MOUNT_FUSE_MAXIMUM_NUMBER_OF_BUFFERS - 1 ) )
+			{
+				/* Read the data up to the end of the extent
+				 */
+				result = mount_file_entry_get_next_extent(
+				          file_entry,
+				          read_offset,
+				          &extent_offset,
+				          &extent_size,
+				          &extent_flags,
+				          &error );
+
+				if( result != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve extent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 read_offset,
+					 read_offset );
+
+					result = -EIO;
+
+					goto on_error;
+				}
+				if( ( extent_size > 0 )
+				 && ( extent_size < (size64_t) read_size ) )
+				{
+					read_size = (size_t) extent_size;
+				}
+			}
+			buffer = (uint8_t *) memory_allocate(
+			                      sizeof( uint8_t ) * read_size );
+
+			if( buffer == NULL )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create buffer.",
+				 function );
+
+				result = -ENOMEM;
+
+				goto on_error;
+			}
+			read_count = mount_file_entry_read_buffer_at_offset(
+			              file_entry,
+			              (void *) buffer,
+			              read_size,
+			              read_offset,
+			              &error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read from file entry.",
+				 function );
+
+				result = -EIO;
+
+				goto on_error;
+			}
+			safe_buffer_vector->buf[ buffer_index ].size  = read_size;
+			safe_buffer_vector->buf[ buffer_index ].flags = 0;
+			safe_buffer_vector->buf[ buffer_index ].mem   = (void *) buffer;
+
+			buffer = NULL;
+		}
+		buffer_index++;
+
+		read_offset += read_size;
+		size        -= read_size;
+	}
+	safe_buffer_vector->count = buffer_index;
+	safe_buffer_vector->idx   = 0;
+	safe_buffer_vector->off   = 0;
+
+	*buffer_vector = safe_buffer_vector;
+
+	return( 0 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( safe_buffer_vector != NULL )
+	{
+		while( buffer_index > 0 )
+		{
+			buffer_index--;
+
+			if( ( safe_buffer_vector->buf[ buffer_index ].flags & FUSE_BUF_IS_FD ) == 0 )
+			{
+				memory_free(
+				 safe_buffer_vector->buf[ buffer_index ].mem );
+			}
+		}
+		memory_free(
+		 safe_buffer_vector );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MOUNT_FUSE_READ_BUF ) */
+
+#if defined( HAVE_MOUNT_FUSE_LSEEK )
+
+/* Seeks the next data (SEEK_DATA) or hole (SEEK_HOLE) at or after the specified offset
+ * Data that is sparse in the image file and all its parent files is considered a hole
+ * Returns the offset if successful or a negative errno value otherwise
+ */
+off_t mount_fuse_lseek(
+       const char *path,
+       off_t offset,
+       int whence,
+       struct fuse_file_info *file_info )
+{
+	libcerror_error_t *error       = NULL;
+	mount_file_entry_t *file_entry = NULL;
+	static char *function          = "mount_fuse_lseek";
+	size64_t extent_size           = 0;
+	size64_t file_size             = 0;
+	off64_t extent_offset          = 0;
+	off64_t seek_offset            = 0;
+	uint32_t extent_flags          = 0;
+	int result                     = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: %s\n",
+		 function,
+		 path );
+	}
+#endif
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( ( whence != SEEK_DATA )
+	 && ( whence != SEEK_HOLE ) )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file information.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info->fh == (uint64_t) NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file information - missing file handle.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	file_entry = (mount_file_entry_t *) file_info->fh;
+
+	if( mount_file_entry_get_size(
+	     file_entry,
+	     &file_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry size.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	/* An offset beyond the end of the file is not an error,
+	 * hence no error is set
+	 */
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= file_size ) )
+	{
+		return( (off_t) -ENXIO );
+	}
+	seek_offset = (off64_t) offset;
+
+	while( (size64_t) seek_offset < file_size )
+	{
+		result = mount_file_entry_get_next_extent(
+		          file_entry,
+		          seek_offset,
+		          &extent_offset,
+		          &extent_size,
+		          &extent_flags,
+		          &error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 seek_offset,
+			 seek_offset );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		if( ( ( whence == SEEK_DATA )
+		  &&  ( ( extent_flags & LIBVHDI_EXTENT_FLAG_IS_SPARSE ) == 0 ) )
+		 || ( ( whence == SEEK_HOLE )
+		  &&  ( ( extent_flags & LIBVHDI_EXTENT_FLAG_IS_SPARSE ) != 0 ) ) )
+		{
+			return( (off_t) seek_offset );
+		}
+		if( extent_size == 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extent size value out of bounds.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		seek_offset = extent_offset + (off64_t) extent_size;
+	}
+	/* There is no more data after the offset, and the end of the file is an implicit hole
+	 */
+	if( whence == SEEK_DATA )
+	{
+		return( (off_t) -ENXIO );
+	}
+	return( (off_t) file_size );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( (off_t) result );
+}
+
+#endif /* defined( HAVE_MOUNT_FUSE_LSEEK ) */
+
 /* Releases a file entry
  * Returns 0 if successful or a negative errno value otherwise
  */
@@ -1328,6 +1869,53 @@ on_error:
 	return( result );
 }
 
+/* Initializes the connection with fuse
+ * Returns the private data
+ */
+#if defined( HAVE_LIBFUSE3 )
+void *mount_fuse_init(
+       struct fuse_conn_info *connection_information,
+       struct fuse_config *configuration VHDITOOLS_ATTRIBUTE_UNUSED )
+#else
+void *mount_fuse_init(
+       struct fuse_conn_info *connection_information )
+#endif
+{
+	struct fuse_context *context = NULL;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	static char *function        = "mount_fuse_init";
+#endif
+
+#if defined( HAVE_LIBFUSE3 )
+	VHDITOOLS_UNREFERENCED_PARAMETER( configuration )
+#endif
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s\n",
+		 function );
+	}
+#endif
+	if( ( connection_information != NULL )
+	 && ( vhdimount_mount_handle != NULL )
+	 && ( vhdimount_mount_handle->maximum_read_size != 0 ) )
+	{
+		/* Note that the readahead is limited to the maximum supported by the kernel
+		 */
+		connection_information->max_readahead = vhdimount_mount_handle->maximum_read_size;
+	}
+	context = fuse_get_context();
+
+	if( context == NULL )
+	{
+		return( NULL );
+	}
+	return( context->private_data );
+}
+
 /* Cleans up when fuse is done
  */
 void mount_fuse_destroy(
@@ -32,7 +32,7 @@
 /* Ensure FUSE_USE_VERSION is defined before including fuse.h
  */
 #if defined( HAVE_LIBFUSE3 )
-#define FUSE_USE_VERSION	30
+#define FUSE_USE_VERSION	32
 #else
 #define FUSE_USE_VERSION	26
 #endif
@@ -47,6 +47,16 @@
 #include <osxfuse/fuse.h>
 #endif
 
+#if ( defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) ) && defined( FUSE_BUFVEC_INIT )
+#define HAVE_MOUNT_FUSE_READ_BUF
+#endif
+
+#if defined( HAVE_LIBFUSE3 ) && defined( SEEK_DATA ) && defined( SEEK_HOLE )
+#if FUSE_VERSION >= FUSE_MAKE_VERSION( 3, 8 )
+#define HAVE_MOUNT_FUSE_LSEEK
+#endif
+#endif
+
 #endif /* defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE ) */
 
 #include "mount_file_entry.h"
@@ -102,6 +112,23 @@ int mount_fuse_read(
      off_t offset,
      struct fuse_file_info *file_info );
 
+#if defined( HAVE_MOUNT_FUSE_READ_BUF )
+int mount_fuse_read_buf(
+     const char *path,
+     struct fuse_bufvec **buffer_vector,
+     size_t size,
+     off_t offset,
+     struct fuse_file_info *file_info );
+#endif
+
+#if defined( HAVE_MOUNT_FUSE_LSEEK )
+off_t mount_fuse_lseek(
+       const char *path,
+       off_t offset,
+       int whence,
+       struct fuse_file_info *file_info );
+#endif
+
 int mount_fuse_release(
      const char *path,
      struct fuse_file_info *file_info );
@@ -142,6 +169,15 @@ int mount_fuse_getattr(
      mount_fuse_stat_t *stat_info );
 #endif
 
+#if defined( HAVE_LIBFUSE3 )
+void *mount_fuse_init(
+       struct fuse_conn_info *connection_information,
+       struct fuse_config *configuration );
+#else
+void *mount_fuse_init(
+       struct fuse_conn_info *connection_information );
+#endif
+
 void mount_fuse_destroy(
       void *private_data );
 
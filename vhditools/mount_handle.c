@@ -26,13 +26,34 @@
 #include <types.h>
 #include <wide_string.h>
 
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#include "byte_size_string.h"
 #include "mount_file_entry.h"
 #include "mount_file_system.h"
 #include "mount_handle.h"
 #include "vhditools_libcerror.h"
 #include "vhditools_libcpath.h"
+#include "vhditools_libcthreads.h"
 #include "vhditools_libvhdi.h"
 
+#define MOUNT_HANDLE_MAXIMUM_NUMBER_OF_THREADS	64
+
+#define MOUNT_HANDLE_MAXIMUM_CACHE_TIMEOUT		( 365 * 24 * 60 * 60 )
+#define MOUNT_HANDLE_IMMUTABLE_CACHE_TIMEOUT		( 24 * 60 * 60 )
+
+#define MOUNT_HANDLE_MINIMUM_READ_SIZE			4096
+#define MOUNT_HANDLE_MAXIMUM_READ_SIZE			( 16 * 1024 * 1024 )
+#define MOUNT_HANDLE_IMMUTABLE_MAXIMUM_READ_SIZE	( 1024 * 1024 )
+
+/* The file descriptors of the files are used by the FUSE sub system to read data directly from the files
+ */
+#if ( defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) ) && defined( HAVE_OPEN ) && defined( HAVE_CLOSE ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define MOUNT_HANDLE_HAVE_FILE_DESCRIPTORS
+#endif
+
 /* Creates a mount handle
  * Make sure the value mount_handle is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -106,6 +127,11 @@ int mount_handle_initialize(
 
 		goto on_error;
 	}
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+	( *mount_handle )->number_of_threads = 4;
+#else
+	( *mount_handle )->number_of_threads = 1;
+#endif
 	return( 1 );
 
 on_error:
@@ -357,6 +383,239 @@ int mount_handle_set_path_prefix(
 	return( 1 );
 }
 
+/* Sets the number of threads
+ * The number of threads determines the number of worker threads of the sub system
+ * and the number of file IO handles each image file can read from concurrently
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int mount_handle_set_number_of_threads(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_number_of_threads";
+	size_t string_index   = 0;
+	size_t string_length  = 0;
+	int number_of_threads = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length == 0 )
+	 || ( string_length > 3 ) )
+	{
+		return( 0 );
+	}
+	for( string_index = 0;
+	     string_index < string_length;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] < (system_character_t) '0' )
+		 || ( string[ string_index ] > (system_character_t) '9' ) )
+		{
+			return( 0 );
+		}
+		number_of_threads *= 10;
+		number_of_threads += (int) ( string[ string_index ] - (system_character_t) '0' );
+	}
+#if defined( HAVE_VHDITOOLS_MULTI_THREAD_SUPPORT )
+	if( ( number_of_threads == 0 )
+	 || ( number_of_threads > MOUNT_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+#else
+	if( number_of_threads != 1 )
+#endif
+	{
+		return( 0 );
+	}
+	mount_handle->number_of_threads = number_of_threads;
+
+	return( 1 );
+}
+
+/* Sets the attribute and entry cache timeout
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int mount_handle_set_cache_timeout(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "mount_handle_set_cache_timeout";
+	size_t string_index    = 0;
+	size_t string_length   = 0;
+	uint32_t cache_timeout = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length == 0 )
+	 || ( string_length > 8 ) )
+	{
+		return( 0 );
+	}
+	for( string_index = 0;
+	     string_index < string_length;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] < (system_character_t) '0' )
+		 || ( string[ string_index ] > (system_character_t) '9' ) )
+		{
+			return( 0 );
+		}
+		cache_timeout *= 10;
+		cache_timeout += (uint32_t) ( string[ string_index ] - (system_character_t) '0' );
+	}
+	if( ( cache_timeout == 0 )
+	 || ( cache_timeout > MOUNT_HANDLE_MAXIMUM_CACHE_TIMEOUT ) )
+	{
+		return( 0 );
+	}
+	mount_handle->cache_timeout = cache_timeout;
+
+	return( 1 );
+}
+
+/* Sets the maximum read size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int mount_handle_set_maximum_read_size(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_maximum_read_size";
+	size_t string_length  = 0;
+	uint64_t size_value   = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( byte_size_string_convert(
+	     string,
+	     string_length,
+	     &size_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to determine maximum read size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size_value < (uint64_t) MOUNT_HANDLE_MINIMUM_READ_SIZE )
+	 || ( size_value > (uint64_t) MOUNT_HANDLE_MAXIMUM_READ_SIZE ) )
+	{
+		return( 0 );
+	}
+	mount_handle->maximum_read_size = (uint32_t) size_value;
+
+	return( 1 );
+}
+
+/* Sets immutable mode
+ * In immutable mode the sub system is allowed to keep cached data and attributes of the image,
+ * the cache timeout and maximum read size default to large values if not set
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_immutable(
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_immutable";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	mount_handle->is_immutable = 1;
+
+	if( mount_handle->cache_timeout == 0 )
+	{
+		mount_handle->cache_timeout = MOUNT_HANDLE_IMMUTABLE_CACHE_TIMEOUT;
+	}
+	if( mount_handle->maximum_read_size == 0 )
+	{
+		mount_handle->maximum_read_size = MOUNT_HANDLE_IMMUTABLE_MAXIMUM_READ_SIZE;
+	}
+	return( 1 );
+}
+
 /* Opens the mount handle
  * Returns 1 if successful, 0 if not or -1 on error
  */
@@ -370,6 +629,7 @@ int mount_handle_open(
 	static char *function                  = "mount_handle_open";
 	size_t basename_length                 = 0;
 	size_t filename_length                 = 0;
+	int file_descriptor                    = -1;
 	int result                             = 0;
 
 	if( mount_handle == NULL )
@@ -437,6 +697,20 @@ int mount_handle_open(
 
 		goto on_error;
 	}
+	if( libvhdi_file_set_maximum_number_of_file_io_handles(
+	     vhdi_file,
+	     mount_handle->number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of file IO handles of file.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	result = libvhdi_file_open_wide(
 	          vhdi_file,
@@ -475,9 +749,15 @@ int mount_handle_open(
 
 		goto on_error;
 	}
+#if defined( MOUNT_HANDLE_HAVE_FILE_DESCRIPTORS )
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY );
+#endif
 	if( mount_file_system_append_file(
 	     mount_handle->file_system,
 	     vhdi_file,
+	     file_descriptor,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -520,6 +800,7 @@ int mount_handle_open_parent(
 	size_t parent_basename_length                 = 0;
 	size_t parent_filename_size                   = 0;
 	size_t parent_path_size                       = 0;
+	int file_descriptor                           = -1;
 	int result                                    = 0;
 
 	if( mount_handle == NULL )
@@ -695,6 +976,20 @@ int mount_handle_open_parent(
 
 		goto on_error;
 	}
+	if( libvhdi_file_set_maximum_number_of_file_io_handles(
+	     parent_vhdi_file,
+	     mount_handle->number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of file IO handles of parent file.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libvhdi_file_open_wide(
 	     parent_vhdi_file,
@@ -748,9 +1043,15 @@ int mount_handle_open_parent(
 
 		goto on_error;
 	}
+#if defined( MOUNT_HANDLE_HAVE_FILE_DESCRIPTORS )
+	file_descriptor = open(
+	                   vhdi_parent_path,
+	                   O_RDONLY );
+#endif
 	if( mount_file_system_append_file(
 	     mount_handle->file_system,
 	     parent_vhdi_file,
+	     file_descriptor,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
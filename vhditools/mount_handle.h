@@ -51,6 +51,22 @@ struct mount_handle
 	 */
 	mount_file_system_t *file_system;
 
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* Value to indicate the image is treated as immutable
+	 */
+	uint8_t is_immutable;
+
+	/* The attribute and entry cache timeout in seconds, where 0 represents the sub system default
+	 */
+	uint32_t cache_timeout;
+
+	/* The maximum read size, where 0 represents the sub system default
+	 */
+	uint32_t maximum_read_size;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -80,6 +96,25 @@ int mount_handle_set_path_prefix(
      size_t path_prefix_size,
      libcerror_error_t **error );
 
+int mount_handle_set_number_of_threads(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int mount_handle_set_cache_timeout(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int mount_handle_set_maximum_read_size(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int mount_handle_set_immutable(
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error );
+
 int mount_handle_open(
      mount_handle_t *mount_handle,
      const system_character_t *filename,
@@ -0,0 +1,743 @@
+/*
+ * Measures the read performance of a Virtual Hard Disk (VHD) image file.
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_FCNTL_H ) || defined( WINAPI )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "bench_handle.h"
+#include "bench_image.h"
+#include "byte_size_string.h"
+#include "vhditools_getopt.h"
+#include "vhditools_libcerror.h"
+#include "vhditools_libclocale.h"
+#include "vhditools_libcnotify.h"
+#include "vhditools_libvhdi.h"
+#include "vhditools_output.h"
+#include "vhditools_signal.h"
+#include "vhditools_unused.h"
+
+/* The default media size of a generated image
+ */
+#define VHDIBENCH_DEFAULT_MEDIA_SIZE	268435456UL
+
+bench_handle_t *vhdibench_bench_handle = NULL;
+int vhdibench_abort                    = 0;
+
+/* Signal handler for vhdibench
+ */
+void vhdibench_signal_handler(
+      vhditools_signal_t signal VHDITOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vhdibench_signal_handler";
+
+	VHDITOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vhdibench_abort = 1;
+
+	if( vhdibench_bench_handle != NULL )
+	{
+		if( bench_handle_signal_abort(
+		     vhdibench_bench_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal benchmark handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* Determines the disk type of the image to generate
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int vhdibench_get_generate_disk_type(
+     const system_character_t *string,
+     uint32_t *disk_type,
+     libcerror_error_t **error )
+{
+	static char *function = "vhdibench_get_generate_disk_type";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( disk_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk type.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 5 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "fixed" ),
+		     5 ) == 0 )
+		{
+			*disk_type = LIBVHDI_DISK_TYPE_FIXED;
+			result     = 1;
+		}
+	}
+	else if( string_length == 7 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "dynamic" ),
+		     7 ) == 0 )
+		{
+			*disk_type = LIBVHDI_DISK_TYPE_DYNAMIC;
+			result     = 1;
+		}
+	}
+	else if( string_length == 12 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "differential" ),
+		     12 ) == 0 )
+		{
+			*disk_type = LIBVHDI_DISK_TYPE_DIFFERENTIAL;
+			result     = 1;
+		}
+	}
+	return( result );
+}
+
+/* Determines the media size of the image to generate
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int vhdibench_get_generate_media_size(
+     const system_character_t *string,
+     size64_t *media_size,
+     libcerror_error_t **error )
+{
+	static char *function = "vhdibench_get_generate_media_size";
+	size_t string_length  = 0;
+	uint64_t size_value   = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media size.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( byte_size_string_convert(
+	     string,
+	     string_length,
+	     &size_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to determine media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size_value == 0 )
+	 || ( ( size_value % 512 ) != 0 ) )
+	{
+		return( 0 );
+	}
+	*media_size = (size64_t) size_value;
+
+	return( 1 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	const char *description = \
+		"Use vhdibench to measure the read performance of a Virtual Hard Disk (VHD) image file.";
+
+	vhditools_option_t options[ ] = {
+		{ 'b', "io_size", "specify the size of a single read in bytes, the default is 4096" },
+		{ 'd', "duration", "specify the duration of the benchmark in seconds, the default is 10" },
+		{ 'g', "type", "generate a synthetic image as the source before the benchmark, options: fixed, dynamic, differential" },
+		{ 'h', NULL, "shows this help" },
+		{ 'm', "media_size", "specify the media size of the generated image in bytes, the default is 256 MiB" },
+		{ 'p', "pattern", "specify the access pattern, options: sequential (default), random, strided" },
+		{ 's', "stride", "specify the distance between the start of consecutive strided reads in bytes, the default is 4 times the IO size" },
+		{ 'S', "seed", "specify the seed of the random access pattern and the generated image, the default is 1" },
+		{ 't', "threads", "specify the number of concurrent reader threads, the default is 1" },
+		{ 'v', NULL, "verbose output to stderr" },
+		{ 'V', NULL, "print version" },
+		{ 0, "source", "the source image" },
+	};
+	system_character_t options_string[ 32 ];
+
+	libvhdi_error_t *error                   = NULL;
+	system_character_t *option_duration      = NULL;
+	system_character_t *option_generate_type = NULL;
+	system_character_t *option_io_size       = NULL;
+	system_character_t *option_media_size    = NULL;
+	system_character_t *option_pattern       = NULL;
+	system_character_t *option_seed          = NULL;
+	system_character_t *option_stride        = NULL;
+	system_character_t *option_threads       = NULL;
+	system_character_t *source               = NULL;
+	char *program                            = "vhdibench";
+	system_integer_t option                  = 0;
+	size64_t media_size                      = VHDIBENCH_DEFAULT_MEDIA_SIZE;
+	uint32_t disk_type                       = LIBVHDI_DISK_TYPE_FIXED;
+	int number_of_options                    = (int) ( sizeof( options ) / sizeof( vhditools_option_t ) );
+	int result                               = 0;
+	int verbose                              = 0;
+
+#if defined( __MINGW32__ ) && defined( HAVE_MINGW_BINMODE )
+	_setmode( _fileno( stdout ), _O_BINARY );
+	_setmode( _fileno( stderr ), _O_BINARY );
+#endif
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "vhditools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( vhditools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	vhditools_output_version_fprint(
+	 stdout,
+	 program );
+
+	if( vhditools_getopt_get_options_string(
+	     options,
+	     number_of_options,
+	     options_string,
+	     32 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to determine options string.\n" );
+
+		goto on_error;
+	}
+	while( ( option = vhditools_getopt(
+	                   argc,
+	                   argv,
+	                   options_string ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				vhditools_getopt_usage_fprint(
+				 stdout,
+				 program,
+				 description,
+				 options,
+				 number_of_options );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_io_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'd':
+				option_duration = optarg;
+
+				break;
+
+			case (system_integer_t) 'g':
+				option_generate_type = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				vhditools_getopt_usage_fprint(
+				 stdout,
+				 program,
+				 description,
+				 options,
+				 number_of_options );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'm':
+				option_media_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'p':
+				option_pattern = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_stride = optarg;
+
+				break;
+
+			case (system_integer_t) 'S':
+				option_seed = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vhditools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		vhditools_getopt_usage_fprint(
+		 stdout,
+		 program,
+		 description,
+		 options,
+		 number_of_options );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvhdi_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvhdi_notify_set_verbose(
+	 verbose );
+
+	if( bench_handle_initialize(
+	     &vhdibench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize benchmark handle.\n" );
+
+		goto on_error;
+	}
+	if( option_pattern != NULL )
+	{
+		result = bench_handle_set_access_pattern(
+		          vhdibench_bench_handle,
+		          option_pattern,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set access pattern.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported access pattern defaulting to: sequential.\n" );
+		}
+	}
+	if( option_io_size != NULL )
+	{
+		result = bench_handle_set_io_size(
+		          vhdibench_bench_handle,
+		          option_io_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set IO size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported IO size defaulting to: 4096.\n" );
+		}
+	}
+	if( option_stride != NULL )
+	{
+		result = bench_handle_set_stride(
+		          vhdibench_bench_handle,
+		          option_stride,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set stride.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported stride defaulting to: 4 times the IO size.\n" );
+		}
+	}
+	if( option_threads != NULL )
+	{
+		result = bench_handle_set_number_of_threads(
+		          vhdibench_bench_handle,
+		          option_threads,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads defaulting to: 1.\n" );
+		}
+	}
+	if( option_duration != NULL )
+	{
+		result = bench_handle_set_duration(
+		          vhdibench_bench_handle,
+		          option_duration,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set duration.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported duration defaulting to: 10.\n" );
+		}
+	}
+	if( option_seed != NULL )
+	{
+		result = bench_handle_set_seed(
+		          vhdibench_bench_handle,
+		          option_seed,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set seed.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported seed defaulting to: 1.\n" );
+		}
+	}
+	if( option_generate_type != NULL )
+	{
+		result = vhdibench_get_generate_disk_type(
+		          option_generate_type,
+		          &disk_type,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to determine disk type of generated image.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported disk type of generated image defaulting to: fixed.\n" );
+		}
+		if( option_media_size != NULL )
+		{
+			result = vhdibench_get_generate_media_size(
+			          option_media_size,
+			          &media_size,
+			          &error );
+
+			if( result == -1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to determine media size of generated image.\n" );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				fprintf(
+				 stderr,
+				 "Unsupported media size of generated image defaulting to: 256 MiB.\n" );
+			}
+		}
+		fprintf(
+		 stdout,
+		 "Generating image: %" PRIs_SYSTEM "\n",
+		 source );
+
+		if( bench_image_generate(
+		     source,
+		     disk_type,
+		     media_size,
+		     vhdibench_bench_handle->seed,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to generate image.\n" );
+
+			goto on_error;
+		}
+	}
+	if( bench_handle_open_input(
+	     vhdibench_bench_handle,
+	     source,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open source file.\n" );
+
+		goto on_error;
+	}
+	if( vhditools_signal_attach(
+	     vhdibench_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = bench_handle_run(
+	          vhdibench_bench_handle,
+	          &error );
+
+	if( vhditools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to run benchmark.\n" );
+
+		goto on_error;
+	}
+	if( bench_handle_results_fprint(
+	     vhdibench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to print benchmark results.\n" );
+
+		goto on_error;
+	}
+	if( bench_handle_close(
+	     vhdibench_bench_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close benchmark handle.\n" );
+
+		goto on_error;
+	}
+	if( bench_handle_free(
+	     &vhdibench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free benchmark handle.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vhdibench_bench_handle != NULL )
+	{
+		bench_handle_free(
+		 &vhdibench_bench_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,487 @@
+/*
+ * Calculates the digest hashes of the media data of a Virtual Hard Disk (VHD) image file.
+ *
+ * Copyright (C) 2012-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_FCNTL_H ) || defined( WINAPI )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "byte_size_string.h"
+#include "hash_handle.h"
+#include "vhditools_getopt.h"
+#include "vhditools_libcerror.h"
+#include "vhditools_libclocale.h"
+#include "vhditools_libcnotify.h"
+#include "vhditools_libvhdi.h"
+#include "vhditools_output.h"
+#include "vhditools_signal.h"
+#include "vhditools_unused.h"
+
+hash_handle_t *vhdihash_hash_handle = NULL;
+int vhdihash_abort                  = 0;
+
+/* Signal handler for vhdihash
+ */
+void vhdihash_signal_handler(
+      vhditools_signal_t signal VHDITOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vhdihash_signal_handler";
+
+	VHDITOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vhdihash_abort = 1;
+
+	if( vhdihash_hash_handle != NULL )
+	{
+		if( hash_handle_signal_abort(
+		     vhdihash_hash_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal hash handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	const char *description = \
+		"Use vhdihash to calculate the digest hashes of the media data of a Virtual Hard Disk (VHD) image file.";
+
+	vhditools_option_t options[ ] = {
+		{ 'b', "chunk_size", "specify the size of the chunks that are read and hashed in bytes, the default is 2 MiB" },
+		{ 'd', "digest_types", "calculate additional digest (hash) types besides md5, options: sha1, sha256" },
+		{ 'h', NULL, "shows this help" },
+		{ 'p', "piece_size", "calculate and print piecewise digest hashes of pieces of the specified size in bytes" },
+		{ 't', "threads", "specify the number of concurrent reader threads, the default is 1" },
+		{ 'v', NULL, "verbose output to stderr" },
+		{ 'V', NULL, "print version" },
+		{ 0, "source", "the source image" },
+	};
+	system_character_t options_string[ 32 ];
+
+	libvhdi_error_t *error                    = NULL;
+	system_character_t *option_chunk_size     = NULL;
+	system_character_t *option_digest_types   = NULL;
+	system_character_t *option_piecewise_size = NULL;
+	system_character_t *option_threads        = NULL;
+	system_character_t *source                = NULL;
+	char *program                             = "vhdihash";
+	system_integer_t option                   = 0;
+	int number_of_options                     = (int) ( sizeof( options ) / sizeof( vhditools_option_t ) );
+	int result                                = 0;
+	int verbose                               = 0;
+
+#if defined( __MINGW32__ ) && defined( HAVE_MINGW_BINMODE )
+	_setmode( _fileno( stdout ), _O_BINARY );
+	_setmode( _fileno( stderr ), _O_BINARY );
+#endif
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "vhditools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( vhditools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	vhditools_output_version_fprint(
+	 stdout,
+	 program );
+
+	if( vhditools_getopt_get_options_string(
+	     options,
+	     number_of_options,
+	     options_string,
+	     32 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to determine options string.\n" );
+
+		goto on_error;
+	}
+	while( ( option = vhditools_getopt(
+	                   argc,
+	                   argv,
+	                   options_string ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				vhditools_getopt_usage_fprint(
+				 stdout,
+				 program,
+				 description,
+				 options,
+				 number_of_options );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_chunk_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'd':
+				option_digest_types = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				vhditools_getopt_usage_fprint(
+				 stdout,
+				 program,
+				 description,
+				 options,
+				 number_of_options );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'p':
+				option_piecewise_size = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vhditools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		vhditools_getopt_usage_fprint(
+		 stdout,
+		 program,
+		 description,
+		 options,
+		 number_of_options );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvhdi_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvhdi_notify_set_verbose(
+	 verbose );
+
+	if( hash_handle_initialize(
+	     &vhdihash_hash_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize hash handle.\n" );
+
+		goto on_error;
+	}
+	if( option_chunk_size != NULL )
+	{
+		result = hash_handle_set_chunk_size(
+		          vhdihash_hash_handle,
+		          option_chunk_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set chunk size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported chunk size defaulting to: 2 MiB.\n" );
+		}
+	}
+	if( option_digest_types != NULL )
+	{
+		result = hash_handle_set_additional_digest_types(
+		          vhdihash_hash_handle,
+		          option_digest_types,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set additional digest types.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported additional digest types.\n" );
+		}
+	}
+	if( option_piecewise_size != NULL )
+	{
+		result = hash_handle_set_piecewise_size(
+		          vhdihash_hash_handle,
+		          option_piecewise_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set piecewise size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported piecewise size, piecewise digest hashes are not calculated.\n" );
+		}
+	}
+	if( option_threads != NULL )
+	{
+		result = hash_handle_set_number_of_threads(
+		          vhdihash_hash_handle,
+		          option_threads,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads defaulting to: 1.\n" );
+		}
+	}
+	if( hash_handle_open_input(
+	     vhdihash_hash_handle,
+	     source,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open source file.\n" );
+
+		goto on_error;
+	}
+	if( hash_handle_open_parent(
+	     vhdihash_hash_handle,
+	     vhdihash_hash_handle->input,
+	     &error ) == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open parent file.\n" );
+
+		goto on_error;
+	}
+	if( vhditools_signal_attach(
+	     vhdihash_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = hash_handle_calculate(
+	          vhdihash_hash_handle,
+	          &error );
+
+	if( vhditools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( result != 1 )
+	{
+		if( vhdihash_abort != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "%s: ABORTED\n",
+			 program );
+		}
+		else
+		{
+			fprintf(
+			 stderr,
+			 "Unable to calculate digest hashes.\n" );
+		}
+		goto on_error;
+	}
+	if( hash_handle_results_fprint(
+	     vhdihash_hash_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to print digest hashes.\n" );
+
+		goto on_error;
+	}
+	if( hash_handle_close(
+	     vhdihash_hash_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close hash handle.\n" );
+
+		goto on_error;
+	}
+	if( hash_handle_free(
+	     &vhdihash_hash_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free hash handle.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vhdihash_hash_handle != NULL )
+	{
+		hash_handle_free(
+		 &vhdihash_hash_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -109,19 +109,24 @@ int main( int argc, char * const argv[] )
 		"Use vhdiinfo to determine information about a Virtual Hard Disk (VHD) image file.";
 
 	vhditools_option_t options[ ] = {
+		{ 'a', NULL, "print the allocation and fragmentation of the image and its parents" },
 		{ 'h', NULL, "shows this help" },
+		{ 't', "threads", "specify the number of threads used to scan the allocation, the default is 1" },
 		{ 'v', NULL, "verbose output to stderr" },
 		{ 'V', NULL, "print version" },
 		{ 0, "source", "the source image" },
 	};
 	system_character_t options_string[ 32 ];
 
-	libvhdi_error_t *error     = NULL;
-	system_character_t *source = NULL;
-	char *program              = "vhdiinfo";
-	system_integer_t option    = 0;
-	int number_of_options      = (int) ( sizeof( options ) / sizeof( vhditools_option_t ) );
-	int verbose                = 0;
+	libvhdi_error_t *error             = NULL;
+	system_character_t *option_threads = NULL;
+	system_character_t *source         = NULL;
+	char *program                      = "vhdiinfo";
+	system_integer_t option            = 0;
+	int number_of_options              = (int) ( sizeof( options ) / sizeof( vhditools_option_t ) );
+	int print_allocation               = 0;
+	int result                         = 0;
+	int verbose                        = 0;
 
 #if defined( __MINGW32__ ) && defined( HAVE_MINGW_BINMODE )
 	_setmode( _fileno( stdout ), _O_BINARY );
@@ -193,6 +198,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_FAILURE );
 
+			case (system_integer_t) 'a':
+				print_allocation = 1;
+
+				break;
+
 			case (system_integer_t) 'h':
 				vhditools_getopt_usage_fprint(
 				 stdout,
@@ -203,6 +213,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 't':
+				option_threads = optarg;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -250,6 +265,28 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( option_threads != NULL )
+	{
+		result = info_handle_set_number_of_threads(
+		          vhdiinfo_info_handle,
+		          option_threads,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads defaulting to: 1.\n" );
+		}
+	}
 	if( info_handle_open_input(
 	     vhdiinfo_info_handle,
 	     source,
@@ -271,6 +308,32 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( print_allocation != 0 )
+	{
+		/* The parent files are only needed to resolve the allocation in the chain
+		 */
+		if( info_handle_open_parent(
+		     vhdiinfo_info_handle,
+		     vhdiinfo_info_handle->input,
+		     &error ) == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open parent file.\n" );
+
+			goto on_error;
+		}
+		if( info_handle_allocation_fprint(
+		     vhdiinfo_info_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to print allocation information.\n" );
+
+			goto on_error;
+		}
+	}
 	if( info_handle_close(
 	     vhdiinfo_info_handle,
 	     &error ) != 0 )
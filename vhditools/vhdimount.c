@@ -22,6 +22,7 @@
 #include <common.h>
 #include <file_stream.h>
 #include <memory.h>
+#include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
 
@@ -115,7 +116,15 @@ int main( int argc, char * const argv[] )
 		"Use vhdimount to mount a Virtual Hard Disk (VHD) image file.";
 
 	vhditools_option_t options[ ] = {
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
+		{ 'c', "cache_timeout", "specify the attribute and entry cache timeout in seconds, the default is determined by the sub system or 86400 in immutable mode" },
+#endif
 		{ 'h', NULL, "shows this help" },
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
+		{ 'i', NULL, "immutable mode, allows the sub system to keep cached data and attributes, the source image must not be modified while mounted" },
+		{ 'r', "read_size", "specify the maximum read and readahead size in bytes, the default is determined by the sub system or 1 MiB in immutable mode" },
+#endif
+		{ 't', "threads", "specify the number of concurrent worker threads, the default is 4 if multi-thread support is available, otherwise 1" },
 		{ 'v', NULL, "verbose output to stderr, while vhdimount will remain running in the foreground" },
 		{ 'V', NULL, "print version" },
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
@@ -129,21 +138,27 @@ int main( int argc, char * const argv[] )
 	const system_character_t *path_prefix       = NULL;
 	libvhdi_error_t *error                      = NULL;
 	size_t path_prefix_size                     = 0;
+	system_character_t *option_threads          = NULL;
 	system_character_t *source                  = NULL;
 	char *program                               = "vhdimount";
 	system_integer_t option                     = 0;
 	int number_of_options                       = (int) ( sizeof( options ) / sizeof( vhditools_option_t ) );
+	int result                                  = 0;
 	int verbose                                 = 0;
 
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE ) || defined( HAVE_LIBDOKAN )
 	system_character_t *mount_point             = NULL;
-	int result                                  = 0;
 #endif
 
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
 	struct fuse_operations vhdimount_fuse_operations;
 
+	system_character_t *option_cache_timeout    = NULL;
 	system_character_t *option_extended_options = NULL;
+	system_character_t *option_read_size        = NULL;
+	char fuse_option_string[ 64 ];
+	int immutable_mode                          = 0;
+	int print_count                             = 0;
 
 #if defined( HAVE_LIBFUSE3 )
 	/* Need to set this to 1 even if there no arguments, otherwise this causes
@@ -151,6 +166,7 @@ int main( int argc, char * const argv[] )
 	 */
 	char *fuse_argv[ 2 ]                        = { program, NULL };
 	struct fuse_args vhdimount_fuse_arguments   = FUSE_ARGS_INIT(1, fuse_argv);
+	struct fuse_loop_config vhdimount_fuse_loop_config;
 #else
 	struct fuse_args vhdimount_fuse_arguments   = FUSE_ARGS_INIT(0, NULL);
 	struct fuse_chan *vhdimount_fuse_channel    = NULL;
@@ -232,6 +248,13 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_FAILURE );
 
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
+			case (system_integer_t) 'c':
+				option_cache_timeout = optarg;
+
+				break;
+#endif
+
 			case (system_integer_t) 'h':
 				vhditools_getopt_usage_fprint(
 				 stdout,
@@ -242,6 +265,23 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
+			case (system_integer_t) 'i':
+				immutable_mode = 1;
+
+				break;
+
+			case (system_integer_t) 'r':
+				option_read_size = optarg;
+
+				break;
+#endif
+
+			case (system_integer_t) 't':
+				option_threads = optarg;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -314,6 +354,88 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( option_threads != NULL )
+	{
+		result = mount_handle_set_number_of_threads(
+		          vhdimount_mount_handle,
+		          option_threads,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads defaulting to: %d.\n",
+			 vhdimount_mount_handle->number_of_threads );
+		}
+	}
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
+	if( option_cache_timeout != NULL )
+	{
+		result = mount_handle_set_cache_timeout(
+		          vhdimount_mount_handle,
+		          option_cache_timeout,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set cache timeout.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported cache timeout using default.\n" );
+		}
+	}
+	if( option_read_size != NULL )
+	{
+		result = mount_handle_set_maximum_read_size(
+		          vhdimount_mount_handle,
+		          option_read_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set maximum read size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported maximum read size using default.\n" );
+		}
+	}
+	if( immutable_mode != 0 )
+	{
+		if( mount_handle_set_immutable(
+		     vhdimount_mount_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set immutable mode.\n" );
+
+			goto on_error;
+		}
+	}
+#endif
 #if defined( WINAPI )
 	path_prefix = _SYSTEM_STRING( "\\VHDI" );
 #else
@@ -346,7 +468,9 @@ int main( int argc, char * const argv[] )
 		goto on_error;
 	}
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
-	if( option_extended_options != NULL )
+	if( ( option_extended_options != NULL )
+	 || ( vhdimount_mount_handle->cache_timeout != 0 )
+	 || ( vhdimount_mount_handle->maximum_read_size != 0 ) )
 	{
 #if defined( HAVE_LIBFUSE3 )
 		// fuse_opt_add_arg: Assertion `!args->argv || args->allocated' failed.
@@ -365,6 +489,86 @@ int main( int argc, char * const argv[] )
 
 			goto on_error;
 		}
+	}
+	if( vhdimount_mount_handle->cache_timeout != 0 )
+	{
+		print_count = narrow_string_snprintf(
+		               fuse_option_string,
+		               64,
+		               "attr_timeout=%" PRIu32 ",entry_timeout=%" PRIu32 "",
+		               vhdimount_mount_handle->cache_timeout,
+		               vhdimount_mount_handle->cache_timeout );
+
+		if( ( print_count < 0 )
+		 || ( print_count >= 64 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set cache timeout fuse option.\n" );
+
+			goto on_error;
+		}
+		if( fuse_opt_add_arg(
+		     &vhdimount_fuse_arguments,
+		     "-o" ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable add fuse arguments.\n" );
+
+			goto on_error;
+		}
+		if( fuse_opt_add_arg(
+		     &vhdimount_fuse_arguments,
+		     fuse_option_string ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable add fuse arguments.\n" );
+
+			goto on_error;
+		}
+	}
+	if( vhdimount_mount_handle->maximum_read_size != 0 )
+	{
+		print_count = narrow_string_snprintf(
+		               fuse_option_string,
+		               64,
+		               "max_read=%" PRIu32 "",
+		               vhdimount_mount_handle->maximum_read_size );
+
+		if( ( print_count < 0 )
+		 || ( print_count >= 64 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set maximum read size fuse option.\n" );
+
+			goto on_error;
+		}
+		if( fuse_opt_add_arg(
+		     &vhdimount_fuse_arguments,
+		     "-o" ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable add fuse arguments.\n" );
+
+			goto on_error;
+		}
+		if( fuse_opt_add_arg(
+		     &vhdimount_fuse_arguments,
+		     fuse_option_string ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable add fuse arguments.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_extended_options != NULL )
+	{
 		if( fuse_opt_add_arg(
 		     &vhdimount_fuse_arguments,
 		     "-o" ) != 0 )
@@ -399,11 +603,18 @@ int main( int argc, char * const argv[] )
 	}
 	vhdimount_fuse_operations.open       = &mount_fuse_open;
 	vhdimount_fuse_operations.read       = &mount_fuse_read;
+#if defined( HAVE_MOUNT_FUSE_READ_BUF )
+	vhdimount_fuse_operations.read_buf   = &mount_fuse_read_buf;
+#endif
+#if defined( HAVE_MOUNT_FUSE_LSEEK )
+	vhdimount_fuse_operations.lseek      = &mount_fuse_lseek;
+#endif
 	vhdimount_fuse_operations.release    = &mount_fuse_release;
 	vhdimount_fuse_operations.opendir    = &mount_fuse_opendir;
 	vhdimount_fuse_operations.readdir    = &mount_fuse_readdir;
 	vhdimount_fuse_operations.releasedir = &mount_fuse_releasedir;
 	vhdimount_fuse_operations.getattr    = &mount_fuse_getattr;
+	vhdimount_fuse_operations.init       = &mount_fuse_init;
 	vhdimount_fuse_operations.destroy    = &mount_fuse_destroy;
 
 #if defined( HAVE_LIBFUSE3 )
@@ -475,8 +686,25 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
-	result = fuse_loop(
-	          vhdimount_fuse_handle );
+	if( vhdimount_mount_handle->number_of_threads > 1 )
+	{
+#if defined( HAVE_LIBFUSE3 )
+		vhdimount_fuse_loop_config.clone_fd         = 0;
+		vhdimount_fuse_loop_config.max_idle_threads = (unsigned int) vhdimount_mount_handle->number_of_threads;
+
+		result = fuse_loop_mt(
+		          vhdimount_fuse_handle,
+		          &vhdimount_fuse_loop_config );
+#else
+		result = fuse_loop_mt(
+		          vhdimount_fuse_handle );
+#endif
+	}
+	else
+	{
+		result = fuse_loop(
+		          vhdimount_fuse_handle );
+	}
 
 	if( result != 0 )
 	{
@@ -521,9 +749,16 @@ int main( int argc, char * const argv[] )
 	vhdimount_dokan_options.MountPoint = mount_point;
 
 #if DOKAN_MINIMUM_COMPATIBLE_VERSION >= 200
-	vhdimount_dokan_options.SingleThread = TRUE;
+	if( vhdimount_mount_handle->number_of_threads > 1 )
+	{
+		vhdimount_dokan_options.SingleThread = FALSE;
+	}
+	else
+	{
+		vhdimount_dokan_options.SingleThread = TRUE;
+	}
 #else
-	vhdimount_dokan_options.ThreadCount  = 0;
+	vhdimount_dokan_options.ThreadCount  = (USHORT) vhdimount_mount_handle->number_of_threads;
 #endif
 	if( verbose != 0 )
 	{